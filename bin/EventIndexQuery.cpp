@@ -0,0 +1,89 @@
+/**
+   Query tool for the index files written by DQM/Physics/interface/EventBitmap.h (SelectionIndex)
+
+   Reads the records of all given index files and combines the events passing the given
+   selection steps (module:step, e.g. topSingleMuonMediumDQM:step2 or ewkMuDQM:ZMuMu) per
+   luminosity section: by default the intersection (events passing all steps), with --or
+   the union (events passing any of the steps). Records of the same step in several files
+   (e.g. of several jobs) are united first. The events are printed as "run lumi event", one
+   per line, sorted by run, lumi and event number; with --count only the number of events
+   per luminosity section and in total are printed. The event data are not accessed.
+
+   Usage: EventIndexQuery [--or] [--count] module:step [module:step ...] -- file [file ...]
+*/
+
+#include <map>
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#include "DQM/Physics/interface/EventBitmap.h"
+
+int main(int argc, char* argv[])
+{
+  bool unite=false, count=false;
+  std::vector<std::string> keys, files;
+  bool options=true;
+  for(int idx=1; idx<argc; ++idx){
+    if( options && !std::strcmp(argv[idx], "--or"   ) ){ unite=true; continue; }
+    if( options && !std::strcmp(argv[idx], "--count") ){ count=true; continue; }
+    if( options && !std::strcmp(argv[idx], "--"     ) ){ options=false; continue; }
+    if( options ) keys.push_back(argv[idx]); else files.push_back(argv[idx]);
+  }
+  if( keys.empty() || files.empty() ){
+    std::fprintf(stderr, "Usage: %s [--or] [--count] module:step [module:step ...] -- file [file ...]\n", argv[0]);
+    return 2;
+  }
+
+  // events per luminosity section and requested step
+  typedef std::pair<unsigned int, unsigned int> LumiID;
+  std::map<LumiID, std::vector<EventBitmap> > lumis;
+  std::map<LumiID, std::vector<bool> > found;
+  for(std::vector<std::string>::const_iterator file=files.begin(); file!=files.end(); ++file){
+    std::ifstream in(file->c_str(), std::ios::in|std::ios::binary);
+    if( !in || !SelectionIndex::header(in) ){
+      std::fprintf(stderr, "%s: no index file\n", file->c_str());
+      return 1;
+    }
+    SelectionIndex::Record record;
+    while( SelectionIndex::read(in, record) ){
+      std::vector<std::string>::const_iterator key=std::find(keys.begin(), keys.end(), record.module+":"+record.step);
+      if( key==keys.end() ) continue;
+      LumiID lumi(record.run, record.lumi);
+      if( lumis.find(lumi)==lumis.end() ){ lumis[lumi].resize(keys.size()); found[lumi].resize(keys.size(), false); }
+      lumis[lumi][key-keys.begin()]|=record.events; found[lumi][key-keys.begin()]=true;
+    }
+    if( !in.eof() ){
+      std::fprintf(stderr, "%s: corrupt record\n", file->c_str());
+      return 1;
+    }
+  }
+
+  unsigned long total=0;
+  for(std::map<LumiID, std::vector<EventBitmap> >::iterator lumi=lumis.begin(); lumi!=lumis.end(); ++lumi){
+    // a step without record has no passing
+    // events in this luminosity section
+    EventBitmap events=lumi->second[0];
+    for(unsigned int idx=1; idx<keys.size(); ++idx){
+      if( unite ) events|=lumi->second[idx];
+      else if( !found[lumi->first][idx] ){ events.clear(); break; }
+      else events&=lumi->second[idx];
+    }
+    if( events.empty() ) continue;
+    total+=events.size();
+    if( count ){
+      std::printf("%u %u %lu\n", lumi->first.first, lumi->first.second, (unsigned long)events.size());
+      continue;
+    }
+    std::vector<uint64_t> numbers=events.events();
+    for(std::vector<uint64_t>::const_iterator event=numbers.begin(); event!=numbers.end(); ++event){
+      std::printf("%u %u %llu\n", lumi->first.first, lumi->first.second, (unsigned long long)*event);
+    }
+  }
+  if( count ) std::printf("total %lu\n", total);
+  return 0;
+}
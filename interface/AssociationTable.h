@@ -0,0 +1,110 @@
+#ifndef ASSOCIATIONTABLE
+#define ASSOCIATIONTABLE
+
+#include <vector>
+
+#include "DataFormats/Common/interface/Ptr.h"
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/JetReco/interface/Jet.h"
+#include "DataFormats/BTauReco/interface/JetTag.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+/**
+   \class   AssociationTable AssociationTable.h "DQM/Physics/interface/AssociationTable.h"
+
+   \brief   Helper class to look up the values associated to a collection by index.
+
+   Helper class to resolve an association (an edm::ValueMap, e.g. the electronId or the
+   JetIDValueMap, or a reco::JetTagCollection) once per event into a dense vector that is
+   aligned with the indices of the edm::View it is used with. The look up by RefToBase,
+   which builds a RefToBase for each object and access, is replaced by a plain array
+   access with the index of the object in the view:
+
+   AssociationTable<float> btags;
+   btags.resolve(*jets, *btagger);
+   for(unsigned int idx=0; idx<jets->size(); ++idx){ if( btags[idx]>workingPoint ) ... }
+
+   The table is meant to be kept as a member and resolved for each event; its memory is
+   reused. As for the look up by RefToBase, an object that is not contained in the
+   association results in an exception, as does the access via _at_ with an index beyond
+   the view. Associations which are only defined for objects of a derived type (e.g. the
+   JetIDValueMap for the calo jets of a view of reco::Jets) are resolved via _resolveType_.
+*/
+
+template <typename T>
+class AssociationTable {
+ public:
+  /// default constructor
+  AssociationTable(){};
+  /// default destructor
+  ~AssociationTable(){};
+
+  /// resolve the values of _map_ for all objects of _view_
+  template <typename Object>
+  void resolve(const edm::View<Object>& view, const edm::ValueMap<T>& map);
+  /// resolve the values of _map_ for the objects of _view_ of type _Type_; all
+  /// other objects get a default constructed value
+  template <typename Type, typename Object>
+  void resolveType(const edm::View<Object>& view, const edm::ValueMap<T>& map);
+  /// resolve the discriminators of _tags_ for all jets of _view_
+  void resolve(const edm::View<reco::Jet>& view, const reco::JetTagCollection& tags);
+  /// value associated to the object with index _idx_ in the view
+  const T& operator[](unsigned int idx) const { return values_[idx]; };
+  /// value associated to the object with index _idx_ in the view; throws
+  /// if _idx_ is beyond the view the table has been resolved for
+  const T& at(unsigned int idx) const {
+    if( idx>=values_.size() ){
+      throw cms::Exception("InvalidReference") << "AssociationTable: index " << idx << " is beyond the " << values_.size() << " resolved values\n";
+    }
+    return values_[idx];
+  };
+  /// number of resolved values
+  unsigned int size() const { return values_.size(); };
+
+ private:
+  /// values in the order of the view
+  std::vector<T> values_;
+};
+
+template <typename T>
+template <typename Object>
+inline void AssociationTable<T>::resolve(const edm::View<Object>& view, const edm::ValueMap<T>& map)
+{
+  values_.resize(view.size());
+  for(unsigned int idx=0; idx<view.size(); ++idx){
+    // a Ptr does not need a heap allocated holder as a RefToBase
+    edm::Ptr<Object> obj=view.ptrAt(idx);
+    values_[idx]=map.get(obj.id(), obj.key());
+  }
+}
+
+template <typename T>
+template <typename Type, typename Object>
+inline void AssociationTable<T>::resolveType(const edm::View<Object>& view, const edm::ValueMap<T>& map)
+{
+  values_.resize(view.size());
+  for(unsigned int idx=0; idx<view.size(); ++idx){
+    if( !dynamic_cast<const Type*>(&view[idx]) ){ values_[idx]=T(); continue; }
+    edm::Ptr<Object> obj=view.ptrAt(idx);
+    values_[idx]=map.get(obj.id(), obj.key());
+  }
+}
+
+template <typename T>
+inline void AssociationTable<T>::resolve(const edm::View<reco::Jet>& view, const reco::JetTagCollection& tags)
+{
+  // the tags are stored in the order of the jet
+  // collection they have been determined for
+  values_.resize(view.size());
+  edm::ProductID id=tags.keyProduct().id();
+  for(unsigned int idx=0; idx<view.size(); ++idx){
+    edm::Ptr<reco::Jet> jet=view.ptrAt(idx);
+    if( jet.id()!=id || jet.key()>=tags.size() ){
+      throw cms::Exception("InvalidReference") << "AssociationTable: jet " << jet.key() << " of product " << jet.id() << " is not tagged\n";
+    }
+    values_[idx]=tags[jet.key()].second;
+  }
+}
+
+#endif
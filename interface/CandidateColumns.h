@@ -0,0 +1,74 @@
+#ifndef CANDIDATECOLUMNS
+#define CANDIDATECOLUMNS
+
+#include <vector>
+
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/BeamSpot/interface/BeamSpot.h"
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+/**
+   \class   MuonColumns CandidateColumns.h "DQM/Physics/interface/CandidateColumns.h"
+
+   \brief   Columnar snapshot of the scalar quantities of a muon collection.
+
+   The quantities of the muons which are read by the DQM/Physics modules are copied
+   once per event into flat arrays (one array per quantity, one entry per muon in the
+   order of the collection). Quantities of the global and the inner track, which are
+   reached via references to other collections, are resolved during the fill; the
+   selection loops of the modules then run over contiguous memory. Track quantities
+   are 0 for muons without the corresponding track (see HAS_GLOBAL_TRACK and
+   HAS_INNER_TRACK). The impact parameters are taken w.r.t. the beam spot. The arrays
+   keep their capacity between events. Example:
+
+   MuonColumns muons;
+   if( !muons.fill(event, muonTag, beamSpotTag) ) return;
+   for(unsigned int idx=0; idx<muons.size(); ++idx){
+     if( muons.is(idx, MuonColumns::GLOBAL) ) pt->Fill(muons.pt[idx]);
+   }
+*/
+
+class MuonColumns {
+ public:
+  /// muon type and track availability flags
+  enum Flags { GLOBAL=1, TRACKER=2, STANDALONE=4, HAS_GLOBAL_TRACK=8, HAS_INNER_TRACK=16 };
+
+ public:
+  /// default constructor
+  MuonColumns(){};
+  /// default destructor
+  ~MuonColumns(){};
+
+  /// fill from the collections in the event; returns false if one of them is not found
+  bool fill(const edm::Event& event, const edm::InputTag& muons, const edm::InputTag& beamSpot);
+  /// fill from a muon collection and the beam spot position
+  void fill(const edm::View<reco::Muon>& muons, const reco::BeamSpot::Point& beamSpot);
+  /// remove all muons
+  void clear();
+
+  /// number of muons
+  unsigned int size() const { return pt.size(); };
+  /// true if the idx-th muon has the flag(s) _flag_ set
+  bool is(unsigned int idx, unsigned int flag) const { return (flags[idx]&flag)==flag; };
+
+ public:
+  /// kinematics
+  std::vector<double> pt, eta, phi, px, py, pz, p;
+  std::vector<int> charge;
+  /// muon type and track availability
+  std::vector<unsigned int> flags;
+  /// number of matched muon stations
+  std::vector<int> nMatches;
+  /// global track: impact parameter, normalized chi2 and valid muon hits
+  std::vector<double> globalDxy, globalNormalizedChi2;
+  std::vector<int> muonHits;
+  /// inner track: impact parameter and valid hits
+  std::vector<double> innerDxy;
+  std::vector<int> innerValidHits, trackerHits, pixelHits;
+  /// isolation in a cone of 0.3
+  std::vector<double> isoR03SumPt, isoR03EmEt, isoR03HadEt;
+};
+
+#endif
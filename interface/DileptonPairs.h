@@ -0,0 +1,85 @@
+#ifndef DILEPTONPAIRS
+#define DILEPTONPAIRS
+
+#include <vector>
+
+/**
+   \class   DileptonPairs DileptonPairs.h "DQM/Physics/interface/DileptonPairs.h"
+
+   \brief   Helper class to compute the invariant masses of all lepton pairs of an event.
+
+   Helper class to compute the invariant masses and the charge flags of all pairs
+   (i<j) of a list of leptons in one go. The four momenta and the charges of the
+   leptons are kept as structure of arrays (px, py, pz, E, charge), such that the
+   inner loop of the pair computation runs over contiguous memory without branches
+   and can be vectorized by the compiler (for the square roots this needs
+   -fno-math-errno, which is set for the package in the BuildFile). Leptons are added in the order of the
+   collection they are taken from; the index returned by add is the index to be used
+   in the mass and flags functions. The masses follow the convention of ROOT's
+   LorentzVector::M(), i.e. they are negative (-sqrt(-m^2)) for space-like pairs.
+   Example:
+
+   DileptonPairs pairs;
+   for(unsigned int idx=0; idx<muons.size(); ++idx){ pairs.add(muons[idx]); }
+   pairs.compute();
+   for(unsigned int i=0; i<pairs.size(); ++i){
+     for(unsigned int j=i+1; j<pairs.size(); ++j){
+       if( pairs.oppositeSign(i, j) ) mass->Fill(pairs.mass(i, j));
+     }
+   }
+
+   The storage is kept between events, such that there are no heap allocations once
+   the largest multiplicity has been seen. Leptons can be added with an energy that
+   differs from the one of the candidate (e.g. with a mass hypothesis or in the
+   massless approximation |p|) via the explicit version of add.
+*/
+
+class DileptonPairs {
+ public:
+  /// charge flags of a lepton pair
+  enum Flags { SAME_SIGN=1, OPPOSITE_SIGN=2 };
+
+ public:
+  /// default constructor
+  DileptonPairs(){};
+  /// default destructor
+  ~DileptonPairs(){};
+
+  /// remove all leptons (to be called at the beginning of each event)
+  void clear();
+  /// add a lepton from its four momentum and charge; returns its index
+  unsigned int add(double px, double py, double pz, double energy, int charge);
+  /// add a lepton candidate; returns its index
+  template <typename Lepton>
+  unsigned int add(const Lepton& lepton){ return add(lepton.px(), lepton.py(), lepton.pz(), lepton.energy(), lepton.charge()); };
+  /// compute the masses and charge flags of all pairs
+  void compute();
+
+  /// number of leptons
+  unsigned int size() const { return px_.size(); };
+  /// invariant mass of the pair (i, j)
+  double mass(unsigned int i, unsigned int j) const { return mass_[pair(i, j)]; };
+  /// charge flags of the pair (i, j)
+  unsigned int flags(unsigned int i, unsigned int j) const { return flags_[pair(i, j)]; };
+  /// true if the leptons of the pair (i, j) have the same charge
+  bool sameSign(unsigned int i, unsigned int j) const { return flags(i, j)&SAME_SIGN; };
+  /// true if the leptons of the pair (i, j) have opposite charge
+  bool oppositeSign(unsigned int i, unsigned int j) const { return flags(i, j)&OPPOSITE_SIGN; };
+
+ private:
+  /// index of the pair (i, j) in the pair arrays (with i<j or j<i)
+  unsigned int pair(unsigned int i, unsigned int j) const {
+    if( j<i ){ unsigned int k=i; i=j; j=k; }
+    return i*(2*size()-i-1)/2+(j-i-1);
+  };
+
+ private:
+  /// four momenta and charges of the leptons
+  std::vector<double> px_, py_, pz_, energy_;
+  std::vector<int> charge_;
+  /// masses and charge flags of all pairs
+  std::vector<double> mass_;
+  std::vector<unsigned char> flags_;
+};
+
+#endif
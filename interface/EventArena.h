@@ -0,0 +1,129 @@
+#ifndef EVENTARENA
+#define EVENTARENA
+
+#include <new>
+#include <vector>
+#include <cstddef>
+
+/**
+   \class   EventArena EventArena.h "DQM/Physics/interface/EventArena.h"
+
+   \brief   Monotonic memory arena for the per-event scratch containers.
+
+   Helper class to provide the memory of short lived containers (selected leptons and
+   jets, b-tag values, ...), which are filled and dropped again for every event. The
+   memory is taken from large blocks by moving a pointer; it is not returned to the
+   arena before _reset_, which the owner calls once per event when none of the scratch
+   containers is alive any more. If the event needed more than one block, the blocks
+   are merged into a single one at the reset, such that in the steady state the storage
+   of the containers is not allocated from the heap. This holds for the containers only:
+   elements which own heap memory themselves still allocate it when they are copied into
+   the container (e.g. the daughters of a reco::Jet); only containers of plain values or
+   pointers (e.g. the selected leptons, the b-tag values) are free of heap allocations.
+   The arena is owned by the module (one per module instance and thus per stream) and is
+   not thread safe. The containers use it via the ArenaAllocator; example:
+
+   ArenaVector<const reco::GsfElectron*>::type elecs(arena);
+   elecs.reserve(n);
+*/
+
+class EventArena {
+ public:
+  /// default constructor; the first block is allocated with the first request
+  explicit EventArena(size_t blockSize=64*1024);
+  /// default destructor
+  ~EventArena();
+
+  /// _bytes_ bytes of memory aligned for any fundamental type
+  void* allocate(size_t bytes){
+    bytes=(bytes+ALIGNMENT-1)&~(ALIGNMENT-1);
+    if( bytes>left_ ) return grow(bytes);
+    void* memory=current_; current_+=bytes; left_-=bytes;
+    return memory;
+  };
+  /// release all memory for reuse; all containers using the arena have to be gone
+  void reset();
+
+ private:
+  /// add a block of at least _bytes_ bytes and allocate from it
+  void* grow(size_t bytes);
+  /// not copyable
+  EventArena(const EventArena&);
+  EventArena& operator=(const EventArena&);
+
+ private:
+  /// alignment of all allocations
+  static const size_t ALIGNMENT=2*sizeof(double);
+  /// size of the first block
+  size_t blockSize_;
+  /// blocks and their sizes
+  std::vector<char*> blocks_;
+  std::vector<size_t> sizes_;
+  /// next free byte and number of free bytes of the last block
+  char* current_;
+  size_t left_;
+};
+
+/**
+   \class   ArenaAllocator EventArena.h "DQM/Physics/interface/EventArena.h"
+
+   \brief   STL allocator taking the memory from an EventArena.
+
+   Allocator for standard containers, which takes the memory from the given EventArena
+   and does not release it (see EventArena::reset). Without arena (0) the memory is taken
+   from the heap, such that the containers can be used with and without arena.
+*/
+
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  template <typename U> struct rebind { typedef ArenaAllocator<U> other; };
+
+ public:
+  /// default constructor
+  ArenaAllocator(EventArena* arena=0) : arena_(arena) {};
+  /// conversion from the allocator of another type
+  template <typename U> ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {};
+
+  /// memory for _n_ objects
+  pointer allocate(size_type n, const void* hint=0){
+    if( !arena_ ) return static_cast<pointer>(::operator new(n*sizeof(T)));
+    return static_cast<pointer>(arena_->allocate(n*sizeof(T)));
+  };
+  /// memory of the arena is released with the reset of the arena
+  void deallocate(pointer p, size_type n){ if( !arena_ ) ::operator delete(p); };
+  /// construct and destroy objects
+  void construct(pointer p, const T& value){ new(static_cast<void*>(p)) T(value); };
+  void destroy(pointer p){ p->~T(); };
+  /// address of an object
+  pointer address(reference x) const { return &x; };
+  const_pointer address(const_reference x) const { return &x; };
+  /// maximal number of objects
+  size_type max_size() const { return size_type(-1)/sizeof(T); };
+  /// arena the memory is taken from (0 for the heap)
+  EventArena* arena() const { return arena_; };
+
+ private:
+  /// arena the memory is taken from
+  EventArena* arena_;
+};
+
+template <typename T, typename U>
+inline bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs){ return lhs.arena()==rhs.arena(); }
+template <typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs){ return lhs.arena()!=rhs.arena(); }
+
+/// std::vector with the memory taken from an EventArena
+template <typename T>
+struct ArenaVector {
+  typedef std::vector<T, ArenaAllocator<T> > type;
+};
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef EVENTBITMAP
+#define EVENTBITMAP
+
+#include <map>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdint.h>
+
+/**
+   \class   EventBitmap EventBitmap.h "DQM/Physics/interface/EventBitmap.h"
+
+   \brief   Compressed set of event numbers (roaring bitmap).
+
+   Helper class to keep the event numbers of the events passing a selection (typically
+   within one luminosity section) in compressed form. The event numbers are split into
+   the upper 48 bits, which select a container, and the lower 16 bits, which are kept in
+   the container either as a sorted array of 16 bit values (up to 4096 events) or as a
+   bitmap of 65536 bits (8 kB) for denser containers. Sets can be intersected (&=) and
+   united (|=) without decompression of the bitmaps. The serialized form (_serialize_ and
+   _deserialize_) is independent of the platform (little endian).
+*/
+
+class EventBitmap {
+ public:
+  /// default constructor
+  EventBitmap(){};
+  /// default destructor
+  ~EventBitmap(){};
+
+  /// add event number _event_
+  void add(uint64_t event);
+  /// true if event number _event_ is contained
+  bool contains(uint64_t event) const;
+  /// number of events
+  uint64_t size() const;
+  /// true if there are no events
+  bool empty() const { return containers_.empty(); };
+  /// remove all events
+  void clear(){ containers_.clear(); };
+  /// sorted event numbers
+  std::vector<uint64_t> events() const;
+
+  /// keep the events contained in both sets
+  EventBitmap& operator&=(const EventBitmap& other);
+  /// keep the events contained in any of both sets
+  EventBitmap& operator|=(const EventBitmap& other);
+
+  /// append the serialized set to _buffer_
+  void serialize(std::string& buffer) const;
+  /// read the set from _size_ bytes at _data_; returns false if the data are corrupt
+  bool deserialize(const char* data, size_t size);
+
+ private:
+  /// events with the same upper 48 bits; _bits_ is empty for array containers
+  struct Container {
+    Container() : size(0) {};
+    /// true for bitmap containers
+    bool dense() const { return !bits.empty(); };
+    /// true if the lower 16 bits _low_ are contained
+    bool contains(uint16_t low) const;
+    /// convert into a bitmap container
+    void toBitmap();
+    /// convert into an array container
+    void toArray();
+    /// convert into a bitmap or an array container, whatever fits the size
+    void optimize();
+    /// sorted lower 16 bits (array container)
+    std::vector<uint16_t> array;
+    /// bitmap of the lower 16 bits (bitmap container)
+    std::vector<uint64_t> bits;
+    /// number of events in the container
+    unsigned int size;
+  };
+
+ private:
+  /// containers indexed by the upper 48 bits
+  std::map<uint64_t, Container> containers_;
+};
+
+/**
+   \class   SelectionIndex EventBitmap.h "DQM/Physics/interface/EventBitmap.h"
+
+   \brief   Index of the events passing the selection steps of a module per luminosity section.
+
+   Helper class to record the event numbers of the events passing each selection step of a
+   module (registered via _add_) in one EventBitmap per step. At the end of each luminosity
+   section the owner calls _write_, which appends one record per step with at least one
+   passing event to the index file and clears the bitmaps. The index file is created by the
+   constructor (one file per module and job) and consists of the header EVTIDX1 followed by
+   the records:
+
+    - module, step : length (2 bytes) and characters
+    - run, lumi    : 4 bytes each
+    - events       : length (4 bytes) and the serialized EventBitmap
+
+   with all integers in little endian. The records of several files can be read via _read_
+   and combined by the EventIndexQuery tool (see bin) without access to the event data.
+*/
+
+class SelectionIndex {
+ public:
+  /// record of the index file
+  struct Record {
+    std::string module, step;
+    unsigned int run, lumi;
+    EventBitmap events;
+  };
+
+ public:
+  /// default constructor
+  SelectionIndex(const std::string& fileName, const std::string& module);
+  /// default destructor
+  ~SelectionIndex(){};
+
+  /// register a selection step; returns the index to be used with _passed_
+  unsigned int add(const std::string& step);
+  /// record that event _event_ passed step _step_
+  void passed(unsigned int step, uint64_t event){ events_[step].add(event); };
+  /// append the records of luminosity section _lumi_ of run _run_ and clear the bitmaps
+  void write(unsigned int run, unsigned int lumi);
+
+  /// check the header of the index file _in_; returns false if it is no index file
+  static bool header(std::istream& in);
+  /// read the next record from _in_; returns false at the end of the file or
+  /// for corrupt data (in the latter case _in_.eof() is false)
+  static bool read(std::istream& in, Record& record);
+
+ private:
+  /// index file
+  std::ofstream out_;
+  /// module label
+  std::string module_;
+  /// names and bitmaps of the selection steps
+  std::vector<std::string> steps_;
+  std::vector<EventBitmap> events_;
+};
+
+#endif
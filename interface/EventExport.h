@@ -0,0 +1,80 @@
+#ifndef EVENTEXPORT
+#define EVENTEXPORT
+
+#include <string>
+#include <vector>
+
+#include "Rtypes.h"
+#include "DataFormats/Provenance/interface/EventID.h"
+
+class TFile;
+class TTree;
+
+/**
+   \class   EventExport EventExport.h "DQM/Physics/interface/EventExport.h"
+
+   \brief   Helper class to write selected events into a flat, columnar ROOT file.
+
+   Helper class to keep a small set of quantities (multiplicities, lepton and jet kine-
+   matics, MET, mass estimates, ...) of the events passing a selection for the offline
+   follow-up, without the need to rerun the reconstruction. The quantities are written
+   into a TTree with one branch (column) per quantity in the file _fileName_, which is
+   created by the constructor and closed by the destructor (i.e. one file per job). The
+   columns are registered by the owner via _add_ before the first event is written:
+
+    - scalar columns  : one value per event (Float_t)
+    - array columns   : up to _maxSize_ values per event (Float_t) with a counter column
+                        n<name> (Int_t); further values are dropped
+
+   For each event the owner sets the values via _set_ (scalars) and _push_ (arrays) and
+   calls _write_, which appends the event with its run, lumi and event number and resets
+   all values to 0. The compression of the file is given in the ROOT convention (algo-
+   rithm*100+level, e.g. 1 for zlib at level 1 or 404 for lz4 at level 4).
+*/
+
+class EventExport {
+ public:
+  /// default constructor
+  EventExport(const std::string& fileName, const std::string& treeName, int compression);
+  /// default destructor; writes the tree and closes the file
+  ~EventExport();
+
+  /// register a scalar column; returns the index to be used with _set_
+  unsigned int add(const std::string& name);
+  /// register an array column with up to _maxSize_ values per event;
+  /// returns the index to be used with _push_
+  unsigned int add(const std::string& name, unsigned int maxSize);
+  /// set the value of scalar column _column_
+  void set(unsigned int column, double value){ values_[offsets_[column]]=value; };
+  /// append a value to array column _column_
+  void push(unsigned int column, double value){
+    if( counts_[column]<(Int_t)sizes_[column] ) values_[offsets_[column]+counts_[column]++]=value;
+  };
+  /// append the event _id_ to the tree and reset all values
+  void write(const edm::EventID& id);
+  /// number of events written so far
+  unsigned long written() const { return written_; };
+
+ private:
+  /// create the branches (on the first write, when all columns are known)
+  void branch();
+
+ private:
+  /// output file and tree (the tree is owned by the file)
+  TFile* file_;
+  TTree* tree_;
+  /// names, offsets into values_ and sizes (0 for scalars) of the columns
+  std::vector<std::string> names_;
+  std::vector<unsigned int> offsets_, sizes_;
+  /// values of all columns of the current event
+  std::vector<Float_t> values_;
+  /// number of values of the array columns of the current event
+  std::vector<Int_t> counts_;
+  /// event id of the current event
+  UInt_t run_, lumi_;
+  ULong64_t event_;
+  /// number of events written so far
+  unsigned long written_;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef FILLBUFFER
+#define FILLBUFFER
+
+#include <vector>
+
+#include "TH1.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+/**
+   \class   FillBuffer FillBuffer.h "DQM/Physics/interface/FillBuffer.h"
+
+   \brief   Helper class to fill a 1-dim MonitorElement in batches.
+
+   Helper class to accumulate (value, weight) pairs for a frequently filled 1-dim
+   MonitorElement in a contiguous buffer and to fill them into the underlying ROOT
+   histogram in one go (TH1::FillN), once the configured batch size is reached; the
+   MonitorElement is marked as updated after each batch, as it is by a single Fill.
+   The owner has to call flush at the end of each luminosity block and before the
+   histograms are saved (endRun/endJob) to make sure no entries are left in the
+   buffer. For a batch size of less or equal 1 or if no MonitorElement is attached
+   the values are filled directly. Each module instance owns its own buffers; as
+   EDAnalyzers are never run concurrently for the same module instance no further
+   synchronisation is needed.
+*/
+
+class FillBuffer {
+ public:
+  /// default constructor
+  FillBuffer() : me_(0), size_(0), n_(0) {};
+  /// constructor attaching a MonitorElement
+  FillBuffer(MonitorElement* me, unsigned int size) : me_(0), size_(0), n_(0) { attach(me, size); };
+  /// default destructor; the owner is expected to flush before
+  ~FillBuffer(){};
+
+  /// attach MonitorElement and reserve the buffer
+  void attach(MonitorElement* me, unsigned int size){
+    flush(); me_=me; size_=size;
+    if( size_>1 ){ values_.resize(size_); weights_.resize(size_); }
+  };
+  /// buffer a value; the buffer is flushed when it is full
+  void fill(double value, double weight=1.){
+    if( !me_ ) return;
+    if( size_<=1 ){ me_->Fill(value, weight); return; }
+    values_[n_]=value; weights_[n_]=weight;
+    if( ++n_==size_ ) flush();
+  };
+  /// fill all buffered values into the histogram
+  void flush(){
+    if( me_ && n_>0 ){ me_->getTH1()->FillN(n_, &values_[0], &weights_[0]); me_->update(); }
+    n_=0;
+  };
+  /// number of buffered values
+  unsigned int buffered() const { return n_; };
+
+ private:
+  /// attached MonitorElement (not owned)
+  MonitorElement* me_;
+  /// batch size
+  unsigned int size_;
+  /// number of buffered values
+  unsigned int n_;
+  /// buffered values and weights
+  std::vector<double> values_, weights_;
+};
+
+#endif
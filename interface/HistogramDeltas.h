@@ -0,0 +1,87 @@
+#ifndef HISTOGRAMDELTAS
+#define HISTOGRAMDELTAS
+
+#include <string>
+#include <vector>
+
+/**
+   \class   HistogramDelta HistogramDeltas.h "DQM/Physics/interface/HistogramDeltas.h"
+
+   \brief   Sparse difference of a 1- or 2-dimensional MonitorElement between two snapshots.
+
+   Keeps the bins of a MonitorElement which changed since the previous snapshot as pairs
+   of the global bin index (as given by TH1::GetBin, including under- and overflow) and
+   the difference of the bin content (and of the sum of squared weights, if the histogram
+   keeps them). The description of the histogram (ROOT class, title, bin edges, axis titles
+   and bin labels) is only kept with the first delta of a histogram within a job; it is
+   empty otherwise (_described_ returns false). Adding up all deltas of a histogram in the order
+   of their creation reproduces the histogram at the time of the last snapshot.
+*/
+
+class HistogramDelta {
+ public:
+  /// default constructor
+  HistogramDelta() : entries(0.) {};
+  /// default destructor
+  ~HistogramDelta(){};
+
+  /// true if the description of the histogram is kept
+  bool described() const { return !xEdges.empty(); };
+  /// true for 2-dimensional histograms (only valid if described)
+  bool is2D() const { return !yEdges.empty(); };
+  /// number of changed bins
+  unsigned int size() const { return bins.size(); };
+
+ public:
+  /// folder and name of the histogram
+  std::string folder, name;
+  /// ROOT class of the histogram, e.g. TH1F or TH2S (description)
+  std::string type;
+  /// title and axis titles of the histogram (description)
+  std::string title, xTitle, yTitle;
+  /// bin edges in x and y (description; yEdges is empty for 1-dim histograms)
+  std::vector<float> xEdges, yEdges;
+  /// bin labels in x and y (description; empty if the axis has no labels)
+  std::vector<std::string> xLabels, yLabels;
+  /// difference of the number of entries
+  double entries;
+  /// global bin indices of the changed bins
+  std::vector<unsigned int> bins;
+  /// difference of the bin contents of the changed bins
+  std::vector<double> values;
+  /// difference of the sum of squared weights of the changed
+  /// bins (empty if the histogram does not keep them)
+  std::vector<double> sumw2;
+};
+
+/**
+   \class   LumiHistogramDeltas HistogramDeltas.h "DQM/Physics/interface/HistogramDeltas.h"
+
+   \brief   HistogramDeltas of all monitored MonitorElements for one luminosity block.
+
+   Product of the MEtoLumiDeltaConverter, which is put into the luminosity block (and into
+   the run for the changes after the last luminosity block of the run). Besides the deltas
+   it keeps the number of events processed within the luminosity block. Products of the
+   same luminosity block from different files are merged by concatenation of the deltas.
+*/
+
+class LumiHistogramDeltas {
+ public:
+  /// default constructor
+  LumiHistogramDeltas() : events(0) {};
+  /// default destructor
+  ~LumiHistogramDeltas(){};
+
+  /// merge the deltas of the same luminosity block (from different files)
+  bool mergeProduct(const LumiHistogramDeltas& other){
+    events+=other.events; deltas.insert(deltas.end(), other.deltas.begin(), other.deltas.end()); return true;
+  };
+
+ public:
+  /// number of events processed within the luminosity block
+  unsigned int events;
+  /// deltas of the changed (or newly booked) histograms
+  std::vector<HistogramDelta> deltas;
+};
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef HISTOGRAMTABLE
+#define HISTOGRAMTABLE
+
+#include <string>
+#include <vector>
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+/**
+   \class   HistogramTable HistogramTable.h "DQM/Physics/interface/HistogramTable.h"
+
+   \brief   Declarative table of the histograms of a monitoring module.
+
+   Helper class to keep the definitions (key, name, title, verbosity level and binning) of
+   all histograms of a monitoring module in one table. The table is built once per module
+   from compiled-in defaults, which may be overridden from the configuration by a VPSet of
+   the following form:
+
+    - key       : key of the histogram to be modified (e.g. muonPt_) [mandatory]
+    - title     : title of the histogram [optional]
+    - verbosity : level from which on the histogram is booked (STANDARD, VERBOSE or DEBUG)
+                  [optional]
+    - nBinsX, lowX, highX, nBinsY, lowY, highY : binning of the histogram [optional]; the
+                  y binning can only be given for 2-dim histograms
+
+   Histograms cannot be added from the configuration; an unknown key is a configuration
+   error. Each entry keeps its position in the table as _slot_, which the owner may use
+   as a precomputed index into per instance arrays (e.g. of the booked MonitorElements)
+   to fill histograms without any look up by name. The table is read-only after its
+   construction and can be shared by all instances of the owner (e.g. all MonitorEnsembles
+   of a module).
+*/
+
+class HistogramTable {
+ public:
+  /// definition of a single histogram
+  struct Entry {
+    /// constructor for 1-dim histograms
+    Entry(const std::string& key, const std::string& name, const std::string& title, int level, int nBins, double low, double high) :
+      key(key), name(name), title(title), level(level), nBinsX(nBins), lowX(low), highX(high), nBinsY(0), lowY(0.), highY(0.), slot(0) {};
+    /// constructor for 2-dim histograms
+    Entry(const std::string& key, const std::string& name, const std::string& title, int level, int nBinsX, double lowX, double highX, int nBinsY, double lowY, double highY) :
+      key(key), name(name), title(title), level(level), nBinsX(nBinsX), lowX(lowX), highX(highX), nBinsY(nBinsY), lowY(lowY), highY(highY), slot(0) {};
+
+    /// true for 2-dim histograms
+    bool is2D() const { return nBinsY>0; };
+
+    /// key of the histogram in the owner and name and title of the MonitorElement
+    std::string key, name, title;
+    /// verbosity level from which on the histogram is booked
+    int level;
+    /// binning in x (nBinsX<=0 leaves the binning to the owner) and y (nBinsY<=0 for 1-dim)
+    int nBinsX; double lowX, highX;
+    int nBinsY; double lowY, highY;
+    /// position in the table
+    unsigned int slot;
+  };
+
+ public:
+  /// default constructor; _overrides_ modify the _defaults_ by key
+  HistogramTable(const std::vector<Entry>& defaults, const std::vector<edm::ParameterSet>& overrides=std::vector<edm::ParameterSet>());
+  /// default destructor
+  ~HistogramTable(){};
+
+  /// number of histograms
+  unsigned int size() const { return entries_.size(); };
+  /// definition of the histogram in _slot_
+  const Entry& operator[](unsigned int slot) const { return entries_[slot]; };
+  /// slot of the histogram _key_; throws if the key is unknown
+  unsigned int slot(const std::string& key) const;
+
+ private:
+  /// verbosity level for its name (STANDARD, VERBOSE or DEBUG)
+  int level(const std::string& verbosity) const;
+
+ private:
+  /// histogram definitions
+  std::vector<Entry> entries_;
+};
+
+#endif
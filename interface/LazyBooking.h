@@ -0,0 +1,107 @@
+#ifndef LAZYBOOKING
+#define LAZYBOOKING
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+/**
+   \class   HistogramDef LazyBooking.h "DQM/Physics/interface/LazyBooking.h"
+
+   \brief   Helper class to keep the definition of a MonitorElement until it is booked.
+
+   Helper class to keep the full definition of a 1- or 2-dimensional MonitorElement
+   (folder, name, title, binning and decorations like axis titles, bin labels and draw
+   options) such that the booking can be deferred to the first time the histogram is
+   actually filled. The decorations are applied right after the booking. The function
+   _bytes_ returns a rough estimate of the resident memory of the booked histogram,
+   which is used to account for the booked histograms against a BookingBudget.
+*/
+
+class HistogramDef {
+ public:
+  /// default constructor
+  HistogramDef() : nBinsX_(0), lowX_(0.), highX_(0.), nBinsY_(0), lowY_(0.), highY_(0.) {};
+  /// constructor for 1-dim histograms
+  HistogramDef(const std::string& folder, const std::string& name, const std::string& title, int nBinsX, double lowX, double highX) :
+    folder_(folder), name_(name), title_(title), nBinsX_(nBinsX), lowX_(lowX), highX_(highX), nBinsY_(0), lowY_(0.), highY_(0.) {};
+  /// constructor for 2-dim histograms
+  HistogramDef(const std::string& folder, const std::string& name, const std::string& title, int nBinsX, double lowX, double highX, int nBinsY, double lowY, double highY) :
+    folder_(folder), name_(name), title_(title), nBinsX_(nBinsX), lowX_(lowX), highX_(highX), nBinsY_(nBinsY), lowY_(lowY), highY_(highY) {};
+  /// default destructor
+  ~HistogramDef(){};
+
+  /// add an axis title to be applied after booking
+  void setAxisTitle(const std::string& title, int axis){ axisTitles_.push_back(std::make_pair(axis, title)); };
+  /// add a bin label to be applied after booking
+  void setBinLabel(int bin, const std::string& label, int axis){ binLabels_.push_back(std::make_pair(std::make_pair(bin, axis), label)); };
+  /// set the draw option to be applied after booking
+  void setOption(const std::string& option){ option_=option; };
+
+  /// histogram name
+  const std::string& name() const { return name_; };
+  /// binning in x
+  int nBinsX() const { return nBinsX_; }; double lowX() const { return lowX_; }; double highX() const { return highX_; };
+  /// binning in y (nBinsY()==0 for 1-dim histograms)
+  int nBinsY() const { return nBinsY_; }; double lowY() const { return lowY_; }; double highY() const { return highY_; };
+  /// rough estimate of the resident memory of the booked histogram in bytes
+  double bytes() const;
+  /// book the MonitorElement in the DQMStore and apply all decorations
+  MonitorElement* book(DQMStore* store) const;
+
+ private:
+  /// folder, name and title of the histogram
+  std::string folder_, name_, title_;
+  /// binning in x
+  int nBinsX_; double lowX_, highX_;
+  /// binning in y (nBinsY_==0 for 1-dim histograms)
+  int nBinsY_; double lowY_, highY_;
+  /// axis titles to be applied after booking
+  std::vector<std::pair<int, std::string> > axisTitles_;
+  /// bin labels to be applied after booking
+  std::vector<std::pair<std::pair<int, int>, std::string> > binLabels_;
+  /// draw option to be applied after booking
+  std::string option_;
+};
+
+/**
+   \class   BookingBudget LazyBooking.h "DQM/Physics/interface/LazyBooking.h"
+
+   \brief   Memory budget for lazily booked MonitorElements.
+
+   Simple bookkeeping of the estimated memory of lazily booked histograms. It is
+   typically owned by a module and shared by all its MonitorEnsembles. A limit of
+   less or equal zero corresponds to no limit. Histograms that would exceed the
+   budget are not booked and their fills are dropped; they are counted as refused.
+*/
+
+class BookingBudget {
+ public:
+  /// default constructor; the limit is given in kB
+  BookingBudget(double limit) : limit_(limit*1024.), used_(0.), booked_(0), refused_(0) {};
+  /// default destructor
+  ~BookingBudget(){};
+
+  /// check whether _bytes_ can be accounted and do so if possible
+  bool request(double bytes){
+    if( limit_>0. && used_+bytes>limit_ ){ ++refused_; return false; }
+    used_+=bytes; ++booked_; return true;
+  };
+  /// used memory in kB
+  double used() const { return used_/1024.; };
+  /// number of booked histograms
+  unsigned int booked() const { return booked_; };
+  /// number of refused histograms
+  unsigned int refused() const { return refused_; };
+
+ private:
+  /// limit and used memory in bytes
+  double limit_, used_;
+  /// number of booked and refused histograms
+  unsigned int booked_, refused_;
+};
+
+#endif
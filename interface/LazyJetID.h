@@ -0,0 +1,114 @@
+#ifndef LAZYJETID
+#define LAZYJETID
+
+#include <map>
+#include <utility>
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Provenance/interface/EventID.h"
+#include "DataFormats/Provenance/interface/ProductID.h"
+#include "DataFormats/JetReco/interface/CaloJet.h"
+#include "DataFormats/JetReco/interface/JetID.h"
+#include "RecoJets/JetProducers/interface/JetIDHelper.h"
+
+/**
+   \class   LazyJetID LazyJetID.h "DQM/Physics/interface/LazyJetID.h"
+
+   \brief   Helper class to determine the JetID of calo jets on demand.
+
+   Helper class to determine the JetID of calo jets only for those jets, for which it
+   is actually requested, instead of for each jet of the collection. The JetID is
+   either calculated on the fly via the JetIDHelper from the constituent towers and
+   rechits (when constructed from the JetIDHelper parameters) or looked up from a
+   JetIDValueMap in the event (when constructed from the input tag of the value map).
+   In the latter case the value map is only loaded when the first JetID is requested
+   in the event, or by _load_, which allows to check for the value map before any JetID
+   is requested. The results are cached per jet (product id and key) until the next
+   event, such that repeated requests for the same jet are free. The call operator
+   returns 0 if the JetID cannot be determined (no calo jet, value map not found).
+*/
+
+class LazyJetID {
+ public:
+  /// constructor for the calculation on the fly via the JetIDHelper
+  LazyJetID(const edm::ParameterSet& cfg) : helper_(new reco::helper::JetIDHelper(cfg)) {};
+  /// constructor for the look up from a JetIDValueMap
+  LazyJetID(const edm::InputTag& src) : helper_(0), src_(src) {};
+  /// default destructor
+  ~LazyJetID(){ if( helper_ ) delete helper_; };
+
+  /// load the JetIDValueMap of the current event; returns false if it is
+  /// not found (always true for the calculation on the fly)
+  bool load(const edm::Event& event);
+  /// JetID of _jet_ in the current event (0 if not available)
+  template <typename Ref>
+  const reco::JetID* operator()(const edm::Event& event, const Ref& jet);
+
+ private:
+  /// copy the results of the JetIDHelper into a JetID
+  void fill(reco::JetID& id) const;
+
+ private:
+  /// JetIDHelper for the calculation on the fly (owned)
+  reco::helper::JetIDHelper* helper_;
+  /// input tag of the JetIDValueMap for the look up
+  edm::InputTag src_;
+  /// JetIDValueMap of the current event
+  edm::Handle<reco::JetIDValueMap> valueMap_;
+  /// event, which the cache belongs to
+  edm::EventID event_;
+  /// cached JetIDs of the current event
+  std::map<std::pair<edm::ProductID, size_t>, reco::JetID> cache_;
+};
+
+inline bool LazyJetID::load(const edm::Event& event)
+{
+  // invalidate the cache with each new event
+  if( event.id()!=event_ ){
+    cache_.clear(); valueMap_=edm::Handle<reco::JetIDValueMap>(); event_=event.id();
+  }
+  if( helper_ ) return true;
+  return valueMap_.isValid() || event.getByLabel(src_, valueMap_);
+}
+
+template <typename Ref>
+const reco::JetID* LazyJetID::operator()(const edm::Event& event, const Ref& jet)
+{
+  if( !load(event) ) return 0;
+  std::pair<edm::ProductID, size_t> key=std::make_pair(jet.id(), jet.key());
+  std::map<std::pair<edm::ProductID, size_t>, reco::JetID>::const_iterator id=cache_.find(key);
+  if( id!=cache_.end() ) return &id->second;
+
+  if( helper_ ){
+    const reco::CaloJet* calojet=dynamic_cast<const reco::CaloJet*>(&*jet);
+    if( !calojet ) return 0;
+    helper_->calculate(event, *calojet);
+    fill(cache_[key]);
+  }
+  else{
+    cache_[key]=(*valueMap_)[jet];
+  }
+  return &cache_[key];
+}
+
+inline void LazyJetID::fill(reco::JetID& id) const
+{
+  id.fHPD            = helper_->fHPD();
+  id.fRBX            = helper_->fRBX();
+  id.n90Hits         = helper_->n90Hits();
+  id.fSubDetector1   = helper_->fSubDetector1();
+  id.fSubDetector2   = helper_->fSubDetector2();
+  id.fSubDetector3   = helper_->fSubDetector3();
+  id.fSubDetector4   = helper_->fSubDetector4();
+  id.restrictedEMF   = helper_->restrictedEMF();
+  id.nHCALTowers     = helper_->nHCALTowers();
+  id.nECALTowers     = helper_->nECALTowers();
+  id.approximatefHPD = helper_->approximatefHPD();
+  id.approximatefRBX = helper_->approximatefRBX();
+  id.hitsInN90       = helper_->hitsInN90();
+}
+
+#endif
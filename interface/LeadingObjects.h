@@ -0,0 +1,77 @@
+#ifndef LEADINGOBJECTS
+#define LEADINGOBJECTS
+
+/**
+   \class   LeadingObjects LeadingObjects.h "DQM/Physics/interface/LeadingObjects.h"
+
+   \brief   Helper class to keep the K leading objects of a collection in a single pass.
+
+   Helper class to determine the K leading objects of a collection (e.g. the two
+   leading jets in corrected pt) in a single loop over the collection. Each object is
+   offered with its sort key (e.g. pt or et) and a compact payload, which holds the
+   index of the object in the collection and those quantities, which are needed later
+   on. The payload is copied only for objects that enter the list of leading objects;
+   if only the sort keys are needed the objects are offered without payload (NoPayload).
+   Objects are kept in descending order of their sort key; objects with equal sort key
+   are kept in the order in which they were offered. Once the list is full, an object
+   is only kept if its sort key is larger than the one of the last object in the list;
+   of several objects with equal sort key the ones offered first win. The list is to be
+   cleared at the beginning of each event. Example:
+
+   struct Lead { unsigned int idx; double eta, phi; };
+   LeadingObjects<Lead, 2> leadingJets;
+   for(unsigned int idx=0; idx<jets.size(); ++idx){
+     Lead lead={ idx, jets[idx].eta(), jets[idx].phi() }; leadingJets.push(jets[idx].pt(), lead);
+   }
+   if(leadingJets.size()>1){ ... leadingJets.key(1) ... leadingJets[1].eta ... }
+*/
+
+/// payload of leading objects, for which only the sort key is needed
+struct NoPayload {};
+
+template <typename Payload, unsigned int K>
+class LeadingObjects {
+ public:
+  /// default constructor
+  LeadingObjects() : n_(0) {};
+  /// default destructor
+  ~LeadingObjects(){};
+
+  /// clear the list of leading objects
+  void clear(){ n_=0; };
+  /// offer an object with sort key _key_; returns true if it is kept
+  bool push(double key, const Payload& payload);
+  /// offer an object without payload; returns true if it is kept
+  bool push(double key){ return push(key, Payload()); };
+  /// number of objects kept (at most K)
+  unsigned int size() const { return n_; };
+  /// sort key of the idx-th leading object
+  double key(unsigned int idx) const { return keys_[idx]; };
+  /// payload of the idx-th leading object
+  const Payload& operator[](unsigned int idx) const { return payloads_[idx]; };
+
+ private:
+  /// number of objects kept
+  unsigned int n_;
+  /// sort keys of the leading objects in descending order
+  double keys_[K];
+  /// payloads of the leading objects
+  Payload payloads_[K];
+};
+
+template <typename Payload, unsigned int K>
+inline bool LeadingObjects<Payload, K>::push(double key, const Payload& payload)
+{
+  // the list is full and the object is not harder than the last one
+  if( n_==K && !(key>keys_[K-1]) ) return false;
+  // move all softer objects one slot down to make
+  // place for the new object (the last one drops out)
+  unsigned int pos = (n_<K) ? n_++ : K-1;
+  for(; pos>0 && key>keys_[pos-1]; --pos){
+    keys_[pos]=keys_[pos-1]; payloads_[pos]=payloads_[pos-1];
+  }
+  keys_[pos]=key; payloads_[pos]=payload;
+  return true;
+}
+
+#endif
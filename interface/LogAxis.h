@@ -0,0 +1,112 @@
+#ifndef LOGAXIS
+#define LOGAXIS
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+/**
+   \class   LogAxis LogAxis.h "DQM/Physics/interface/LogAxis.h"
+
+   \brief   Helper class for 1-dim MonitorElements with logarithmic binning.
+
+   Helper class to provide the bin edges of 1-dim MonitorElements with logarithmically
+   spaced bins in x (e.g. for masses, HT or MET over several orders of magnitude) or with
+   arbitrary bin edges. The edges are computed once and kept as floats, as expected by
+   the booking of the MonitorElement, such that several MonitorElements can be booked
+   with the same axis. For such variable bin histograms ROOT searches for the bin of
+   each value in the array of bin edges. For the logarithmically spaced part of the
+   edges (all edges from the first positive one on) _bin_ computes the bin directly from
+   the logarithm of the value and corrects it against the neighbouring edges, such that
+   values at the bin edges end up in the same bin as in ROOT. Values below the first
+   positive edge and irregular edges, which are not logarithmically spaced, are looked up
+   by a binary search. _fill_ fills the MonitorElement via Fill at the center of the bin
+   (or at the value itself for under- and overflow), which keeps the statistics and the
+   update flag of the MonitorElement to ROOT and to the DQMStore. Example:
+
+   LogAxis axis(200, 1., 1000.);
+   MonitorElement* mass = store->book1D("mass", "mass", axis.nBins(), axis.edges());
+   axis.fill(mass, value);
+*/
+
+class LogAxis {
+ public:
+  /// nBins logarithmically spaced bins between min and max (min>0)
+  LogAxis(unsigned int nBins, double min, double max);
+  /// arbitrary bin edges in increasing order
+  LogAxis(const std::vector<double>& edges);
+  /// default destructor
+  ~LogAxis(){};
+
+  /// number of bins
+  unsigned int nBins() const { return edges_.size()-1; };
+  /// bin edges for the booking of the MonitorElement
+  float* edges(){ return &edges_[0]; };
+  /// bin of x following the ROOT conventions (0: underflow, nBins+1: overflow)
+  int bin(double x) const;
+  /// center of bin idx (1..nBins)
+  double center(int idx) const { return 0.5*((double)edges_[idx-1]+(double)edges_[idx]); };
+  /// fill x with weight w into the MonitorElement booked with this axis
+  void fill(MonitorElement* me, double x, double w=1.) const { int idx=bin(x); me->Fill(idx>0 && idx<=(int)nBins() ? center(idx) : x, w); };
+
+ private:
+  /// find the logarithmically spaced part of the edges
+  void init();
+
+ private:
+  /// bin edges as used for the booking
+  std::vector<float> edges_;
+  /// first edge of the logarithmically spaced part (nBins if there is none)
+  int first_;
+  /// log10 of the first edge of the logarithmically spaced part and
+  /// inverse bin width in log10
+  double logMin_, invLogWidth_;
+};
+
+inline LogAxis::LogAxis(unsigned int nBins, double min, double max)
+{
+  double logMin=log10(min), logMax=log10(max);
+  for(unsigned int idx=0; idx<=nBins; ++idx){
+    edges_.push_back(std::pow(10., logMin+(logMax-logMin)*idx/nBins));
+  }
+  init();
+}
+
+inline LogAxis::LogAxis(const std::vector<double>& edges) : edges_(edges.begin(), edges.end())
+{
+  init();
+}
+
+inline void LogAxis::init()
+{
+  int n=nBins(); first_=0; logMin_=0.; invLogWidth_=0.;
+  while( first_<n && !(edges_[first_]>0.) ) ++first_;
+  if( first_>=n ){ first_=n; return; }
+  logMin_=log10((double)edges_[first_]); invLogWidth_=(n-first_)/(log10((double)edges_[n])-logMin_);
+  // all edges have to be within a small fraction of a bin of the
+  // expectation; otherwise the edges are irregular
+  for(int idx=first_; idx<=n; ++idx){
+    if( std::fabs((log10((double)edges_[idx])-logMin_)*invLogWidth_-(idx-first_))>1.e-3 ){ first_=n; return; }
+  }
+}
+
+inline int LogAxis::bin(double x) const
+{
+  int n=nBins();
+  if( !(x>=edges_[0]) ) return 0;
+  if( x>=edges_[n] ) return n+1;
+  if( x<edges_[first_] ){
+    // below the logarithmically spaced part or irregular edges
+    return std::upper_bound(edges_.begin(), edges_.begin()+first_+1, x)-edges_.begin();
+  }
+  int idx=first_+(int)((log10(x)-logMin_)*invLogWidth_)+1;
+  // correct for the rounding of the float edges
+  if( idx>n ) idx=n; else if( idx<first_+1 ) idx=first_+1;
+  while( idx>first_+1 && x<edges_[idx-1] ) --idx;
+  while( idx<n && x>=edges_[idx] ) ++idx;
+  return idx;
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef LUMITRENDS
+#define LUMITRENDS
+
+#include <string>
+#include <vector>
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+/**
+   \class   LumiTrends LumiTrends.h "DQM/Physics/interface/LumiTrends.h"
+
+   \brief   Helper class to monitor the yields of a module as a function of the luminosity section.
+
+   Helper class to keep a set of scalar counters (e.g. the number of Z->mumu candidates),
+   which are registered by the owner via _add_ and incremented via _count_ during the event
+   loop. At the end of each luminosity block the owner calls _append_, which adds the counts
+   of the luminosity section as one point to a trend MonitorElement per counter and resets
+   the counters. The number of analyzed events per luminosity section (from _event_) is kept
+   in the trend Events, such that the yields can be normalized. The trends are booked in
+   the subfolder Trends of the given directory with one bin per luminosity section for the
+   first _nLumis_ luminosity sections; for later luminosity sections the range of the trend
+   is doubled by ROOT, merging neighbouring bins. This keeps the size of the trends bounded
+   for long runs and avoids the booking of per luminosity section histograms. The owner calls
+   _beginRun_ at the beginning of each run, which resets the trends to their initial range,
+   such that each run starts with empty trends. The counters are plain members of the
+   (single) module instance and require no synchronization.
+*/
+
+class LumiTrends {
+ public:
+  /// default constructor
+  LumiTrends(const std::string& directory, unsigned int nLumis);
+  /// default destructor
+  ~LumiTrends(){};
+
+  /// register a counter; returns the index to be used with _count_
+  unsigned int add(const std::string& name, const std::string& title);
+  /// count an analyzed event
+  void event(){ events_+=1.; };
+  /// increment counter _idx_ by _weight_
+  void count(unsigned int idx, double weight=1.){ counts_[idx]+=weight; };
+  /// append the counts of luminosity section _lumi_ to the trends and reset them
+  void append(unsigned int lumi);
+  /// reset the trends and the counters at the beginning of a run
+  void beginRun();
+
+ private:
+  /// book a trend in the Trends folder
+  MonitorElement* book(const std::string& name, const std::string& title);
+  /// reset _trend_ to its initial range
+  void reset(MonitorElement* trend);
+
+ private:
+  /// folder for the trends
+  std::string folder_;
+  /// number of luminosity sections with one bin each
+  unsigned int nLumis_;
+  /// analyzed events of the current luminosity section
+  double events_;
+  /// counts of the current luminosity section
+  std::vector<double> counts_;
+  /// trends of the analyzed events and of the counters
+  MonitorElement* eventTrend_;
+  std::vector<MonitorElement*> trends_;
+};
+
+#endif
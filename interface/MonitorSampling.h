@@ -0,0 +1,84 @@
+#ifndef MONITORSAMPLING
+#define MONITORSAMPLING
+
+#include <string>
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+/**
+   \class   MonitorSampling MonitorSampling.h "DQM/Physics/interface/MonitorSampling.h"
+
+   \brief   Helper class to restrict the expensive monitoring of a module to a subsample of events.
+
+   Helper class to decide for each event whether the expensive monitoring histograms of a
+   module (kinematic distributions, isolation, invariant masses, ...) are filled. The cheap
+   counters (multiplicities, trigger counts, cut-flow) are expected to be filled by the owner
+   for every event. An event is sampled if both of the following conditions are met:
+
+    - prescale   : the event is the 1st, (N+1)th, (2N+1)th, ... event seen by the module
+                   (deterministic 1-in-N subsample; <=1 means every event)
+    - timeBudget : the CPU time [ms] spent in the sampled events so far does not exceed the
+                   budget times the number of events seen so far (<=0 means no budget)
+
+   The CPU time of a sampled event is taken between _start_ and _stop_, most easily with a
+   Clock in the scope of the analyze method. The bookkeeping is published as MonitorElements
+   in the subfolder Sampling of the given directory:
+
+    - Events : number of all (bin 1) and of sampled (bin 2) events; as a histogram it is
+               merged in the harvesting, where the ratio of the two bins gives the weight
+    - Weight : weight of the sampled events (all/sampled) of the job
+
+   Histograms that are filled for sampled events only have to be scaled by this weight to
+   be compared with the histograms that are filled for every event.
+*/
+
+class MonitorSampling {
+ public:
+  /// stop watch for the CPU time of a sampled event, which is stopped
+  /// when it goes out of scope (no-op for a null pointer)
+  class Clock {
+  public:
+    Clock(MonitorSampling* sampling) : sampling_(sampling) { if(sampling_) sampling_->start(); };
+    ~Clock(){ if(sampling_) sampling_->stop(); };
+  private:
+    MonitorSampling* sampling_;
+  };
+
+ public:
+  /// default constructor
+  MonitorSampling(const std::string& directory, unsigned int prescale, double timeBudget);
+  /// default destructor
+  ~MonitorSampling(){};
+
+  /// to be called at the beginning of each event; returns true if the event is sampled
+  bool next();
+  /// true if the current event is sampled
+  bool sampled() const { return sampled_; };
+  /// weight of the sampled events (all/sampled)
+  double weight() const { return nSampled_>0 ? double(nEvents_)/nSampled_ : 0.; };
+  /// start the clock (for sampled events only)
+  void start(){ if(sampled_) start_=cpuTime(); };
+  /// stop the clock and add the CPU time to the budget (for sampled events only)
+  void stop(){ if(sampled_) spent_+=cpuTime()-start_; };
+
+ private:
+  /// CPU time of the current thread in ms
+  double cpuTime() const;
+
+ private:
+  /// sample every prescale_ event
+  unsigned int prescale_;
+  /// CPU time budget per event in ms
+  double timeBudget_;
+  /// number of events seen and sampled so far
+  unsigned long nEvents_, nSampled_;
+  /// true if the current event is sampled
+  bool sampled_;
+  /// start time of the current measurement and CPU time spent in sampled events
+  double start_, spent_;
+  /// histograms
+  MonitorElement *events_, *weight_;
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef NMINUSONE
+#define NMINUSONE
+
+#include <vector>
+
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+/**
+   \class   NMinusOne NMinusOne.h "DQM/Physics/interface/NMinusOne.h"
+
+   \brief   Helper class to fill N-1 histograms from bitmasks of selection flags.
+
+   Helper class for N-1 (cut flow) monitoring. The results of up to 32 selection
+   flags are combined into a bitmask (bit i set: flag i passed). Per object results
+   can be computed once and combined with event or pair level flags via bitwise
+   operations before they are handed to the fill function. The N-1 histograms are
+   registered as a table of entries, each consisting of
+
+    - flag     : the flag the histogram belongs to or ALL for histograms that are
+                 only filled if all flags passed
+    - me       : the MonitorElement to be filled
+    - value    : the slot of the value to be filled (see set)
+    - once     : whether the histogram is to be filled at most once per event (for
+                 event quantities in object loops)
+    - require  : context bits that have to be set in the fill call (e.g. to split
+                 histograms into barrel and endcap)
+
+   An entry is filled if all flags but its own passed. The once-per-event state is
+   cleared by reset, which has to be called at the beginning of each event.
+*/
+
+class NMinusOne {
+ public:
+  /// flag of histograms only filled if all flags passed
+  static const unsigned int ALL = 32;
+
+ public:
+  /// default constructor
+  NMinusOne(unsigned int nFlags, unsigned int nValues) : all_(nFlags<32 ? (1u<<nFlags)-1 : ~0u), values_(nValues, 0.) {};
+  /// default destructor
+  ~NMinusOne(){};
+
+  /// bit of flag _flag_ for a passed selection
+  static unsigned int bit(unsigned int flag, bool passed=true){ return passed ? 1u<<flag : 0u; };
+
+  /// add an entry to the table of N-1 histograms
+  void add(unsigned int flag, MonitorElement* me, unsigned int value, bool once=false, unsigned int require=0){
+    Entry entry={ flag, me, value, once, require, false }; entries_.push_back(entry);
+  };
+  /// clear the once-per-event state
+  void reset(){
+    for(std::vector<Entry>::iterator entry=entries_.begin(); entry!=entries_.end(); ++entry){ entry->done=false; }
+  };
+  /// set the value of slot _value_ for the next fill
+  void set(unsigned int value, double x){ values_[value]=x; };
+  /// true if all flags in _mask_ passed
+  bool passed(unsigned int mask) const { return (mask&all_)==all_; };
+  /// true if at least N-1 flags in _mask_ passed
+  bool passedNMinusOne(unsigned int mask) const { unsigned int failed=all_&~mask; return (failed&(failed-1))==0; };
+  /// fill all N-1 histograms for _mask_; returns passedNMinusOne(mask)
+  bool fill(unsigned int mask, unsigned int context=0){
+    unsigned int failed=all_&~mask;
+    if( (failed&(failed-1))!=0 ) return false;
+    for(std::vector<Entry>::iterator entry=entries_.begin(); entry!=entries_.end(); ++entry){
+      if( failed!=0 && (entry->flag==ALL || failed!=bit(entry->flag)) ) continue;
+      if( (context&entry->require)!=entry->require ) continue;
+      if( entry->once ){ if( entry->done ) continue; entry->done=true; }
+      entry->me->Fill(values_[entry->value]);
+    }
+    return true;
+  };
+
+ private:
+  /// one N-1 histogram
+  struct Entry {
+    unsigned int flag;
+    MonitorElement* me;
+    unsigned int value;
+    bool once;
+    unsigned int require;
+    bool done;
+  };
+
+ private:
+  /// mask with all flags set
+  unsigned int all_;
+  /// values of the current object
+  std::vector<double> values_;
+  /// table of N-1 histograms
+  std::vector<Entry> entries_;
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef SELECTIONGRAPH
+#define SELECTIONGRAPH
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+#include "DataFormats/Provenance/interface/EventID.h"
+#include "DataFormats/Provenance/interface/Timestamp.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+
+/**
+   \class   SelectionGraph SelectionGraph.h "DQM/Physics/interface/SelectionGraph.h"
+
+   \brief   Service to share the selection steps of the top DQM module family.
+
+   The modules TopSingleLeptonDQM, SingleTopTChannelLeptonDQM and TopDiLeptonOfflineDQM
+   are typically run several times in the same sequence with identically configured
+   selection steps (e.g. the same jet multiplicity cut on the same jet collection).
+   Each module registers its selection steps with the graph in its constructor. Steps
+   with the same object type and the same configuration (src, select, min, max and all
+   optional extras of the SelectionStep class) are mapped
+   to a single node, which keeps a single instance of the corresponding SelectionStep.
+   Each node is evaluated at most once per event, the result is cached and handed to all
+   subscribers that ask for it within the same event. The following object types are
+   supported (the type is the prefix of the selection step label of the modules):
+
+    - muons     : SelectionStep<reco::Muon>::select(event)
+    - muons/pf  : SelectionStep<reco::PFCandidate>::select(event, "muon")
+    - elecs     : SelectionStep<reco::GsfElectron>::select(event)
+    - elecs/pf  : SelectionStep<reco::PFCandidate>::select(event, "electron")
+    - pvs       : SelectionStep<reco::Vertex>::selectVertex(event)
+    - jets      : SelectionStep<reco::Jet>::select(event, setup)
+    - jets/pf   : SelectionStep<reco::PFJet>::select(event, setup)
+    - jets/calo : SelectionStep<reco::CaloJet>::select(event, setup)
+    - met       : SelectionStep<reco::MET>::select(event)
+
+   The graph is shared between the modules as a service, which is enabled in the
+   configuration via
+
+   process.SelectionGraph = cms.Service("SelectionGraph")
+
+   and which clears the cache at the beginning of each event. If the service is not
+   available the modules keep a graph of their own (default constructor), for which
+   the cache is keyed by the edm::EventID only. The graph is not protected against
+   concurrent access; it is used by legacy modules, which are run one at a time.
+*/
+
+class SelectionGraph {
+ public:
+  /// default constructor (graph owned by a single module)
+  SelectionGraph() : subscriptions_(0) {};
+  /// constructor of the service shared by all subscribing modules
+  SelectionGraph(const edm::ParameterSet& cfg, edm::ActivityRegistry& registry);
+  /// default destructor
+  ~SelectionGraph();
+
+  /// check whether an object type is supported
+  bool supports(const std::string& type) const;
+  /// register a selection step of type _type_; returns the
+  /// id of the (possibly already existing) node to be used
+  /// in the select function
+  unsigned int subscribe(const std::string& type, const edm::ParameterSet& cfg);
+  /// evaluate node with id _id_ (once per event)
+  bool select(unsigned int id, const edm::Event& event, const edm::EventSetup& setup);
+  /// clear the cached results at the beginning of the event
+  void preProcessEvent(const edm::EventID& id, const edm::Timestamp& time);
+
+  /// number of unique nodes
+  unsigned int nodes() const { return nodes_.size(); };
+  /// number of subscriptions
+  unsigned int subscriptions() const { return subscriptions_; };
+
+ private:
+  /// type erased interface of a selection step
+  class Node {
+  public:
+    virtual ~Node(){};
+    virtual bool evaluate(const edm::Event& event, const edm::EventSetup& setup) = 0;
+  };
+  /// node implementation for a given SelectionStep type
+  template <typename Object> class StepNode;
+
+ private:
+  /// not copyable
+  SelectionGraph(const SelectionGraph&);
+  SelectionGraph& operator=(const SelectionGraph&);
+  /// create a new node for the given type
+  Node* create(const std::string& type, const edm::ParameterSet& cfg) const;
+
+ private:
+  /// index of unique nodes; the key is the object
+  /// type together with the selection configuration
+  std::map<std::string, unsigned int> index_;
+  /// unique selection nodes
+  std::vector<Node*> nodes_;
+  /// event for which the node was evaluated last
+  std::vector<edm::EventID> evaluated_;
+  /// cached result of the last evaluation
+  std::vector<bool> results_;
+  /// number of subscriptions (for bookkeeping)
+  unsigned int subscriptions_;
+};
+
+#endif
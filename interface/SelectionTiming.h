@@ -0,0 +1,92 @@
+#ifndef SELECTIONTIMING
+#define SELECTIONTIMING
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+
+/**
+   \class   SelectionTiming SelectionTiming.h "DQM/Physics/interface/SelectionTiming.h"
+
+   \brief   Helper class to monitor the cost and the rejection of selection steps.
+
+   Helper class to record for each selection step of a module the number of accepted
+   and rejected events and the CPU time spent in the selection and in the fill of the
+   corresponding MonitorEnsemble. The results are published as MonitorElements in the
+   subfolder Timing of the given directory (all with one bin per selection step):
+
+    - Accepted   : number of events accepted by the selection step
+    - Rejected   : number of events rejected by the selection step
+    - SelectTime : cumulative CPU time [ms] of the selection step
+    - FillTime   : cumulative CPU time [ms] of the fill of the MonitorEnsemble
+
+   The accept/reject counters are updated for each event. The timing is only taken for
+   every Nth event (sampling) to keep the overhead low; the histograms give the sum of
+   the CPU time of the sampled calls, which is to be scaled by the sampling to estimate
+   the total. The mean CPU time per call is given by the sum divided by the number of
+   sampled calls (accepted plus rejected events of the step divided by the sampling).
+   The modules measure the selection steps and the fills with a Clock in the scope of
+   their select and fill functions. Note that with the SelectionGraph the CPU time of a
+   selection step shared between modules is accounted to the module that evaluates it
+   first in the event.
+*/
+
+class SelectionTiming {
+ public:
+  /// measurements of a selection step
+  enum Measurement{ SELECT, FILL };
+  /// stop watch for the selection step _step_ or for the fill of its MonitorEnsemble,
+  /// which is stopped when it goes out of scope (no-op for a null pointer); the result
+  /// of a selection step is handed through _passed_
+  class Clock {
+  public:
+    Clock(SelectionTiming* timing, const std::string& step, Measurement what) : timing_(timing), step_(step), what_(what), passed_(false) { if(timing_) timing_->start(); };
+    ~Clock(){ if(timing_) what_==SELECT ? timing_->selected(step_, passed_) : timing_->filled(step_); };
+    bool passed(bool passed){ passed_=passed; return passed; };
+  private:
+    SelectionTiming* timing_;
+    const std::string& step_;
+    Measurement what_;
+    bool passed_;
+  };
+
+ public:
+  /// default constructor
+  SelectionTiming(const std::string& directory, const std::vector<std::string>& steps, unsigned int sampling);
+  /// default destructor
+  ~SelectionTiming(){};
+
+  /// to be called at the beginning of each event
+  void next(){ sampled_ = (sampling_<=1 || (nEvents_++)%sampling_==0); };
+  /// start the clock (for sampled events only)
+  void start(){ if(sampled_) start_=cpuTime(); };
+  /// record the result of the selection step _step_
+  void selected(const std::string& step, bool passed);
+  /// record the fill of the MonitorEnsemble of selection step _step_
+  void filled(const std::string& step);
+
+ private:
+  /// CPU time of the current thread in ms
+  double cpuTime() const;
+  /// bin of the selection step in the histograms
+  double bin(const std::string& step) const;
+
+ private:
+  /// sample every sampling_ event
+  unsigned int sampling_;
+  /// number of events seen so far
+  unsigned long nEvents_;
+  /// true if the current event is sampled
+  bool sampled_;
+  /// start time of the current measurement
+  double start_;
+  /// bins of the selection steps
+  std::map<std::string, double> bins_;
+  /// histograms
+  MonitorElement *accepted_, *rejected_, *selectTime_, *fillTime_;
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef SPARSEHISTOGRAM
+#define SPARSEHISTOGRAM
+
+#include <boost/unordered_map.hpp>
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+#include "DQM/Physics/interface/LazyBooking.h"
+
+/**
+   \class   SparseHistogram SparseHistogram.h "DQM/Physics/interface/SparseHistogram.h"
+
+   \brief   Helper class to keep a large, mostly empty 1- or 2-dim histogram in sparse form.
+
+   Helper class to accumulate the fills of a large but sparsely populated histogram (like
+   a run number histogram with 10k bins of which only one is filled per run) in a hash map
+   of the non-empty bins instead of a dense MonitorElement. The bin is determined from the
+   (fixed) binning of the HistogramDef analytically, following the global bin convention of
+   ROOT including under- and overflow. The dense MonitorElement is booked only by _save_,
+   which the owner calls at the end of each run before the histograms are written; the
+   sparse contents are filled into it and cleared then. During the run only the non-empty
+   bins are kept. The MonitorElement is not accounted against a BookingBudget.
+*/
+
+class SparseHistogram {
+ public:
+  /// default constructor
+  SparseHistogram() : entries_(0.), weighted_(false), me_(0) {};
+  /// constructor from the histogram definition
+  SparseHistogram(const HistogramDef& def) : def_(def), entries_(0.), weighted_(false), me_(0) {};
+  /// default destructor
+  ~SparseHistogram(){};
+
+  /// histogram definition (e.g. to add axis titles or bin labels before booking)
+  HistogramDef& definition() { return def_; };
+  /// fill a 1-dim histogram
+  void fill(double x, double weight=1.){ add(bin(x, def_.nBinsX(), def_.lowX(), def_.highX()), weight); };
+  /// fill a 2-dim histogram
+  void fill(double x, double y, double weight){
+    add(bin(x, def_.nBinsX(), def_.lowX(), def_.highX())+(def_.nBinsX()+2)*bin(y, def_.nBinsY(), def_.lowY(), def_.highY()), weight);
+  };
+  /// number of non-empty bins not yet saved
+  unsigned int size() const { return bins_.size(); };
+  /// rough estimate of the resident memory of the sparse bins in bytes
+  double bytes() const;
+  /// book the dense MonitorElement (if not done yet), fill the sparse contents
+  /// into it and clear them; returns the MonitorElement
+  MonitorElement* save(DQMStore* store);
+  /// dense MonitorElement (0 if save has not been called yet)
+  MonitorElement* me() const { return me_; };
+
+ private:
+  /// sum of weights and squared weights of a bin
+  struct Bin {
+    Bin() : sumw(0.), sumw2(0.) {};
+    double sumw, sumw2;
+  };
+
+ private:
+  /// bin along one axis (0: underflow, n+1: overflow)
+  static int bin(double value, int n, double low, double high){
+    if( !(value>=low) ) return 0;
+    if( value>=high ) return n+1;
+    int idx=int((value-low)/(high-low)*n)+1;
+    return idx>n ? n : idx;
+  };
+  /// center of bin _idx_ along one axis (outside of the range for under- and overflow)
+  static double center(int idx, int n, double low, double high){ return low+(idx-0.5)*(high-low)/n; };
+  /// add _weight_ to the global bin _idx_
+  void add(int idx, double weight){
+    Bin& content=bins_[idx]; content.sumw+=weight; content.sumw2+=weight*weight;
+    entries_+=1.; if( weight!=1. ) weighted_=true;
+  };
+
+ private:
+  /// histogram definition for the booking
+  HistogramDef def_;
+  /// non-empty bins indexed by the global bin
+  boost::unordered_map<int, Bin> bins_;
+  /// number of fills not yet saved
+  double entries_;
+  /// true if weights different from 1 have been filled
+  bool weighted_;
+  /// dense MonitorElement (not owned)
+  MonitorElement* me_;
+};
+
+#endif
@@ -17,14 +17,14 @@
    \brief   Helper function to determine trigger accepts.
    
    Helper function to determine trigger accept for given TriggerResults and 
-   a given TriggerPath(s).
+   a given TriggerPath(s). The versions taking edm::TriggerNames do not need
+   an edm::Event and can be used standalone (e.g. for benchmarking).
 */
 
 inline bool 
-accept(const edm::Event& event, const edm::TriggerResults& triggerTable, const std::string& triggerPath)
+accept(const edm::TriggerNames& triggerNames, const edm::TriggerResults& triggerTable, const std::string& triggerPath)
 {
   bool passed=false;
-  const edm::TriggerNames& triggerNames = event.triggerNames(triggerTable);
   for(unsigned int i=0; i<triggerNames.triggerNames().size(); ++i){
     if(triggerNames.triggerNames()[i] == triggerPath) {
       if(triggerTable.accept(i)){
@@ -37,11 +37,11 @@ accept(const edm::Event& event, const edm::TriggerResults& triggerTable, const s
 }
 
 inline bool 
-accept(const edm::Event& event, const edm::TriggerResults& triggerTable, const std::vector<std::string>& triggerPaths)
+accept(const edm::TriggerNames& triggerNames, const edm::TriggerResults& triggerTable, const std::vector<std::string>& triggerPaths)
 {
   bool passed=false;
   for(unsigned int j=0; j<triggerPaths.size(); ++j){
-    if(accept(event, triggerTable, triggerPaths[j])){
+    if(accept(triggerNames, triggerTable, triggerPaths[j])){
       passed=true;
       break;
     }
@@ -49,6 +49,18 @@ accept(const edm::Event& event, const edm::TriggerResults& triggerTable, const s
   return passed;
 }
 
+inline bool 
+accept(const edm::Event& event, const edm::TriggerResults& triggerTable, const std::string& triggerPath)
+{
+  return accept(event.triggerNames(triggerTable), triggerTable, triggerPath);
+}
+
+inline bool 
+accept(const edm::Event& event, const edm::TriggerResults& triggerTable, const std::vector<std::string>& triggerPaths)
+{
+  return accept(event.triggerNames(triggerTable), triggerTable, triggerPaths);
+}
+
 
 #include "DataFormats/JetReco/interface/Jet.h"
 #include "FWCore/Framework/interface/EventSetup.h"
@@ -71,13 +83,17 @@ class Calculate {
   /// default destructor
   ~Calculate(){};
      
-  /// calculate W boson mass estimate
-  double massWBoson(const std::vector<reco::Jet>& jets);
+  /// calculate W boson mass estimate; the jets are given as std::vector 
+  /// of reco::Jet with any allocator (e.g. ArenaVector<reco::Jet>::type)
+  template <typename Jets> double massWBoson(const Jets& jets)
+  { if(!failed_&& massWBoson_<0) operator()(jets.empty() ? 0 : &jets[0], jets.size()); return massWBoson_; };
   /// calculate t-quark mass estimate
-  double massTopQuark(const std::vector<reco::Jet>& jets);
+  template <typename Jets> double massTopQuark(const Jets& jets)
+  { if(!failed_&& massTopQuark_<0) operator()(jets.empty() ? 0 : &jets[0], jets.size()); return massTopQuark_; };
   /// calculate b-tagged t-quark mass estimate
   //double massBTopQuark(const std::vector<reco::Jet>& jets, std::vector<bool> bjet);
-  double massBTopQuark(const std::vector<reco::Jet>& jets, std::vector<double> VbtagWP, double btagWP_);
+  template <typename Jets, typename Values> double massBTopQuark(const Jets& jets, const Values& VbtagWP, double btagWP_)
+  { if(!failed_&& massBTopQuark_<0) operator2(jets.empty() ? 0 : &jets[0], jets.size(), VbtagWP.empty() ? 0 : &VbtagWP[0], VbtagWP.size(), btagWP_); return massBTopQuark_; };
 
   /// calculate W boson transverse mass estimate
   double tmassWBoson(reco::RecoCandidate* lep, const reco::MET& met, const reco::Jet& b);
@@ -88,9 +104,9 @@ class Calculate {
   /// do the calculation; this is called only once per event by the first 
   /// function call to return a mass estimate. The once calculated values 
   /// are cached afterwards
-  void operator()(const std::vector<reco::Jet>& jets);
+  void operator()(const reco::Jet* jets, unsigned int nJets);
   ///do the calculation of the t-quark mass with one b-jet
-  void operator2(const std::vector<reco::Jet>& , std::vector<double> , double);
+  void operator2(const reco::Jet* jets, unsigned int nJets, const double* bjet, unsigned int nBJets, double btagWP);
   ///do the calculation of the transverse top and W masses
   void operator()(const reco::Jet& bJet, reco::RecoCandidate* lepton, const reco::MET& met);
   
@@ -119,6 +135,8 @@ class Calculate {
 
 
 #include "DataFormats/JetReco/interface/JetID.h"
+#include "DQM/Physics/interface/LazyJetID.h"
+#include "DQM/Physics/interface/AssociationTable.h"
 #include "DataFormats/JetReco/interface/PFJet.h"
 #include "DataFormats/JetReco/interface/CaloJet.h"
 #include "DataFormats/BTauReco/interface/JetTag.h"
@@ -152,7 +170,9 @@ class Calculate {
     - jetCorrector : label of jet corrector (optional).
     - jetBTagger   : parameters defining the btag algorithm and working point of choice
                      (optional).
-    - jetID        : parameters defining the jetID value map and selection (optional).
+    - jetID        : parameters defining the jetID value map and selection (optional). 
+                     The jetID is only looked up for calo jets, which passed the kinematic 
+                     selection (see LazyJetID).
 
 
    The parameters _src_ and _select_ are mandatory. The parameters _min_ and _max_ are 
@@ -166,7 +186,11 @@ class Calculate {
    The class has one template value, which is the object collection to apply the selection 
    on. This has to be parsed to the StringCutParser class. The function select is overrided 
    for jets to circumvent problems with the template specialisation. Note that for MET not 
-   type1 or muon corrections are supported on reco candidates.
+   type1 or muon corrections are supported on reco candidates. The electronId and the btag 
+   discriminators are resolved once per event into AssociationTables aligned with the input 
+   collection. Without electronId, b-tag and jetID the selection only depends on the input 
+   collection; the event based functions then use the overloads for an already fetched 
+   edm::View, which can also be called without an edm::Event.
 */
 
 template <typename Object> 
@@ -175,7 +199,7 @@ public:
   /// default constructor
   SelectionStep(const edm::ParameterSet& cfg);
   /// default destructor
-  ~SelectionStep(){};
+  ~SelectionStep(){ if( jetIDSelect_ ) delete jetIDSelect_; if( jetID_ ) delete jetID_; };
 
   /// apply selection
   bool select(const edm::Event& event);
@@ -183,6 +207,19 @@ public:
   /// apply selection override for jets
   bool select(const edm::Event& event, const edm::EventSetup& setup); 
   bool selectVertex(const edm::Event& event);
+  /// apply selection to an already fetched collection; this is what 
+  /// select(event) does if no electronId is configured
+  bool select(const edm::View<Object>& src);
+  /// apply selection to an already fetched jet collection, corrected with
+  /// _corrector_ (if not 0); this is what select(event, setup) does if 
+  /// neither b-tag nor jetID are configured
+  bool select(const edm::View<Object>& src, const JetCorrector* corrector);
+  /// apply vertex selection to an already fetched collection
+  bool selectVertex(const edm::View<Object>& src);
+private:
+  /// not copyable (owns the jetID selection)
+  SelectionStep(const SelectionStep&);
+  SelectionStep& operator=(const SelectionStep&);
 private:
   /// input collection
   edm::InputTag src_;
@@ -216,6 +253,12 @@ private:
   StringCutObjectSelector<Object> select_;
   /// selection string on the jetID
   StringCutObjectSelector<reco::JetID>* jetIDSelect_;
+  /// jetID from the value map, looked up only for jets
+  /// that passed the kinematic selection
+  LazyJetID* jetID_;
+  /// electronId and btag discriminators of the current event in 
+  /// the order of the input collection
+  AssociationTable<float> electronIds_, btags_;
 };
 
 /// default constructor
@@ -223,7 +266,8 @@ template <typename Object>
 SelectionStep<Object>::SelectionStep(const edm::ParameterSet& cfg) :
   src_( cfg.getParameter<edm::InputTag>( "src"   )),
   select_( cfg.getParameter<std::string>("select")),
-  jetIDSelect_(0)
+  jetIDSelect_(0),
+  jetID_(0)
 {
   // construct min/max if the corresponding params
   // exist otherwise they are initialized with -1
@@ -248,6 +292,7 @@ SelectionStep<Object>::SelectionStep(const edm::ParameterSet& cfg) :
     edm::ParameterSet jetID=cfg.getParameter<edm::ParameterSet>("jetID");
     jetIDLabel_ =jetID.getParameter<edm::InputTag>("label");
     jetIDSelect_= new StringCutObjectSelector<reco::JetID>(jetID.getParameter<std::string>("select"));
+    jetID_= new LazyJetID(jetIDLabel_);
   }
 }
 
@@ -258,12 +303,14 @@ bool SelectionStep<Object>::select(const edm::Event& event)
   // fetch input collection
   edm::Handle<edm::View<Object> > src; 
   if( !event.getByLabel(src_, src) ) return false;
+  // without electronId the selection only depends on the collection
+  if( electronId_.label().empty() ) return select(*src);
 
-  // load electronId value map if configured such
+  // load electronId value map (it is resolved 
+  // for electron collections only)
   edm::Handle<edm::ValueMap<float> > electronId;
-  if(!electronId_.label().empty()) {
-    if( !event.getByLabel(electronId_, electronId) ) return false;
-  }
+  if( !event.getByLabel(electronId_, electronId) ) return false;
+  if( !src->empty() && dynamic_cast<const reco::GsfElectron*>(&src->front()) ) electronIds_.resolve(*src, *electronId);
 
   // determine multiplicity of selected objects
   int n=0;
@@ -271,7 +318,7 @@ bool SelectionStep<Object>::select(const edm::Event& event)
     // special treatment for electrons
     if(dynamic_cast<const reco::GsfElectron*>(&*obj)){
       unsigned int idx = obj-src->begin();
-      if( electronId_.label().empty() ? true : ((int)(*electronId)[src->refAt(idx)] & eidPattern_) ){   
+      if( (int)electronIds_[idx] & eidPattern_ ){   
 	if(select_(*obj))++n;
       }
     }
@@ -284,6 +331,19 @@ bool SelectionStep<Object>::select(const edm::Event& event)
   return (min_<0 && max_<0) ? (n>0):accept;
 }
 
+/// apply selection to an already fetched collection
+template <typename Object> 
+bool SelectionStep<Object>::select(const edm::View<Object>& src)
+{
+  // determine multiplicity of selected objects
+  int n=0;
+  for(typename edm::View<Object>::const_iterator obj=src.begin(); obj!=src.end(); ++obj){
+    if(select_(*obj))++n;
+  }
+  bool accept=(min_>=0 ? n>=min_:true) && (max_>=0 ? n<=max_:true);
+  return (min_<0 && max_<0) ? (n>0):accept;
+}
+
 
 /// apply selection with special treatment for PFCandidates 
 template <typename Object>
@@ -297,9 +357,11 @@ bool SelectionStep<Object>::select(const edm::Event& event, const std::string& t
   edm::Handle<edm::View<reco::GsfElectron> > elecs_gsf;
   
   // load electronId value map if configured such
+  // (it is resolved for electron collections only)
   edm::Handle<edm::ValueMap<float> > electronId;
   if(!electronId_.label().empty()) {
     if( !event.getByLabel(electronId_, electronId) ) return false;
+    if( !src->empty() && dynamic_cast<const reco::GsfElectron*>(&src->front()) ) electronIds_.resolve(*src, *electronId);
   }
   
   // determine multiplicity of selected objects
@@ -334,7 +396,7 @@ bool SelectionStep<Object>::select(const edm::Event& event, const std::string& t
     // special treatment for electrons
     else if(dynamic_cast<const reco::GsfElectron*>(&*obj)){
       unsigned int idx = obj-src->begin();
-      int eID = (int)(*electronId)[src->refAt(idx)];
+      int eID = electronId_.label().empty() ? 0 : (int)electronIds_[idx];
       if( electronId_.label().empty() ? true : ( (eID & eidPattern_)  && (eID >= 5) ) ){
         if(select_(*obj))++n;
       }
@@ -363,10 +425,15 @@ bool SelectionStep<Object>::selectVertex(const edm::Event& event)
   if(!electronId_.label().empty()) {
     if( !event.getByLabel(electronId_, electronId) ) return false;
   }
+  return selectVertex(*src);
+}
 
+template <typename Object> 
+bool SelectionStep<Object>::selectVertex(const edm::View<Object>& src)
+{
   // determine multiplicity of selected objects
   int n=0;
-  for(typename edm::View<Object>::const_iterator obj=src->begin(); obj!=src->end(); ++obj){
+  for(typename edm::View<Object>::const_iterator obj=src.begin(); obj!=src.end(); ++obj){
    
       if(select_(*obj))++n;
   }
@@ -393,14 +460,13 @@ bool SelectionStep<Object>::select(const edm::Event& event, const edm::EventSetu
     if( !event.getByLabel(src_, bjets) ) return false;
     if( !event.getByLabel(btagLabel_, btagger) ) return false;
     if( !event.getByLabel(pvs_, pvertex) ) return false;
+    btags_.resolve(*bjets, *btagger);
   }
 
-  // load jetID value map if configured such 
-  edm::Handle<reco::JetIDValueMap> jetID;
-  if(jetIDSelect_){
-    if( !event.getByLabel(jetIDLabel_, jetID) ) return false;
-
-  }
+  // check for the jetID value map if configured such; the 
+  // jetIDs are only looked up for jets, which passed the 
+  // kinematic selection
+  if( jetIDSelect_ && !jetID_->load(event) ) return false;
 
   // load jet corrector if configured such
   const JetCorrector* corrector=0;
@@ -424,22 +490,26 @@ bool SelectionStep<Object>::select(const edm::Event& event, const edm::EventSetu
         << "------------------------------------------------------------------------------------- \n";
     }
   }
+  // without b-tag and jetID the selection only depends on the collection
+  if( btagLabel_.label().empty() && !jetIDSelect_ ) return select(*src, corrector);
+
   // determine multiplicity of selected objects
   int n=0;
   for(typename edm::View<Object>::const_iterator obj=src->begin(); obj!=src->end(); ++obj){
     // check for chosen btag discriminator to be above the 
     // corresponding working point if configured such 
     unsigned int idx = obj-src->begin();
-    if( btagLabel_.label().empty() ? true : (*btagger)[bjets->refAt(idx)]>btagWorkingPoint_ ){   
-      bool passedJetID=true;
-      // check jetID for calo jets
-      if( jetIDSelect_ && dynamic_cast<const reco::CaloJet*>(src->refAt(idx).get())){
-	passedJetID=(*jetIDSelect_)((*jetID)[src->refAt(idx)]);
-      }
-      if(passedJetID){
-	// scale jet energy if configured such
-	Object jet=*obj; jet.scaleEnergy(corrector ? corrector->correction(*obj) : 1.);
-	if(select_(jet))++n;
+    if( btagLabel_.label().empty() ? true : btags_[idx]>btagWorkingPoint_ ){   
+      // scale jet energy if configured such
+      Object jet=*obj; jet.scaleEnergy(corrector ? corrector->correction(*obj) : 1.);
+      if(select_(jet)){
+	// check jetID for calo jets
+	if( jetIDSelect_ && dynamic_cast<const reco::CaloJet*>(&*obj)){
+	  const reco::JetID* jetID=(*jetID_)(event, src->refAt(idx));
+	  if( !jetID ) return false;
+	  if( !(*jetIDSelect_)(*jetID) ) continue;
+	}
+	++n;
       }
     }
   }
@@ -447,4 +517,19 @@ bool SelectionStep<Object>::select(const edm::Event& event, const edm::EventSetu
   return (min_<0 && max_<0) ? (n>0):accept;
 }
 
+/// apply selection to an already fetched jet collection
+template <typename Object> 
+bool SelectionStep<Object>::select(const edm::View<Object>& src, const JetCorrector* corrector)
+{
+  // determine multiplicity of selected objects
+  int n=0;
+  for(typename edm::View<Object>::const_iterator obj=src.begin(); obj!=src.end(); ++obj){
+    // scale jet energy if configured such
+    Object jet=*obj; jet.scaleEnergy(corrector ? corrector->correction(*obj) : 1.);
+    if(select_(jet))++n;
+  }
+  bool accept=(min_>=0 ? n>=min_:true) && (max_>=0 ? n<=max_:true);
+  return (min_<0 && max_<0) ? (n>0):accept;
+}
+
 #endif
@@ -14,6 +14,7 @@ from DQM.Physics.ExoticaDQM_cfi import *
 from DQM.Physics.susyDQM_cfi import *
 from DQM.Physics.HiggsDQM_cfi import *
 from JetMETCorrections.Configuration.JetCorrectionProducersAllAlgos_cff import *
+from DQM.Physics.selectionGraph_cfi import *
 
 ## unused
 #from DQM.Physics.qcdUeDQM_cfi import *
@@ -79,6 +79,11 @@ ExoticaDQM = cms.EDAnalyzer(
     #PtThrMu1 = cms.untracked.double(3.0),
     #PtThrMu2 = cms.untracked.double(3.0)
 
+    #
+    # run the sub-analyses (MultiJets, LongLived, EventInterpretation)
+    # concurrently within each event (default: False)
+    #concurrentSubAnalyses = cms.bool(True),
+
     JetIDParams  = cms.PSet(
         useRecHits      = cms.bool(True),
         hbheRecHitsColl = cms.InputTag("hbhereco"),
@@ -12,6 +12,12 @@ HiggsDQM = cms.EDAnalyzer("HiggsDQM",
     genParticleCollection    = cms.InputTag("genParticles"),
 
     PtThrMu1 = cms.untracked.double(3.0),
-    PtThrMu2 = cms.untracked.double(3.0)
+    PtThrMu2 = cms.untracked.double(3.0),
+
+    # fill the kinematic distributions for every Nth event and/or within a
+    # CPU time budget [ms/event] only (1 and 0.: every event); multiplicities
+    # and lepton counts are filled always
+    SamplingPrescale   = cms.untracked.uint32(1),
+    SamplingTimeBudget = cms.untracked.double(0.)
 )
 
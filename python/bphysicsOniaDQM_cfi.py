@@ -4,6 +4,10 @@ import FWCore.ParameterSet.Config as cms
 bphysicsOniaDQM = cms.EDAnalyzer("BPhysicsOniaDQM",
                               MuonCollection = cms.InputTag("muons"),
                               vertex = cms.InputTag("offlinePrimaryVertices"),
+                              # batch size for the global-global dimuon mass fills (<=1: no batching)
+                              fillBatchSize = cms.untracked.uint32(128),
+                              # number of lumi sections with one bin in the JPsi yield trends (0: no trends)
+                              trendLumis = cms.untracked.uint32(0),
 )
 
 
@@ -57,5 +57,9 @@ ewkElecDQM = cms.EDAnalyzer("EwkElecDQM",
 
       # PU dependence
       PUMax = cms.untracked.uint32(60),
-      PUBinCount = cms.untracked.uint32(12)  # Bin size PUMax/PUBinCount
+      PUBinCount = cms.untracked.uint32(12),  # Bin size PUMax/PUBinCount
+
+      # W candidates per lumi section; number of lumi sections with
+      # one bin (0: no trends) ->
+      trendLumis = cms.untracked.uint32(0)
 )
@@ -37,5 +37,22 @@ ewkMuDQM = cms.EDAnalyzer("EwkMuDQM",
 
       # To further suppress ttbar ->
       EJetMin = cms.untracked.double(40.),
-      NJetMax = cms.untracked.int32(999999)
+      NJetMax = cms.untracked.int32(999999),
+
+      # Batch size for the per-muon fills before cuts (<=1: no batching) ->
+      fillBatchSize = cms.untracked.uint32(128),
+
+      # Fill the distributions before cuts for every Nth event and/or within
+      # a CPU time budget [ms/event] only (1 and 0.: every event); counters,
+      # multiplicities and N-1 histograms are filled always ->
+      SamplingPrescale = cms.untracked.uint32(1),
+      SamplingTimeBudget = cms.untracked.double(0.),
+
+      # W and Z candidates per lumi section; number of lumi sections
+      # with one bin (0: no trends) ->
+      trendLumis = cms.untracked.uint32(0),
+
+      # File for the index of the W and Z candidates per lumi section, to be
+      # queried with EventIndexQuery ("": no index) ->
+      EventIndexFile = cms.untracked.string("")
 )
@@ -0,0 +1,7 @@
+import FWCore.ParameterSet.Config as cms
+
+## merges the per lumi deltas of the MEtoLumiDeltaConverter into
+## the monitor histograms of the DQMStore (harvesting step)
+lumiDeltaToMEConverter = cms.EDAnalyzer("LumiDeltaToMEConverter",
+    src = cms.InputTag("meToLumiDeltaConverter")
+)
@@ -0,0 +1,8 @@
+import FWCore.ParameterSet.Config as cms
+
+## per lumi deltas of the monitor histograms of the given DQMStore
+## folders for the incremental harvesting; to be scheduled after
+## all DQM modules, which fill these folders
+meToLumiDeltaConverter = cms.EDProducer("MEtoLumiDeltaConverter",
+    folders = cms.vstring("Physics/Top")
+)
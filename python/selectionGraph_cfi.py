@@ -0,0 +1,5 @@
+import FWCore.ParameterSet.Config as cms
+
+## selection steps shared by the top DQM modules; the
+## results are cached for the duration of one event
+SelectionGraph = cms.Service("SelectionGraph")
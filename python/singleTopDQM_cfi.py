@@ -23,7 +23,14 @@ singleTopDQM = cms.EDAnalyzer("SingleTopTChannelLeptonDQM",
     ),
     ## [optional] : when omitted the verbosity level is set to STANDARD
     monitoring = cms.PSet(
-      verbosity = cms.string("DEBUG")
+      verbosity = cms.string("DEBUG"),
+      ## [optional] : modifications of the compiled-in histogram definitions,
+      ## selected by key; title, verbosity (level from which on the histogram
+      ## is booked) and binning may be given, unknown keys are an error
+      #histograms = cms.VPSet(
+      #  cms.PSet(key = cms.string("muonPt_"), nBinsX = cms.int32(100), highX = cms.double(500.)),
+      #  cms.PSet(key = cms.string("jetBDiscCombVtx_"), verbosity = cms.string("STANDARD"))
+      #)
     ),
     ## [optional] : when omitted all monitoring plots for primary vertices
     ## will be filled w/o extras
@@ -88,6 +95,16 @@ singleTopDQM = cms.EDAnalyzer("SingleTopTChannelLeptonDQM",
     )                                            
   ),                                  
   ## ------------------------------------------------------
+  ## TIMING
+  ##
+  ## [optional] : when omitted no timing and rejection
+  ## monitoring of the selection steps is done; the CPU
+  ## time is sampled every Nth event
+  ##
+  #timing = cms.PSet(
+  #  sampling = cms.uint32(100)
+  #),
+  ## ------------------------------------------------------
   ## PRESELECTION
   ##
   ## setup of the event preselection, which will not
@@ -0,0 +1,208 @@
+import FWCore.ParameterSet.Config as cms
+
+## --------------------------------------------------------------------
+## Synthetic events for the offline (performance) test of the DQM/Physics
+## modules without any input files or conditions. The producers are run
+## with the module labels of the reconstructed collections, which are
+## read by the DQM modules. To be loaded into a process with the name HLT
+## and an EmptySource; the trigger paths below then take the role of the
+## HLT menu (TriggerResults::HLT and HLTConfigProvider). The output is to
+## be written to a file and read back by the DQM job, see
+## test/syntheticEvents_cfg.py and test/dqmPhysicsSynthetic_cfg.py. The
+## producers are part of the test plugin library of the package
+## (DQMPhysicsSyntheticPlugins, test/BuildFile.xml).
+## --------------------------------------------------------------------
+
+## mean number of pileup interactions for typical running conditions
+## (2010: 2, 2011: 10, 2012: 20); to be applied with setPileup below
+pileupScenarios = { 'noPU' : 0., '2010' : 2., '2011' : 10., '2012' : 20. }
+
+RandomNumberGeneratorService = cms.Service("RandomNumberGeneratorService",
+    offlinePrimaryVertices       = cms.PSet( initialSeed = cms.untracked.uint32(1001) ),
+    muons                        = cms.PSet( initialSeed = cms.untracked.uint32(1002) ),
+    gsfElectrons                 = cms.PSet( initialSeed = cms.untracked.uint32(1003) ),
+    ak5PFJets                    = cms.PSet( initialSeed = cms.untracked.uint32(1004) ),
+    ak5CaloJets                  = cms.PSet( initialSeed = cms.untracked.uint32(1005) ),
+    pfMet                        = cms.PSet( initialSeed = cms.untracked.uint32(1006) ),
+    met                          = cms.PSet( initialSeed = cms.untracked.uint32(1007) ),
+    tcMet                        = cms.PSet( initialSeed = cms.untracked.uint32(1008) ),
+    corMetGlobalMuons            = cms.PSet( initialSeed = cms.untracked.uint32(1023) ),
+    trackCountingHighEffBJetTags = cms.PSet( initialSeed = cms.untracked.uint32(1009) ),
+    trackCountingHighPurBJetTags = cms.PSet( initialSeed = cms.untracked.uint32(1010) ),
+    simpleSecondaryVertexHighEffBJetTags = cms.PSet( initialSeed = cms.untracked.uint32(1011) ),
+    combinedSecondaryVertexBJetTags      = cms.PSet( initialSeed = cms.untracked.uint32(1012) ),
+    hltMu9                       = cms.PSet( initialSeed = cms.untracked.uint32(1013) ),
+    hltMu11                      = cms.PSet( initialSeed = cms.untracked.uint32(1014) ),
+    hltMu15                      = cms.PSet( initialSeed = cms.untracked.uint32(1015) ),
+    hltIsoMu24                   = cms.PSet( initialSeed = cms.untracked.uint32(1016) ),
+    hltDoubleMu3                 = cms.PSet( initialSeed = cms.untracked.uint32(1017) ),
+    hltEle10                     = cms.PSet( initialSeed = cms.untracked.uint32(1018) ),
+    hltEle15                     = cms.PSet( initialSeed = cms.untracked.uint32(1019) ),
+    hltEle15CaloEleId            = cms.PSet( initialSeed = cms.untracked.uint32(1020) ),
+    hltDoubleEle10               = cms.PSet( initialSeed = cms.untracked.uint32(1021) ),
+    hltQuadJet30                 = cms.PSet( initialSeed = cms.untracked.uint32(1022) )
+)
+
+## beam spot and primary vertices
+offlineBeamSpot = cms.EDProducer("SyntheticBeamSpotProducer",
+    x      = cms.double(0.07),
+    y      = cms.double(0.0),
+    z      = cms.double(0.0),
+    sigmaZ = cms.double(5.5)
+)
+offlinePrimaryVertices = cms.EDProducer("SyntheticVertexProducer",
+    beamSpot = cms.InputTag("offlineBeamSpot"),
+    pileup   = cms.double(0.)
+)
+
+## leptons: W-like spectrum of prompt leptons plus Z->ll
+muons = cms.EDProducer("SyntheticMuonProducer",
+    beamSpot          = cms.InputTag("offlineBeamSpot"),
+    vertices          = cms.InputTag("offlinePrimaryVertices"),
+    mean              = cms.double(0.6),
+    ptMin             = cms.double(3.),
+    ptSlope           = cms.double(20.),
+    etaMax            = cms.double(2.4),
+    resonanceFraction = cms.double(0.1),
+    resonanceMass     = cms.double(91.19),
+    resonanceWidth    = cms.double(2.50),
+    fakeFraction      = cms.double(0.3),
+    isoPerVertex      = cms.double(0.3)
+)
+gsfElectrons = cms.EDProducer("SyntheticElectronProducer",
+    beamSpot          = cms.InputTag("offlineBeamSpot"),
+    vertices          = cms.InputTag("offlinePrimaryVertices"),
+    mean              = cms.double(0.6),
+    ptMin             = cms.double(5.),
+    ptSlope           = cms.double(20.),
+    etaMax            = cms.double(2.5),
+    resonanceFraction = cms.double(0.1),
+    resonanceMass     = cms.double(91.19),
+    resonanceWidth    = cms.double(2.50),
+    fakeFraction      = cms.double(0.4),
+    isoPerVertex      = cms.double(0.3)
+)
+
+## electron identification
+eidRobustLoose = cms.EDProducer("SyntheticElectronIDProducer",
+    electrons         = cms.InputTag("gsfElectrons"),
+    maxSigmaIetaIeta  = cms.double(0.03),
+    maxDeltaEtaIn     = cms.double(0.01),
+    maxHadronicOverEm = cms.double(0.1),
+    maxRelIso         = cms.double(999.),
+    passValue         = cms.double(1.)
+)
+## for the simpleEleId value maps all working points (id, isolation and
+## conversion rejection) are set for passing electrons
+simpleEleId70cIso = eidRobustLoose.clone(
+    maxSigmaIetaIeta  = cms.double(0.03),
+    maxDeltaEtaIn     = cms.double(0.007),
+    maxHadronicOverEm = cms.double(0.05),
+    maxRelIso         = cms.double(0.1),
+    passValue         = cms.double(7.)
+)
+
+## jets: hard jets plus soft jets from pileup
+ak5PFJets = cms.EDProducer("SyntheticJetProducer",
+    vertices      = cms.InputTag("offlinePrimaryVertices"),
+    type          = cms.string("PF"),
+    mean          = cms.double(3.),
+    ptMin         = cms.double(10.),
+    ptSlope       = cms.double(30.),
+    etaMax        = cms.double(4.7),
+    pileupJets    = cms.double(0.5),
+    pileupPtMin   = cms.double(10.),
+    pileupPtSlope = cms.double(5.)
+)
+ak5CaloJets = ak5PFJets.clone( type = cms.string("Calo") )
+
+## b-tags of the PF jets
+trackCountingHighEffBJetTags = cms.EDProducer("SyntheticJetTagProducer",
+    jets            = cms.InputTag("ak5PFJets"),
+    bFraction       = cms.double(0.2),
+    signalMean      = cms.double(6.),
+    signalWidth     = cms.double(3.),
+    backgroundMean  = cms.double(0.),
+    backgroundWidth = cms.double(1.5)
+)
+trackCountingHighPurBJetTags = trackCountingHighEffBJetTags.clone(
+    signalMean      = cms.double(4.),
+    backgroundMean  = cms.double(-1.)
+)
+simpleSecondaryVertexHighEffBJetTags = trackCountingHighEffBJetTags.clone(
+    signalMean      = cms.double(2.5),
+    signalWidth     = cms.double(0.8),
+    backgroundMean  = cms.double(0.),
+    backgroundWidth = cms.double(0.5)
+)
+combinedSecondaryVertexBJetTags = trackCountingHighEffBJetTags.clone(
+    signalMean      = cms.double(0.8),
+    signalWidth     = cms.double(0.2),
+    backgroundMean  = cms.double(0.2),
+    backgroundWidth = cms.double(0.15)
+)
+
+## missing et: resolution plus genuine missing et from W-like events
+pfMet = cms.EDProducer("SyntheticMETProducer",
+    vertices        = cms.InputTag("offlinePrimaryVertices"),
+    type            = cms.string("PF"),
+    sumEt           = cms.double(300.),
+    sumEtPerVertex  = cms.double(40.),
+    genuineFraction = cms.double(0.3),
+    genuineMean     = cms.double(35.)
+)
+met   = pfMet.clone( type = cms.string("Calo") )
+tcMet = pfMet.clone( type = cms.string("plain") )
+corMetGlobalMuons = pfMet.clone( type = cms.string("Calo") )
+
+syntheticEvents = cms.Sequence(offlineBeamSpot
+                               *offlinePrimaryVertices
+                               *muons
+                               *gsfElectrons
+                               *eidRobustLoose
+                               *simpleEleId70cIso
+                               *ak5PFJets
+                               *ak5CaloJets
+                               *trackCountingHighEffBJetTags
+                               *trackCountingHighPurBJetTags
+                               *simpleSecondaryVertexHighEffBJetTags
+                               *combinedSecondaryVertexBJetTags
+                               *pfMet
+                               *met
+                               *tcMet
+                               *corMetGlobalMuons
+                               )
+
+## emulated HLT paths; the decision follows the offline objects
+hltMu9 = cms.EDFilter("SyntheticTriggerFilter",
+    src        = cms.InputTag("muons"),
+    ptMin      = cms.double(9.),
+    minN       = cms.uint32(1),
+    efficiency = cms.double(0.9)
+)
+hltMu11           = hltMu9.clone( ptMin = cms.double(11.) )
+hltMu15           = hltMu9.clone( ptMin = cms.double(15.) )
+hltIsoMu24        = hltMu9.clone( ptMin = cms.double(24.), efficiency = cms.double(0.8) )
+hltDoubleMu3      = hltMu9.clone( ptMin = cms.double( 3.), minN = cms.uint32(2) )
+hltEle10          = hltMu9.clone( src = cms.InputTag("gsfElectrons"), ptMin = cms.double(10.) )
+hltEle15          = hltEle10.clone( ptMin = cms.double(15.) )
+hltEle15CaloEleId = hltEle10.clone( ptMin = cms.double(15.), efficiency = cms.double(0.8) )
+hltDoubleEle10    = hltEle10.clone( minN = cms.uint32(2) )
+hltQuadJet30      = hltMu9.clone( src = cms.InputTag("ak5CaloJets"), ptMin = cms.double(30.), minN = cms.uint32(4) )
+
+HLT_Mu9                    = cms.Path(syntheticEvents*hltMu9)
+HLT_Mu11                   = cms.Path(syntheticEvents*hltMu11)
+HLT_Mu15_v2                = cms.Path(syntheticEvents*hltMu15)
+HLT_IsoMu24_eta2p1_v12     = cms.Path(syntheticEvents*hltIsoMu24)
+HLT_DoubleMu3              = cms.Path(syntheticEvents*hltDoubleMu3)
+HLT_Ele10_LW_L1R           = cms.Path(syntheticEvents*hltEle10)
+HLT_Ele15_LW_L1R           = cms.Path(syntheticEvents*hltEle15)
+HLT_Ele15_SW_CaloEleId_L1R = cms.Path(syntheticEvents*hltEle15CaloEleId)
+HLT_DoubleEle10            = cms.Path(syntheticEvents*hltDoubleEle10)
+HLT_QuadJet30              = cms.Path(syntheticEvents*hltQuadJet30)
+
+def setPileup(process, scenario):
+    """set the mean number of pileup interactions from a scenario
+    in pileupScenarios or from a number"""
+    mean = pileupScenarios[scenario] if scenario in pileupScenarios else float(scenario)
+    process.offlinePrimaryVertices.pileup = mean
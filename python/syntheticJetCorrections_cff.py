@@ -0,0 +1,24 @@
+import FWCore.ParameterSet.Config as cms
+
+## --------------------------------------------------------------------
+## Stand-in jet energy corrections for the test of the DQM/Physics
+## modules on synthetic events (see syntheticEvents_cff.py), which do
+## not need a GlobalTag. The correctors are provided under the labels
+## of the correction services used by the DQM modules. The ESProducer
+## is part of the test plugin library of the package (test/BuildFile.xml).
+## --------------------------------------------------------------------
+
+jetCorrectionsRecordSource = cms.ESSource("EmptyESSource",
+    recordName = cms.string("JetCorrectionsRecord"),
+    iovIsRunNotTime = cms.bool(True),
+    firstValid = cms.vuint32(1)
+)
+
+ak5PFL2L3 = cms.ESProducer("SyntheticJetCorrectionESProducer",
+    scale  = cms.double(1.10),
+    offset = cms.double(0.)
+)
+ak5CaloL2L3 = ak5PFL2L3.clone( scale = cms.double(1.30) )
+## L1FastJet: average pileup offset subtracted before the scaling
+ak5PFL1FastL2L3 = ak5PFL2L3.clone( offset = cms.double(1.5) )
+ak5CaloL1FastL2L3 = ak5CaloL2L3.clone( offset = cms.double(1.0) )
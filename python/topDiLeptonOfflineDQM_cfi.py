@@ -22,7 +22,14 @@ topDiLeptonOfflineDQM = cms.EDAnalyzer("TopDiLeptonOfflineDQM",
     ),
     ## [optional] : when omitted the verbosity level is set to STANDARD
     monitoring = cms.PSet(
-      verbosity = cms.string("DEBUG")
+      verbosity = cms.string("DEBUG"),
+      ## [optional] : modifications of the compiled-in histogram definitions,
+      ## selected by key; title, verbosity (level from which on the histogram
+      ## is booked) and binning may be given, unknown keys are an error
+      #histograms = cms.VPSet(
+      #  cms.PSet(key = cms.string("invMass_"), nBinsX = cms.int32(160)),
+      #  cms.PSet(key = cms.string("diMuonLogger_"), verbosity = cms.string("VERBOSE"))
+      #)
     ),
     ## [optional] : when omitted all monitoring plots for electrons
     ## will be filled w/o extras
@@ -90,6 +97,29 @@ topDiLeptonOfflineDQM = cms.EDAnalyzer("TopDiLeptonOfflineDQM",
     #)    
   ),
                                   
+  ## ------------------------------------------------------
+  ## TIMING
+  ##
+  ## [optional] : when omitted no timing and rejection
+  ## monitoring of the selection steps is done; the CPU
+  ## time is sampled every Nth event
+  ##
+  #timing = cms.PSet(
+  #  sampling = cms.uint32(100)
+  #),
+  ## ------------------------------------------------------
+  ## EVENT EXPORT
+  ##
+  ## [optional] : when omitted no events are exported; other-
+  ## wise the events passing the last selection step are
+  ## written into a flat TTree (one branch per quantity) in
+  ## the given file; compression in the ROOT convention
+  ## (algorithm*100+level) [optional, default: 1]
+  ##
+  #eventExport = cms.PSet(
+  #  fileName    = cms.string("topDiLeptonEvents.root"),
+  #  compression = cms.int32(1)
+  #),
   ## ------------------------------------------------------
   ## PRESELECTION
   ##
@@ -22,7 +22,26 @@ topSingleLeptonDQM = cms.EDAnalyzer("TopSingleLeptonDQM",
     ),
     ## [optional] : when omitted the verbosity level is set to STANDARD
     monitoring = cms.PSet(
-      verbosity = cms.string("DEBUG")
+      verbosity = cms.string("DEBUG"),
+      ## [optional] : when omitted or False all histograms are booked at
+      ## construction; when True they are booked when filled first
+      #lazyBooking = cms.bool(True),
+      ## [optional] : memory budget in kB for lazily booked histograms of
+      ## the module; when omitted or <=0 there is no limit
+      #memoryBudget = cms.double(2048.),
+      ## [optional] : batch size for the buffered fills of the b-tag
+      ## discriminators; when omitted set to 128 (<=1: no batching)
+      #fillBatchSize = cms.untracked.uint32(128),
+      ## [optional] : histograms to be kept in sparse form until the
+      ## end of the run (for large, mostly empty histograms)
+      #sparseHistograms = cms.vstring("RunNumb_", "muonDelXY_"),
+      ## [optional] : modifications of the compiled-in histogram definitions,
+      ## selected by key; title, verbosity (level from which on the histogram
+      ## is booked) and binning may be given, unknown keys are an error
+      #histograms = cms.VPSet(
+      #  cms.PSet(key = cms.string("muonPt_"), nBinsX = cms.int32(100), highX = cms.double(500.)),
+      #  cms.PSet(key = cms.string("jetBCVtx_"), verbosity = cms.string("STANDARD"))
+      #)
     ),
     ## [optional] : when omitted all monitoring plots for primary vertices
     ## will be filled w/o extras
@@ -88,6 +107,68 @@ topSingleLeptonDQM = cms.EDAnalyzer("TopSingleLeptonDQM",
     )                                            
   ),                                  
   ## ------------------------------------------------------
+  ## TIMING
+  ##
+  ## [optional] : when omitted no timing and rejection
+  ## monitoring of the selection steps is done; the CPU
+  ## time is sampled every Nth event
+  ##
+  #timing = cms.PSet(
+  #  sampling = cms.uint32(100)
+  #),
+  ## ------------------------------------------------------
+  ## SAMPLING
+  ##
+  ## [optional] : when omitted the kinematic distributions
+  ## are filled for every event; otherwise only for every
+  ## Nth event (prescale) and as long as the CPU time of
+  ## the sampled events stays within the budget [ms] per
+  ## event (timeBudget, <=0 means no budget). Multiplici-
+  ## ties and trigger monitoring are filled always; the
+  ## weight of the sampled events is given in the folder
+  ## Sampling
+  ##
+  #sampling = cms.PSet(
+  #  prescale   = cms.uint32(10),
+  #  timeBudget = cms.double(0.)
+  #),
+  ## ------------------------------------------------------
+  ## TRENDS
+  ##
+  ## [optional] : when omitted no trends are booked; other-
+  ## wise the number of events passing each selection step
+  ## is monitored per lumi section in the folder Trends
+  ## (one bin per lumi section for the first N lumis)
+  ##
+  #trends = cms.PSet(
+  #  lumis = cms.uint32(500)
+  #),
+  ## ------------------------------------------------------
+  ## EVENT EXPORT
+  ##
+  ## [optional] : when omitted no events are exported; other-
+  ## wise the events passing the last selection step are
+  ## written into a flat TTree (one branch per quantity) in
+  ## the given file; compression in the ROOT convention
+  ## (algorithm*100+level) [optional, default: 1]
+  ##
+  #eventExport = cms.PSet(
+  #  fileName    = cms.string("topSingleLeptonEvents.root"),
+  #  compression = cms.int32(1)
+  #),
+  ## ------------------------------------------------------
+  ## EVENT INDEX
+  ##
+  ## [optional] : when omitted no index is written; other-
+  ## wise the event numbers of the events passing each
+  ## selection step are written per lumi section into the
+  ## given file (one file per module), to be queried with
+  ## EventIndexQuery
+  ##
+  #eventIndex = cms.PSet(
+  #  fileName = cms.string("topSingleLeptonDQM.evtidx")
+  #),
+  ## ------------------------------------------------------
   ## PRESELECTION
   ##
   ## setup of the event preselection, which will not
@@ -0,0 +1,153 @@
+#include "DQM/Physics/src/AllocationCounter.h"
+
+#include <cmath>
+#include <malloc.h>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/ParameterSet/interface/Registry.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "DQMServices/Core/interface/DQMStore.h"
+
+namespace {
+
+  /// counters, which are updated by the malloc hook
+  unsigned long long allocations=0, bytes=0;
+  /// the hook that was installed before
+  void* (*previousHook)(size_t, const void*)=0;
+
+  /// malloc hook: the original hook is restored for the
+  /// call to malloc, such that it does not recurse; neither
+  /// the hook nor the counters are thread-safe
+  void* countingHook(size_t size, const void* caller)
+  {
+    __malloc_hook=previousHook;
+    void* result=malloc(size);
+    ++allocations; bytes+=size;
+    previousHook=__malloc_hook;
+    __malloc_hook=countingHook;
+    return result;
+  }
+
+  /// bin edges for the counts per event: one bin for
+  /// 0, then nBins logarithmic bins between 1 and max
+  std::vector<double> countEdges(unsigned int nBins, double max)
+  {
+    std::vector<double> edges(1, 0.);
+    for(unsigned int idx=0; idx<=nBins; ++idx){ edges.push_back(std::pow(max, double(idx)/nBins)); }
+    return edges;
+  }
+
+}
+
+AllocationCounter::AllocationCounter(const edm::ParameterSet& cfg, edm::ActivityRegistry& registry):
+  events_(0), startAllocations_(0), startBytes_(0),
+  monitorElements_(cfg.getUntrackedParameter<bool>("monitorElements", false)),
+  directory_(cfg.getUntrackedParameter<std::string>("directory", "Physics/Allocations")),
+  allocationsAxis_(countEdges(60, 1.e6)), bytesAxis_(countEdges(90, 1.e9))
+{
+  std::vector<std::string> modules=cfg.getUntrackedParameter<std::vector<std::string> >("modules", std::vector<std::string>());
+  modules_.insert(modules.begin(), modules.end());
+
+  registry.watchPreModuleBeginJob(this, &AllocationCounter::preModuleBeginJob);
+  registry.watchPostBeginJob(this, &AllocationCounter::postBeginJob);
+  registry.watchPreProcessEvent(this, &AllocationCounter::preProcessEvent);
+  registry.watchPreModule(this, &AllocationCounter::preModule);
+  registry.watchPostModule(this, &AllocationCounter::postModule);
+  registry.watchPostEndJob(this, &AllocationCounter::postEndJob);
+}
+
+AllocationCounter::~AllocationCounter()
+{
+  if( __malloc_hook==countingHook ) __malloc_hook=previousHook;
+}
+
+void
+AllocationCounter::preModuleBeginJob(const edm::ModuleDescription& module)
+{
+  if( !modules_.empty() && !modules_.count(module.moduleLabel()) ) return;
+  counts_[module.moduleLabel()];
+}
+
+void
+AllocationCounter::postBeginJob()
+{
+  // the malloc hook counts the allocations of all threads and swaps
+  // the global hook on each call; multi-threaded jobs are refused
+  const edm::ParameterSet& process=edm::getProcessParameterSet();
+  if( process.existsAs<edm::ParameterSet>("options", false) ){
+    edm::ParameterSet options=process.getUntrackedParameter<edm::ParameterSet>("options");
+    unsigned int nThreads=options.getUntrackedParameter<unsigned int>("numberOfThreads", 1);
+    if( nThreads>1 ){
+      throw cms::Exception("Configuration") << "AllocationCounter: the counting is single-thread only, but " << nThreads << " threads are configured\n";
+    }
+  }
+  previousHook=__malloc_hook;
+  __malloc_hook=countingHook;
+
+  if( !monitorElements_ ) return;
+  for(std::map<std::string, Count>::iterator count=counts_.begin(); count!=counts_.end(); ++count){
+    book(count->first, count->second);
+  }
+}
+
+void
+AllocationCounter::preProcessEvent(const edm::EventID& id, const edm::Timestamp& time)
+{
+  ++events_;
+}
+
+void
+AllocationCounter::preModule(const edm::ModuleDescription& module)
+{
+  startAllocations_=allocations; startBytes_=bytes;
+}
+
+void
+AllocationCounter::postModule(const edm::ModuleDescription& module)
+{
+  unsigned long long moduleAllocations=allocations-startAllocations_, moduleBytes=bytes-startBytes_;
+  // the counts of all modules to be counted have been added in the beginJob
+  std::map<std::string, Count>::iterator entry=counts_.find(module.moduleLabel());
+  if( entry==counts_.end() ) return;
+  Count& count=entry->second;
+  count.allocations+=moduleAllocations; count.bytes+=moduleBytes;
+  if( moduleAllocations>count.maxAllocations ) count.maxAllocations=moduleAllocations;
+  if( moduleBytes>count.maxBytes ) count.maxBytes=moduleBytes;
+  if( !monitorElements_ ) return;
+  allocationsAxis_.fill(count.allocationsME, moduleAllocations);
+  bytesAxis_.fill(count.bytesME, moduleBytes);
+}
+
+void
+AllocationCounter::book(const std::string& label, Count& count)
+{
+  DQMStore* store=edm::Service<DQMStore>().operator->();
+  store->setCurrentFolder(directory_);
+  count.allocationsME=store->book1D(label+"Allocations", "Allocations per event ("+label+")", allocationsAxis_.nBins(), allocationsAxis_.edges());
+  count.allocationsME->setAxisTitle("allocations/event", 1);
+  count.bytesME=store->book1D(label+"Bytes", "Allocated bytes per event ("+label+")", bytesAxis_.nBins(), bytesAxis_.edges());
+  count.bytesME->setAxisTitle("bytes/event", 1);
+}
+
+void
+AllocationCounter::postEndJob()
+{
+  double events=(events_>0) ? events_ : 1.;
+  for(std::map<std::string, Count>::const_iterator count=counts_.begin(); count!=counts_.end(); ++count){
+    edm::LogVerbatim("AllocationReport")
+      << "AllocationReport " << count->first << " " << count->second.allocations/events << " " << count->second.bytes/events
+      << " " << count->second.maxAllocations << " " << count->second.maxBytes;
+  }
+  // peak resident set size of the job (high water mark in kB)
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while( std::getline(status, line) ){
+    if( line.compare(0, 6, "VmHWM:")!=0 ) continue;
+    std::istringstream value(line.substr(6)); double kB=0.; value >> kB;
+    edm::LogVerbatim("AllocationReport") << "PeakRSSReport " << kB/1024.;
+  }
+}
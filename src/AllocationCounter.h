@@ -0,0 +1,101 @@
+#ifndef ALLOCATIONCOUNTER
+#define ALLOCATIONCOUNTER
+
+#include <set>
+#include <map>
+#include <string>
+
+#include "DataFormats/Provenance/interface/EventID.h"
+#include "DataFormats/Provenance/interface/Timestamp.h"
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+#include "DQM/Physics/interface/LogAxis.h"
+
+/**
+   \class   AllocationCounter AllocationCounter.h "DQM/Physics/src/AllocationCounter.h"
+
+   \brief   Service to count the heap allocations of each module per event.
+
+   Counts the calls to malloc (and thus to operator new) and the number of allocated
+   bytes between the begin and the end of each module call within the event loop via
+   the malloc hooks of glibc. At the end of the job one line per module of the form
+
+   AllocationReport <module label> <allocations/event> <bytes/event> <max allocations> <max bytes>
+
+   is written to the log (category AllocationReport), with the mean and the maximum
+   per event, followed by the peak resident set size of the job in MB (PeakRSSReport
+   <MB>), to be parsed e.g. by the throughput benchmark test/dqmPhysicsBenchmark.py.
+   Optional parameters (all untracked):
+
+    - modules         : labels of the modules to be counted (default: all)
+    - monitorElements : publish the distributions of the allocations and of the bytes
+                        per event of each module as MonitorElements <label>Allocations
+                        and <label>Bytes (logarithmic binning, first bin for 0) in the
+                        directory _directory_ (default: false)
+    - directory       : directory of the MonitorElements (default: Physics/Allocations)
+
+   The modules to be counted are taken from the module descriptions at their beginJob;
+   their MonitorElements are booked and the malloc hook is installed at the end of the
+   beginJob, such that the event loop neither books nor adds entries to the counts. The
+   counting adds a small overhead to each allocation and is meant for test jobs only.
+   The service is single-thread only: the malloc hook of glibc (deprecated, removed in
+   glibc 2.34) is global, it is swapped on each call and the counters are not atomic.
+   The job is stopped with a Configuration exception at the end of the beginJob if more
+   than one thread is configured (process.options.numberOfThreads).
+*/
+
+class AllocationCounter {
+ public:
+  /// default constructor
+  AllocationCounter(const edm::ParameterSet& cfg, edm::ActivityRegistry& registry);
+  /// default destructor
+  ~AllocationCounter();
+
+  /// add the counts of a module to be counted
+  void preModuleBeginJob(const edm::ModuleDescription& module);
+  /// refuse multi-threaded jobs, install the malloc hook and
+  /// book the MonitorElements of all modules to be counted
+  void postBeginJob();
+  /// count the events
+  void preProcessEvent(const edm::EventID& id, const edm::Timestamp& time);
+  /// start counting for a module
+  void preModule(const edm::ModuleDescription& module);
+  /// stop counting for a module
+  void postModule(const edm::ModuleDescription& module);
+  /// write the report
+  void postEndJob();
+
+ private:
+  /// allocations and bytes of one module
+  struct Count {
+    Count() : allocations(0), bytes(0), maxAllocations(0), maxBytes(0), allocationsME(0), bytesME(0) {};
+    unsigned long long allocations, bytes;
+    unsigned long long maxAllocations, maxBytes;
+    /// distributions per event (monitorElements only)
+    MonitorElement *allocationsME, *bytesME;
+  };
+
+ private:
+  /// book the MonitorElements of module _label_
+  void book(const std::string& label, Count& count);
+
+ private:
+  /// number of events
+  unsigned long events_;
+  /// counters at the start of the current module
+  unsigned long long startAllocations_, startBytes_;
+  /// allocations and bytes per module label
+  std::map<std::string, Count> counts_;
+  /// labels of the modules to be counted (all if empty)
+  std::set<std::string> modules_;
+  /// publish the distributions as MonitorElements
+  bool monitorElements_;
+  /// directory of the MonitorElements
+  std::string directory_;
+  /// binning of the allocations and of the bytes per event
+  LogAxis allocationsAxis_, bytesAxis_;
+};
+
+#endif
@@ -34,6 +34,10 @@ BPhysicsOniaDQM::BPhysicsOniaDQM(const ParameterSet& parameters) {
   // Muon Collection Label
   theMuonCollectionLabel = parameters.getParameter<InputTag>("MuonCollection");
   vertex = parameters.getParameter<InputTag>("vertex");
+  // Batch size for the dimuon mass fills (optional, <=1 means no batching)
+  fillBatchSize = parameters.getUntrackedParameter<unsigned int>("fillBatchSize", 128);
+  // Number of lumi sections with one bin in the yield trends (optional, 0 means no trends)
+  trendLumis = parameters.getUntrackedParameter<unsigned int>("trendLumis", 0);
 
   global_background = NULL;
   diMuonMass_global = NULL;
@@ -52,12 +56,15 @@ BPhysicsOniaDQM::BPhysicsOniaDQM(const ParameterSet& parameters) {
   trkSigNoCut = NULL;
   trkBkgNoCut = NULL;
 
-  //   JPsiGlbYdLumi = NULL;
-  //   JPsiStaYdLumi = NULL;
-  //   JPsiTrkYdLumi = NULL;
+  trends = NULL;
+
+  globalHistograms = false;
+  standaloneHistograms = false;
+  trackerHistograms = false;
 }
 
 BPhysicsOniaDQM::~BPhysicsOniaDQM() { 
+  delete trends;
 }
 
 void BPhysicsOniaDQM::beginJob() {
@@ -85,6 +92,22 @@ void BPhysicsOniaDQM::beginJob() {
     trkSigCut = theDbe->book1D("trkSigCut", "Opposite-sign trk-trk dimuon mass", 650, 0, 130);
     trkSigNoCut = theDbe->book1D("trkSigNoCut", "Opposite-sign trk-trk dimuon mass (no cut)", 650, 0, 130);
     trkBkgNoCut = theDbe->book1D("trkBkgNoCutt", "Same-sign trk-trk dimuon mass (no cut)", 650, 0, 130);
+
+    globalHistograms = diMuonMass_global || global_background || glbSigNoCut || glbBkgNoCut;
+    standaloneHistograms = diMuonMass_standalone || standalone_background || staSigNoCut || staBkgNoCut;
+    trackerHistograms = diMuonMass_tracker || tracker_background || trkSigNoCut || trkBkgNoCut;
+
+    diMuonMass_globalBuffer.attach(diMuonMass_global, fillBatchSize);
+    global_backgroundBuffer.attach(global_background, fillBatchSize);
+    glbSigNoCutBuffer.attach(glbSigNoCut, fillBatchSize);
+    glbBkgNoCutBuffer.attach(glbBkgNoCut, fillBatchSize);
+
+    if (trendLumis>0) {
+      trends = new LumiTrends("Physics/BPhysics/", trendLumis);
+      jpsiGlbTrend = trends->add("JPsiGlbYdLumi", "JPsi yield from global-global dimuon");
+      jpsiStaTrend = trends->add("JPsiStaYdLumi", "JPsi yield from standalone-standalone dimuon");
+      jpsiTrkTrend = trends->add("JPsiTrkYdLumi", "JPsi yield from tracker-tracker dimuon");
+    }
   }
 
 }
@@ -92,6 +115,7 @@ void BPhysicsOniaDQM::beginJob() {
 void BPhysicsOniaDQM::analyze(const Event& iEvent, const EventSetup& iSetup) {
 
   LogTrace(metname)<<"[BPhysicsOniaDQM] Analysis of event # ";
+  if (trends!=NULL) trends->event();
   
   // Take the STA muon container
   Handle<MuonCollection> muons;
@@ -109,26 +133,47 @@ void BPhysicsOniaDQM::analyze(const Event& iEvent, const EventSetup& iSetup) {
   }
 
   if(muons.isValid()){
+    // compute the dimuon masses for all pairs of each track type at once; only
+    // for track types with booked histograms and at least two muons in the event
+    unsigned int nGlobal = 0, nStandalone = 0, nTracker = 0;
+    for (MuonCollection::const_iterator recoMu = muons->begin(); recoMu!=muons->end(); ++recoMu){
+      if (recoMu->isGlobalMuon()) nGlobal++;
+      if (recoMu->isStandAloneMuon()) nStandalone++;
+      if (recoMu->isTrackerMuon()) nTracker++;
+    }
+    bool global = globalHistograms && nGlobal>1;
+    bool standalone = standaloneHistograms && nStandalone>1;
+    bool tracker = trackerHistograms && nTracker>1;
+    globalPairs.clear(); standalonePairs.clear(); trackerPairs.clear();
+    for (MuonCollection::const_iterator recoMu = muons->begin(); recoMu!=muons->end(); ++recoMu){
+      if (global)     addMuon(globalPairs,     recoMu->isGlobalMuon()     ? recoMu->globalTrack() : reco::TrackRef(), recoMu->charge());
+      if (standalone) addMuon(standalonePairs, recoMu->isStandAloneMuon() ? recoMu->outerTrack()  : reco::TrackRef(), recoMu->charge());
+      if (tracker)    addMuon(trackerPairs,    recoMu->isTrackerMuon()    ? recoMu->innerTrack()  : reco::TrackRef(), recoMu->charge());
+    }
+    if (global) globalPairs.compute();
+    if (standalone) standalonePairs.compute();
+    if (tracker) trackerPairs.compute();
+
     for (MuonCollection::const_iterator recoMu1 = muons->begin(); recoMu1!=muons->end(); ++recoMu1){
+      unsigned int idx1 = recoMu1 - muons->begin();
 
       // only loop over the remaining muons if recoMu1 is one of the following
       if(recoMu1->isGlobalMuon() || recoMu1->isTrackerMuon() || recoMu1->isStandAloneMuon()){
         for (MuonCollection::const_iterator recoMu2 = recoMu1+1; recoMu2!=muons->end(); ++recoMu2){
+          unsigned int idx2 = recoMu2 - muons->begin();
 
           // fill the relevant histograms if recoMu2 satisfies one of the following
-          if (recoMu1->isGlobalMuon() && recoMu2->isGlobalMuon()){
-            math::XYZVector vec1 = recoMu1->globalTrack()->momentum();
-            math::XYZVector vec2 = recoMu2->globalTrack()->momentum();
-            float massJPsi = computeMass(vec1,vec2);
+          if (global && recoMu1->isGlobalMuon() && recoMu2->isGlobalMuon()){
+            float massJPsi = computeMass(globalPairs,idx1,idx2);
 
             // if opposite charges, fill glbSig, else fill glbBkg
             if (((*recoMu1).charge()*(*recoMu2).charge())<0) {
               if(diMuonMass_global!=NULL){  // BPhysicsOniaDQM original one
-                diMuonMass_global->Fill(massJPsi);
+                diMuonMass_globalBuffer.fill(massJPsi);
               }
 
               if(glbSigNoCut!=NULL){
-                glbSigNoCut->Fill(massJPsi);
+                glbSigNoCutBuffer.fill(massJPsi);
                 if (selGlobalMuon(*recoMu1) && selGlobalMuon(*recoMu2)) {
                   if (glbSigCut!=NULL) glbSigCut->Fill(massJPsi);
                   if (massJPsi >= 3.0 && massJPsi <= 3.2) jpsiGlbSigPerLS++;
@@ -136,21 +181,19 @@ void BPhysicsOniaDQM::analyze(const Event& iEvent, const EventSetup& iSetup) {
               }
             } else {
               if(global_background!=NULL){  // BPhysicsOniaDQM original one
-                global_background->Fill (massJPsi);
+                global_backgroundBuffer.fill(massJPsi);
               }
 
               if(glbBkgNoCut!=NULL){
-                glbBkgNoCut->Fill(massJPsi);
+                glbBkgNoCutBuffer.fill(massJPsi);
               }
             }
           }
           
-          if(recoMu1->isStandAloneMuon() && recoMu2->isStandAloneMuon() &&
+          if(standalone && recoMu1->isStandAloneMuon() && recoMu2->isStandAloneMuon() &&
             fabs(recoMu1->outerTrack()->d0()) < 5 && fabs(recoMu1->outerTrack()->dz()) < 30 &&
             fabs(recoMu2->outerTrack()->d0()) < 5 && fabs(recoMu2->outerTrack()->dz()) < 30){
-            math::XYZVector vec1 = recoMu1->outerTrack()->momentum();
-            math::XYZVector vec2 = recoMu2->outerTrack()->momentum();
-            float massJPsi = computeMass(vec1,vec2);
+            float massJPsi = computeMass(standalonePairs,idx1,idx2);
 
             // if opposite charges, fill staSig, else fill staBkg
             if (((*recoMu1).charge()*(*recoMu2).charge())<0) {
@@ -176,12 +219,10 @@ void BPhysicsOniaDQM::analyze(const Event& iEvent, const EventSetup& iSetup) {
             }
           }
 
-          if(recoMu1->isTrackerMuon() && recoMu2->isTrackerMuon() &&
+          if(tracker && recoMu1->isTrackerMuon() && recoMu2->isTrackerMuon() &&
             muon::isGoodMuon(*recoMu1, muon::TrackerMuonArbitrated) &&
             muon::isGoodMuon(*recoMu2, muon::TrackerMuonArbitrated)){
-            math::XYZVector vec1 = recoMu1->innerTrack()->momentum();
-            math::XYZVector vec2 = recoMu2->innerTrack()->momentum();
-            float massJPsi = computeMass(vec1,vec2);
+            float massJPsi = computeMass(trackerPairs,idx1,idx2);
 
             // if opposite charges, fill trkSig, else fill trkBkg
             if (((*recoMu1).charge()*(*recoMu2).charge())<0) {
@@ -216,6 +257,7 @@ void BPhysicsOniaDQM::analyze(const Event& iEvent, const EventSetup& iSetup) {
 
 void BPhysicsOniaDQM::endJob(void) {
   LogTrace(metname)<<"[BPhysicsOniaDQM] EndJob";
+  flushBuffers();
 }
 
 void BPhysicsOniaDQM::beginLuminosityBlock(const edm::LuminosityBlock &lumiBlock, const edm::EventSetup &iSetup)
@@ -229,87 +271,55 @@ void BPhysicsOniaDQM::beginLuminosityBlock(const edm::LuminosityBlock &lumiBlock
 
 void BPhysicsOniaDQM::endLuminosityBlock(const edm::LuminosityBlock &lumiBlock, const edm::EventSetup &iSetup)
 {
-  LogTrace(metname)<<"[BPhysicsOniaDQM] Start of a LuminosityBlock";
+  LogTrace(metname)<<"[BPhysicsOniaDQM] End of a LuminosityBlock";
 
-  edm::Handle<LumiSummary> lumiSummary;
-  lumiBlock.getByLabel("lumiProducer",lumiSummary);
+  flushBuffers();
 
-  int LBlockNum = lumiBlock.id().luminosityBlock();
-  
-  jpsiGlbSig.insert( pair<int,int>(LBlockNum, jpsiGlbSigPerLS) );
-  jpsiStaSig.insert( pair<int,int>(LBlockNum, jpsiStaSigPerLS) );
-  jpsiTrkSig.insert( pair<int,int>(LBlockNum, jpsiTrkSigPerLS) );
-//  cout << "lumi: " << LBlockNum << "\t" << jpsiGlbSig[LBlockNum] << "\t" << jpsiStaSig[LBlockNum] << "\t" << jpsiTrkSig[LBlockNum] << endl;
-
-  if (jpsiGlbSig.size()%5 != 0) return;
-
-  theDbe->setCurrentFolder("Physics/BPhysics");
-//   if(JPsiGlbYdLumi!=NULL) {
-//     theDbe->removeElement("JPsiGlbYdLumi");   // Remove histograms from previous run
-//     theDbe->removeElement("JPsiStaYdLumi");
-//     theDbe->removeElement("JPsiTrkYdLumi");
-//   }
-
-//   int xmin = (*jpsiGlbSig.begin()).first;
-//   int xmax = (*jpsiGlbSig.rbegin()).first;
-//   int nx   = (xmax - xmin + 1)/5 + 1; // Merge 5 lumisections into 1 bin
-// //  cout << "x-axis " << xmin << " " << xmax << endl;
-
-//   JPsiGlbYdLumi = theDbe->book1D("JPsiGlbYdLumi", "JPsi yield from global-global dimuon", nx, xmin, xmax);
-//   JPsiStaYdLumi = theDbe->book1D("JPsiStaYdLumi", "JPsi yield from standalone-standalone dimuon", nx, xmin, xmax);
-//   JPsiTrkYdLumi = theDbe->book1D("JPsiTrkYdLumi", "JPsi yield from tracker-tracker dimuon", nx, xmin, xmax);
-
-//   map<int,int>::iterator glb;
-//   map<int,int>::iterator sta;
-//   map<int,int>::iterator trk;
-//   for (glb = jpsiGlbSig.begin(); glb != jpsiGlbSig.end(); ++glb)
-//   {
-//     int bin = ((*glb).first - xmin + 1)/5 + 1;  //X-axis bin #
-//     sta = jpsiStaSig.find((*glb).first);
-//     trk = jpsiTrkSig.find((*glb).first);
-//     JPsiGlbYdLumi->setBinContent(bin,JPsiGlbYdLumi->getBinContent(bin)+(*glb).second);
-//     JPsiStaYdLumi->setBinContent(bin,JPsiStaYdLumi->getBinContent(bin)+(*sta).second);
-//     JPsiTrkYdLumi->setBinContent(bin,JPsiTrkYdLumi->getBinContent(bin)+(*trk).second);
-// //    cout << "glb: " << bin << "\t" << (*glb).first << "\t" << (*glb).second << endl;
-// //    cout << "sta: " << bin << "\t" << (*sta).first << "\t" << (*sta).second << endl;
-// //    cout << "trk: " << bin << "\t" << (*trk).first << "\t" << (*trk).second << endl;
-//   }
+  if (trends!=NULL) {
+    trends->count(jpsiGlbTrend, jpsiGlbSigPerLS);
+    trends->count(jpsiStaTrend, jpsiStaSigPerLS);
+    trends->count(jpsiTrkTrend, jpsiTrkSigPerLS);
+    trends->append(lumiBlock.id().luminosityBlock());
+  }
 }
 
 void BPhysicsOniaDQM::beginRun(const edm::Run& iRun, const edm::EventSetup& iSetup)
 {
   LogTrace(metname)<<"[BPhysicsOniaDQM] Start of a Run";
+  if (trends!=NULL) trends->beginRun();
 }
 
 void BPhysicsOniaDQM::endRun(const edm::Run& iRun, const edm::EventSetup& iSetup)
 {
   LogTrace(metname)<<"[BPhysicsOniaDQM] End of a Run";
-  
-  if (!jpsiGlbSig.empty()) {
-    jpsiGlbSig.clear();
-    jpsiStaSig.clear();
-    jpsiTrkSig.clear();
-  }
+  flushBuffers();
+}
+
+void BPhysicsOniaDQM::flushBuffers()
+{
+  diMuonMass_globalBuffer.flush();
+  global_backgroundBuffer.flush();
+  glbSigNoCutBuffer.flush();
+  glbBkgNoCutBuffer.flush();
 }
 
-float BPhysicsOniaDQM::computeMass(const math::XYZVector &vec1,const math::XYZVector &vec2){
+void BPhysicsOniaDQM::addMuon(DileptonPairs &pairs, const reco::TrackRef &track, int charge){
   // mass of muon
-  float massMu = 0.10566;
-  float eMu1 = -999;
-  if(massMu*massMu + vec1.Mag2()>0)
-    eMu1 = sqrt(massMu*massMu + vec1.Mag2());
-  float eMu2 = -999;
-  if(massMu*massMu + vec2.Mag2()>0)
-    eMu2 = sqrt(massMu*massMu + vec2.Mag2());
-
-  float pJPsi = -999;
-  if((vec1+vec2).Mag2()>0)
-    pJPsi = sqrt((vec1+vec2).Mag2());
-  float eJPsi = eMu1 + eMu2;
-
-  float massJPsi = -999;
-  if((eJPsi*eJPsi - pJPsi*pJPsi) > 0)
-    massJPsi = sqrt(eJPsi*eJPsi - pJPsi*pJPsi);
+  double massMu = 0.10566;
+  // muons without the given track are added with null four
+  // momentum; their pairs are never used
+  if(track.isNull()){
+    pairs.add(0.,0.,0.,0.,charge);
+    return;
+  }
+  const math::XYZVector &vec = track->momentum();
+  pairs.add(vec.x(),vec.y(),vec.z(),sqrt(massMu*massMu + vec.Mag2()),charge);
+}
+
+float BPhysicsOniaDQM::computeMass(const DileptonPairs &pairs, unsigned int idx1, unsigned int idx2){
+  float massJPsi = pairs.mass(idx1,idx2);
+  if(!(massJPsi > 0))
+    massJPsi = -999;
  
  return massJPsi;
 }
@@ -17,6 +17,9 @@
 #include "FWCore/Utilities/interface/InputTag.h"
 #include "FWCore/Framework/interface/LuminosityBlock.h"
 #include "DataFormats/Luminosity/interface/LumiSummary.h"
+#include "DQM/Physics/interface/FillBuffer.h"
+#include "DQM/Physics/interface/LumiTrends.h"
+#include "DQM/Physics/interface/DileptonPairs.h"
 
 #include <string>
 #include <cmath>
@@ -47,7 +50,8 @@ class BPhysicsOniaDQM : public edm::EDAnalyzer {
 
  private:
 
-  float computeMass(const math::XYZVector &vec1,const math::XYZVector &vec2);
+  void addMuon(DileptonPairs &pairs, const reco::TrackRef &track, int charge);
+  float computeMass(const DileptonPairs &pairs, unsigned int idx1, unsigned int idx2);
   bool isMuonInAccept(const reco::Muon &recoMu);
   bool selGlobalMuon(const reco::Muon &recoMu);
   bool selTrackerMuon(const reco::Muon &recoMu);
@@ -81,19 +85,38 @@ class BPhysicsOniaDQM : public edm::EDAnalyzer {
   MonitorElement* trkSigNoCut;
   MonitorElement* trkBkgNoCut;
 
-  //   MonitorElement* JPsiGlbYdLumi;
-  //   MonitorElement* JPsiStaYdLumi;
-  //   MonitorElement* JPsiTrkYdLumi;
+  // Batched fills for the global-global dimuon mass histograms
+  // (filled for every muon pair); flushed at the end of each 
+  // luminosity block, run and job
+  unsigned int fillBatchSize;
+  FillBuffer diMuonMass_globalBuffer;
+  FillBuffer global_backgroundBuffer;
+  FillBuffer glbSigNoCutBuffer;
+  FillBuffer glbBkgNoCutBuffer;
+  void flushBuffers();
 
   //Yield of dimuon objects
   int jpsiGlbSigPerLS;
   int jpsiStaSigPerLS;
   int jpsiTrkSigPerLS;
-  std::map<int,int> jpsiGlbSig;
-  std::map<int,int> jpsiStaSig;
-  std::map<int,int> jpsiTrkSig;
+
+  // Trends of the yields per lumi section (0 if not configured)
+  unsigned int trendLumis;
+  LumiTrends* trends;
+  unsigned int jpsiGlbTrend, jpsiStaTrend, jpsiTrkTrend;
 
   math::XYZPoint RefVtx;
+
+  // Invariant masses of all muon pairs from the global, standalone and
+  // tracker tracks (indices as in the muon collection)
+  DileptonPairs globalPairs;
+  DileptonPairs standalonePairs;
+  DileptonPairs trackerPairs;
+  // True if any dimuon mass histogram of the global, standalone or tracker
+  // tracks is booked; the pairs are only computed for these track types
+  bool globalHistograms;
+  bool standaloneHistograms;
+  bool trackerHistograms;
 };
 #endif
 
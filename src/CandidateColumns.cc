@@ -0,0 +1,67 @@
+#include "DQM/Physics/interface/CandidateColumns.h"
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+
+bool
+MuonColumns::fill(const edm::Event& event, const edm::InputTag& muons, const edm::InputTag& beamSpot)
+{
+  edm::Handle<edm::View<reco::Muon> > muonCollection;
+  if( !event.getByLabel(muons, muonCollection) ) return false;
+  edm::Handle<reco::BeamSpot> beamSpotHandle;
+  if( !event.getByLabel(beamSpot, beamSpotHandle) ) return false;
+  fill(*muonCollection, beamSpotHandle->position());
+  return true;
+}
+
+void
+MuonColumns::fill(const edm::View<reco::Muon>& muons, const reco::BeamSpot::Point& beamSpot)
+{
+  unsigned int n=muons.size();
+  pt.resize(n); eta.resize(n); phi.resize(n); px.resize(n); py.resize(n); pz.resize(n); p.resize(n); charge.resize(n);
+  flags.resize(n); nMatches.resize(n);
+  globalDxy.resize(n); globalNormalizedChi2.resize(n); muonHits.resize(n);
+  innerDxy.resize(n); innerValidHits.resize(n); trackerHits.resize(n); pixelHits.resize(n);
+  isoR03SumPt.resize(n); isoR03EmEt.resize(n); isoR03HadEt.resize(n);
+
+  for(unsigned int idx=0; idx<n; ++idx){
+    const reco::Muon& mu=muons[idx];
+    pt[idx]=mu.pt(); eta[idx]=mu.eta(); phi[idx]=mu.phi();
+    px[idx]=mu.px(); py[idx]=mu.py(); pz[idx]=mu.pz(); p[idx]=mu.p();
+    charge[idx]=mu.charge();
+    nMatches[idx]=mu.numberOfMatches();
+
+    unsigned int type=0;
+    if( mu.isGlobalMuon()     ) type|=GLOBAL;
+    if( mu.isTrackerMuon()    ) type|=TRACKER;
+    if( mu.isStandAloneMuon() ) type|=STANDALONE;
+
+    globalDxy[idx]=0.; globalNormalizedChi2[idx]=0.; muonHits[idx]=0;
+    reco::TrackRef gm=mu.globalTrack();
+    if( gm.isNonnull() ){
+      type|=HAS_GLOBAL_TRACK;
+      globalDxy[idx]=gm->dxy(beamSpot);
+      globalNormalizedChi2[idx]=gm->normalizedChi2();
+      muonHits[idx]=gm->hitPattern().numberOfValidMuonHits();
+    }
+    innerDxy[idx]=0.; innerValidHits[idx]=0; trackerHits[idx]=0; pixelHits[idx]=0;
+    reco::TrackRef tk=mu.innerTrack();
+    if( tk.isNonnull() ){
+      type|=HAS_INNER_TRACK;
+      innerDxy[idx]=tk->dxy(beamSpot);
+      innerValidHits[idx]=tk->numberOfValidHits();
+      trackerHits[idx]=tk->hitPattern().numberOfValidTrackerHits();
+      pixelHits[idx]=tk->hitPattern().numberOfValidPixelHits();
+    }
+    flags[idx]=type;
+
+    const reco::MuonIsolation& iso=mu.isolationR03();
+    isoR03SumPt[idx]=iso.sumPt; isoR03EmEt[idx]=iso.emEt; isoR03HadEt[idx]=iso.hadEt;
+  }
+}
+
+void
+MuonColumns::clear()
+{
+  fill(edm::View<reco::Muon>(), reco::BeamSpot::Point());
+}
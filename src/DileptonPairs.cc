@@ -0,0 +1,47 @@
+#include "DQM/Physics/interface/DileptonPairs.h"
+
+#include <cmath>
+
+void
+DileptonPairs::clear()
+{
+  px_.clear(); py_.clear(); pz_.clear(); energy_.clear(); charge_.clear();
+}
+
+unsigned int
+DileptonPairs::add(double px, double py, double pz, double energy, int charge)
+{
+  px_.push_back(px); py_.push_back(py); pz_.push_back(pz); energy_.push_back(energy); charge_.push_back(charge);
+  return px_.size()-1;
+}
+
+void
+DileptonPairs::compute()
+{
+  unsigned int n=size(), nPairs=(n>1 ? n*(n-1)/2 : 0);
+  mass_ .resize(nPairs);
+  flags_.resize(nPairs);
+  if( n<2 ) return;
+
+  const double* px=&px_[0]; const double* py=&py_[0]; const double* pz=&pz_[0];
+  const double* energy=&energy_[0]; const int* charge=&charge_[0];
+  for(unsigned int i=0, offset=0; i<n-1; offset+=n-i-1, ++i){
+    // the pairs (i, i+1..n-1) are stored contiguously starting at offset; the
+    // inner loop is kept free of branches, such that it can be vectorized
+    double* mass2=&mass_[offset]; unsigned char* flags=&flags_[offset];
+    const double pxi=px[i], pyi=py[i], pzi=pz[i], energyi=energy[i]; const int chargei=charge[i];
+    for(unsigned int k=0, j=i+1; j<n; ++k, ++j){
+      double sumPx=pxi+px[j], sumPy=pyi+py[j], sumPz=pzi+pz[j], sumE=energyi+energy[j];
+      mass2[k]=sumE*sumE-(sumPx*sumPx+sumPy*sumPy+sumPz*sumPz);
+      int sign=chargei*charge[j];
+      flags[k]=(sign>0)*SAME_SIGN | (sign<0)*OPPOSITE_SIGN;
+    }
+  }
+  // the square roots are taken in a separate loop; it is only vectorized
+  // if errno is not set by sqrt (-fno-math-errno)
+  double* mass=&mass_[0];
+  for(unsigned int k=0; k<nPairs; ++k){
+    double root=std::sqrt(std::fabs(mass[k]));
+    mass[k]=(mass[k]<0.) ? -root : root;
+  }
+}
@@ -0,0 +1,40 @@
+#include "DQM/Physics/interface/EventArena.h"
+
+const size_t EventArena::ALIGNMENT;
+
+EventArena::EventArena(size_t blockSize) :
+  blockSize_(blockSize), current_(0), left_(0)
+{
+}
+
+EventArena::~EventArena()
+{
+  for(unsigned int idx=0; idx<blocks_.size(); ++idx){ delete[] blocks_[idx]; }
+}
+
+void*
+EventArena::grow(size_t bytes)
+{
+  // the blocks grow geometrically, such that an event
+  // needs only a few of them before the first reset
+  size_t size=sizes_.empty() ? blockSize_ : 2*sizes_.back();
+  if( size<bytes ) size=bytes;
+  blocks_.push_back(new char[size]); sizes_.push_back(size);
+  current_=blocks_.back()+bytes; left_=size-bytes;
+  return blocks_.back();
+}
+
+void
+EventArena::reset()
+{
+  if( blocks_.size()>1 ){
+    // merge all blocks into one, which holds a
+    // full event from the next event on
+    size_t size=0;
+    for(unsigned int idx=0; idx<blocks_.size(); ++idx){ size+=sizes_[idx]; delete[] blocks_[idx]; }
+    blocks_.clear(); sizes_.clear();
+    blocks_.push_back(new char[size]); sizes_.push_back(size);
+  }
+  current_=blocks_.empty() ? 0 : blocks_[0];
+  left_=sizes_.empty() ? 0 : sizes_[0];
+}
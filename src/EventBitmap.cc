@@ -0,0 +1,327 @@
+#include "DQM/Physics/interface/EventBitmap.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+  // maximal size of an array container; above a bitmap
+  // container (1024 words of 64 bits) takes less memory
+  const unsigned int MAXARRAY = 4096;
+  // number of 64 bit words of a bitmap container
+  const unsigned int NWORDS = 1024;
+  // header of the index files of the SelectionIndex
+  const char INDEXHEADER[] = "EVTIDX1";
+  // maximal length of a string read from a stream, which
+  // is not seekable (i.e. whose remaining size is unknown)
+  const uint64_t MAXLENGTH = uint64_t(1)<<28;
+
+  // number of bits set in _word_
+  unsigned int popcount(uint64_t word)
+  {
+    unsigned int count=0;
+    for(; word; word&=word-1){ ++count; }
+    return count;
+  }
+
+  // append _nBytes_ bytes of _value_ to _buffer_ (little endian)
+  void put(std::string& buffer, uint64_t value, unsigned int nBytes)
+  {
+    for(unsigned int idx=0; idx<nBytes; ++idx){ buffer.push_back(char((value>>(8*idx))&0xff)); }
+  }
+
+  // read _nBytes_ bytes (little endian) at _pos_ into _value_;
+  // returns false if the data end before
+  bool get(const char* data, size_t size, size_t& pos, uint64_t& value, unsigned int nBytes)
+  {
+    if( pos+nBytes>size ) return false;
+    value=0;
+    for(unsigned int idx=0; idx<nBytes; ++idx){ value|=uint64_t((unsigned char)data[pos+idx])<<(8*idx); }
+    pos+=nBytes;
+    return true;
+  }
+
+  // read _nBytes_ bytes (little endian) from _in_ into _value_
+  bool get(std::istream& in, uint64_t& value, unsigned int nBytes)
+  {
+    char data[8]; size_t pos=0;
+    return in.read(data, nBytes) && get(data, nBytes, pos, value, nBytes);
+  }
+
+  // number of bytes left in _in_; MAXLENGTH if _in_ is not seekable
+  uint64_t remaining(std::istream& in)
+  {
+    std::streampos pos=in.tellg();
+    if( pos==std::streampos(-1) ){ in.clear(); return MAXLENGTH; }
+    in.seekg(0, std::ios::end); std::streampos end=in.tellg(); in.seekg(pos);
+    if( !in || end==std::streampos(-1) ){ in.clear(); in.seekg(pos); return MAXLENGTH; }
+    return end>pos ? uint64_t(end-pos) : 0;
+  }
+
+  // read a string of _nBytes_ length bytes from _in_ into _value_; the
+  // length is checked against the remaining size of _in_ before any
+  // memory is allocated for the string
+  bool get(std::istream& in, std::string& value, unsigned int nBytes)
+  {
+    uint64_t size=0;
+    if( !get(in, size, nBytes) || size>remaining(in) ) return false;
+    value.resize(size);
+    return size==0 || in.read(&value[0], size);
+  }
+
+}
+
+bool
+EventBitmap::Container::contains(uint16_t low) const
+{
+  if( dense() ) return (bits[low>>6]>>(low&63))&1;
+  return std::binary_search(array.begin(), array.end(), low);
+}
+
+void
+EventBitmap::Container::toBitmap()
+{
+  if( dense() ) return;
+  bits.assign(NWORDS, 0);
+  for(std::vector<uint16_t>::const_iterator low=array.begin(); low!=array.end(); ++low){ bits[*low>>6]|=uint64_t(1)<<(*low&63); }
+  std::vector<uint16_t>().swap(array);
+}
+
+void
+EventBitmap::Container::toArray()
+{
+  if( !dense() ) return;
+  array.clear(); array.reserve(size);
+  for(unsigned int low=0; low<NWORDS*64; ++low){
+    if( (bits[low>>6]>>(low&63))&1 ) array.push_back(uint16_t(low));
+  }
+  std::vector<uint64_t>().swap(bits);
+}
+
+void
+EventBitmap::Container::optimize()
+{
+  if( size>MAXARRAY ) toBitmap(); else toArray();
+}
+
+void
+EventBitmap::add(uint64_t event)
+{
+  Container& container=containers_[event>>16];
+  uint16_t low=uint16_t(event&0xffff);
+  if( container.dense() ){
+    uint64_t& word=container.bits[low>>6]; uint64_t bit=uint64_t(1)<<(low&63);
+    if( !(word&bit) ){ word|=bit; ++container.size; }
+    return;
+  }
+  // events arrive mostly in increasing order
+  // within a luminosity section
+  std::vector<uint16_t>::iterator pos=container.array.end();
+  if( !container.array.empty() && container.array.back()>=low ){
+    pos=std::lower_bound(container.array.begin(), container.array.end(), low);
+    if( *pos==low ) return;
+  }
+  container.array.insert(pos, low); ++container.size;
+  container.optimize();
+}
+
+bool
+EventBitmap::contains(uint64_t event) const
+{
+  std::map<uint64_t, Container>::const_iterator container=containers_.find(event>>16);
+  return container!=containers_.end() && container->second.contains(uint16_t(event&0xffff));
+}
+
+uint64_t
+EventBitmap::size() const
+{
+  uint64_t size=0;
+  for(std::map<uint64_t, Container>::const_iterator container=containers_.begin(); container!=containers_.end(); ++container){
+    size+=container->second.size;
+  }
+  return size;
+}
+
+std::vector<uint64_t>
+EventBitmap::events() const
+{
+  std::vector<uint64_t> events; events.reserve(size());
+  for(std::map<uint64_t, Container>::const_iterator container=containers_.begin(); container!=containers_.end(); ++container){
+    uint64_t high=container->first<<16;
+    if( !container->second.dense() ){
+      for(std::vector<uint16_t>::const_iterator low=container->second.array.begin(); low!=container->second.array.end(); ++low){ events.push_back(high|*low); }
+      continue;
+    }
+    for(unsigned int low=0; low<NWORDS*64; ++low){
+      if( container->second.contains(uint16_t(low)) ) events.push_back(high|low);
+    }
+  }
+  return events;
+}
+
+EventBitmap&
+EventBitmap::operator&=(const EventBitmap& other)
+{
+  std::map<uint64_t, Container>::iterator container=containers_.begin();
+  while( container!=containers_.end() ){
+    std::map<uint64_t, Container>::const_iterator match=other.containers_.find(container->first);
+    if( match==other.containers_.end() ){ containers_.erase(container++); continue; }
+    Container& lhs=container->second; const Container& rhs=match->second;
+    if( lhs.dense() && rhs.dense() ){
+      lhs.size=0;
+      for(unsigned int word=0; word<NWORDS; ++word){ lhs.bits[word]&=rhs.bits[word]; lhs.size+=popcount(lhs.bits[word]); }
+    }
+    else{
+      // the result of an intersection with an array
+      // container is an array container
+      std::vector<uint16_t> result;
+      const std::vector<uint16_t>& array=lhs.dense() ? rhs.array : lhs.array; const Container& filter=lhs.dense() ? lhs : rhs;
+      for(std::vector<uint16_t>::const_iterator low=array.begin(); low!=array.end(); ++low){
+	if( filter.contains(*low) ) result.push_back(*low);
+      }
+      std::vector<uint64_t>().swap(lhs.bits); lhs.array.swap(result); lhs.size=lhs.array.size();
+    }
+    lhs.optimize();
+    if( lhs.size==0 ){ containers_.erase(container++); continue; }
+    ++container;
+  }
+  return *this;
+}
+
+EventBitmap&
+EventBitmap::operator|=(const EventBitmap& other)
+{
+  for(std::map<uint64_t, Container>::const_iterator match=other.containers_.begin(); match!=other.containers_.end(); ++match){
+    Container& lhs=containers_[match->first]; const Container& rhs=match->second;
+    if( !lhs.dense() && !rhs.dense() ){
+      std::vector<uint16_t> result; result.reserve(lhs.array.size()+rhs.array.size());
+      std::set_union(lhs.array.begin(), lhs.array.end(), rhs.array.begin(), rhs.array.end(), std::back_inserter(result));
+      lhs.array.swap(result); lhs.size=lhs.array.size();
+    }
+    else{
+      // the result of a union with a bitmap
+      // container is a bitmap container
+      lhs.toBitmap();
+      if( rhs.dense() ){
+	for(unsigned int word=0; word<NWORDS; ++word){ lhs.bits[word]|=rhs.bits[word]; }
+      }
+      else{
+	for(std::vector<uint16_t>::const_iterator low=rhs.array.begin(); low!=rhs.array.end(); ++low){ lhs.bits[*low>>6]|=uint64_t(1)<<(*low&63); }
+      }
+      lhs.size=0;
+      for(unsigned int word=0; word<NWORDS; ++word){ lhs.size+=popcount(lhs.bits[word]); }
+    }
+    lhs.optimize();
+  }
+  return *this;
+}
+
+void
+EventBitmap::serialize(std::string& buffer) const
+{
+  // number of containers, then per container the upper 48 bits,
+  // the type (0: array, 1: bitmap), the size and the content
+  put(buffer, containers_.size(), 4);
+  for(std::map<uint64_t, Container>::const_iterator container=containers_.begin(); container!=containers_.end(); ++container){
+    put(buffer, container->first, 6); put(buffer, container->second.dense(), 1); put(buffer, container->second.size, 4);
+    if( container->second.dense() ){
+      for(unsigned int word=0; word<NWORDS; ++word){ put(buffer, container->second.bits[word], 8); }
+    }
+    else{
+      for(unsigned int idx=0; idx<container->second.array.size(); ++idx){ put(buffer, container->second.array[idx], 2); }
+    }
+  }
+}
+
+bool
+EventBitmap::deserialize(const char* data, size_t size)
+{
+  containers_.clear();
+  size_t pos=0; uint64_t nContainers=0;
+  if( !get(data, size, pos, nContainers, 4) ) return false;
+  for(uint64_t idx=0; idx<nContainers; ++idx){
+    uint64_t high=0, dense=0, nEvents=0;
+    if( !get(data, size, pos, high, 6) || !get(data, size, pos, dense, 1) || !get(data, size, pos, nEvents, 4) ) return false;
+    // the containers are written in increasing order of the upper bits; the
+    // size is checked against the remaining data before any memory is allocated
+    if( dense>1 || (!containers_.empty() && high<=containers_.rbegin()->first) ) return false;
+    if( nEvents>NWORDS*64 || (dense ? NWORDS*8 : 2*nEvents)>size-pos ) return false;
+    Container& container=containers_[high]; container.size=nEvents;
+    if( dense ){
+      // the number of bits set has to match the size
+      container.bits.resize(NWORDS); uint64_t nBits=0;
+      for(unsigned int word=0; word<NWORDS; ++word){
+	if( !get(data, size, pos, container.bits[word], 8) ) return false;
+	nBits+=popcount(container.bits[word]);
+      }
+      if( nBits!=nEvents ) return false;
+    }
+    else{
+      // the events have to be sorted without duplicates, as
+      // expected by the look up and the set operations
+      container.array.resize(nEvents);
+      for(uint64_t low=0; low<nEvents; ++low){
+	uint64_t value=0; if( !get(data, size, pos, value, 2) ) return false;
+	if( low>0 && value<=container.array[low-1] ) return false;
+	container.array[low]=uint16_t(value);
+      }
+    }
+  }
+  return pos==size;
+}
+
+SelectionIndex::SelectionIndex(const std::string& fileName, const std::string& module) :
+  out_(fileName.c_str(), std::ios::out|std::ios::binary|std::ios::trunc), module_(module)
+{
+  if( !out_ ){
+    throw cms::Exception("Configuration") << "SelectionIndex: cannot create file '" << fileName << "'\n";
+  }
+  out_.write(INDEXHEADER, sizeof(INDEXHEADER)-1);
+}
+
+unsigned int
+SelectionIndex::add(const std::string& step)
+{
+  steps_.push_back(step); events_.push_back(EventBitmap());
+  return steps_.size()-1;
+}
+
+void
+SelectionIndex::write(unsigned int run, unsigned int lumi)
+{
+  std::string buffer;
+  for(unsigned int idx=0; idx<steps_.size(); ++idx){
+    if( events_[idx].empty() ) continue;
+    std::string events; events_[idx].serialize(events);
+    put(buffer, module_.size(), 2); buffer+=module_;
+    put(buffer, steps_[idx].size(), 2); buffer+=steps_[idx];
+    put(buffer, run, 4); put(buffer, lumi, 4);
+    put(buffer, events.size(), 4); buffer+=events;
+    events_[idx].clear();
+  }
+  // flushed per luminosity section such that the index
+  // is complete up to the last one in case of a crash
+  if( !buffer.empty() ){ out_.write(buffer.data(), buffer.size()); out_.flush(); }
+}
+
+bool
+SelectionIndex::header(std::istream& in)
+{
+  char data[sizeof(INDEXHEADER)-1];
+  return in.read(data, sizeof(data)) && std::string(data, sizeof(data))==INDEXHEADER;
+}
+
+bool
+SelectionIndex::read(std::istream& in, Record& record)
+{
+  // the end of the file is only expected before a record
+  if( in.peek()==std::char_traits<char>::eof() ) return false;
+  uint64_t run=0, lumi=0; std::string events;
+  bool valid= get(in, record.module, 2) && get(in, record.step, 2) && get(in, run, 4) && get(in, lumi, 4) && get(in, events, 4);
+  if( valid ) valid=record.events.deserialize(events.data(), events.size());
+  // corrupt data are flagged by a stream which is not at its end
+  if( !valid ){ in.clear(); return false; }
+  record.run=run; record.lumi=lumi;
+  return true;
+}
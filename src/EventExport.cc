@@ -0,0 +1,73 @@
+#include "DQM/Physics/interface/EventExport.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+
+#include "TFile.h"
+#include "TTree.h"
+
+EventExport::EventExport(const std::string& fileName, const std::string& treeName, int compression) :
+  file_(0), tree_(0), run_(0), lumi_(0), event_(0), written_(0)
+{
+  TDirectory* current=gDirectory;
+  file_=TFile::Open(fileName.c_str(), "RECREATE", "", compression);
+  if( !file_ || file_->IsZombie() ){
+    throw cms::Exception("Configuration") << "EventExport: cannot create file '" << fileName << "'\n";
+  }
+  tree_=new TTree(treeName.c_str(), treeName.c_str());
+  tree_->SetDirectory(file_);
+  // do not leave the export file as the current directory
+  if( current ) current->cd();
+}
+
+EventExport::~EventExport()
+{
+  if( !file_ ) return;
+  TDirectory* current=gDirectory;
+  file_->cd(); tree_->Write(); file_->Close(); delete file_;
+  if( current && current!=file_ ) current->cd();
+}
+
+unsigned int
+EventExport::add(const std::string& name)
+{
+  return add(name, 0);
+}
+
+unsigned int
+EventExport::add(const std::string& name, unsigned int maxSize)
+{
+  // the branches keep the addresses of the values
+  if( tree_->GetNbranches()>0 ){
+    throw cms::Exception("LogicError") << "EventExport: column '" << name << "' added after the first event\n";
+  }
+  names_.push_back(name); sizes_.push_back(maxSize); offsets_.push_back(values_.size()); counts_.push_back(0);
+  values_.resize(values_.size()+(maxSize>0 ? maxSize : 1), 0.);
+  return names_.size()-1;
+}
+
+void
+EventExport::write(const edm::EventID& id)
+{
+  if( tree_->GetNbranches()==0 ) branch();
+  run_=id.run(); lumi_=id.luminosityBlock(); event_=id.event();
+  tree_->Fill(); ++written_;
+  std::fill(values_.begin(), values_.end(), 0.); std::fill(counts_.begin(), counts_.end(), 0);
+}
+
+void
+EventExport::branch()
+{
+  tree_->Branch("run"  , &run_  , "run/i"  );
+  tree_->Branch("lumi" , &lumi_ , "lumi/i" );
+  tree_->Branch("event", &event_, "event/l");
+  for(unsigned int idx=0; idx<names_.size(); ++idx){
+    if( sizes_[idx]==0 ){
+      tree_->Branch(names_[idx].c_str(), &values_[offsets_[idx]], (names_[idx]+"/F").c_str());
+      continue;
+    }
+    // variable size arrays are stored with their counter
+    tree_->Branch(("n"+names_[idx]).c_str(), &counts_[idx], ("n"+names_[idx]+"/I").c_str());
+    tree_->Branch(names_[idx].c_str(), &values_[offsets_[idx]], (names_[idx]+"[n"+names_[idx]+"]/F").c_str());
+  }
+}
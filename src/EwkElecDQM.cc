@@ -9,6 +9,7 @@
 
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
+#include "DQM/Physics/interface/LeadingObjects.h"
 
 #include "DataFormats/TrackReco/interface/Track.h"
 #include "DataFormats/BeamSpot/interface/BeamSpot.h"
@@ -28,6 +29,7 @@
 
 #include "FWCore/Common/interface/TriggerNames.h"
 #include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
 #include "DataFormats/Common/interface/TriggerResults.h"
 
 #include "DataFormats/Common/interface/View.h"
@@ -36,6 +38,11 @@ using namespace edm;
 using namespace std;
 using namespace reco;
 
+namespace {
+  // payload of the leading electrons: index in the collection and direction
+  struct LeadingElectron { unsigned int idx; float eta, phi; };
+}
+
 EwkElecDQM::EwkElecDQM( const ParameterSet & cfg ) :
       // Input collections
       trigTag_(cfg.getUntrackedParameter<edm::InputTag> ("TrigTag", edm::InputTag("TriggerResults::HLT"))),
@@ -87,7 +94,13 @@ EwkElecDQM::EwkElecDQM( const ParameterSet & cfg ) :
       eJetMin_(cfg.getUntrackedParameter<double>("EJetMin", 999999.)),
       nJetMax_(cfg.getUntrackedParameter<int>("NJetMax", 999999)),
       PUMax_(cfg.getUntrackedParameter<unsigned int>("PUMax", 60)),
-      PUBinCount_(cfg.getUntrackedParameter<unsigned int>("PUBinCount", 12))
+      PUBinCount_(cfg.getUntrackedParameter<unsigned int>("PUBinCount", 12)),
+
+      // N-1 histograms
+      wSel_(NWFLAGS, NVALUES),
+
+      // Trends per lumi section (none if not configured)
+      trends_(0), wTrend_(0)
       
 //       caloJetCollection_(cfg.getUntrackedParameter<edm:InputTag>("CaloJetCollection","sisCone5CaloJets"))
 
@@ -101,6 +114,13 @@ EwkElecDQM::EwkElecDQM( const ParameterSet & cfg ) :
   theDbe->setCurrentFolder("Physics/EwkElecDQM");
   init_histograms();
 
+  // number of lumi sections with one bin in the trends (0: no trends)
+  unsigned int trendLumis = cfg.getUntrackedParameter<unsigned int>("trendLumis", 0);
+  if (trendLumis>0) {
+    trends_ = new LumiTrends("Physics/EwkElecDQM/", trendLumis);
+    wTrend_ = trends_->add("WENu", "W#rightarrowe#nu candidates per lumi section");
+  }
+
 }
 
 void EwkElecDQM::beginRun(const Run& iRun, const EventSetup& iSet) {
@@ -119,6 +139,8 @@ void EwkElecDQM::beginRun(const Run& iRun, const EventSetup& iSet) {
      isValidHltConfig_ = hltConfigProvider_.init( iRun, iSet, "HLT", isConfigChanged );
 
      LogTrace("") << "isValidHltConfig_=" << isValidHltConfig_ << "\n";
+
+     if (trends_) trends_->beginRun();
 }
 
 
@@ -258,6 +280,27 @@ void EwkElecDQM::init_histograms() {
 	     jet_eta_before_       = theDbe->book1D("JETETA1_BEFORECUTS",chtitle, 20, -5, 5);
 	     jet_eta_after_       = theDbe->book1D("JETETA1_AFTERCUTS",chtitle, 20, -5, 5);
 
+	     // N-1 histograms; barrel and endcap histograms are filled depending
+	     // on the electron position, the leading jet only if above 10 GeV
+	     wSel_.add(E_PT     , pt_after_           , PT     );
+	     wSel_.add(E_ETA    , eta_after_          , ETA    );
+	     wSel_.add(E_SIEIE  , sieiebarrel_after_  , SIEIE  , false, BARREL);
+	     wSel_.add(E_SIEIE  , sieieendcap_after_  , SIEIE  , false, ENDCAP);
+	     wSel_.add(E_DETAIN , detainbarrel_after_ , DETAIN , false, BARREL);
+	     wSel_.add(E_DETAIN , detainendcap_after_ , DETAIN , false, ENDCAP);
+	     wSel_.add(E_ECALISO, ecalisobarrel_after_, ECALISO, false, BARREL);
+	     wSel_.add(E_ECALISO, ecalisoendcap_after_, ECALISO, false, ENDCAP);
+	     wSel_.add(E_HCALISO, hcalisobarrel_after_, HCALISO, false, BARREL);
+	     wSel_.add(E_HCALISO, hcalisoendcap_after_, HCALISO, false, ENDCAP);
+	     wSel_.add(E_TRKISO , trkisobarrel_after_ , TRKISO , false, BARREL);
+	     wSel_.add(E_TRKISO , trkisoendcap_after_ , TRKISO , false, ENDCAP);
+	     wSel_.add(E_HLT    , trig_after_         , HLT    , true );
+	     wSel_.add(E_MT     , mt_after_           , MT     );
+	     wSel_.add(E_MET    , met_after_          , MET    , true );
+	     wSel_.add(E_NJETS  , njets_after_        , NJETS  , true );
+	     wSel_.add(E_NJETS  , jet_et_after_       , JET_ET , true , HARDJET);
+	     wSel_.add(E_NJETS  , jet_eta_after_      , JET_ETA, true , HARDJET);
+
 // 	     snprintf(chtitle, 255, "Jet with 2nd highest E_{T} (%s)", jetTag_.label().data());
 // 	     jet2_et_before      = theDbe->book1D("JETET2_BEFORECUTS",chtitle, 20, 0., 200.0);
 // 	     jet2_et_after       = theDbe->book1D("JETET2_AFTERCUTS",chtitle, 20, 0., 200.0);
@@ -267,9 +310,17 @@ void EwkElecDQM::init_histograms() {
 }
 
 
+EwkElecDQM::~EwkElecDQM() {
+  if (trends_) delete trends_;
+}
+
 void EwkElecDQM::endJob() {
 }
 
+void EwkElecDQM::endLuminosityBlock(const LuminosityBlock& lumiBlock, const EventSetup&) {
+  if (trends_) trends_->append(lumiBlock.id().luminosityBlock());
+}
+
 void EwkElecDQM::endRun(const Run& r, const EventSetup&) {
 
   // overall
@@ -357,6 +408,8 @@ void EwkElecDQM::endRun(const Run& r, const EventSetup&) {
 
 void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
       
+      if (trends_) trends_->event();
+
       // Reset global event selection flags
       bool rec_sel = false;
       bool eid_sel = false;
@@ -506,35 +559,18 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 	//LogError("") << ">>> JET collection does not exist !!!";
 	return;
       }      
-      float electron_et   = -8.0;
-      float electron_eta  = -8.0;
-      float electron_phi  = -8.0;
-      float electron2_et  = -9.0;
-      float electron2_eta = -9.0;
-      float electron2_phi = -9.0;
       //need to get some electron info so jets can be cleaned of them
+      //(the two leading electrons in pt, also used for the invariant mass)
+      LeadingObjects<LeadingElectron, 2> leadingElectrons;
       for (unsigned int i=0; i<electronCollectionSize; i++) 
 	{
 	  const GsfElectron& elec = electronCollection->at(i);	 
-
-	  if (i < 1)
-	    {
-	       electron_et   = elec.pt();
-	       electron_eta  = elec.eta();
-	       electron_phi  = elec.phi();
-	    }
-	  if (i == 2)
-	    {
-	       electron2_et  = elec.pt();
-	       electron2_eta = elec.eta();
-	       electron2_phi = elec.phi();
-	    }       
+	  LeadingElectron lead = { i, elec.eta(), elec.phi() };
+	  leadingElectrons.push(elec.pt(), lead);
 	}
 
-      float jet_et    = -8.0;
-      float jet_eta   = -8.0;
       int   jet_count = 0;
-      float jet2_et   = -9.0;
+      LeadingObjects<float, 1> leadingJets;
       unsigned int jetCollectionSize = jetCollection->size();
       int njets = 0;
       for (unsigned int i=0; i<jetCollectionSize; i++) {
@@ -543,12 +579,14 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 	float jet_current_et = jet.et();
 // 	cout << "jet_current_et " << jet_current_et << endl;
 	// if it overlaps with electron, it is not a jet
-	if ( electron_et>0.0 && fabs(jet.eta()-electron_eta ) < 0.2 
-	     && calcDeltaPhi(jet.phi(), electron_phi ) < 0.2)
-	  continue;
-	if ( electron2_et>0.0&& fabs(jet.eta()-electron2_eta) < 0.2 
-	     && calcDeltaPhi(jet.phi(), electron2_phi) < 0.2) 
-	  continue;
+	bool overlap = false;
+	for (unsigned int k=0; k<leadingElectrons.size(); k++)
+	  {
+	    if ( leadingElectrons.key(k)>0.0 && fabs(jet.eta()-leadingElectrons[k].eta) < 0.2 
+		 && calcDeltaPhi(jet.phi(), leadingElectrons[k].phi) < 0.2)
+	      overlap = true;
+	  }
+	if (overlap) continue;
 
 	// if it has too low Et, throw away
 // 	if (jet_current_et < eJetMin_) continue; //Keep if only want to plot above jet cut
@@ -558,17 +596,10 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 	    njets++;
 	    jet_count++;
 	  }
-	if (jet_current_et > jet_et) 
-	  {
-	    jet2_et  = jet_et;  // 2nd highest jet get's et from current highest
-	    jet_et   = jet.et(); // current highest jet gets et from the new highest
-	    jet_eta  = jet.eta();
-	  } 
-	else if (jet_current_et > jet2_et) 
-	  {
-	    jet2_et  = jet.et();
-	  }
+	leadingJets.push(jet_current_et, jet.eta());
       }
+      float jet_et  = leadingJets.size()>0 ? leadingJets.key(0) : -8.0;
+      float jet_eta = leadingJets.size()>0 ? leadingJets[0]     : -8.0;
 
       //Fill After all electron cuts (or both before and after)
       if (jet_et>10) //don't want low energy "jets"
@@ -587,26 +618,22 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
       // Start counting
       nall++;
 
-      // Histograms per event should be done only once, so keep track of them
-      bool hlt_hist_done = false;
-      //bool minv_hist_done = false;
-       bool met_hist_done = false;
-//       bool nz1_hist_done = false;
-//       bool nz2_hist_done = false;
-      bool njets_hist_done = false;
+      // N-1 histograms of event quantities are filled only once per event
+      wSel_.reset();
 
       // Central selection criteria
-      //const int NFLAGS = 13; // number of individual selection criteria
-      const int NFLAGS = 11; // number of individual selection criteria
-      // 0: pt cut           | rec
-      // 1: eta cut          | rec
-      // 2: sieie            | eid
-      // 3: detain           | eid
-      // 4: ecal iso         | iso
-      // 5: hcal iso         | iso
-      // 6: trk iso          | iso
-      // 7: trigger fired    | hlt/all
-      bool electron_sel[NFLAGS];
+      // (see EwkElecDQM::WFlags), the results are kept as bitmask
+      //  0: pt cut           | rec
+      //  1: eta cut          | rec
+      //  2: sieie            | eid
+      //  3: detain           | eid
+      //  4: ecal iso         | iso
+      //  5: hcal iso         | iso
+      //  6: trk iso          | iso
+      //  7: trigger fired    | hlt/all
+      //  8: mt
+      //  9: met
+      // 10: njets
 
       // for invariant mass calculation
       // keep track of highest-pt electrons for initial (RECO) electrons 
@@ -634,10 +661,7 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 
       for (unsigned int i=0; i<electronCollectionSize; i++) 
 	{
-	  for (int j=0; j<NFLAGS; ++j) 
-	    {
-	      electron_sel[j] = false;
-            }
+	  unsigned int electron_sel = 0;
 	  
 	  const GsfElectron& elec = electronCollection->at(i);
 	  //if (!mu.isGlobalMuon()) continue;
@@ -649,14 +673,15 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 	  //reco::TrackRef tk = mu.innerTrack();
 	  // should have stuff for electron track?
 	  
-	  if (i < 2)
+	  for (unsigned int k=0; k<leadingElectrons.size(); k++)
 	    {
-	      electron[i][0] = 1.;
-	      electron[i][1] = elec.massSqr();
-	      electron[i][2] = elec.energy();
-	      electron[i][3] = elec.px();
-	      electron[i][4] = elec.py();
-	      electron[i][5] = elec.pz();
+	      if (leadingElectrons[k].idx != i) continue;
+	      electron[k][0] = 1.;
+	      electron[k][1] = elec.massSqr();
+	      electron[k][2] = elec.energy();
+	      electron[k][3] = elec.px();
+	      electron[k][4] = elec.py();
+	      electron[k][5] = elec.pz();
 	    }
 
 	  // Pt,eta cuts
@@ -665,8 +690,8 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 	  double py = elec.py();
 	  double eta = elec.eta();
 	  LogTrace("") << "\t... pt, eta: " << pt << " [GeV], " << eta;;
-	  if (pt>ptCut_) electron_sel[0] = true; 
-	  if (fabs(eta)<etaCut_) electron_sel[1] = true; 
+	  electron_sel |= NMinusOne::bit(E_PT, pt>ptCut_);
+	  electron_sel |= NMinusOne::bit(E_ETA, fabs(eta)<etaCut_);
 	  
 	  bool isBarrel = false;
 	  bool isEndcap = false;
@@ -700,19 +725,19 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 	  // Electron ID cuts
 	  double sieie = (double) elec.sigmaIetaIeta();
 	  double detain = (double) elec.deltaEtaSuperClusterTrackAtVtx(); // think this is detain
-	  if (sieie < sieieCutBarrel_ && isBarrel) electron_sel[2] = true; 
-	  if (sieie < sieieCutEndcap_ && isEndcap) electron_sel[2] = true; 
-	  if (detain < detainCutBarrel_ && isBarrel) electron_sel[3] = true; 
-	  if (detain < detainCutEndcap_ && isEndcap) electron_sel[3] = true; 
+	  electron_sel |= NMinusOne::bit(E_SIEIE, sieie < sieieCutBarrel_ && isBarrel);
+	  electron_sel |= NMinusOne::bit(E_SIEIE, sieie < sieieCutEndcap_ && isEndcap);
+	  electron_sel |= NMinusOne::bit(E_DETAIN, detain < detainCutBarrel_ && isBarrel);
+	  electron_sel |= NMinusOne::bit(E_DETAIN, detain < detainCutEndcap_ && isEndcap);
 	  if (isBarrel)
 	    {
-	      LogTrace("") << "\t... sieie value " << sieie << " (barrel), pass? " << electron_sel[2]; 
-	      LogTrace("") << "\t... detain value " << detain << " (barrel), pass? " << electron_sel[3]; 
+	      LogTrace("") << "\t... sieie value " << sieie << " (barrel), pass? " << ((electron_sel & NMinusOne::bit(E_SIEIE))!=0); 
+	      LogTrace("") << "\t... detain value " << detain << " (barrel), pass? " << ((electron_sel & NMinusOne::bit(E_DETAIN))!=0); 
 	    }
 	  else if (isEndcap)
 	    {
-	      LogTrace("") << "\t... sieie value " << sieie << " (endcap), pass? " << electron_sel[2]; 
-	      LogTrace("") << "\t... detain value " << detain << " (endcap), pass? " << electron_sel[2]; 
+	      LogTrace("") << "\t... sieie value " << sieie << " (endcap), pass? " << ((electron_sel & NMinusOne::bit(E_SIEIE))!=0); 
+	      LogTrace("") << "\t... detain value " << detain << " (endcap), pass? " << ((electron_sel & NMinusOne::bit(E_SIEIE))!=0); 
 	    }
 	  
 	  if (isBarrel) 
@@ -738,23 +763,23 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 	  //isovar += mu.isolationR03().hadEt;
 	  //}
 	  //if (isRelativeIso_) isovar /= pt;
-	  if (ecalisovar<ecalIsoCutBarrel_ && isBarrel) electron_sel[4] = true; 
-	  if (ecalisovar<ecalIsoCutEndcap_ && isEndcap) electron_sel[4] = true; 
-	  if (hcalisovar<hcalIsoCutBarrel_ && isBarrel) electron_sel[5] = true; 
-	  if (hcalisovar<hcalIsoCutEndcap_ && isEndcap) electron_sel[5] = true; 
-	  if (trkisovar<trkIsoCutBarrel_ && isBarrel) electron_sel[6] = true;   
-	  if (trkisovar<trkIsoCutEndcap_ && isEndcap) electron_sel[6] = true;   
+	  electron_sel |= NMinusOne::bit(E_ECALISO, ecalisovar<ecalIsoCutBarrel_ && isBarrel);
+	  electron_sel |= NMinusOne::bit(E_ECALISO, ecalisovar<ecalIsoCutEndcap_ && isEndcap);
+	  electron_sel |= NMinusOne::bit(E_HCALISO, hcalisovar<hcalIsoCutBarrel_ && isBarrel);
+	  electron_sel |= NMinusOne::bit(E_HCALISO, hcalisovar<hcalIsoCutEndcap_ && isEndcap);
+	  electron_sel |= NMinusOne::bit(E_TRKISO, trkisovar<trkIsoCutBarrel_ && isBarrel);
+	  electron_sel |= NMinusOne::bit(E_TRKISO, trkisovar<trkIsoCutEndcap_ && isEndcap);
 	  if (isBarrel)
 	    {
-	      LogTrace("") << "\t... ecal isolation value " << ecalisovar << " (barrel), pass? " << electron_sel[4]; 
-	      LogTrace("") << "\t... hcal isolation value " << hcalisovar << " (barrel), pass? " << electron_sel[5];
-	      LogTrace("") << "\t... trk isolation value " << trkisovar << " (barrel), pass? " << electron_sel[6];
+	      LogTrace("") << "\t... ecal isolation value " << ecalisovar << " (barrel), pass? " << ((electron_sel & NMinusOne::bit(E_ECALISO))!=0); 
+	      LogTrace("") << "\t... hcal isolation value " << hcalisovar << " (barrel), pass? " << ((electron_sel & NMinusOne::bit(E_HCALISO))!=0);
+	      LogTrace("") << "\t... trk isolation value " << trkisovar << " (barrel), pass? " << ((electron_sel & NMinusOne::bit(E_TRKISO))!=0);
 	    }
 	  else if (isEndcap)
 	    {
-	      LogTrace("") << "\t... ecal isolation value " << ecalisovar << " (endcap), pass? " << electron_sel[4]; 
-	      LogTrace("") << "\t... hcal isolation value " << hcalisovar << " (endcap), pass? " << electron_sel[5];
-	      LogTrace("") << "\t... trk isolation value " << trkisovar << " (endcap), pass? " << electron_sel[6];
+	      LogTrace("") << "\t... ecal isolation value " << ecalisovar << " (endcap), pass? " << ((electron_sel & NMinusOne::bit(E_ECALISO))!=0); 
+	      LogTrace("") << "\t... hcal isolation value " << hcalisovar << " (endcap), pass? " << ((electron_sel & NMinusOne::bit(E_HCALISO))!=0);
+	      LogTrace("") << "\t... trk isolation value " << trkisovar << " (endcap), pass? " << ((electron_sel & NMinusOne::bit(E_TRKISO))!=0);
 	    }
 	  
 	  //iso_before_->Fill(isovar);
@@ -773,7 +798,7 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 	  
 	  
 	  // HLT 
-	  if (trigger_fired) electron_sel[7] = true; 
+	  electron_sel |= NMinusOne::bit(E_HLT, trigger_fired);
 	  
 	  
 	  //             // MET/MT cuts
@@ -785,9 +810,9 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 	  massT = (massT>0) ? sqrt(massT) : 0;
 	  
 	  LogTrace("") << "\t... W mass, W_et, W_px, W_py: " << massT << ", " << w_et << ", " << w_px << ", " << w_py << " [GeV]";
-	  if (massT>mtMin_ && massT<mtMax_) electron_sel[8] = true; 
+	  electron_sel |= NMinusOne::bit(E_MT, massT>mtMin_ && massT<mtMax_);
 	  mt_before_->Fill(massT);
-	  if (met_et>metMin_ && met_et<metMax_) electron_sel[9] = true; 
+	  electron_sel |= NMinusOne::bit(E_MET, met_et>metMin_ && met_et<metMax_);
 	  
 	  //             // Acoplanarity cuts
 	  //             Geom::Phi<double> deltaphi(mu.phi()-atan2(met_py,met_px));
@@ -800,22 +825,13 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 	  
 	  //             // Remaining flags (from global event information)
 	  //             if (nmuonsForZ1<1 || nmuonsForZ2<2) muon_sel[11] = true; 
-	  if (njets<=nJetMax_) electron_sel[10] = true; 
+	  electron_sel |= NMinusOne::bit(E_NJETS, njets<=nJetMax_);
 	  
 	  // Collect necessary flags "per electron"
-	  int flags_passed = 0;
-	  bool rec_sel_this = true;
-	  bool eid_sel_this = true;
-	  bool iso_sel_this = true;
-	  bool all_sel_this = true;
-	  for (int j=0; j<NFLAGS; ++j) 
-	    {
-	      if (electron_sel[j]) flags_passed += 1;
-	      if (j<2  && !electron_sel[j]) rec_sel_this = false;
-	      if (j<4  && !electron_sel[j]) eid_sel_this = false;
-	      if (j<7  && !electron_sel[j]) iso_sel_this = false;
-	      if (!electron_sel[j]) all_sel_this = false;
-	    }
+	  bool rec_sel_this = (electron_sel & REC_CUTS)==REC_CUTS;
+	  bool eid_sel_this = (electron_sel & EID_CUTS)==EID_CUTS;
+	  bool iso_sel_this = (electron_sel & ISO_CUTS)==ISO_CUTS;
+	  bool all_sel_this = wSel_.passed(electron_sel);
 	  
 	  if (all_sel_this)
 	    {
@@ -851,128 +867,20 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 	  if (all_sel_this) all_sel = true;
 
 	  // Do N-1 histograms now (and only once for global event quantities)
-	  if (flags_passed >= (NFLAGS-1)) 
-	    {
-	      if (!electron_sel[0] || flags_passed==NFLAGS) 
-		{
-		  pt_after_->Fill(pt);
-		}
-	      if (!electron_sel[1] || flags_passed==NFLAGS) 
-		{
-		  eta_after_->Fill(eta);
-		}
-	      if (!electron_sel[2] || flags_passed==NFLAGS) 
-		{
-		  if (isBarrel)
-		    {
-		      sieiebarrel_after_->Fill(sieie);
-		    }
-		  else if (isEndcap)
-		    {
-		      sieieendcap_after_->Fill(sieie);
-		    }
-		}
-	      if (!electron_sel[3] || flags_passed==NFLAGS) 
-		{
-		  if (isBarrel)
-		    {
-		      detainbarrel_after_->Fill(detain);
-		    }
-		  else if (isEndcap)
-		    {
-		      detainendcap_after_->Fill(detain);
-		    }
-		}
-	      if (!electron_sel[4] || flags_passed==NFLAGS) 
-		{
-		  if (isBarrel)
-		    {
-		      ecalisobarrel_after_->Fill(ecalisovar);
-		    }
-		  else if (isEndcap)
-		    {
-		      ecalisoendcap_after_->Fill(ecalisovar);
-		    }
-		}
-	      if (!electron_sel[5] || flags_passed==NFLAGS) 
-		{
-		  if (isBarrel)
-		    {
-		      hcalisobarrel_after_->Fill(hcalisovar);
-		    }
-		  else if (isEndcap)
-		    {
-		      hcalisoendcap_after_->Fill(hcalisovar);
-		    }
-		}
-	      if (!electron_sel[6] || flags_passed==NFLAGS) 
-		{
-		  if (isBarrel)
-		    {
-		      trkisobarrel_after_->Fill(trkisovar);
-		    }
-		  else if (isEndcap)
-		    {
-		      trkisoendcap_after_->Fill(trkisovar);
-		    }
-		}
-	      // 		if (!electron_sel[3] || flags_passed==NFLAGS) 
-	      // 		  {
-	      // 		    detain_after_->Fill(detain);
-	      // 		  }
-	      // 		if (!electron_sel[4] || flags_passed==NFLAGS) 
-	      // 		  {
-	      // 		    ecaliso_after_->Fill(trackerHits);
-	      // 		  }
-	      // 		if (!electron_sel[5] || flags_passed==NFLAGS) 
-	      // 		  {
-	      // 		    tkelectr_after_->Fill(electr.isTrackerElectron());
-	      // 		  }
-	      // 		if (!electron_sel[6] || flags_passed==NFLAGS) 
-	      // 		  {
-	      // 		    iso_after_->Fill(isovar);
-	      // 		  }
-	      if (!electron_sel[7] || flags_passed==NFLAGS) 
-		{
-		  if (!hlt_hist_done) 
-		    {
-		      trig_after_->Fill(trigger_fired);
-		    }
-		}
-	      hlt_hist_done = true;
-	      if (!electron_sel[8] || flags_passed==NFLAGS) 
-		{
-		  mt_after_->Fill(massT);
-		}
-	      if (!electron_sel[9] || flags_passed==NFLAGS) 
-		{
-		  if (!met_hist_done) {
-		    met_after_->Fill(met_et);
-		  }
-		}
-	      met_hist_done = true;
-	      //                   if (!muon_sel[10] || flags_passed==NFLAGS) 
-	      //                         acop_after_->Fill(acop);
-	      //                   if (!muon_sel[11] || flags_passed==NFLAGS) 
-	      //                         if (!nz1_hist_done) nz1_after_->Fill(nmuonsForZ1);
-	      //                         nz1_hist_done = true;
-	      //                   if (!muon_sel[11] || flags_passed==NFLAGS) 
-	      //                         if (!nz2_hist_done) nz2_after_->Fill(nmuonsForZ2);
-	      //                         nz2_hist_done = true;
-	      if (!electron_sel[10] || flags_passed==NFLAGS) {
-		if (!njets_hist_done) 
-		  {
-		    njets_after_->Fill(njets);
-		    if (jet_et>10) //don't want low energy "jets"
-		      {
-			jet_et_after_   ->Fill(jet_et);
-			jet_eta_after_  ->Fill(jet_eta);
-		      }
-		  }
-	      }
-	      njets_hist_done = true;
-
-            } // end N-1 histos block
+	  wSel_.set(PT     , pt        );
+	  wSel_.set(ETA    , eta       );
+	  wSel_.set(SIEIE  , sieie     );
+	  wSel_.set(DETAIN , detain    );
+	  wSel_.set(ECALISO, ecalisovar);
+	  wSel_.set(HCALISO, hcalisovar);
+	  wSel_.set(TRKISO , trkisovar );
+	  wSel_.set(HLT    , trigger_fired);
+	  wSel_.set(MT     , massT     );
+	  wSel_.set(MET    , met_et    );
+	  wSel_.set(NJETS  , njets     );
+	  wSel_.set(JET_ET , jet_et    );
+	  wSel_.set(JET_ETA, jet_eta   );
+	  wSel_.fill(electron_sel, (isBarrel ? BARREL : 0) | (isEndcap ? ENDCAP : 0) | (jet_et>10 ? HARDJET : 0));
 	  
 	} // end loop through electrons
 
@@ -1005,6 +913,7 @@ void EwkElecDQM::analyze (const Event & ev, const EventSetup &) {
 
       if (all_sel) {
             nsel++;
+            if (trends_) trends_->count(wTrend_);
             LogTrace("") << ">>>> Event ACCEPTED";
       } else {
             LogTrace("") << ">>>> Event REJECTED";
@@ -13,22 +13,36 @@
 
 #include "FWCore/Framework/interface/EDAnalyzer.h"
 #include "FWCore/Utilities/interface/InputTag.h"
+#include "DQM/Physics/interface/NMinusOne.h"
+#include "DQM/Physics/interface/LumiTrends.h"
 
 class DQMStore;
 class MonitorElement;
 class EwkElecDQM : public edm::EDAnalyzer {
 public:
   EwkElecDQM (const edm::ParameterSet &);
+  virtual ~EwkElecDQM();
   virtual void analyze(const edm::Event&, const edm::EventSetup&);
   virtual void beginJob();
   virtual void endJob();
   virtual void beginRun(const edm::Run&, const edm::EventSetup&);
   virtual void endRun(const edm::Run&, const edm::EventSetup&);
+  virtual void endLuminosityBlock(const edm::LuminosityBlock&, const edm::EventSetup&);
 
   double calcDeltaPhi(double phi1, double phi2);
 
   void init_histograms();
 private:
+  /// flags of the W selection
+  enum WFlags { E_PT, E_ETA, E_SIEIE, E_DETAIN, E_ECALISO, E_HCALISO, E_TRKISO, E_HLT, E_MT, E_MET, E_NJETS, NWFLAGS };
+  /// values of the N-1 histograms
+  enum Values { PT, ETA, SIEIE, DETAIN, ECALISO, HCALISO, TRKISO, HLT, MT, MET, NJETS, JET_ET, JET_ETA, NVALUES };
+  /// context of the N-1 histograms (barrel/endcap electron, leading jet above 10 GeV)
+  enum Context { BARREL=1, ENDCAP=2, HARDJET=4 };
+  /// groups of flags for the rec, eid and iso selection steps
+  static const unsigned int REC_CUTS = (1u<<E_PT)|(1u<<E_ETA);
+  static const unsigned int EID_CUTS = REC_CUTS|(1u<<E_SIEIE)|(1u<<E_DETAIN);
+  static const unsigned int ISO_CUTS = EID_CUTS|(1u<<E_ECALISO)|(1u<<E_HCALISO)|(1u<<E_TRKISO);
 
   edm::InputTag trigTag_;
   //  edm::InputTag muonTag_;
@@ -181,6 +195,13 @@ private:
 /*   MonitorElement* jet2_et_before_; */
 /*   MonitorElement* jet2_et_after_; */
 
+  // N-1 histograms of the W selection
+  NMinusOne wSel_;
+
+  // W candidates per lumi section (0 if not configured)
+  LumiTrends* trends_;
+  unsigned int wTrend_;
+
 };
 
 
@@ -24,6 +24,7 @@
 
 #include "FWCore/Common/interface/TriggerNames.h"
 #include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
 #include "DataFormats/Common/interface/TriggerResults.h"
 
 #include "DataFormats/Common/interface/View.h"
@@ -34,6 +35,17 @@ using namespace edm;
 using namespace std;
 using namespace reco;
 
+namespace {
+  /// per muon quantities and cut results (see EwkMuDQM::MuonFlags)
+  struct MuonCuts {
+    MuonCuts() : valid(false), mask(0), pt(0.), eta(0.), dxy(0.), iso(0.), charge(0.), quality(false) {}
+    bool valid;
+    unsigned int mask;
+    double pt, eta, dxy, iso, charge;
+    bool quality;
+  };
+}
+
 EwkMuDQM::EwkMuDQM( const ParameterSet & cfg ) :
       // Input collections
       trigTag_      (cfg.getUntrackedParameter<edm::InputTag> ("TrigTag", edm::InputTag("TriggerResults::HLT"))),
@@ -80,7 +92,23 @@ EwkMuDQM::EwkMuDQM( const ParameterSet & cfg ) :
 
       // Photon cuts 
       ptThrForPhoton_(cfg.getUntrackedParameter<double>("ptThrForPhoton",5.)),
-      nPhoMax_(cfg.getUntrackedParameter<int>("nPhoMax", 999999)) 
+      nPhoMax_(cfg.getUntrackedParameter<int>("nPhoMax", 999999)),
+
+      // Batch size for the per-muon fills (<=1 means no batching)
+      fillBatchSize_(cfg.getUntrackedParameter<unsigned int>("fillBatchSize", 128)),
+
+      // Sampling of the distributions before cuts (none if not configured)
+      sampling_(0),
+
+      // Trends per lumi section (none if not configured)
+      trends_(0), wTrend_(0), zTrend_(0),
+
+      // Event index per lumi section (none if not configured)
+      index_(0), wIndex_(0), zIndex_(0),
+
+      // N-1 histograms
+      wSel_(NWFLAGS, NVALUES),
+      zSel_(NZFLAGS, NVALUES)
 {
   isValidHltConfig_ = false;
 
@@ -88,6 +116,34 @@ EwkMuDQM::EwkMuDQM( const ParameterSet & cfg ) :
   theDbe->setCurrentFolder("Physics/EwkMuDQM");
   init_histograms();
 
+  // 1-in-N and/or CPU time budget [ms/event] (<=1 and <=0: no sampling)
+  unsigned int samplingPrescale = cfg.getUntrackedParameter<unsigned int>("SamplingPrescale", 1);
+  double samplingTimeBudget = cfg.getUntrackedParameter<double>("SamplingTimeBudget", 0.);
+  if (samplingPrescale>1 || samplingTimeBudget>0.) {
+        sampling_ = new MonitorSampling("Physics/EwkMuDQM/", samplingPrescale, samplingTimeBudget);
+  }
+
+  // Number of lumi sections with one bin in the trends (0: no trends)
+  unsigned int trendLumis = cfg.getUntrackedParameter<unsigned int>("trendLumis", 0);
+  if (trendLumis>0) {
+        trends_ = new LumiTrends("Physics/EwkMuDQM/", trendLumis);
+        wTrend_ = trends_->add("WMuNu", "W#rightarrow#mu#nu candidates per lumi section");
+        zTrend_ = trends_->add("ZMuMu", "Z#rightarrow#mu#mu candidates per lumi section");
+  }
+
+  // File for the index of the W and Z candidates per lumi section ("": no index)
+  std::string indexFile = cfg.getUntrackedParameter<std::string>("EventIndexFile", "");
+  if (!indexFile.empty()) {
+        index_ = new SelectionIndex(indexFile, cfg.getParameter<std::string>("@module_label"));
+        wIndex_ = index_->add("WMuNu");
+        zIndex_ = index_->add("ZMuMu");
+  }
+}
+
+EwkMuDQM::~EwkMuDQM() {
+  if (sampling_) delete sampling_;
+  if (trends_) delete trends_;
+  if (index_) delete index_;
 }
 
 void EwkMuDQM::beginRun(const Run& iRun, const EventSetup& iSet) {
@@ -105,6 +161,7 @@ void EwkMuDQM::beginRun(const Run& iRun, const EventSetup& iSet) {
      // isValidHltConfig_ used to short-circuit analyze() in case of problems
      isValidHltConfig_ = hltConfigProvider_.init( iRun, iSet, "HLT", isConfigChanged );
 
+     if (trends_) trends_->beginRun();
 }
 
 void EwkMuDQM::beginJob() {
@@ -116,9 +173,11 @@ void EwkMuDQM::init_histograms() {
   char chtitle[256] = "";
 
   pt_before_ = theDbe->book1D("PT_BEFORECUTS","Muon transverse momentum (global muon) [GeV]",100,0.,100.);
+  pt_before_buffer_.attach(pt_before_, fillBatchSize_);
   pt_after_ = theDbe->book1D("PT_AFTERWCUTS","Muon transverse momentum (global muon) [GeV]",100,0.,100.);
 
   eta_before_ = theDbe->book1D("ETA_BEFORECUTS","Muon pseudo-rapidity",50,-2.5,2.5);
+  eta_before_buffer_.attach(eta_before_, fillBatchSize_);
   eta_after_ = theDbe->book1D("ETA_AFTERWCUTS","Muon pseudo-rapidity",50,-2.5,2.5);
 
   dxy_before_ = theDbe->book1D("DXY_BEFORECUTS","Muon transverse distance to beam spot [cm]",1000,-0.5,0.5);
@@ -241,43 +300,97 @@ void EwkMuDQM::init_histograms() {
   phEta_ = theDbe->book1D("phEta",chtitle,100,-2.5,2.5); 
   //pfphEta_ = theDbe->book1D("pfphEta","PF Photon pseudorapidity",100,-2.5,2.5); 
 
+  // N-1 histograms of the W selection
+  wSel_.add(W_PT     , pt_after_            , PT         );
+  wSel_.add(W_ETA    , eta_after_           , ETA        );
+  wSel_.add(W_DXY    , dxy_after_           , DXY        );
+  wSel_.add(W_QUALITY, goodewkmuon_after_   , QUALITY    );
+  wSel_.add(W_ISO    , iso_after_           , ISO        );
+  wSel_.add(W_HLT    , trig_after_          , HLT        , true);
+  wSel_.add(W_MT     , mt_after_            , MT         );
+  wSel_.add(W_MET    , met_after_           , MET        , true);
+  wSel_.add(W_ACOP   , acop_after_          , ACOP       );
+  wSel_.add(W_NJETS  , njets_after_         , NJETS      , true);
+  wSel_.add(W_NJETS  , leadingjet_pt_after_ , LEADJET_PT , true);
+  wSel_.add(W_NJETS  , leadingjet_eta_after_, LEADJET_ETA, true);
+  wSel_.add(NMinusOne::ALL, npvs_after_      , NPVS       , true);
+  wSel_.add(NMinusOne::ALL, muoncharge_after_, CHARGE     , true);
+
+  // N-1 histograms of the Z selection
+  zSel_.add(Z_PT1     , pt1_afterZ_           , PT         );
+  zSel_.add(Z_ETA1    , eta1_afterZ_          , ETA        );
+  zSel_.add(Z_DXY1    , dxy1_afterZ_          , DXY        );
+  zSel_.add(Z_QUALITY1, goodewkmuon1_afterZ_  , QUALITY    );
+  zSel_.add(Z_ISO1    , iso1_afterZ_          , ISO        );
+  zSel_.add(Z_PT2     , pt2_afterZ_           , PT2        );
+  zSel_.add(Z_ETA2    , eta2_afterZ_          , ETA2       );
+  zSel_.add(Z_DXY2    , dxy2_afterZ_          , DXY2       );
+  zSel_.add(Z_QUALITY2, goodewkmuon2_afterZ_  , QUALITY2   );
+  zSel_.add(Z_ISO2    , iso2_afterZ_          , ISO2       );
+  zSel_.add(Z_HLT     , ztrig_afterZ_         , HLT        , true);
+  zSel_.add(Z_MASS    , dimuonmass_afterZ_    , MASS       );
+  zSel_.add(Z_NJETS   , njets_afterZ_         , NJETS      , true);
+  zSel_.add(Z_NJETS   , leadingjet_pt_afterZ_ , LEADJET_PT , true);
+  zSel_.add(Z_NJETS   , leadingjet_eta_afterZ_, LEADJET_ETA, true);
+  zSel_.add(NMinusOne::ALL, met_afterZ_       , MET        );
+  zSel_.add(NMinusOne::ALL, npvs_afterZ_      , NPVS       , true);
+  zSel_.add(NMinusOne::ALL, muoncharge_afterZ_, CHARGE     , true);
+  zSel_.add(NMinusOne::ALL, ptDiffPM_afterZ_  , PTDIFF     , true);
+
 }
 
 
 void EwkMuDQM::endJob() {
+  pt_before_buffer_.flush();
+  eta_before_buffer_.flush();
 }
 
 void EwkMuDQM::endRun(const Run& r, const EventSetup& iSet) {
+  pt_before_buffer_.flush();
+  eta_before_buffer_.flush();
+}
 
+void EwkMuDQM::endLuminosityBlock(const LuminosityBlock& lumiBlock, const EventSetup& iSet) {
+  pt_before_buffer_.flush();
+  eta_before_buffer_.flush();
+  if (trends_) trends_->append(lumiBlock.id().luminosityBlock());
+  if (index_) index_->write(lumiBlock.id().run(), lumiBlock.id().luminosityBlock());
 }
 
 void EwkMuDQM::analyze (const Event & ev, const EventSetup & iSet) {
+
+      if (trends_) trends_->event();
       
-      // Muon collection
-      Handle<View<Muon> > muonCollection;
-      if (!ev.getByLabel(muonTag_, muonCollection)) {
-	//LogWarning("") << ">>> Muon collection does not exist !!!";
+      // Muon collection and beam spot; the muon quantities are read
+      // from the columnar snapshot of the muons of this event
+      if (!muonColumns_.fill(ev, muonTag_, InputTag("offlineBeamSpot"))) {
+	//LogWarning("") << ">>> Muon collection or beam spot does not exist !!!";
 	return;
       }
-      unsigned int muonCollectionSize = muonCollection->size();
+      const MuonColumns& mus = muonColumns_;
+      unsigned int muonCollectionSize = mus.size();
 
-      // Beam spot
-      Handle<reco::BeamSpot> beamSpotHandle;
-      if (!ev.getByLabel(InputTag("offlineBeamSpot"), beamSpotHandle)) {
-	//LogWarning("") << ">>> No beam spot found !!!";
-	return;
-      }
+      // The distributions before cuts are only filled for sampled events
+      bool sampled = !sampling_ || sampling_->next();
+      MonitorSampling::Clock clock(sampling_);
 
 
+      // Masses of all muon pairs (massless approximation), used
+      // for the Z rejection and for the Z selection below
+      dileptons_.clear();
+      for (unsigned int i=0; i<muonCollectionSize; i++) {
+            dileptons_.add(mus.px[i], mus.py[i], mus.pz[i], mus.p[i], mus.charge[i]);
+      }
+      dileptons_.compute();
+
       // Loop to reject/control Z->mumu is done separately
       unsigned int nmuonsForZ1 = 0;
       unsigned int nmuonsForZ2 = 0;
       bool cosmic = false;
       for (unsigned int i=0; i<muonCollectionSize; i++) {
-            const Muon& mu = muonCollection->at(i);
-            if (!mu.isGlobalMuon()) continue;
-            double pt = mu.pt();
-            double dxy = mu.innerTrack()->dxy(beamSpotHandle->position());
+            if (!mus.is(i, MuonColumns::GLOBAL)) continue;
+            double pt = mus.pt[i];
+            double dxy = mus.innerDxy[i];
 
             if (fabs(dxy)>1) { cosmic=true; break;} 
 
@@ -285,15 +398,13 @@ void EwkMuDQM::analyze (const Event & ev, const EventSetup & iSet) {
             if (pt>ptThrForZ2_) nmuonsForZ2++;
 
             for (unsigned int j=i+1; j<muonCollectionSize; j++) {
-                 const Muon& mu2 = muonCollection->at(j);
-                 if (mu2.isGlobalMuon() && (mu.charge()*mu2.charge()==-1) ){
-                         const math::XYZTLorentzVector ZRecoGlb (mu.px()+mu2.px(), mu.py()+mu2.py() , mu.pz()+mu2.pz(), mu.p()+mu2.p());
-                         dimuonmass_before_->Fill(ZRecoGlb.mass());
-			 if (mu.charge()>0) {
-			   ptDiffPM_before_->Fill(mu.pt()-mu2.pt());
+                 if (sampled && mus.is(j, MuonColumns::GLOBAL) && (mus.charge[i]*mus.charge[j]==-1) ){
+                         dimuonmass_before_->Fill(dileptons_.mass(i, j));
+			 if (mus.charge[i]>0) {
+			   ptDiffPM_before_->Fill(mus.pt[i]-mus.pt[j]);
 			 }
 			 else {
-			   ptDiffPM_before_->Fill(mu2.pt()-mu.pt());
+			   ptDiffPM_before_->Fill(mus.pt[j]-mus.pt[i]);
 			 }
                  }
             }
@@ -312,7 +423,7 @@ void EwkMuDQM::analyze (const Event & ev, const EventSetup & iSet) {
       const MET& met = metCollection->at(0);
       double met_et = met.pt();
       LogTrace("") << ">>> MET, MET_px, MET_py: " << met_et << ", " << met.px() << ", " << met.py() << " [GeV]";
-      met_before_->Fill(met_et);
+      if (sampled) met_before_->Fill(met_et);
 
       // Vertices in the event
       Handle<View<reco::Vertex> > vertexCollection;
@@ -376,8 +487,7 @@ void EwkMuDQM::analyze (const Event & ev, const EventSetup & iSet) {
             const Jet& jet = jetCollection->at(i);
                   double minDistance=99999; // This is in order to use PFJets
                   for (unsigned int j=0; j<muonCollectionSize; j++) {
-                        const Muon& mu = muonCollection->at(j);
-                        double distance = sqrt( (mu.eta()-jet.eta())*(mu.eta()-jet.eta()) +(mu.phi()-jet.phi())*(mu.phi()-jet.phi()) );      
+                        double distance = sqrt( (mus.eta[j]-jet.eta())*(mus.eta[j]-jet.eta()) +(mus.phi[j]-jet.phi())*(mus.phi[j]-jet.phi()) );      
                         if (minDistance>distance) minDistance=distance;
                   }
                   if (minDistance<0.3) continue; // 0.3 is the isolation cone around the muon
@@ -393,8 +503,10 @@ void EwkMuDQM::analyze (const Event & ev, const EventSetup & iSet) {
       double lead_jet_eta=-100;
       if(LEADJET!=-1){
       const Jet& leadJet = jetCollection->at(LEADJET);
-      leadingjet_pt_before_->Fill(leadJet.pt());
-      leadingjet_eta_before_->Fill(leadJet.eta());
+      if (sampled) {
+            leadingjet_pt_before_->Fill(leadJet.pt());
+            leadingjet_eta_before_->Fill(leadJet.eta());
+      }
       lead_jet_pt=leadJet.pt();
       lead_jet_eta=leadJet.eta();
       }
@@ -411,9 +523,9 @@ void EwkMuDQM::analyze (const Event & ev, const EventSetup & iSet) {
       	double photonPt = ph.pt();
       	if (photonPt> ptThrForPhoton_) {
 	  ngam++;
-	  phEta_->Fill(ph.eta());
+	  if (sampled) phEta_->Fill(ph.eta());
 	}
-	phPt_->Fill(photonPt); 
+	if (sampled) phPt_->Fill(photonPt); 
       	}
       nph_->Fill(ngam); 
       LogTrace("") << " >>> N photons " << ngam << std::endl;
@@ -441,61 +553,49 @@ void EwkMuDQM::analyze (const Event & ev, const EventSetup & iSet) {
       // Start counting
       nall++;
 
-      // Histograms per event should be done only once, so keep track of them
-      bool hlt_hist_done = false;
-      bool zhlt_hist_done = false;
-      bool zjets_hist_done = false;
-      bool zfullsel_hist_done = false;
-      bool met_hist_done = false;
-      bool njets_hist_done = false;
-      bool wfullsel_hist_done = false;
+      // N-1 histograms of event quantities are filled only once per event
+      wSel_.reset();
+      zSel_.reset();
 
-      // Central W->mu nu selection criteria
-      const int NFLAGS = 11;
-      bool muon_sel[NFLAGS];
-      const int NFLAGSZ = 13;
-      bool zmuon_sel[NFLAGSZ];
-      bool muon4Z=false;
+      // Per muon quantities and cut results; they are determined once per
+      // muon and reused for the W selection and for both legs of the Z
+      // selection, where they are combined via bitwise operations
+      std::vector<MuonCuts> muons(muonCollectionSize);
 
       double number_of_muons=0;
       double number_of_goodMuons=0;
 
-
       for (unsigned int i=0; i<muonCollectionSize; i++) {
-            for (int j=0; j<NFLAGS; ++j) {
-                  muon_sel[j] = false;
-            }
-
             number_of_muons++;
 
-            const Muon& mu = muonCollection->at(i);
-            if (!mu.isGlobalMuon()) continue;
-            if (mu.globalTrack().isNull()) continue;
-            if (mu.innerTrack().isNull()) continue;
+            if (!mus.is(i, MuonColumns::GLOBAL | MuonColumns::HAS_GLOBAL_TRACK | MuonColumns::HAS_INNER_TRACK)) continue;
 
             LogTrace("") << "> Wsel: processing muon number " << i << "...";
-            reco::TrackRef gm = mu.globalTrack();
-            reco::TrackRef tk = mu.innerTrack();
+            MuonCuts& cuts = muons[i];
+            cuts.valid = true;
 
             // Pt,eta cuts
-            double pt = mu.pt();
-            double eta = mu.eta();
-            LogTrace("") << "\t... pt, eta: " << pt << " [GeV], " << eta;;
-            if (pt>ptCut_) muon_sel[0] = true; 
-            if (fabs(eta)<etaCut_) muon_sel[1] = true; 
+            cuts.pt = mus.pt[i];
+            cuts.eta = mus.eta[i];
+            LogTrace("") << "\t... pt, eta: " << cuts.pt << " [GeV], " << cuts.eta;;
+            cuts.mask |= NMinusOne::bit(MU_PT, cuts.pt>ptCut_);
+            cuts.mask |= NMinusOne::bit(MU_ETA, fabs(cuts.eta)<etaCut_);
+            cuts.mask |= NMinusOne::bit(MU_PTZ1, cuts.pt>ptThrForZ1_);
+            cuts.mask |= NMinusOne::bit(MU_PTZ2, cuts.pt>ptThrForZ2_);
 
-            double charge=mu.charge();
+            cuts.charge=mus.charge[i];
 
             // d0, chi2, nhits quality cuts
-            double dxy = gm->dxy(beamSpotHandle->position());
-            double normalizedChi2 = gm->normalizedChi2();
-            double trackerHits = tk->hitPattern().numberOfValidTrackerHits();
-            int pixelHits = tk->hitPattern().numberOfValidPixelHits();
-            int muonHits = gm->hitPattern().numberOfValidMuonHits();
-            int nMatches = mu.numberOfMatches();
+            cuts.dxy = mus.globalDxy[i];
+            double normalizedChi2 = mus.globalNormalizedChi2[i];
+            double trackerHits = mus.trackerHits[i];
+            int pixelHits = mus.pixelHits[i];
+            int muonHits = mus.muonHits[i];
+            int nMatches = mus.nMatches[i];
+            bool isTrackerMuon = mus.is(i, MuonColumns::TRACKER);
 
-            LogTrace("") << "\t... dxy, normalizedChi2, trackerHits, isTrackerMuon?: " << dxy << " [cm], " << normalizedChi2 << ", " << trackerHits << ", " << mu.isTrackerMuon();
-            if (fabs(dxy)<dxyCut_) muon_sel[2] = true; 
+            LogTrace("") << "\t... dxy, normalizedChi2, trackerHits, isTrackerMuon?: " << cuts.dxy << " [cm], " << normalizedChi2 << ", " << trackerHits << ", " << isTrackerMuon;
+            cuts.mask |= NMinusOne::bit(MU_DXY, fabs(cuts.dxy)<dxyCut_);
 
             bool quality=true;
             
@@ -503,15 +603,18 @@ void EwkMuDQM::analyze (const Event & ev, const EventSetup & iSet) {
             if (trackerHits<trackerHitsCut_) quality =false;
             if (pixelHits<pixelHitsCut_) quality =false;
             if (muonHits<muonHitsCut_) quality=false;;
-            if (!mu.isTrackerMuon()) quality=false;
+            if (!isTrackerMuon) quality=false;
             if (nMatches<nMatchesCut_) quality=false;
-            muon_sel[3]=quality;
+            cuts.quality = quality;
+            cuts.mask |= NMinusOne::bit(MU_QUALITY, quality);
             if(quality) number_of_goodMuons++;
 
-            pt_before_->Fill(pt);
-            eta_before_->Fill(eta);
-            dxy_before_->Fill(dxy);
-            muoncharge_before_->Fill(charge);
+            if (sampled) {
+                  pt_before_buffer_.fill(cuts.pt);
+                  eta_before_buffer_.fill(cuts.eta);
+                  dxy_before_->Fill(cuts.dxy);
+                  muoncharge_before_->Fill(cuts.charge);
+            }
             goodewkmuon_before_->Fill(quality);
 
 	    // Charge asymmetry
@@ -522,204 +625,136 @@ void EwkMuDQM::analyze (const Event & ev, const EventSetup & iSet) {
 
 
             // Isolation cuts
-            double isovar = mu.isolationR03().sumPt;
+            cuts.iso = mus.isoR03SumPt[i];
             if (isCombinedIso_) {
-                  isovar += mu.isolationR03().emEt;
-                  isovar += mu.isolationR03().hadEt;
+                  cuts.iso += mus.isoR03EmEt[i];
+                  cuts.iso += mus.isoR03HadEt[i];
             }
-            if (isRelativeIso_) isovar /= pt;
-            if (isovar<isoCut03_) muon_sel[4] = true; 
+            if (isRelativeIso_) cuts.iso /= cuts.pt;
+            cuts.mask |= NMinusOne::bit(MU_ISO, cuts.iso<isoCut03_);
 
-            LogTrace("") << "\t... isolation value" << isovar <<", isolated? " << muon_sel[6];
-            iso_before_->Fill(isovar);
+            LogTrace("") << "\t... isolation value" << cuts.iso <<", isolated? " << (cuts.iso<isoCut03_);
+            if (sampled) iso_before_->Fill(cuts.iso);
+      }
 
+      // Central W->mu nu selection criteria
+      bool muon4Z=false;
+      bool wfullsel=false;
+      bool zfullsel=false;
 
-            // HLT (not mtched to muon for the time being)
-            if (trigger_fired) muon_sel[5] = true; 
+      for (unsigned int i=0; i<muonCollectionSize; i++) {
+            const MuonCuts& cuts = muons[i];
+            if (!cuts.valid) continue;
 
             // For Z:
-            if (pt>ptThrForZ1_ && fabs(eta)<etaCut_ && fabs(dxy)<dxyCut_ && quality && trigger_fired && isovar<isoCut03_) { muon4Z = true;}
+            if ((cuts.mask & (LEG_CUTS | NMinusOne::bit(MU_PTZ1)))==(LEG_CUTS | NMinusOne::bit(MU_PTZ1)) && trigger_fired) { muon4Z = true;}
 
 
             // MET/MT cuts
-            double w_et = met_et+mu.pt();
-            double w_px = met.px()+mu.px();
-            double w_py = met.py()+mu.py();
+            double w_et = met_et+mus.pt[i];
+            double w_px = met.px()+mus.px[i];
+            double w_py = met.py()+mus.py[i];
             
             double massT = w_et*w_et - w_px*w_px - w_py*w_py;
             massT = (massT>0) ? sqrt(massT) : 0;
 
             LogTrace("") << "\t... W mass, W_et, W_px, W_py: " << massT << ", " << w_et << ", " << w_px << ", " << w_py << " [GeV]";
-            if (massT>mtMin_ && massT<mtMax_) muon_sel[6] = true; 
-            mt_before_->Fill(massT);
-            if (met_et>metMin_ && met_et<metMax_) muon_sel[7] = true; 
+            if (sampled) mt_before_->Fill(massT);
 
             // Acoplanarity cuts
-            Geom::Phi<double> deltaphi(mu.phi()-atan2(met.py(),met.px()));
+            Geom::Phi<double> deltaphi(mus.phi[i]-atan2(met.py(),met.px()));
             double acop = deltaphi.value();
             if (acop<0) acop = - acop;
             acop = M_PI - acop;
             LogTrace("") << "\t... acoplanarity: " << acop;
-            if (acop<acopCut_) muon_sel[8] = true; 
-            acop_before_->Fill(acop);
-
-            // Remaining flags (from global event information)
-            if (nmuonsForZ1<1 || nmuonsForZ2<2) muon_sel[9] = true; 
-            if (njets<=nJetMax_) muon_sel[10] = true; 
-
-            // Collect necessary flags "per muon"
-            int flags_passed = 0;
-            for (int j=0; j<NFLAGS; ++j) {
-	      if (muon_sel[j]) flags_passed += 1;
-            }
+            if (sampled) acop_before_->Fill(acop);
+
+            // Combine the per muon cut results with the remaining flags
+            // (W kinematics and global event information)
+            unsigned int wmask = (cuts.mask & LEG_CUTS)
+                               | NMinusOne::bit(W_HLT  , trigger_fired)
+                               | NMinusOne::bit(W_MT   , massT>mtMin_ && massT<mtMax_)
+                               | NMinusOne::bit(W_MET  , met_et>metMin_ && met_et<metMax_)
+                               | NMinusOne::bit(W_ACOP , acop<acopCut_)
+                               | NMinusOne::bit(W_ZVETO, nmuonsForZ1<1 || nmuonsForZ2<2)
+                               | NMinusOne::bit(W_NJETS, njets<=nJetMax_);
 
             // Do N-1 histograms now (and only once for global event quantities)
-            if (flags_passed >= (NFLAGS-1)) {
-                  if (!muon_sel[0] || flags_passed==NFLAGS) 
-                        pt_after_->Fill(pt);
-                  if (!muon_sel[1] || flags_passed==NFLAGS) 
-                        eta_after_->Fill(eta);
-                  if (!muon_sel[2] || flags_passed==NFLAGS) 
-                        dxy_after_->Fill(dxy);
-                  if (!muon_sel[3] || flags_passed==NFLAGS)
-                        goodewkmuon_after_->Fill(quality);
-                  if (!muon_sel[4] || flags_passed==NFLAGS) 
-                        iso_after_->Fill(isovar);
-                  if (!muon_sel[5] || flags_passed==NFLAGS) 
-                        if (!hlt_hist_done) trig_after_->Fill(trigger_fired);
-                        hlt_hist_done = true;
-                  if (!muon_sel[6] || flags_passed==NFLAGS) 
-                        mt_after_->Fill(massT);
-                  if (!muon_sel[7] || flags_passed==NFLAGS) 
-                        if (!met_hist_done) met_after_->Fill(met_et);
-                        met_hist_done = true;
-                  if (!muon_sel[8] || flags_passed==NFLAGS) 
-                        acop_after_->Fill(acop);
-		  // no action here for muon_sel[9]
-                  if (!muon_sel[10] || flags_passed==NFLAGS) { 
-                        if (!njets_hist_done) {
-                                    njets_after_->Fill(njets);
-                                    leadingjet_pt_after_->Fill(lead_jet_pt);
-                                    leadingjet_eta_after_->Fill(lead_jet_eta);
-                        }
-                        njets_hist_done = true;
-		  }
-                  if( flags_passed==NFLAGS ) {
-		    if (!wfullsel_hist_done){
-                        npvs_after_->Fill(nvvertex);
-                        muoncharge_after_->Fill(charge);
-			//if (charge>0) ptPlus_afterW_->Fill(pt);
-			//if (charge<0) ptMinus_afterW_->Fill(pt);
-		    }
-		    wfullsel_hist_done=true;    
-                  } 
-	    }
+            wSel_.set(PT         , cuts.pt     );
+            wSel_.set(ETA        , cuts.eta    );
+            wSel_.set(DXY        , cuts.dxy    );
+            wSel_.set(QUALITY    , cuts.quality);
+            wSel_.set(ISO        , cuts.iso    );
+            wSel_.set(HLT        , trigger_fired);
+            wSel_.set(MT         , massT       );
+            wSel_.set(MET        , met_et      );
+            wSel_.set(ACOP       , acop        );
+            wSel_.set(NJETS      , njets       );
+            wSel_.set(LEADJET_PT , lead_jet_pt );
+            wSel_.set(LEADJET_ETA, lead_jet_eta);
+            wSel_.set(NPVS       , nvvertex    );
+            wSel_.set(CHARGE     , cuts.charge );
+            wSel_.fill(wmask);
+            if (wSel_.passed(wmask)) wfullsel = true;
 	    
 
             // The cases in which the event is rejected as a Z are considered independently:
-            if ( muon4Z &&  !muon_sel[9]){
+            if ( muon4Z && !(wmask & NMinusOne::bit(W_ZVETO)) ){
 
                    // Plots for 2 muons       
                    for (unsigned int j=i+1; j<muonCollectionSize; j++) {
-
-                         for (int ij=0; ij<NFLAGSZ; ++ij) {
-                               zmuon_sel[ij] = false;
-                         }
-
-		         for (int ji=0; ji<5; ++ji ) {
-		           zmuon_sel[ji] = muon_sel[ji];
-		         }
-
-                         const Muon& mu2 = muonCollection->at(j);
-                              if (!mu2.isGlobalMuon()) continue;
-                              if (mu2.charge() * charge != -1 ) continue;
-			            reco::TrackRef gm2 = mu2.globalTrack();
-				    reco::TrackRef tk2 = mu2.innerTrack();
-                                    double pt2 = mu2.pt(); if (pt2>ptThrForZ2_) zmuon_sel[5] = true;
-                                    double eta2=mu2.eta(); if (fabs(eta2)<etaCut_) zmuon_sel[6] = true;
-				    double dxy2 = gm2->dxy(beamSpotHandle->position()); if (fabs(dxy2)<dxyCut_) zmuon_sel[7] = true;
-                                    double normalizedChi22 = gm2->normalizedChi2();
-                                    double trackerHits2    = tk2->hitPattern().numberOfValidTrackerHits();
-                                    int    pixelHits2      = tk2->hitPattern().numberOfValidPixelHits();
-                                    int    muonHits2       = gm2->hitPattern().numberOfValidMuonHits();
-                                    int    nMatches2       = mu2.numberOfMatches();
-				    bool quality2=true;
-                                    if (normalizedChi22>normalizedChi2Cut_) quality2 = false; 
-                                    if (trackerHits2<trackerHitsCut_)       quality2 = false;
-                                    if (pixelHits2<pixelHitsCut_)           quality2 = false;
-                                    if (muonHits2<muonHitsCut_)             quality2 = false;
-                                    if (!mu2.isTrackerMuon())               quality2 = false;
-                                    if (nMatches2<nMatchesCut_)             quality2 = false;
-                                    zmuon_sel[8]=quality2;
-                                    double isovar2 = mu2.isolationR03().sumPt; 
-                                    if (isCombinedIso_) {
-                                          isovar2 += mu2.isolationR03().emEt;
-                                          isovar2 += mu2.isolationR03().hadEt;
-                                    }
-                                    if (isRelativeIso_) isovar2 /= pt2;
-                                    if (isovar2<isoCut03_) zmuon_sel[9] = true;
-				    if (trigger_fired) zmuon_sel[10] = true; 
-                               const math::XYZTLorentzVector ZRecoGlb (mu.px()+mu2.px(), mu.py()+mu2.py() , mu.pz()+mu2.pz(), mu.p()+mu2.p());
-			       if (ZRecoGlb.mass()>dimuonMassMin_ && ZRecoGlb.mass()<dimuonMassMax_) zmuon_sel[11] = true; 
-
-					//jet flag
-					if (njets <=nJetMax_) zmuon_sel[12] = true; 
-
-                               // start filling histos: N-1 plots
-			       int  flags_passed_z = 0;
-
-			       for (int jj=0; jj<NFLAGSZ; ++jj) {
-				 if (zmuon_sel[jj]) ++flags_passed_z ;
-			       }
-
-			       if (flags_passed_z >= (NFLAGSZ-1)) {
-				       if (!zmuon_sel[0]  || flags_passed_z==NFLAGSZ) {pt1_afterZ_->Fill(pt); } 
-				       if (!zmuon_sel[1]  || flags_passed_z==NFLAGSZ) {eta1_afterZ_->Fill(eta); }  
-				       if (!zmuon_sel[2]  || flags_passed_z==NFLAGSZ) {dxy1_afterZ_->Fill(dxy); }  
-				       if (!zmuon_sel[3]  || flags_passed_z==NFLAGSZ) {goodewkmuon1_afterZ_->Fill(quality); }  
-				       if (!zmuon_sel[4]  || flags_passed_z==NFLAGSZ) {iso1_afterZ_->Fill(isovar); }  
-				       if (!zmuon_sel[5]  || flags_passed_z==NFLAGSZ) { pt2_afterZ_->Fill(pt2); }  
-				       if (!zmuon_sel[6]  || flags_passed_z==NFLAGSZ) { eta2_afterZ_->Fill(eta2); }  
-				       if (!zmuon_sel[7]  || flags_passed_z==NFLAGSZ) {dxy2_afterZ_->Fill(dxy2); }  
-				       if (!zmuon_sel[8]  || flags_passed_z==NFLAGSZ) {goodewkmuon2_afterZ_->Fill(quality2); }  
-				       if (!zmuon_sel[9]  || flags_passed_z==NFLAGSZ) {iso2_afterZ_->Fill(isovar2); }   
-				       if (!zmuon_sel[10] || flags_passed_z==NFLAGSZ) { 
-                                         if (!zhlt_hist_done) ztrig_afterZ_->Fill(trigger_fired); 
-                                          zhlt_hist_done = true; 
-				       }  
-				       if (!zmuon_sel[11] || flags_passed_z==NFLAGSZ) {dimuonmass_afterZ_->Fill(ZRecoGlb.mass()); } 
-				       if (!zmuon_sel[12] || flags_passed_z==NFLAGSZ ){
-					 if(!zjets_hist_done){
-					   njets_afterZ_->Fill(njets);
-					   leadingjet_pt_afterZ_->Fill(lead_jet_pt);
-					   leadingjet_eta_afterZ_->Fill(lead_jet_eta);
-					 }
-					 zjets_hist_done=true;
-				       }
-				       if(flags_passed_z==NFLAGSZ) {
-					 met_afterZ_->Fill(met_et);
-					 if(!zfullsel_hist_done){
-					   npvs_afterZ_->Fill(nvvertex);
-					   muoncharge_afterZ_->Fill(charge);
-					   if (charge>0) {
-					     //ptPlus_afterZ_->Fill(mu.pt());
-					     //ptMinus_afterZ_->Fill(mu2.pt());
-					     ptDiffPM_afterZ_->Fill(mu.pt()-mu2.pt());
-					   }
-					   else {
-					     //ptPlus_afterZ_->Fill(mu2.pt());
-					     //ptMinus_afterZ_->Fill(mu.pt());
-					     ptDiffPM_afterZ_->Fill(mu2.pt()-mu.pt());
-					   }
-					 }
-					 zfullsel_hist_done=true;
-				       }
-			       }
+                         const MuonCuts& cuts2 = muons[j];
+                         if (!cuts2.valid) continue;
+                         if (cuts2.charge * cuts.charge != -1 ) continue;
+
+                         double dimuonMass = dileptons_.mass(i, j);
+
+                         // Combine the cut results of both legs with the
+                         // remaining flags; for the second leg the lower 
+                         // pt threshold for Z candidates is used
+                         unsigned int zmask = (cuts.mask & LEG_CUTS)
+                                            | NMinusOne::bit(Z_PT2, cuts2.mask & NMinusOne::bit(MU_PTZ2))
+                                            | (cuts2.mask & (LEG_CUTS & ~NMinusOne::bit(MU_PT))) << (Z_ETA2-MU_ETA)
+                                            | NMinusOne::bit(Z_HLT  , trigger_fired)
+                                            | NMinusOne::bit(Z_MASS , dimuonMass>dimuonMassMin_ && dimuonMass<dimuonMassMax_)
+                                            | NMinusOne::bit(Z_NJETS, njets<=nJetMax_);
+
+                         // start filling histos: N-1 plots
+                         zSel_.set(PT         , cuts.pt      );
+                         zSel_.set(ETA        , cuts.eta     );
+                         zSel_.set(DXY        , cuts.dxy     );
+                         zSel_.set(QUALITY    , cuts.quality );
+                         zSel_.set(ISO        , cuts.iso     );
+                         zSel_.set(PT2        , cuts2.pt     );
+                         zSel_.set(ETA2       , cuts2.eta    );
+                         zSel_.set(DXY2       , cuts2.dxy    );
+                         zSel_.set(QUALITY2   , cuts2.quality);
+                         zSel_.set(ISO2       , cuts2.iso    );
+                         zSel_.set(HLT        , trigger_fired);
+                         zSel_.set(MASS       , dimuonMass);
+                         zSel_.set(NJETS      , njets        );
+                         zSel_.set(LEADJET_PT , lead_jet_pt  );
+                         zSel_.set(LEADJET_ETA, lead_jet_eta );
+                         zSel_.set(MET        , met_et       );
+                         zSel_.set(NPVS       , nvvertex     );
+                         zSel_.set(CHARGE     , cuts.charge  );
+                         zSel_.set(PTDIFF     , cuts.charge>0 ? mus.pt[i]-mus.pt[j] : mus.pt[j]-mus.pt[i]);
+                         zSel_.fill(zmask);
+                         if (zSel_.passed(zmask)) zfullsel = true;
 		   }
 	    }
       }
 
-      if (zfullsel_hist_done) {
+      if (trends_) {
+            if (wfullsel) trends_->count(wTrend_);
+            if (zfullsel) trends_->count(zTrend_);
+      }
+      if (index_) {
+            if (wfullsel) index_->passed(wIndex_, ev.id().event());
+            if (zfullsel) index_->passed(zIndex_, ev.id().event());
+      }
+
+      if (zfullsel) {
 	// here was a Z candidate
 	n_zselPt1thr_->Fill(nmuonsForZ1);
 	n_zselPt2thr_->Fill(nmuonsForZ2);
@@ -13,20 +13,40 @@
 
 #include "FWCore/Framework/interface/EDAnalyzer.h"
 #include "FWCore/Utilities/interface/InputTag.h"
+#include "DQM/Physics/interface/FillBuffer.h"
+#include "DQM/Physics/interface/NMinusOne.h"
+#include "DQM/Physics/interface/DileptonPairs.h"
+#include "DQM/Physics/interface/CandidateColumns.h"
+#include "DQM/Physics/interface/MonitorSampling.h"
+#include "DQM/Physics/interface/LumiTrends.h"
+#include "DQM/Physics/interface/EventBitmap.h"
 
 class DQMStore;
 class MonitorElement;
 class EwkMuDQM : public edm::EDAnalyzer {
 public:
   EwkMuDQM (const edm::ParameterSet &);
+  virtual ~EwkMuDQM();
   virtual void analyze(const edm::Event&, const edm::EventSetup&);
   virtual void beginJob();
   virtual void endJob();
   virtual void beginRun(const edm::Run&, const edm::EventSetup&);
   virtual void endRun(const edm::Run&, const edm::EventSetup&);
+  virtual void endLuminosityBlock(const edm::LuminosityBlock&, const edm::EventSetup&);
 
   void init_histograms();
 private:
+  /// per muon cut results
+  enum MuonFlags { MU_PT, MU_ETA, MU_DXY, MU_QUALITY, MU_ISO, MU_PTZ1, MU_PTZ2 };
+  /// flags of the W selection; the first five flags are the per muon cuts
+  enum WFlags { W_PT, W_ETA, W_DXY, W_QUALITY, W_ISO, W_HLT, W_MT, W_MET, W_ACOP, W_ZVETO, W_NJETS, NWFLAGS };
+  /// flags of the Z selection; the first five flags are the per muon cuts of the first leg
+  enum ZFlags { Z_PT1, Z_ETA1, Z_DXY1, Z_QUALITY1, Z_ISO1, Z_PT2, Z_ETA2, Z_DXY2, Z_QUALITY2, Z_ISO2, Z_HLT, Z_MASS, Z_NJETS, NZFLAGS };
+  /// values of the N-1 histograms
+  enum Values { PT, ETA, DXY, QUALITY, ISO, PT2, ETA2, DXY2, QUALITY2, ISO2, HLT, MT, MET, ACOP, NJETS, LEADJET_PT, LEADJET_ETA, NPVS, CHARGE, MASS, PTDIFF, NVALUES };
+  /// per muon cuts used for the W selection and for each leg of the Z selection
+  static const unsigned int LEG_CUTS = (1u<<MU_PT)|(1u<<MU_ETA)|(1u<<MU_DXY)|(1u<<MU_QUALITY)|(1u<<MU_ISO);
+
 
   edm::InputTag trigTag_;
   edm::InputTag muonTag_;
@@ -70,6 +90,21 @@ private:
   double ptThrForPhoton_; 
   int    nPhoMax_ ; 
 
+  unsigned int fillBatchSize_;
+
+  // subsample of events for which the distributions before cuts
+  // are filled (0 if all events are filled); the counters, the
+  // multiplicities and the N-1 histograms are filled always
+  MonitorSampling* sampling_;
+
+  // W and Z candidates per lumi section (0 if not configured)
+  LumiTrends* trends_;
+  unsigned int wTrend_, zTrend_;
+
+  // W and Z candidates per lumi section for reprocessing (0 if not configured)
+  SelectionIndex* index_;
+  unsigned int wIndex_, zIndex_;
+
   bool isValidHltConfig_;
   HLTConfigProvider  hltConfigProvider_;
 
@@ -159,6 +194,20 @@ private:
   MonitorElement* pfphEta_;
   MonitorElement* phEta_;
 
+  // batched fills for the per-muon histograms before cuts;
+  // flushed at the end of each lumi block, run and job
+  FillBuffer pt_before_buffer_;
+  FillBuffer eta_before_buffer_;
+
+  // N-1 histograms of the W and the Z selection
+  NMinusOne wSel_;
+  NMinusOne zSel_;
+
+  // invariant masses of the muon pairs of the event
+  DileptonPairs dileptons_;
+  // columnar snapshot of the muons (memory kept between events)
+  MuonColumns muonColumns_;
+
 };
 
 #endif
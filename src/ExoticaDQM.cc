@@ -2,6 +2,9 @@
 
 #include <memory>
 
+#include "tbb/task_group.h"
+#include <boost/bind.hpp>
+
 // DQM
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
@@ -74,6 +77,14 @@ using namespace trigger;
 
 typedef vector<string> vstring;
 
+namespace {
+  // on-the-fly jet energy correction of the jets of the event
+  struct OnTheFlyCorrection {
+    const JetCorrector* corrector; const Event& event; const EventSetup& setup;
+    template <typename Jet> double operator()(const Jet& jet) const { return corrector->correction(jet, event, setup); }
+  };
+}
+
 struct SortCandByDecreasingPt {
   bool operator()( const Candidate &c1, const Candidate &c2) const {
     return c1.pt() > c2.pt();
@@ -124,13 +135,18 @@ ExoticaDQM::ExoticaDQM(const edm::ParameterSet& ps){
   PFMETLabelEI_       = ps.getParameter<InputTag>("pfMETCollectionEI");
   
   //Cuts - MultiJets 
-  jetID                    = new reco::helper::JetIDHelper(ps.getParameter<ParameterSet>("JetIDParams"));
+  jetID                    = new LazyJetID(ps.getParameter<ParameterSet>("JetIDParams"));
   mj_monojet_ptPFJet_      = ps.getParameter<double>("mj_monojet_ptPFJet");
   mj_monojet_ptPFMuon_     = ps.getParameter<double>("mj_monojet_ptPFMuon");
   mj_monojet_ptPFElectron_ = ps.getParameter<double>("mj_monojet_ptPFElectron");
   CaloJetCorService_       = ps.getParameter<std::string>("CaloJetCorService");
   PFJetCorService_         = ps.getParameter<std::string>("PFJetCorService");
 
+  // run the sub-analyses concurrently within the event (optional)
+  concurrent_ = ps.existsAs<bool>("concurrentSubAnalyses") ? ps.getParameter<bool>("concurrentSubAnalyses") : false;
+  validEI_    = false;
+  countJetEI_ = 0;
+
   // just to initialize
   //isValidHltConfig_ = false;
 }
@@ -140,6 +156,7 @@ ExoticaDQM::ExoticaDQM(const edm::ParameterSet& ps){
 // -- Destructor
 //
 ExoticaDQM::~ExoticaDQM(){
+  delete jetID;
   edm::LogInfo("ExoticaDQM") <<  " Deleting ExoticaDQM " << "\n" ;
 }
 
@@ -249,7 +266,6 @@ void ExoticaDQM::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup
   // Jets
   bool ValidCaloJet = iEvent.getByLabel(CaloJetLabel_, caloJetCollection_);
   if(!ValidCaloJet) return;
-  calojets = *caloJetCollection_; 
   // MET
   bool ValidCaloMET = iEvent.getByLabel(CaloMETLabel_, caloMETCollection_);
   if(!ValidCaloMET) return;
@@ -259,7 +275,6 @@ void ExoticaDQM::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup
   // PFJets
   bool ValidPFJet = iEvent.getByLabel(PFJetLabel_, pfJetCollection_);
   if(!ValidPFJet) return;
-  pfjets = *pfJetCollection_; 
   // PFMETs
   bool ValidPFMET = iEvent.getByLabel(PFMETLabel_, pfMETCollection_);
   if(!ValidPFMET) return;
@@ -288,100 +303,74 @@ void ExoticaDQM::analyze(const edm::Event& iEvent, const edm::EventSetup& iSetup
   }
   
   //---------- CaloJet Correction (on-the-fly) ----------
-  const JetCorrector* calocorrector = JetCorrector::getJetCorrector(CaloJetCorService_,iSetup);
-  CaloJetCollection::const_iterator calojet_ = calojets.begin();
-  for(; calojet_ != calojets.end(); ++calojet_){
-    double scale = calocorrector->correction(*calojet_,iEvent, iSetup);	
-    jetID->calculate(iEvent, *calojet_);
-    
-    if(scale*calojet_->pt()>CaloJetPt[0]){
-      CaloJetPt[1]   = CaloJetPt[0]; 
-      CaloJetPx[1]   = CaloJetPx[0];
-      CaloJetPy[1]   = CaloJetPy[0];
-      CaloJetEta[1]  = CaloJetEta[0];
-      CaloJetPhi[1]  = CaloJetPhi[0];
-      CaloJetEMF[1]  = CaloJetEMF[0];
-      CaloJetfHPD[1] = CaloJetfHPD[0];
-      CaloJetn90[1]  = CaloJetn90[0];
-      //
-      CaloJetPt[0]   = scale*calojet_->pt();
-      CaloJetPx[0]   = scale*calojet_->px();
-      CaloJetPy[0]   = scale*calojet_->py();
-      CaloJetEta[0]  = calojet_->eta();
-      CaloJetPhi[0]  = calojet_->phi();
-      CaloJetEMF[0]  = calojet_->emEnergyFraction();
-      CaloJetfHPD[0] = jetID->fHPD();
-      CaloJetn90[0]  = jetID->n90Hits();
-    }
-    else if(scale*calojet_->pt()<CaloJetPt[0] && scale*calojet_->pt()>CaloJetPt[1] ){
-      CaloJetPt[1]   = scale*calojet_->pt();
-      CaloJetPx[1]   = scale*calojet_->px();
-      CaloJetPy[1]   = scale*calojet_->py();
-      CaloJetEta[1]  = calojet_->eta();
-      CaloJetPhi[1]  = calojet_->phi();
-      CaloJetEMF[1]  = calojet_->emEnergyFraction();
-      CaloJetfHPD[1] = jetID->fHPD();
-      CaloJetn90[1]  = jetID->n90Hits();
-    }
-    else{}
+  // determine the two leading jets in corrected pt first; the 
+  // jetID is only calculated for these two jets afterwards
+  LeadingObjects<LeadingJet, 2> leadingCaloJets;
+  OnTheFlyCorrection calocorrection = { JetCorrector::getJetCorrector(CaloJetCorService_,iSetup), iEvent, iSetup };
+  leadingJets(*caloJetCollection_, calocorrection, 0., leadingCaloJets);
+  for(unsigned int i=0; i<leadingCaloJets.size(); i++){
+    const CaloJet& calojet = (*caloJetCollection_)[leadingCaloJets[i].idx];
+    double scale   = leadingCaloJets[i].scale;
+    CaloJetPt[i]   = leadingCaloJets.key(i);
+    CaloJetPx[i]   = scale*calojet.px();
+    CaloJetPy[i]   = scale*calojet.py();
+    CaloJetEta[i]  = calojet.eta();
+    CaloJetPhi[i]  = calojet.phi();
+    CaloJetEMF[i]  = calojet.emEnergyFraction();
+    const reco::JetID* id = (*jetID)(iEvent, CaloJetRef(caloJetCollection_, leadingCaloJets[i].idx));
+    if(!id) continue;
+    CaloJetfHPD[i] = id->fHPD;
+    CaloJetn90[i]  = id->n90Hits;
   }
   
   //
-  mj_monojet_countPFJet=0;
-  const JetCorrector* pfcorrector = JetCorrector::getJetCorrector(PFJetCorService_,iSetup);
-  PFJetCollection::const_iterator pfjet_ = pfjets.begin();
-  for(; pfjet_ != pfjets.end(); ++pfjet_){
-    double scale = pfcorrector->correction(*pfjet_,iEvent, iSetup);
-    if(scale*pfjet_->pt()>PFJetPt[0]){
-      PFJetPt[1]   = PFJetPt[0];
-      PFJetPx[1]   = PFJetPx[0];
-      PFJetPy[1]   = PFJetPy[0];
-      PFJetEta[1]  = PFJetEta[0];
-      PFJetPhi[1]  = PFJetPhi[0];
-      PFJetNHEF[1] = PFJetNHEF[0]; 
-      PFJetCHEF[1] = PFJetCHEF[0];
-      PFJetNEMF[1] = PFJetNEMF[0]; 
-      PFJetCEMF[1] = PFJetCEMF[0];
-      //
-      PFJetPt[0]   = scale*pfjet_->pt();
-      PFJetPx[0]   = scale*pfjet_->px();
-      PFJetPy[0]   = scale*pfjet_->py();
-      PFJetEta[0]  = pfjet_->eta();
-      PFJetPhi[0]  = pfjet_->phi();
-      PFJetNHEF[0] = pfjet_->neutralHadronEnergyFraction();
-      PFJetCHEF[0] = pfjet_->chargedHadronEnergyFraction();
-      PFJetNEMF[0] = pfjet_->neutralEmEnergyFraction();
-      PFJetCEMF[0] = pfjet_->chargedEmEnergyFraction();
-    }
-    else if(scale*pfjet_->pt()<PFJetPt[0] && scale*pfjet_->pt()>PFJetPt[1] ){
-      PFJetPt[1]   = scale*pfjet_->pt();
-      PFJetPx[1]   = scale*pfjet_->px();
-      PFJetPy[1]   = scale*pfjet_->py();
-      PFJetEta[1]  = pfjet_->eta();
-      PFJetPhi[1]  = pfjet_->phi(); 
-      PFJetNHEF[1] = pfjet_->neutralHadronEnergyFraction();
-      PFJetCHEF[1] = pfjet_->chargedHadronEnergyFraction();
-      PFJetNEMF[1] = pfjet_->neutralEmEnergyFraction();
-      PFJetCEMF[1] = pfjet_->chargedEmEnergyFraction();
-    }
-    else{}
-    if(scale*pfjet_->pt()>mj_monojet_ptPFJet_) mj_monojet_countPFJet++;
+  LeadingObjects<LeadingJet, 2> leadingPFJets;
+  OnTheFlyCorrection pfcorrection = { JetCorrector::getJetCorrector(PFJetCorService_,iSetup), iEvent, iSetup };
+  mj_monojet_countPFJet = leadingJets(*pfJetCollection_, pfcorrection, mj_monojet_ptPFJet_, leadingPFJets);
+  for(unsigned int i=0; i<leadingPFJets.size(); i++){
+    const PFJet& pfjet = (*pfJetCollection_)[leadingPFJets[i].idx];
+    double scale = leadingPFJets[i].scale;
+    PFJetPt[i]   = leadingPFJets.key(i);
+    PFJetPx[i]   = scale*pfjet.px();
+    PFJetPy[i]   = scale*pfjet.py();
+    PFJetEta[i]  = pfjet.eta();
+    PFJetPhi[i]  = pfjet.phi();
+    PFJetNHEF[i] = pfjet.neutralHadronEnergyFraction();
+    PFJetCHEF[i] = pfjet.chargedHadronEnergyFraction();
+    PFJetNEMF[i] = pfjet.neutralEmEnergyFraction();
+    PFJetCEMF[i] = pfjet.chargedEmEnergyFraction();
   }
   //#######################################################
   
   
-  // Analyze
+  // Prepare: all access to the event and the event setup happens
+  // here, as it is not safe to be done from several threads
   //
-  analyzeMultiJets(iEvent);
-  //analyzeMultiJetsTrigger(iEvent);
+  prepareLongLived(iEvent);
+  prepareEventInterpretation(iEvent, iSetup);
+  
+  // Analyze: the sub-analyses only use the data prepared above
+  // and fill disjoint histograms
   //
-  analyzeLongLived(iEvent);
-  //analyzeLongLivedTrigger(iEvent);
-
-  analyzeEventInterpretation(iEvent, iSetup);
+  if(concurrent_){
+    tbb::task_group subAnalyses;
+    subAnalyses.run(boost::bind(&ExoticaDQM::analyzeLongLived, this));
+    subAnalyses.run(boost::bind(&ExoticaDQM::analyzeEventInterpretation, this));
+    analyzeMultiJets();
+    subAnalyses.wait();
+  }
+  else{
+    analyzeMultiJets();
+    //analyzeMultiJetsTrigger(iEvent);
+    //
+    analyzeLongLived();
+    //analyzeLongLivedTrigger(iEvent);
+
+    analyzeEventInterpretation();
+  }
 }
 
-void ExoticaDQM::analyzeMultiJets(const Event & iEvent){ 
+void ExoticaDQM::analyzeMultiJets(){ 
 
   //--- MonoJet
   //bool checkLepton = false;
@@ -416,13 +405,13 @@ void ExoticaDQM::analyzeMultiJets(const Event & iEvent){
   
   //--- MET
   const CaloMETCollection *calometcol = caloMETCollection_.product();
-  const CaloMET met = calometcol->front();
+  const CaloMET& met = calometcol->front();
   mj_caloMet_et->Fill(met.et());
   mj_caloMet_phi->Fill(met.phi());
   
   //
   const PFMETCollection *pfmetcol = pfMETCollection_.product();
-  const PFMET pfmet = pfmetcol->front();
+  const PFMET& pfmet = pfmetcol->front();
   mj_pfMet_et->Fill(pfmet.et());
   mj_pfMet_phi->Fill(pfmet.phi());
 }
@@ -430,7 +419,7 @@ void ExoticaDQM::analyzeMultiJets(const Event & iEvent){
 void ExoticaDQM::analyzeMultiJetsTrigger(const Event & iEvent){
 }
 
-void ExoticaDQM::analyzeLongLived(const Event & iEvent){ 
+void ExoticaDQM::prepareLongLived(const Event & iEvent){ 
   // SMajMajPho, SMinMinPho
   // get ECAL reco hits
   Handle<EBRecHitCollection> ecalhitseb;
@@ -443,21 +432,30 @@ void ExoticaDQM::analyzeLongLived(const Event & iEvent){
   iEvent.getByLabel("reducedEcalRecHitsEE", ecalhitsee);
   rhitsee = ecalhitsee.product(); // get a ptr to the product
   //
-  int nPhot = 0;
+  // the seeds are dereferenced here, as this may read
+  // the cluster collection from the event
+  photonSeeds_.clear();
+  photonRecHits_.clear();
   reco::PhotonCollection::const_iterator photon = PhotonCollection_->begin();
   for(; photon != PhotonCollection_->end(); ++photon){
     if(photon->energy()<3.) continue;
-    if(nPhot>=40) continue;
+    if(photonSeeds_.size()>=40) continue;
     
-    const Ptr<CaloCluster> theSeed = photon->superCluster()->seed(); 
-    const EcalRecHitCollection* rechits = ( photon->isEB()) ? rhitseb : rhitsee;
-    CaloClusterPtr SCseed = photon->superCluster()->seed();
+    photonSeeds_.push_back(&*photon->superCluster()->seed());
+    photonRecHits_.push_back(( photon->isEB()) ? rhitseb : rhitsee);
+  }
+}
+
+void ExoticaDQM::analyzeLongLived(){ 
+  for(unsigned int nPhot=0; nPhot<photonSeeds_.size(); ++nPhot){
+    const CaloCluster& seed = *photonSeeds_[nPhot];
+    const EcalRecHitCollection* rechits = photonRecHits_[nPhot];
     
-    std::pair<DetId, float> maxRH = EcalClusterTools::getMaximum( *theSeed, &(*rechits) );
+    std::pair<DetId, float> maxRH = EcalClusterTools::getMaximum( seed, &(*rechits) );
     
     if(maxRH.second) {
-      Cluster2ndMoments moments = EcalClusterTools::cluster2ndMoments(*SCseed, *rechits);
-      //std::vector<float> etaphimoments = EcalClusterTools::localCovariances(*SCseed, &(*rechits), &(*topology));
+      Cluster2ndMoments moments = EcalClusterTools::cluster2ndMoments(seed, *rechits);
+      //std::vector<float> etaphimoments = EcalClusterTools::localCovariances(seed, &(*rechits), &(*topology));
       ll_gammajet_sMajMajPhot->Fill(moments.sMaj);
       ll_gammajet_sMinMinPhot->Fill(moments.sMin);
     }
@@ -465,7 +463,6 @@ void ExoticaDQM::analyzeLongLived(const Event & iEvent){
       ll_gammajet_sMajMajPhot->Fill(-100.);
       ll_gammajet_sMinMinPhot->Fill(-100.);
     }
-    ++nPhot;
   }
 
 }
@@ -473,34 +470,33 @@ void ExoticaDQM::analyzeLongLived(const Event & iEvent){
 void ExoticaDQM::analyzeLongLivedTrigger(const Event & iEvent){
 }
 
-void ExoticaDQM::analyzeEventInterpretation(const Event & iEvent, const edm::EventSetup& iSetup){  
+void ExoticaDQM::prepareEventInterpretation(const Event & iEvent, const edm::EventSetup& iSetup){  
 
   // EI
+  validEI_ = false;
   // PFElectrons
   bool ValidPFElectronEI = iEvent.getByLabel(PFElectronLabelEI_, pfElectronCollectionEI_);
   if(!ValidPFElectronEI) return;
-  pfelectronsEI = *pfElectronCollectionEI_;
 
   // PFMuons
   bool ValidPFMuonEI = iEvent.getByLabel(PFMuonLabelEI_, pfMuonCollectionEI_);
   if(!ValidPFMuonEI) return;
-  pfmuonsEI = *pfMuonCollectionEI_;
   
   // PFJets
   bool ValidPFJetEI = iEvent.getByLabel(PFJetLabelEI_, pfJetCollectionEI_);
   if(!ValidPFJetEI) return;
-  pfjetsEI = *pfJetCollectionEI_;
   
   // PFMETs
   bool ValidPFMETEI = iEvent.getByLabel(PFMETLabelEI_, pfMETCollectionEI_);
   if(!ValidPFMETEI) return;
 
   // Jet Correction
-  int countJet = 0;
+  validEI_ = true;
+  countJetEI_ = 0;
   PFJetEIPt    = -99.;
   const JetCorrector* pfcorrectorEI = JetCorrector::getJetCorrector(PFJetCorService_,iSetup);
-  PFJetCollection::const_iterator pfjet_ = pfjetsEI.begin();
-  for(; pfjet_ != pfjetsEI.end(); ++pfjet_){
+  PFJetCollection::const_iterator pfjet_ = pfJetCollectionEI_->begin();
+  for(; pfjet_ != pfJetCollectionEI_->end(); ++pfjet_){
     double scale = pfcorrectorEI->correction(*pfjet_,iEvent, iSetup);
     if(scale*pfjet_->pt()<PFJetEIPt) continue;
     PFJetEIPt   = scale*pfjet_->pt();
@@ -512,14 +508,19 @@ void ExoticaDQM::analyzeEventInterpretation(const Event & iEvent, const edm::Eve
     PFJetEICHEF = pfjet_->chargedHadronEnergyFraction();
     PFJetEINEMF = pfjet_->neutralEmEnergyFraction();
     PFJetEICEMF = pfjet_->chargedEmEnergyFraction();
-    countJet++;
+    countJetEI_++;
   }
-  if(countJet>0){
+}
+
+void ExoticaDQM::analyzeEventInterpretation(){  
+  if(!validEI_) return;
+
+  if(countJetEI_>0){
     ei_pfjet1_pt->Fill(PFJetEIPt);
   }
   
   const PFMETCollection *pfmetcolEI = pfMETCollectionEI_.product();
-  const PFMET pfmetEI = pfmetcolEI->front();
+  const PFMET& pfmetEI = pfmetcolEI->front();
   ei_pfmet_pt->Fill(pfmetEI.et());
 }
 
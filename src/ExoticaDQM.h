@@ -56,6 +56,8 @@
 #include "DataFormats/JetReco/interface/PFJetCollection.h"
 #include "DataFormats/JetReco/interface/CaloJetCollection.h"
 #include "RecoJets/JetProducers/interface/JetIDHelper.h"
+#include "DQM/Physics/interface/LazyJetID.h"
+#include "DQM/Physics/interface/LeadingObjects.h"
 
 // Photon
 #include "DataFormats/EgammaCandidates/interface/Photon.h"
@@ -88,6 +90,14 @@ public:
 
   ExoticaDQM(const edm::ParameterSet& ps);
   virtual ~ExoticaDQM();
+
+  // payload of the leading jets: index in the collection and jet energy correction
+  struct LeadingJet { unsigned int idx; double scale; };
+  // determine the two leading jets of _jets_ in corrected pt, where _correction_
+  // returns the jet energy correction of a jet; returns the number of jets with
+  // a corrected pt above _ptMin_
+  template <typename Jets, typename Correction>
+  static unsigned int leadingJets(const Jets& jets, const Correction& correction, double ptMin, LeadingObjects<LeadingJet, 2>& leading);
   
 protected:
 
@@ -100,13 +110,18 @@ protected:
   virtual void endJob();
   
   //Diagnostic
-  virtual void analyzeMultiJets(edm::Event const& e);
+  // the prepare methods read everything needed from the event; the analyze
+  // methods of the sub-analyses only use these data and fill disjoint sets 
+  // of histograms, such that they can be run concurrently
+  virtual void analyzeMultiJets();
   virtual void analyzeMultiJetsTrigger(edm::Event const& e);
   
-  virtual void analyzeLongLived(edm::Event const& e);
+  virtual void prepareLongLived(edm::Event const& e);
+  virtual void analyzeLongLived();
   virtual void analyzeLongLivedTrigger(edm::Event const& e); 
 
-  virtual void analyzeEventInterpretation(edm::Event const& e, edm::EventSetup const& eSetup);
+  virtual void prepareEventInterpretation(edm::Event const& e, edm::EventSetup const& eSetup);
+  virtual void analyzeEventInterpretation();
   
   //
   //virtual void analyzeTopLike(edm::Event const& e);
@@ -139,6 +154,9 @@ private:
   std::vector<std::string>  theTriggerForLongLivedList;
   edm::Handle<edm::TriggerResults> triggerResults_;
 
+  // Note: the collections are only read via their handles (valid
+  // for the current event); they are never copied into members
+
 
   // Electrons
   edm::InputTag ElectronLabel_;
@@ -146,7 +164,6 @@ private:
   //
   edm::InputTag PFElectronLabelEI_;
   edm::Handle<reco::PFCandidateCollection> pfElectronCollectionEI_;
-  reco::PFCandidateCollection pfelectronsEI; 
   
   
   // Muons
@@ -155,7 +172,6 @@ private:
   //
   edm::InputTag PFMuonLabelEI_;
   edm::Handle<reco::PFCandidateCollection> pfMuonCollectionEI_;
-  reco::PFCandidateCollection pfmuonsEI; 
 
   
   // Taus
@@ -172,21 +188,17 @@ private:
   //
   edm::InputTag PFPhotonLabelEI_;
   edm::Handle<reco::PFCandidateCollection> pfPhotonCollectionEI_;
-  reco::PFCandidateCollection pfphotons;
 
   
   // Jets
   edm::InputTag CaloJetLabel_;
   edm::Handle<reco::CaloJetCollection> caloJetCollection_;
-  reco::CaloJetCollection calojets; 
   //
   edm::InputTag PFJetLabel_; 
   edm::Handle<reco::PFJetCollection> pfJetCollection_;
-  reco::PFJetCollection pfjets;
   //
   edm::InputTag PFJetLabelEI_; 
   edm::Handle<reco::PFJetCollection> pfJetCollectionEI_;
-  reco::PFJetCollection pfjetsEI;
   
   
   // MET
@@ -206,7 +218,7 @@ private:
   // inputs
   std::string CaloJetCorService_;
   std::string PFJetCorService_;
-  reco::helper::JetIDHelper *jetID;
+  LazyJetID *jetID;
   double mj_monojet_ptPFJet_;
   double mj_monojet_ptPFMuon_;
   double mj_monojet_ptPFElectron_;
@@ -246,6 +258,16 @@ private:
   double PFJetEICHEF;
   double PFJetEINEMF;
   double PFJetEICEMF;
+  int    countJetEI_;
+  bool   validEI_;
+
+  // Cuts - Long Lived: seed clusters of the photons and
+  // the corresponding ECAL rechits of the current event
+  std::vector<const reco::CaloCluster*> photonSeeds_;
+  std::vector<const EcalRecHitCollection*> photonRecHits_;
+
+  // run the sub-analyses concurrently within the event
+  bool concurrent_;
   
   ///////////////////////////
   // Histograms
@@ -285,4 +307,18 @@ private:
 };
 
 
+template <typename Jets, typename Correction>
+unsigned int ExoticaDQM::leadingJets(const Jets& jets, const Correction& correction, double ptMin, LeadingObjects<LeadingJet, 2>& leading)
+{
+  unsigned int count=0;
+  leading.clear();
+  for(typename Jets::const_iterator jet=jets.begin(); jet!=jets.end(); ++jet){
+    double scale = correction(*jet);
+    LeadingJet lead = { (unsigned int)(jet - jets.begin()), scale };
+    leading.push(scale*jet->pt(), lead);
+    if(scale*jet->pt()>ptMin) count++;
+  }
+  return count;
+}
+
 #endif
@@ -27,6 +27,7 @@
 
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
+#include "DQM/Physics/interface/LeadingObjects.h"
 
 //#include "HiggsAnalysis/HiggsToZZ4Leptons/plugins/HZZ4LeptonsElectronAssociationMap.h"
 //#include "HiggsAnalysis/HiggsToZZ4Leptons/plugins/HZZ4LeptonsMuonAssociationMap.h"
@@ -150,6 +151,13 @@ HiggsDQM::HiggsDQM(const edm::ParameterSet& ps){
   // cuts:
   ptThrMu1_ = ps.getUntrackedParameter<double>("PtThrMu1");
   ptThrMu2_ = ps.getUntrackedParameter<double>("PtThrMu2");
+  // sampling: 1-in-N and/or CPU time budget [ms/event] (<=1 and <=0: none)
+  sampling_ = 0;
+  unsigned int samplingPrescale = ps.getUntrackedParameter<unsigned int>("SamplingPrescale", 1);
+  double samplingTimeBudget = ps.getUntrackedParameter<double>("SamplingTimeBudget", 0.);
+  if ( samplingPrescale>1 || samplingTimeBudget>0. ) {
+    sampling_ = new MonitorSampling("Physics/Higgs/", samplingPrescale, samplingTimeBudget);
+  }
  
 
   
@@ -162,6 +170,7 @@ HiggsDQM::~HiggsDQM(){
   //cout<<"Entering HiggsDQM::~HiggsDQM: "<<endl;
   
   edm::LogInfo("HiggsDQM") <<  " Deleting HiggsDQM " << "\n" ;
+  if ( sampling_ ) delete sampling_;
 
   //cout<<"...leaving HiggsDQM::~HiggsDQM. "<<endl;
 }
@@ -267,6 +276,9 @@ void HiggsDQM::analyze(const edm::Event& e, const edm::EventSetup& eSetup){
   Handle<TriggerResults> HLTresults;
   e.getByLabel(theTriggerResultsCollection, HLTresults); 
   if ( !HLTresults.isValid() ) return;
+  // the kinematic distributions are only filled for sampled events
+  bool sampled = !sampling_ || sampling_->next();
+  MonitorSampling::Clock clock(sampling_);
   //unsigned int triggerIndex_elec = hltConfig.triggerIndex(theElecTriggerPathToPass);
   //unsigned int triggerIndex_muon = hltConfig.triggerIndex(theMuonTriggerPathToPass);
   bool passed_electron_HLT = true;
@@ -281,8 +293,11 @@ void HiggsDQM::analyze(const edm::Event& e, const edm::EventSetup& eSetup){
   Handle<VertexCollection> vertexHandle;
   e.getByLabel("offlinePrimaryVertices", vertexHandle);
   if ( vertexHandle.isValid() ){
-    VertexCollection vertexCollection = *(vertexHandle.product());
-    int vertex_number     = vertexCollection.size();
+    int vertex_number     = vertexHandle->size();
+    h_vertex_number->Fill(vertex_number);
+  }
+  if ( vertexHandle.isValid() && !vertexHandle->empty() && sampled ){
+    const VertexCollection& vertexCollection = *(vertexHandle.product());
     VertexCollection::const_iterator v = vertexCollection.begin();
     double vertex_chi2    = v->normalizedChi2(); //v->chi2();
     double vertex_d0      = sqrt(v->x()*v->x()+v->y()*v->y());
@@ -292,7 +307,6 @@ void HiggsDQM::analyze(const edm::Event& e, const edm::EventSetup& eSetup){
     for (Vertex::trackRef_iterator vertex_curTrack = v->tracks_begin(); vertex_curTrack!=v->tracks_end(); vertex_curTrack++) {
       vertex_sumTrks += (*vertex_curTrack)->pt();
     }
-    h_vertex_number->Fill(vertex_number);
     h_vertex_chi2->Fill(vertex_chi2);
     h_vertex_d0  ->Fill(vertex_d0);
     h_vertex_numTrks->Fill(vertex_numTrks);
@@ -311,9 +325,11 @@ void HiggsDQM::analyze(const edm::Event& e, const edm::EventSetup& eSetup){
     if( passed_electron_HLT ) {
       for (reco::GsfElectronCollection::const_iterator recoElectron=electronCollection->begin(); recoElectron!=electronCollection->end(); recoElectron++){
 //      cout << "Electron with pt= " <<  recoElectron->pt() << " and eta" << recoElectron->eta() << " p=" <<  recoElectron->p() << endl;
-        h_ePt->Fill(recoElectron->pt());
-        h_eEta->Fill(recoElectron->eta());
-        h_ePhi->Fill(recoElectron->phi());
+        if( sampled ){
+          h_ePt->Fill(recoElectron->pt());
+          h_eEta->Fill(recoElectron->eta());
+          h_ePhi->Fill(recoElectron->phi());
+        }
         if(recoElectron->charge()==1){
           posEle++;
         }else if(recoElectron->charge()==-1){
@@ -330,8 +346,15 @@ void HiggsDQM::analyze(const edm::Event& e, const edm::EventSetup& eSetup){
     nEle = posEle+negEle; if(nEle>9.) nEle=9.;
     h_eMultiplicity->Fill(nEle);  
 
-    // Z->ee:
-    unsigned int eleCollectionSize = electronCollection->size();
+    // Z->ee (sampled events only):
+    // (masses of all pairs in the massless approximation)
+    unsigned int eleCollectionSize = sampled ? electronCollection->size() : 0;
+    dileptons_.clear();
+    for(unsigned int i=0; i<eleCollectionSize; i++) {
+      const GsfElectron& ele = electronCollection->at(i);
+      dileptons_.add(ele.px(), ele.py(), ele.pz(), ele.p(), ele.charge());
+    }
+    dileptons_.compute();
     for(unsigned int i=0; i<eleCollectionSize; i++) {
       const GsfElectron& ele = electronCollection->at(i);
       double pt = ele.pt();
@@ -340,8 +363,7 @@ void HiggsDQM::analyze(const edm::Event& e, const edm::EventSetup& eSetup){
     	  const GsfElectron& ele2 = electronCollection->at(j);
     	  double pt2 = ele2.pt();
     	  if(pt2>ptThrMu2_){
-    	    const math::XYZTLorentzVector ZRecoEE (ele.px()+ele2.px(), ele.py()+ele2.py() , ele.pz()+ele2.pz(), ele.p()+ele2.p());
-    	    h_dielemass->Fill(ZRecoEE.mass());
+    	    h_dielemass->Fill(dileptons_.mass(i, j));
     	  }
         }
       }
@@ -363,7 +385,9 @@ void HiggsDQM::analyze(const edm::Event& e, const edm::EventSetup& eSetup){
     if( passed_muon_HLT ) {
       for (reco::MuonCollection::const_iterator recoMuon=muonCollection->begin(); recoMuon!=muonCollection->end(); recoMuon++){
         //cout << "Muon with pt= " <<  muIter->pt() << " and eta" << muIter->eta() << " p=" <<  muIter->p() << endl;
-        if(recoMuon->isGlobalMuon()&&recoMuon->isTrackerMuon()){
+        if(!sampled){
+          // no classification needed for the multiplicity only
+        }else if(recoMuon->isGlobalMuon()&&recoMuon->isTrackerMuon()){
           h_mPt_GMTM->Fill(recoMuon->pt());
           h_mEta_GMTM->Fill(recoMuon->eta());
           h_mPhi_GMTM->Fill(recoMuon->phi());
@@ -394,8 +418,15 @@ void HiggsDQM::analyze(const edm::Event& e, const edm::EventSetup& eSetup){
       h_mMultiplicity->Fill(nMu);
     }
 
-    // Z->mumu:
-    unsigned int muonCollectionSize = muonCollection->size();
+    // Z->mumu (sampled events only):
+    // (masses of all pairs in the massless approximation)
+    unsigned int muonCollectionSize = sampled ? muonCollection->size() : 0;
+    dileptons_.clear();
+    for(unsigned int i=0; i<muonCollectionSize; i++) {
+      const Muon& mu = muonCollection->at(i);
+      dileptons_.add(mu.px(), mu.py(), mu.pz(), mu.p(), mu.charge());
+    }
+    dileptons_.compute();
     for(unsigned int i=0; i<muonCollectionSize; i++) {
       const Muon& mu = muonCollection->at(i);
       //if (!mu.isGlobalMuon()) continue;
@@ -407,18 +438,15 @@ void HiggsDQM::analyze(const edm::Event& e, const edm::EventSetup& eSetup){
     	  if(pt2>ptThrMu2_){
     	    // Glb + Glb  
     	    if(mu.isGlobalMuon() && mu2.isGlobalMuon()){
-    	      const math::XYZTLorentzVector ZRecoGMGM (mu.px()+mu2.px(), mu.py()+mu2.py() , mu.pz()+mu2.pz(), mu.p()+mu2.p());
-    	      h_dimumass_GMGM->Fill(ZRecoGMGM.mass());
+    	      h_dimumass_GMGM->Fill(dileptons_.mass(i, j));
     	    }
     	    // Glb + TM 
     	    else if(mu.isGlobalMuon() && mu2.isTrackerMuon()){
-    	      const math::XYZTLorentzVector ZRecoGMTM (mu.px()+mu2.px(), mu.py()+mu2.py() , mu.pz()+mu2.pz(), mu.p()+mu2.p());
-    	      h_dimumass_GMTM->Fill(ZRecoGMTM.mass());
+    	      h_dimumass_GMTM->Fill(dileptons_.mass(i, j));
     	    }
     	    // TM + TM 
     	    else if(mu.isTrackerMuon() && mu2.isTrackerMuon()){
-    	      const math::XYZTLorentzVector ZRecoTMTM (mu.px()+mu2.px(), mu.py()+mu2.py() , mu.pz()+mu2.pz(), mu.p()+mu2.p());
-    	      h_dimumass_TMTM->Fill(ZRecoTMTM.mass());
+    	      h_dimumass_TMTM->Fill(dileptons_.mass(i, j));
     	    }
     	  }
         }
@@ -432,13 +460,9 @@ void HiggsDQM::analyze(const edm::Event& e, const edm::EventSetup& eSetup){
   Handle<CaloJetCollection> caloJetCollection;
   e.getByLabel (theCaloJetCollectionLabel,caloJetCollection);
   if ( caloJetCollection.isValid() ){
-    float jet_et    = -8.0;
-    //    float jet_eta   = -8.0; // UNUSED
-    //    float jet_phi   = -8.0; // UNUSED
+    // et of the two leading jets above 15 GeV
     int   jet_count = 0;
-    float jet2_et   = -9.0;
-    //    float jet2_eta  = -9.0; // UNUSED
-    //    float jet2_phi  = -9.0; // UNUSED
+    LeadingObjects<NoPayload, 2> leadingJets;
     for (CaloJetCollection::const_iterator i_calojet = caloJetCollection->begin(); i_calojet != caloJetCollection->end(); i_calojet++) {
       float jet_current_et = i_calojet->et();
       // if it overlaps with electron, it is not a jet
@@ -447,30 +471,22 @@ void HiggsDQM::analyze(const edm::Event& e, const edm::EventSetup& eSetup){
       // if it has too low Et, throw away
       if (jet_current_et < 15) continue;
       jet_count++;
-      if (jet_current_et > jet_et) {
-        jet2_et  = jet_et;  // 2nd highest jet get's et from current highest
-	//        jet2_eta = jet_eta; // UNUSED
-	//        jet2_phi = jet_phi; // UNUSED
-        jet_et   = i_calojet->et(); // current highest jet gets et from the new highest
-	//        jet_eta  = i_calojet->eta(); // UNUSED
-	//        jet_phi  = i_calojet->phi(); // UNUSED
-      } else if (jet_current_et > jet2_et) {
-        jet2_et  = i_calojet->et();
-	//        jet2_eta = i_calojet->eta(); // UNUSED
-	//        jet2_phi = i_calojet->phi(); // UNUSED
-      }
+      leadingJets.push(jet_current_et);
     }
-    if (jet_et>0.0) {
-      h_jet_et   ->Fill(jet_et);
+    if (leadingJets.size()>0) {
+      if (sampled) h_jet_et->Fill(leadingJets.key(0));
       h_jet_count->Fill(jet_count);
     }
+    if (leadingJets.size()>1 && sampled) {
+      h_jet2_et  ->Fill(leadingJets.key(1));
+    }
   }
   
 //-------------------------------
 //--- MET
 //-------------------------------
   Handle<CaloMETCollection> caloMETCollection;
-  e.getByLabel(theCaloMETCollectionLabel, caloMETCollection);
+  if ( sampled ) e.getByLabel(theCaloMETCollectionLabel, caloMETCollection);
   if ( caloMETCollection.isValid() ){
     float caloMet = caloMETCollection->begin()->et();
     float caloMet_phi = caloMETCollection->begin()->phi();
@@ -478,7 +494,7 @@ void HiggsDQM::analyze(const edm::Event& e, const edm::EventSetup& eSetup){
     h_caloMet_phi    ->Fill(caloMet_phi);
   }
   Handle<PFMETCollection> pfMETCollection;
-  e.getByLabel(thePfMETCollectionLabel, pfMETCollection);
+  if ( sampled ) e.getByLabel(thePfMETCollectionLabel, pfMETCollection);
   if ( pfMETCollection.isValid() ){
     float pfMet = pfMETCollection->begin()->et();
     float pfMet_phi = pfMETCollection->begin()->phi();
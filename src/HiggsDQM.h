@@ -31,6 +31,8 @@
 #include "DataFormats/VertexReco/interface/Vertex.h"
 
 #include "DQMServices/Core/interface/MonitorElement.h"
+#include "DQM/Physics/interface/DileptonPairs.h"
+#include "DQM/Physics/interface/MonitorSampling.h"
 
 #include <iostream>
 #include <fstream>
@@ -134,7 +136,12 @@ private:
   MonitorElement* h_dielemass;
   MonitorElement* h_lepcounts;
   
-  
+  // invariant masses of the lepton pairs of the event
+  DileptonPairs dileptons_;
+  // subsample of events for which the kinematic distributions are
+  // filled (0 if all events are filled); the multiplicities and
+  // lepton counts are filled always
+  MonitorSampling* sampling_;
 };
 
 
@@ -0,0 +1,47 @@
+#include "DQM/Physics/interface/HistogramTable.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+HistogramTable::HistogramTable(const std::vector<Entry>& defaults, const std::vector<edm::ParameterSet>& overrides) :
+  entries_(defaults)
+{
+  for(unsigned int idx=0; idx<entries_.size(); ++idx){ entries_[idx].slot=idx; }
+  // all parameters but the key are optional; the
+  // defaults are kept for those which are omitted
+  for(std::vector<edm::ParameterSet>::const_iterator cfg=overrides.begin(); cfg!=overrides.end(); ++cfg){
+    Entry& entry=entries_[slot(cfg->getParameter<std::string>("key"))];
+    if( cfg->existsAs<std::string>("title"    ) ) entry.title = cfg->getParameter<std::string>("title");
+    if( cfg->existsAs<std::string>("verbosity") ) entry.level = level(cfg->getParameter<std::string>("verbosity"));
+    if( cfg->existsAs<int   >("nBinsX") ) entry.nBinsX= cfg->getParameter<int   >("nBinsX");
+    if( cfg->existsAs<double>("lowX"  ) ) entry.lowX  = cfg->getParameter<double>("lowX"  );
+    if( cfg->existsAs<double>("highX" ) ) entry.highX = cfg->getParameter<double>("highX" );
+    if( cfg->existsAs<int>("nBinsY") || cfg->existsAs<double>("lowY") || cfg->existsAs<double>("highY") ){
+      if( !entry.is2D() ){
+	throw cms::Exception("Configuration") << "HistogramTable: y binning given for 1-dim histogram '" << entry.key << "'\n";
+      }
+      if( cfg->existsAs<int   >("nBinsY") ) entry.nBinsY= cfg->getParameter<int   >("nBinsY");
+      if( cfg->existsAs<double>("lowY"  ) ) entry.lowY  = cfg->getParameter<double>("lowY"  );
+      if( cfg->existsAs<double>("highY" ) ) entry.highY = cfg->getParameter<double>("highY" );
+    }
+    if( (entry.nBinsX>0 && entry.highX<=entry.lowX) || (entry.is2D() && entry.highY<=entry.lowY) ){
+      throw cms::Exception("Configuration") << "HistogramTable: empty range for histogram '" << entry.key << "'\n";
+    }
+  }
+}
+
+unsigned int
+HistogramTable::slot(const std::string& key) const
+{
+  for(unsigned int idx=0; idx<entries_.size(); ++idx){
+    if( entries_[idx].key==key ) return idx;
+  }
+  throw cms::Exception("Configuration") << "HistogramTable: unknown histogram '" << key << "'\n";
+}
+
+int
+HistogramTable::level(const std::string& verbosity) const
+{
+  if( verbosity=="STANDARD" ) return 0;
+  if( verbosity=="VERBOSE"  ) return 1;
+  if( verbosity=="DEBUG"    ) return 2;
+  throw cms::Exception("Configuration") << "HistogramTable: unknown verbosity '" << verbosity << "' (STANDARD, VERBOSE or DEBUG)\n";
+}
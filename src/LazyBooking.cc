@@ -0,0 +1,33 @@
+#include "DQM/Physics/interface/LazyBooking.h"
+
+#include "TH1.h"
+
+// approximate fixed overhead of a booked TH1/MonitorElement
+// pair (axes, names, titles, DQMStore bookkeeping) in bytes
+static const double HISTOGRAM_OVERHEAD = 1024.;
+
+double
+HistogramDef::bytes() const
+{
+  // TH1F/TH2F keep one float per bin including
+  // the under- and overflow bins
+  double nCells = (nBinsX_+2.)*(nBinsY_>0 ? nBinsY_+2. : 1.);
+  return HISTOGRAM_OVERHEAD + nCells*sizeof(float);
+}
+
+MonitorElement*
+HistogramDef::book(DQMStore* store) const
+{
+  store->setCurrentFolder(folder_);
+  MonitorElement* me = nBinsY_>0 ?
+    store->book2D(name_, title_, nBinsX_, lowX_, highX_, nBinsY_, lowY_, highY_) :
+    store->book1D(name_, title_, nBinsX_, lowX_, highX_);
+  for(unsigned int idx=0; idx<axisTitles_.size(); ++idx){
+    me->setAxisTitle(axisTitles_[idx].second, axisTitles_[idx].first);
+  }
+  for(unsigned int idx=0; idx<binLabels_.size(); ++idx){
+    me->setBinLabel(binLabels_[idx].first.first, binLabels_[idx].second, binLabels_[idx].first.second);
+  }
+  if(!option_.empty()) me->getTH1()->SetOption(option_.c_str());
+  return me;
+}
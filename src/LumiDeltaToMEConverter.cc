@@ -0,0 +1,111 @@
+#include "DQM/Physics/src/LumiDeltaToMEConverter.h"
+
+#include <vector>
+
+#include "TH1.h"
+#include "TH2.h"
+#include "TArrayD.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+LumiDeltaToMEConverter::LumiDeltaToMEConverter(const edm::ParameterSet& cfg):
+  src_(cfg.getParameter<edm::InputTag>("src")), store_(0), lumis_(0), events_(0), bins_(0), dropped_(0)
+{
+}
+
+LumiDeltaToMEConverter::~LumiDeltaToMEConverter()
+{
+  for(std::map<std::string, Target>::iterator target=targets_.begin(); target!=targets_.end(); ++target){
+    if( target->second.delta ) delete target->second.delta;
+  }
+}
+
+void
+LumiDeltaToMEConverter::endLuminosityBlock(const edm::LuminosityBlock& lumi, const edm::EventSetup& setup)
+{
+  edm::Handle<LumiHistogramDeltas> deltas;
+  if( !lumi.getByLabel(src_, deltas) ) return;
+  merge(*deltas); ++lumis_;
+}
+
+void
+LumiDeltaToMEConverter::endRun(const edm::Run& run, const edm::EventSetup& setup)
+{
+  edm::Handle<LumiHistogramDeltas> deltas;
+  if( !run.getByLabel(src_, deltas) ) return;
+  merge(*deltas);
+}
+
+void
+LumiDeltaToMEConverter::endJob()
+{
+  edm::LogInfo("LumiDeltaToMEConverter") << "Merged " << lumis_ << " lumis (" << events_ << " events), "
+					 << bins_ << " bins into " << targets_.size() << " histograms; "
+					 << dropped_ << " deltas of undescribed histograms dropped";
+}
+
+void
+LumiDeltaToMEConverter::merge(const LumiHistogramDeltas& deltas)
+{
+  events_+=deltas.events;
+  for(std::vector<HistogramDelta>::const_iterator delta=deltas.deltas.begin(); delta!=deltas.deltas.end(); ++delta){
+    std::map<std::string, Target>::iterator known=targets_.find(delta->folder+"/"+delta->name);
+    Target* target=(known!=targets_.end()) ? &known->second : book(*delta);
+    if( !target ){ ++dropped_; continue; }
+
+    // unpack the delta into a histogram of the same binning; without
+    // squared weights the bins are taken as unweighted counts
+    TH1* hist=target->delta;
+    hist->Reset();
+    for(unsigned int idx=0; idx<delta->bins.size(); ++idx){
+      hist->SetBinContent(delta->bins[idx], delta->values[idx]);
+    }
+    if( !delta->sumw2.empty() && hist->GetSumw2N()==0 ) hist->Sumw2();
+    if( hist->GetSumw2N()>0 ){
+      const std::vector<double>& sumw2=delta->sumw2.empty() ? delta->values : delta->sumw2;
+      TArrayD& weights=*hist->GetSumw2();
+      for(unsigned int idx=0; idx<delta->bins.size(); ++idx){ weights[delta->bins[idx]]=sumw2[idx]; }
+    }
+    hist->SetEntries(delta->entries);
+    target->me->getTH1()->Add(hist);
+    target->me->update();
+    bins_+=delta->bins.size();
+  }
+}
+
+LumiDeltaToMEConverter::Target*
+LumiDeltaToMEConverter::book(const HistogramDelta& delta)
+{
+  if( !delta.described() ) return 0;
+  if( !store_ ) store_=edm::Service<DQMStore>().operator->();
+  // reuse a MonitorElement of the same name, which
+  // has been booked by another module of the job
+  MonitorElement* me=store_->get(delta.folder+"/"+delta.name);
+  if( !me ){
+    store_->setCurrentFolder(delta.folder);
+    // the MonitorElement is booked with the ROOT class of the original
+    // histogram; the DQMStore books a copy of the given histogram
+    const char* name=delta.name.c_str(); const char* title=delta.title.c_str();
+    const float* x=&delta.xEdges[0]; int nx=delta.xEdges.size()-1;
+    const float* y=delta.is2D() ? &delta.yEdges[0] : 0; int ny=delta.yEdges.size()-1;
+    if( delta.type=="TH1S" ){ TH1S hist(name, title, nx, x); me=store_->book1S(delta.name, &hist); }
+    else if( delta.type=="TH1D" ){ TH1D hist(name, title, nx, x); me=store_->book1DD(delta.name, &hist); }
+    else if( delta.type=="TH2F" ){ TH2F hist(name, title, nx, x, ny, y); me=store_->book2D(delta.name, &hist); }
+    else if( delta.type=="TH2S" ){ TH2S hist(name, title, nx, x, ny, y); me=store_->book2S(delta.name, &hist); }
+    else if( delta.type=="TH2D" ){ TH2D hist(name, title, nx, x, ny, y); me=store_->book2DD(delta.name, &hist); }
+    else{ TH1F hist(name, title, nx, x); me=store_->book1D(delta.name, &hist); }
+    if( !delta.xTitle.empty() ) me->setAxisTitle(delta.xTitle, 1);
+    if( !delta.yTitle.empty() ) me->setAxisTitle(delta.yTitle, 2);
+    for(unsigned int bin=0; bin<delta.xLabels.size(); ++bin){
+      if( !delta.xLabels[bin].empty() ) me->setBinLabel(bin+1, delta.xLabels[bin], 1);
+    }
+    for(unsigned int bin=0; bin<delta.yLabels.size(); ++bin){
+      if( !delta.yLabels[bin].empty() ) me->setBinLabel(bin+1, delta.yLabels[bin], 2);
+    }
+  }
+  Target& target=targets_[delta.folder+"/"+delta.name];
+  target.me=me;
+  target.delta=static_cast<TH1*>(me->getTH1()->Clone());
+  target.delta->SetDirectory(0);
+  return &target;
+}
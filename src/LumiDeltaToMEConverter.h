@@ -0,0 +1,78 @@
+#ifndef LUMIDELTATOMECONVERTER
+#define LUMIDELTATOMECONVERTER
+
+#include <map>
+#include <string>
+
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+#include "TH1.h"
+#include "DQM/Physics/interface/HistogramDeltas.h"
+
+/**
+   \class   LumiDeltaToMEConverter LumiDeltaToMEConverter.h "DQM/Physics/src/LumiDeltaToMEConverter.h"
+
+   \brief   Module to merge the per luminosity block deltas of the MEtoLumiDeltaConverter into MonitorElements.
+
+   Harvesting counterpart of the MEtoLumiDeltaConverter. The LumiHistogramDeltas given by
+   the parameter _src_ are read at the end of each luminosity block and run and streamed
+   into MonitorElements in the DQMStore, which are booked from the description of the
+   histograms (with the ROOT class of the original histogram) when they are seen for the
+   first time. Each delta is unpacked into a histogram of the same binning, which is added
+   to the MonitorElement via TH1::Add; the MonitorElement is then marked as updated. The
+   time spent per luminosity block scales with the number of changed histograms and bins
+   only; there is no collation of full snapshots.
+   Deltas of histograms without a description that have not been booked before (e.g. for
+   input files which do not start with the first luminosity block of the producing job)
+   are dropped and counted. The number of merged luminosity blocks, events and bins is
+   reported at the end of the job.
+*/
+
+class LumiDeltaToMEConverter : public edm::EDAnalyzer {
+ public:
+  /// default constructor
+  LumiDeltaToMEConverter(const edm::ParameterSet& cfg);
+  /// default destructor
+  ~LumiDeltaToMEConverter();
+
+  /// nothing to be done during the event loop
+  virtual void analyze(const edm::Event& event, const edm::EventSetup& setup){};
+  /// merge the deltas of the luminosity block
+  virtual void endLuminosityBlock(const edm::LuminosityBlock& lumi, const edm::EventSetup& setup);
+  /// merge the deltas after the last luminosity block of the run
+  virtual void endRun(const edm::Run& run, const edm::EventSetup& setup);
+  /// report the merged luminosity blocks, events and bins
+  virtual void endJob();
+
+ private:
+  /// MonitorElement and the histogram its deltas are unpacked into
+  struct Target {
+    Target() : me(0), delta(0) {};
+    MonitorElement* me; TH1* delta;
+  };
+
+ private:
+  /// merge _deltas_ into the MonitorElements
+  void merge(const LumiHistogramDeltas& deltas);
+  /// book the MonitorElement described by _delta_; returns 0 if it is not described
+  Target* book(const HistogramDelta& delta);
+
+ private:
+  /// input deltas
+  edm::InputTag src_;
+  /// storage manager
+  DQMStore* store_;
+  /// booked MonitorElements indexed by their full name
+  std::map<std::string, Target> targets_;
+  /// merged luminosity blocks, events and bins
+  unsigned long lumis_, events_, bins_;
+  /// dropped deltas of undescribed histograms
+  unsigned long dropped_;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#include "DQM/Physics/interface/LumiTrends.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+
+#include "TH1.h"
+
+LumiTrends::LumiTrends(const std::string& directory, unsigned int nLumis) :
+  folder_(directory+"Trends"), nLumis_(nLumis>0 ? nLumis : 1), events_(0.)
+{
+  eventTrend_=book("Events", "Analyzed events per lumi section");
+}
+
+unsigned int
+LumiTrends::add(const std::string& name, const std::string& title)
+{
+  trends_.push_back(book(name, title));
+  counts_.push_back(0.);
+  return counts_.size()-1;
+}
+
+void
+LumiTrends::append(unsigned int lumi)
+{
+  // counters without entries are skipped to keep the
+  // number of fills at one per non-empty point
+  if( events_>0. ) eventTrend_->Fill(lumi, events_);
+  for(unsigned int idx=0; idx<counts_.size(); ++idx){
+    if( counts_[idx]!=0. ) trends_[idx]->Fill(lumi, counts_[idx]);
+    counts_[idx]=0.;
+  }
+  events_=0.;
+}
+
+void
+LumiTrends::beginRun()
+{
+  reset(eventTrend_);
+  for(unsigned int idx=0; idx<counts_.size(); ++idx){ reset(trends_[idx]); counts_[idx]=0.; }
+  events_=0.;
+}
+
+MonitorElement*
+LumiTrends::book(const std::string& name, const std::string& title)
+{
+  DQMStore* store=edm::Service<DQMStore>().operator->();
+  store->setCurrentFolder(folder_);
+  MonitorElement* trend=store->book1D(name, title, nLumis_, 0.5, nLumis_+0.5);
+  trend->setAxisTitle("lumi section", 1);
+  // let ROOT double the range for later lumi sections
+  trend->getTH1()->SetBit(TH1::kCanRebin);
+  return trend;
+}
+
+void
+LumiTrends::reset(MonitorElement* trend)
+{
+  // the range may have been extended during the previous run
+  trend->Reset();
+  trend->getTH1()->SetBins(nLumis_, 0.5, nLumis_+0.5);
+}
@@ -0,0 +1,100 @@
+#include "DQM/Physics/src/MEtoLumiDeltaConverter.h"
+
+#include <memory>
+
+#include "TH1.h"
+#include "TAxis.h"
+#include "TArrayD.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+
+MEtoLumiDeltaConverter::MEtoLumiDeltaConverter(const edm::ParameterSet& cfg):
+  folders_(cfg.getParameter<std::vector<std::string> >("folders")), store_(0), events_(0)
+{
+  produces<LumiHistogramDeltas, edm::InLumi>();
+  produces<LumiHistogramDeltas, edm::InRun >();
+}
+
+void
+MEtoLumiDeltaConverter::produce(edm::Event& event, const edm::EventSetup& setup)
+{
+  ++events_;
+}
+
+void
+MEtoLumiDeltaConverter::endLuminosityBlock(edm::LuminosityBlock& lumi, const edm::EventSetup& setup)
+{
+  std::auto_ptr<LumiHistogramDeltas> product(new LumiHistogramDeltas());
+  deltas(*product);
+  edm::LogInfo("MEtoLumiDeltaConverter") << "Lumi " << lumi.luminosityBlock() << ": " << product->events << " events, "
+					 << product->deltas.size() << " changed histograms";
+  lumi.put(product);
+}
+
+void
+MEtoLumiDeltaConverter::endRun(edm::Run& run, const edm::EventSetup& setup)
+{
+  std::auto_ptr<LumiHistogramDeltas> product(new LumiHistogramDeltas());
+  deltas(*product);
+  run.put(product);
+}
+
+void
+MEtoLumiDeltaConverter::deltas(LumiHistogramDeltas& deltas)
+{
+  deltas.events=events_; events_=0;
+  if( !store_ ) store_=edm::Service<DQMStore>().operator->();
+  for(std::vector<std::string>::const_iterator folder=folders_.begin(); folder!=folders_.end(); ++folder){
+    std::vector<MonitorElement*> mes=store_->getAllContents(*folder);
+    for(std::vector<MonitorElement*>::const_iterator me=mes.begin(); me!=mes.end(); ++me){
+      MonitorElement::Kind kind=(*me)->kind();
+      if( kind!=MonitorElement::DQM_KIND_TH1F && kind!=MonitorElement::DQM_KIND_TH1S && kind!=MonitorElement::DQM_KIND_TH1D &&
+	  kind!=MonitorElement::DQM_KIND_TH2F && kind!=MonitorElement::DQM_KIND_TH2S && kind!=MonitorElement::DQM_KIND_TH2D ) continue;
+
+      TH1* hist=(*me)->getTH1();
+      Snapshot& snapshot=snapshots_[(*me)->getFullname()];
+      unsigned int nCells=hist->GetNcells();
+      // the snapshot of a histogram seen for the first time is empty
+      if( snapshot.contents.size()!=nCells ){ snapshot.contents.assign(nCells, 0.); snapshot.sumw2.clear(); snapshot.entries=0.; }
+      const TArrayD* sumw2=(hist->GetSumw2N()>0) ? hist->GetSumw2() : 0;
+      if( sumw2 && snapshot.sumw2.size()!=nCells ) snapshot.sumw2.assign(nCells, 0.);
+
+      HistogramDelta delta;
+      for(unsigned int bin=0; bin<nCells; ++bin){
+	double value=hist->GetBinContent(bin)-snapshot.contents[bin];
+	double weights=sumw2 ? sumw2->At(bin)-snapshot.sumw2[bin] : 0.;
+	if( value==0. && weights==0. ) continue;
+	delta.bins.push_back(bin); delta.values.push_back(value);
+	if( sumw2 ) delta.sumw2.push_back(weights);
+	snapshot.contents[bin]+=value;
+	if( sumw2 ) snapshot.sumw2[bin]+=weights;
+      }
+      delta.entries=hist->GetEntries()-snapshot.entries; snapshot.entries=hist->GetEntries();
+      // only the histograms which changed are written; the
+      // description goes with the first delta of a histogram
+      if( delta.bins.empty() && delta.entries==0. ) continue;
+      delta.folder=(*me)->getPathname(); delta.name=(*me)->getName();
+      if( !snapshot.described ){ describe(*me, delta); snapshot.described=true; }
+      deltas.deltas.push_back(delta);
+    }
+  }
+}
+
+void
+MEtoLumiDeltaConverter::describe(MonitorElement* me, HistogramDelta& delta) const
+{
+  TH1* hist=me->getTH1();
+  delta.type=hist->ClassName();
+  delta.title=hist->GetTitle();
+  delta.xTitle=hist->GetXaxis()->GetTitle();
+  for(int bin=1; bin<=hist->GetNbinsX()+1; ++bin){ delta.xEdges.push_back(hist->GetXaxis()->GetBinLowEdge(bin)); }
+  if( hist->GetXaxis()->GetLabels() ){
+    for(int bin=1; bin<=hist->GetNbinsX(); ++bin){ delta.xLabels.push_back(hist->GetXaxis()->GetBinLabel(bin)); }
+  }
+  if( hist->GetDimension()<2 ) return;
+  delta.yTitle=hist->GetYaxis()->GetTitle();
+  for(int bin=1; bin<=hist->GetNbinsY()+1; ++bin){ delta.yEdges.push_back(hist->GetYaxis()->GetBinLowEdge(bin)); }
+  if( hist->GetYaxis()->GetLabels() ){
+    for(int bin=1; bin<=hist->GetNbinsY(); ++bin){ delta.yLabels.push_back(hist->GetYaxis()->GetBinLabel(bin)); }
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef METOLUMIDELTACONVERTER
+#define METOLUMIDELTACONVERTER
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+#include "DQM/Physics/interface/HistogramDeltas.h"
+
+/**
+   \class   MEtoLumiDeltaConverter MEtoLumiDeltaConverter.h "DQM/Physics/src/MEtoLumiDeltaConverter.h"
+
+   \brief   Module to write the per luminosity block changes of MonitorElements into the lumi.
+
+   At the end of each luminosity block the module compares all 1- and 2-dimensional
+   MonitorElements below the DQMStore folders given by the parameter _folders_ with their
+   snapshot from the end of the previous luminosity block and puts the non-zero differences
+   as LumiHistogramDeltas into the luminosity block; histograms which did not change are
+   not written. The description of a histogram is sent with its first delta. Changes after the last luminosity block
+   of a run (e.g. from endRun) are put into the run. This replaces the full snapshots of the
+   MEtoEDMConverter for the incremental harvesting with the LumiDeltaToMEConverter, which
+   merges the deltas in O(changed bins). The module has to be scheduled after all DQM modules
+   which fill the monitored folders. Profiles and 3-dimensional histograms are not supported.
+*/
+
+class MEtoLumiDeltaConverter : public edm::EDProducer {
+ public:
+  /// default constructor
+  MEtoLumiDeltaConverter(const edm::ParameterSet& cfg);
+  /// default destructor
+  ~MEtoLumiDeltaConverter(){};
+
+  /// count the events of the luminosity block
+  virtual void produce(edm::Event& event, const edm::EventSetup& setup);
+  /// put the deltas since the previous luminosity block into the lumi
+  virtual void endLuminosityBlock(edm::LuminosityBlock& lumi, const edm::EventSetup& setup);
+  /// put the deltas since the last luminosity block into the run
+  virtual void endRun(edm::Run& run, const edm::EventSetup& setup);
+
+ private:
+  /// bin contents, squared weights and entries at the previous snapshot
+  struct Snapshot {
+    Snapshot() : entries(0.), described(false) {};
+    std::vector<double> contents, sumw2; double entries;
+    /// true once a delta with the description has been written
+    bool described;
+  };
+
+ private:
+  /// fill the deltas of all monitored histograms since the previous snapshot
+  void deltas(LumiHistogramDeltas& deltas);
+  /// fill the description of the histogram _me_ into _delta_
+  void describe(MonitorElement* me, HistogramDelta& delta) const;
+
+ private:
+  /// DQMStore folders to be monitored
+  std::vector<std::string> folders_;
+  /// storage manager
+  DQMStore* store_;
+  /// number of events since the previous snapshot
+  unsigned int events_;
+  /// snapshots indexed by the full name of the histograms
+  std::map<std::string, Snapshot> snapshots_;
+};
+
+#endif
@@ -0,0 +1,35 @@
+#include "DQM/Physics/interface/MonitorSampling.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+
+#include <time.h>
+
+MonitorSampling::MonitorSampling(const std::string& directory, unsigned int prescale, double timeBudget) :
+  prescale_(prescale), timeBudget_(timeBudget), nEvents_(0), nSampled_(0), sampled_(false), start_(0.), spent_(0.)
+{
+  DQMStore* store=edm::Service<DQMStore>().operator->();
+  store->setCurrentFolder(directory+"Sampling");
+
+  events_= store->book1D  ("Events", "Sampled events", 2, 0., 2.);
+  events_->setBinLabel(1, "all"    , 1);
+  events_->setBinLabel(2, "sampled", 1);
+  weight_= store->bookFloat("Weight");
+}
+
+bool
+MonitorSampling::next()
+{
+  // the budget is checked against the events seen before this one, such
+  // that the first event is always sampled
+  sampled_ = (prescale_<=1 || nEvents_%prescale_==0) && (timeBudget_<=0. || spent_<=timeBudget_*nEvents_);
+  ++nEvents_; events_->Fill(0.5);
+  if(sampled_){ ++nSampled_; events_->Fill(1.5); }
+  weight_->Fill(weight());
+  return sampled_;
+}
+
+double
+MonitorSampling::cpuTime() const
+{
+  timespec ts; clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec*1.e3+ts.tv_nsec*1.e-6;
+}
@@ -0,0 +1,114 @@
+#include "DQM/Physics/interface/SelectionGraph.h"
+#include "DQM/Physics/interface/TopDQMHelpers.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/METReco/interface/MET.h"
+#include "DataFormats/JetReco/interface/PFJet.h"
+#include "DataFormats/JetReco/interface/CaloJet.h"
+#include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/EgammaCandidates/interface/GsfElectron.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+
+/// node implementation for a given SelectionStep type; the mode
+/// determines which of the select functions is to be called
+template <typename Object>
+class SelectionGraph::StepNode : public SelectionGraph::Node {
+public:
+  /// different flavours of the SelectionStep::select functions
+  enum Mode{ EVENT, SETUP, VERTEX, PFMUON, PFELECTRON };
+
+public:
+  /// default constructor
+  StepNode(const edm::ParameterSet& cfg, Mode mode) : step_(cfg), mode_(mode) {};
+  /// default destructor
+  virtual ~StepNode(){};
+  /// apply the selection
+  virtual bool evaluate(const edm::Event& event, const edm::EventSetup& setup){
+    switch(mode_){
+    case SETUP      : return step_.select(event, setup);
+    case VERTEX     : return step_.selectVertex(event);
+    case PFMUON     : return step_.select(event, "muon");
+    case PFELECTRON : return step_.select(event, "electron");
+    default         : return step_.select(event);
+    }
+  };
+
+private:
+  /// selection step
+  SelectionStep<Object> step_;
+  /// flavour of the select function
+  Mode mode_;
+};
+
+SelectionGraph::SelectionGraph(const edm::ParameterSet& cfg, edm::ActivityRegistry& registry) :
+  subscriptions_(0)
+{
+  registry.watchPreProcessEvent(this, &SelectionGraph::preProcessEvent);
+}
+
+SelectionGraph::~SelectionGraph()
+{
+  for(unsigned int idx=0; idx<nodes_.size(); ++idx){
+    delete nodes_[idx];
+  }
+}
+
+bool
+SelectionGraph::supports(const std::string& type) const
+{
+  return (type=="muons" || type=="muons/pf" || type=="elecs" || type=="elecs/pf" || type=="pvs" ||
+	  type=="jets"  || type=="jets/pf"  || type=="jets/calo" || type=="met");
+}
+
+SelectionGraph::Node*
+SelectionGraph::create(const std::string& type, const edm::ParameterSet& cfg) const
+{
+  if(type=="muons"    ) return new StepNode<reco::Muon       >(cfg, StepNode<reco::Muon       >::EVENT     );
+  if(type=="muons/pf" ) return new StepNode<reco::PFCandidate>(cfg, StepNode<reco::PFCandidate>::PFMUON    );
+  if(type=="elecs"    ) return new StepNode<reco::GsfElectron>(cfg, StepNode<reco::GsfElectron>::EVENT     );
+  if(type=="elecs/pf" ) return new StepNode<reco::PFCandidate>(cfg, StepNode<reco::PFCandidate>::PFELECTRON);
+  if(type=="pvs"      ) return new StepNode<reco::Vertex     >(cfg, StepNode<reco::Vertex     >::VERTEX    );
+  if(type=="jets"     ) return new StepNode<reco::Jet        >(cfg, StepNode<reco::Jet        >::SETUP     );
+  if(type=="jets/pf"  ) return new StepNode<reco::PFJet      >(cfg, StepNode<reco::PFJet      >::SETUP     );
+  if(type=="jets/calo") return new StepNode<reco::CaloJet    >(cfg, StepNode<reco::CaloJet    >::SETUP     );
+  if(type=="met"      ) return new StepNode<reco::MET        >(cfg, StepNode<reco::MET        >::EVENT     );
+  throw cms::Exception("Configuration") << "SelectionGraph: unsupported object type '" << type << "'\n";
+}
+
+unsigned int
+SelectionGraph::subscribe(const std::string& type, const edm::ParameterSet& cfg)
+{
+  // the label of the selection step does not change the
+  // selection itself; drop it from the key such that the
+  // same step with different labels maps to the same node
+  edm::ParameterSet step(cfg);
+  if(step.exists("label")) step.eraseSimpleParameter("label");
+  std::string key = type+"|"+step.toString();
+
+  ++subscriptions_;
+  std::map<std::string, unsigned int>::const_iterator node=index_.find(key);
+  if(node!=index_.end()) return node->second;
+
+  nodes_.push_back(create(type, cfg));
+  evaluated_.push_back(edm::EventID());
+  results_.push_back(false);
+  index_[key]=nodes_.size()-1;
+  return nodes_.size()-1;
+}
+
+bool
+SelectionGraph::select(unsigned int id, const edm::Event& event, const edm::EventSetup& setup)
+{
+  if(evaluated_[id]!=event.id()){
+    results_[id]=nodes_[id]->evaluate(event, setup);
+    evaluated_[id]=event.id();
+  }
+  return results_[id];
+}
+
+void
+SelectionGraph::preProcessEvent(const edm::EventID& id, const edm::Timestamp& time)
+{
+  evaluated_.assign(evaluated_.size(), edm::EventID());
+}
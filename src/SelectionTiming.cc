@@ -0,0 +1,53 @@
+#include "DQM/Physics/interface/SelectionTiming.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+
+#include <time.h>
+
+SelectionTiming::SelectionTiming(const std::string& directory, const std::vector<std::string>& steps, unsigned int sampling) :
+  sampling_(sampling), nEvents_(0), sampled_(false), start_(0.)
+{
+  DQMStore* store=edm::Service<DQMStore>().operator->();
+  store->setCurrentFolder(directory+"Timing");
+
+  unsigned int nSteps=steps.size();
+  accepted_  = store->book1D     ("Accepted"  , "Accepted events"       , nSteps, 0., nSteps);
+  rejected_  = store->book1D     ("Rejected"  , "Rejected events"       , nSteps, 0., nSteps);
+  selectTime_= store->book1D     ("SelectTime", "CPU time (selection)"  , nSteps, 0., nSteps);
+  fillTime_  = store->book1D     ("FillTime"  , "CPU time (monitoring)" , nSteps, 0., nSteps);
+  for(unsigned int idx=0; idx<nSteps; ++idx){
+    bins_[steps[idx]]=idx+0.5;
+    accepted_  ->setBinLabel(idx+1, steps[idx], 1);
+    rejected_  ->setBinLabel(idx+1, steps[idx], 1);
+    selectTime_->setBinLabel(idx+1, steps[idx], 1);
+    fillTime_  ->setBinLabel(idx+1, steps[idx], 1);
+  }
+  selectTime_->setAxisTitle("t_{CPU} [ms]", 2);
+  fillTime_  ->setAxisTitle("t_{CPU} [ms]", 2);
+}
+
+void
+SelectionTiming::selected(const std::string& step, bool passed)
+{
+  if(sampled_) selectTime_->Fill(bin(step), cpuTime()-start_);
+  passed ? accepted_->Fill(bin(step)) : rejected_->Fill(bin(step));
+}
+
+void
+SelectionTiming::filled(const std::string& step)
+{
+  if(sampled_) fillTime_->Fill(bin(step), cpuTime()-start_);
+}
+
+double
+SelectionTiming::cpuTime() const
+{
+  timespec ts; clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec*1.e3+ts.tv_nsec*1.e-6;
+}
+
+double
+SelectionTiming::bin(const std::string& step) const
+{
+  std::map<std::string, double>::const_iterator idx=bins_.find(step);
+  return idx!=bins_.end() ? idx->second : -1.;
+}
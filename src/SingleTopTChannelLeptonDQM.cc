@@ -8,6 +8,7 @@
 #include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
 #include "DataFormats/GsfTrackReco/interface/GsfTrack.h"
 #include "DataFormats/Math/interface/deltaR.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include <iostream>
 using namespace std;
 namespace SingleTopTChannelLepton {
@@ -19,10 +20,14 @@ namespace SingleTopTChannelLepton {
   // be used for the top mass estimate
   static const double WMASS = 80.4;
   
-  MonitorEnsemble::MonitorEnsemble(const char* label, const edm::ParameterSet& cfg, const edm::VParameterSet& vcfg) : 
-    label_(label), pvSelect_(0), jetIDSelect_(0), includeBTag_(false), lowerEdge_(-1.), upperEdge_(-1.), logged_(0)
+  MonitorEnsemble::MonitorEnsemble(const char* label, const edm::ParameterSet& cfg, const edm::VParameterSet& vcfg, const HistogramTable* table) : 
+    label_(label), pvSelect_(0), jetIDSelect_(0), includeBTag_(false), lowerEdge_(-1.), upperEdge_(-1.), logged_(0), table_(table), arena_(0)
     
   {
+    // the slots of the table have to follow the enumeration
+    if( table_->size()!=NHISTOGRAMS ){
+      throw cms::Exception("Configuration") << "MonitorEnsemble: histogram table has " << table_->size() << " entries, expected " << NHISTOGRAMS << "\n";
+    }
     // sources have to be given; this PSet is not optional
     edm::ParameterSet sources=cfg.getParameter<edm::ParameterSet>("sources");
     muons_ = sources.getParameter<edm::InputTag>("muons");
@@ -167,180 +172,171 @@ namespace SingleTopTChannelLepton {
     // determine number of bins for trigger monitoring
     unsigned int nPaths=triggerPaths_.size();
     
-    // --- [STANDARD] --- //
-    // number of selected primary vertices
-    hists_["pvMult_"     ] = store_->book1D("PvMult"     , "N_{pvs}"          ,     100,     0.,    100.);  
-    // pt of the leading muon
-    hists_["muonPt_"     ] = store_->book1D("MuonPt"     , "pt(#mu)"          ,     50,     0.,    250.);   
-    // muon multiplicity before std isolation
-    hists_["muonMult_"   ] = store_->book1D("MuonMult"   , "N_{20}(#mu)"     ,     10,     0.,     10.);   
-    // muon multiplicity after  std isolation
-    hists_["muonMultIso_"] = store_->book1D("MuonMultIso", "N_{Iso}(#mu)"     ,     10,     0.,     10.);   
-    // pt of the leading electron
-    hists_["elecPt_"     ] = store_->book1D("ElecPt"     , "pt(e)"            ,     50,     0.,    250.);   
-    // electron multiplicity before std isolation
-    hists_["elecMult_"   ] = store_->book1D("ElecMult"   , "N_{30}(e)"       ,     10,     0.,     10.);   
-    // electron multiplicity after  std isolation
-    hists_["elecMultIso_"] = store_->book1D("ElecMultIso", "N_{Iso}(e)"       ,     10,     0.,     10.);   
-    // multiplicity of jets with pt>20 (corrected to L2+L3)
-    hists_["jetMult_"    ] = store_->book1D("JetMult"    , "N_{30}(jet)"      ,     10,     0.,     10.);   
-    // trigger efficiency estimates for single lepton triggers
-    hists_["triggerEff_" ] = store_->book1D("TriggerEff" , "Eff(trigger)"     , nPaths,     0.,  nPaths);
-    // monitored trigger occupancy for single lepton triggers
-    hists_["triggerMon_" ] = store_->book1D("TriggerMon" , "Mon(trigger)"     , nPaths,     0.,  nPaths);
-    // MET (calo)
-    hists_["metCalo_"    ] = store_->book1D("METCalo"    , "MET_{Calo}"       ,     50,     0.,    200.);   
-    // W mass estimate
-    hists_["massW_"      ] = store_->book1D("MassW"      , "M(W)"             ,     60,     0.,    300.);   
-    // Top mass estimate
-    hists_["massTop_"    ] = store_->book1D("MassTop"    , "M(Top)"           ,     50,     0.,    500.);   
-    // W mass transverse estimate mu
-    hists_["MTWm_"       ] = store_->book1D("MTWm"       , "M_{T}^{W}(#mu)"   ,     60,     0.,    300.);
-    // Top mass transverse estimate mu
-    hists_["mMTT_"       ] = store_->book1D("mMTT"       , "M_{T}^{t}(#mu)"   ,     50,     0.,    500.);
-
-    // W mass transverse estimate e
-    hists_["MTWe_"       ] = store_->book1D("MTWe"       , "M_{T}^{W}(e)"     ,     60,     0.,    300.);
-    // Top mass transverse estimate e
-    hists_["eMTT_"       ] = store_->book1D("eMTT"       , "M_{T}^{t}(e)"     ,     50,     0.,    500.);
+    // book all histograms of the table up to the verbosity
+    // level; histograms without binning in x are booked with
+    // one bin per trigger path
+    hists_.assign(table_->size(), 0);
+    for(unsigned int slot=0; slot<table_->size(); ++slot){
+      const HistogramTable::Entry& hist=(*table_)[slot];
+      if( hist.level>verbosity_ ) continue;
+      int nBinsX=hist.nBinsX>0 ? hist.nBinsX : nPaths; double highX=hist.nBinsX>0 ? hist.highX : nPaths;
+      if( hist.is2D() ) hists_[slot] = store_->book2D(hist.name, hist.title, nBinsX, hist.lowX, highX, hist.nBinsY, hist.lowY, hist.highY);
+      else hists_[slot] = store_->book1D(hist.name, hist.title, nBinsX, hist.lowX, highX);
+    }
     
     // set bin labels for trigger monitoring
-    triggerBinLabels(std::string("trigger"), triggerPaths_);
-
-    if( verbosity_==STANDARD) return;
-
-    // --- [VERBOSE] --- //
-
-    // eta of the leading muon
-    hists_["muonEta_"    ] = store_->book1D("MuonEta"    , "#eta(#mu)"        ,     30,    -3.,      3.);   
-    // std isolation variable of the leading muon
-    hists_["muonPFRelIso_" ] = store_->book1D("MuonPFRelIso","PFIso_{Rel}(#mu)",    50,     0.,      1.);   
-    hists_["muonRelIso_" ] = store_->book1D("MuonRelIso" , "Iso_{Rel}(#mu)"   ,     50,     0.,      1.);   
-
-    // eta of the leading electron
-    hists_["elecEta_"    ] = store_->book1D("ElecEta"    , "#eta(e)"          ,     30,    -3.,      3.);   
-    // std isolation variable of the leading electron
-    hists_["elecRelIso_" ] = store_->book1D("ElecRelIso" , "Iso_{Rel}(e)"     ,     50,     0.,      1.);   
-    hists_["elecPFRelIso_" ] = store_->book1D("ElecPFRelIso" , "PFIso_{Rel}(e)",    50,     0.,      1.);   
-
-    // multiplicity of btagged jets (for track counting high efficiency) with pt(L2L3)>30
-    hists_["jetMultBEff_"] = store_->book1D("JetMultBEff", "N_{30}(b/eff)"    ,     10,     0.,     10.);   
-    // btag discriminator for track counting high efficiency for jets with pt(L2L3)>30
-    hists_["jetBDiscEff_"] = store_->book1D("JetBDiscEff", "Disc_{b/eff}(jet)",     100,     0.,     10.);   
-    
-    
-    // eta of the 1. leading jet 
-    hists_["jet1Eta_"     ] = store_->book1D("Jet1Eta"   , "#eta (jet1)" ,    50,     -5.,    5.);   
-    // eta of the 2. leading jet 
-    hists_["jet2Eta_"     ] = store_->book1D("Jet2Eta"   , "#eta (jet2)" ,    50,     -5.,    5.);   
-    
-    // pt of the 1. leading jet (corrected to L2+L3)
-    hists_["jet1Pt_"     ] = store_->book1D("Jet1Pt"     , "pt_{L2L3}(jet1)"  ,     60,     0.,    300.);   
-    // pt of the 2. leading jet (corrected to L2+L3)
-    hists_["jet2Pt_"     ] = store_->book1D("Jet2Pt"     , "pt_{L2L3}(jet2)"  ,     60,     0.,    300.);   
-    
-    
-    // eta and pt of the b-tagged jet (filled only when nJets==2)
-    hists_["TaggedJetEta_"     ] = store_->book1D("TaggedJetEta"   , "#eta (Tagged jet)"  ,   50,   -5.,  5.);
-    hists_["TaggedJetPt_"      ] = store_->book1D("TaggedJetPt"     , "pt_{L2L3}(Tagged jet)"   ,   60,    0.,  300.);
-    
-    // eta and pt of the jet not passing b-tag (filled only when nJets==2)
-    hists_["UnTaggedJetEta_"     ] = store_->book1D("UnTaggedJetEta"   , "#eta (UnTagged jet)"  ,   50,   -5.,  5.);
-    hists_["UnTaggedJetPt_"      ] = store_->book1D("UnTaggedJetPt"     , "pt_{L2L3}(UnTagged jet)"   ,   60,    0.,  300.);
-    
-    // eta and pt of the most forward jet in the event with nJets==2
-    hists_["FwdJetEta_"     ] = store_->book1D("FwdJetEta"   , "#eta (Fwd jet)"  ,   50,   -5.,  5.);
-    hists_["FwdJetPt_"      ] = store_->book1D("FwdJetPt"     , "pt_{L2L3}(Fwd jet)"   ,   60,    0.,  300.);
-    
-    
-    // 2D histogram (pt,eta) of the b-tagged jet (filled only when nJets==2)
-    hists_["TaggedJetPtEta_"   ] = store_->book2D("TaggedJetPt_Eta"     , "(pt vs #eta)_{L2L3}(Tagged jet)" , 60, 0., 300., 50, -5., 5.);   
-    
-    // 2D histogram (pt,eta) of the not-b tagged jet (filled only when nJets==2)
-    hists_["UnTaggedJetPtEta_"   ] = store_->book2D("UnTaggedJetPt_Eta"     , "(pt vs #eta)_{L2L3}(UnTagged jet)" , 60, 0., 300., 50, -5., 5.);   
-    
-    
-    
-    // MET (tc)
-    hists_["metTC_"      ] = store_->book1D("METTC"      , "MET_{TC}"         ,     50,     0.,    200.);   
-    // MET (pflow)
-    hists_["metPflow_"   ] = store_->book1D("METPflow"   , "MET_{Pflow}"      ,     50,     0.,    200.);   
-    
-    // dz for muons (to suppress cosmis)
-    hists_["muonDelZ_"    ] = store_->book1D("MuonDelZ"  , "d_{z}(#mu)"       ,     50,   -25.,     25.);
-    // dxy for muons (to suppress cosmics)
-    hists_["muonDelXY_"   ] = store_->book2D("MuonDelXY" , "d_{xy}(#mu)"      ,     50,   -0.1,     0.1,   50,   -0.1,   0.1);
+    triggerBinLabels(triggerPaths_);
     
     // set axes titles for dxy for muons
-    hists_["muonDelXY_"   ]->setAxisTitle( "x [cm]", 1); hists_["muonDelXY_"   ]->setAxisTitle( "y [cm]", 2);
-    
-    if( verbosity_==VERBOSE) return;
-
-    // --- [DEBUG] --- //
-
-    // relative muon isolation from charged hadrons  for the leading muon
-    hists_["muonChHadIso_" ] = store_->book1D("MuonChHadIso" , "Iso_{ChHad}(#mu)"   ,     100,     0.,      1.);   
-    // relative muon isolation from neutral hadrons for the leading muon
-    hists_["muonNeuHadIso_" ] = store_->book1D("MuonNeuHadIso" , "Iso_{NeuHad}(#mu)"  ,  100,     0.,      1.);   
-    // relative muon isolation from photons for the leading muon
-    hists_["muonPhIso_" ] = store_->book1D("MuonPhIso" , "Iso_{Ph}(#mu)"  ,  100,     0.,      1.);   
-
-    // relative electron isolation from charged hadrons for the leading electron
-    hists_["elecChHadIso_" ] = store_->book1D("ElecChHadIso" , "Iso_{ChHad}(e)"     ,     100,     0.,      1.);   
-    // relative electron isolation from neutral hadrons for the leading electron
-    hists_["elecNeuHadIso_" ] = store_->book1D("ElecNeuHadIso" , "Iso_{NeuHad}(e)"    ,     100,     0.,      1.);   
-    // relative electron isolation from photons for the leading electron
-    hists_["elecPhIso_" ] = store_->book1D("ElecPhIso" , "Iso_{Ph}(e)"    ,     100,     0.,      1.);   
-    
-    // multiplicity of btagged jets (for track counting high purity) with pt(L2L3)>30
-    hists_["jetMultBPur_"] = store_->book1D("JetMultBPur", "N_{30}(b/pur)"    ,     10,     0.,     10.);   
-    // btag discriminator for track counting high purity
-    hists_["jetBDiscPur_"] = store_->book1D("JetBDiscPur", "Disc_{b/pur}(Jet)",     200,     -10.,     10.);   
-    // btag discriminator for track counting high purity for 1. leading jet
-    hists_["jet1BDiscPur_"] = store_->book1D("Jet1BDiscPur", "Disc_{b/pur}(Jet1)",     200,     -10.,     10.);   
-    // btag discriminator for track counting high purity for 2. leading jet
-    hists_["jet2BDiscPur_"] = store_->book1D("Jet2BDiscPur", "Disc_{b/pur}(Jet2)",     200,     -10.,     10.);   
-
-
-    // multiplicity of btagged jets (for simple secondary vertex) with pt(L2L3)>30
-    hists_["jetMultBVtx_"] = store_->book1D("JetMultBVtx", "N_{30}(b/vtx)"    ,     10,     0.,     10.);   
-    // btag discriminator for simple secondary vertex
-    hists_["jetBDiscVtx_"] = store_->book1D("JetBDiscVtx", "Disc_{b/vtx}(Jet)",     35,    -1.,      6.);   
-
-
-    // multiplicity of btagged jets (for combined secondary vertex) with pt(L2L3)>30
-    hists_["jetMultBCombVtx_"] = store_->book1D("JetMultBCombVtx", "N_{30}(b/CSV)"    ,     10,     0.,     10.);
-    // btag discriminator for combined secondary vertex
-    hists_["jetBDiscCombVtx_"] = store_->book1D("JetBDiscCombVtx", "Disc_{b/CSV}(Jet)",     60,    -1.,      2.);
-    // btag discriminator for combined secondary vertex for 1. leading jet
-    hists_["jet1BDiscCombVtx_"] = store_->book1D("Jet1BDiscCombVtx", "Disc_{b/CSV}(Jet1)",     60,    -1.,      2.);   
-    // btag discriminator for combined secondary vertex for 2. leading jet
-    hists_["jet2BDiscCombVtx_"] = store_->book1D("Jet2BDiscCombVtx", "Disc_{b/CSV}(Jet2)",     60,    -1.,      2.);   
-    
-    
-    // pt of the 1. leading jet (uncorrected)
-    hists_["jet1PtRaw_"  ] = store_->book1D("Jet1PtRaw"  , "pt_{Raw}(jet1)"   ,     60,     0.,    300.);   
-    // pt of the 2. leading jet (uncorrected)
-    hists_["jet2PtRaw_"  ] = store_->book1D("Jet2PtRaw"  , "pt_{Raw}(jet2)"   ,     60,     0.,    300.);   
+    if( booked(MUON_DEL_XY) ){
+      hists_[MUON_DEL_XY]->setAxisTitle( "x [cm]", 1); hists_[MUON_DEL_XY]->setAxisTitle( "y [cm]", 2);
+    }
     
-    // selected events
-    hists_["eventLogger_"] = store_->book2D("EventLogger", "Logged Events"    ,      9,     0.,      9.,   10,   0.,   10.);
+    if( !booked(EVENT_LOGGER) ) return;
     
     // set axes titles for selected events
-    hists_["eventLogger_"]->getTH1()->SetOption("TEXT");
-    hists_["eventLogger_"]->setBinLabel( 1 , "Run"             , 1);
-    hists_["eventLogger_"]->setBinLabel( 2 , "Block"           , 1);
-    hists_["eventLogger_"]->setBinLabel( 3 , "Event"           , 1);
-    hists_["eventLogger_"]->setBinLabel( 4 , "pt_{L2L3}(jet1)" , 1);
-    hists_["eventLogger_"]->setBinLabel( 5 , "pt_{L2L3}(jet2)" , 1);
-    hists_["eventLogger_"]->setBinLabel( 6 , "pt_{L2L3}(jet3)" , 1);
-    hists_["eventLogger_"]->setBinLabel( 7 , "pt_{L2L3}(jet4)" , 1);
-    hists_["eventLogger_"]->setBinLabel( 8 , "M_{W}"           , 1);
-    hists_["eventLogger_"]->setBinLabel( 9 , "M_{Top}"         , 1);
-    hists_["eventLogger_"]->setAxisTitle("logged evts"         , 2);
+    hists_[EVENT_LOGGER]->getTH1()->SetOption("TEXT");
+    hists_[EVENT_LOGGER]->setBinLabel( 1 , "Run"             , 1);
+    hists_[EVENT_LOGGER]->setBinLabel( 2 , "Block"           , 1);
+    hists_[EVENT_LOGGER]->setBinLabel( 3 , "Event"           , 1);
+    hists_[EVENT_LOGGER]->setBinLabel( 4 , "pt_{L2L3}(jet1)" , 1);
+    hists_[EVENT_LOGGER]->setBinLabel( 5 , "pt_{L2L3}(jet2)" , 1);
+    hists_[EVENT_LOGGER]->setBinLabel( 6 , "pt_{L2L3}(jet3)" , 1);
+    hists_[EVENT_LOGGER]->setBinLabel( 7 , "pt_{L2L3}(jet4)" , 1);
+    hists_[EVENT_LOGGER]->setBinLabel( 8 , "M_{W}"           , 1);
+    hists_[EVENT_LOGGER]->setBinLabel( 9 , "M_{Top}"         , 1);
+    hists_[EVENT_LOGGER]->setAxisTitle("logged evts"         , 2);
     return;
   }
   
+  std::vector<HistogramTable::Entry>
+  MonitorEnsemble::defaults()
+  {
+    typedef HistogramTable::Entry H;
+    // key, name, title, level, binning (nBins<=0: one bin per trigger path)
+    static const H DEFAULTS[] = {
+      // --- [STANDARD] --- //
+      // number of selected primary vertices
+      H("pvMult_"           , "PvMult"           , "N_{pvs}"                           , STANDARD,   100,    0.,  100.),
+      // pt of the leading muon
+      H("muonPt_"           , "MuonPt"           , "pt(#mu)"                           , STANDARD,    50,    0.,  250.),
+      // muon multiplicity before std isolation
+      H("muonMult_"         , "MuonMult"         , "N_{20}(#mu)"                       , STANDARD,    10,    0.,   10.),
+      // muon multiplicity after  std isolation
+      H("muonMultIso_"      , "MuonMultIso"      , "N_{Iso}(#mu)"                      , STANDARD,    10,    0.,   10.),
+      // pt of the leading electron
+      H("elecPt_"           , "ElecPt"           , "pt(e)"                             , STANDARD,    50,    0.,  250.),
+      // electron multiplicity before std isolation
+      H("elecMult_"         , "ElecMult"         , "N_{30}(e)"                         , STANDARD,    10,    0.,   10.),
+      // electron multiplicity after  std isolation
+      H("elecMultIso_"      , "ElecMultIso"      , "N_{Iso}(e)"                        , STANDARD,    10,    0.,   10.),
+      // multiplicity of jets with pt>20 (corrected to L2+L3)
+      H("jetMult_"          , "JetMult"          , "N_{30}(jet)"                       , STANDARD,    10,    0.,   10.),
+      // trigger efficiency estimates for single lepton triggers
+      H("triggerEff_"       , "TriggerEff"       , "Eff(trigger)"                      , STANDARD,     0,    0.,    0.),
+      // monitored trigger occupancy for single lepton triggers
+      H("triggerMon_"       , "TriggerMon"       , "Mon(trigger)"                      , STANDARD,     0,    0.,    0.),
+      // MET (calo)
+      H("metCalo_"          , "METCalo"          , "MET_{Calo}"                        , STANDARD,    50,    0.,  200.),
+      // W mass estimate
+      H("massW_"            , "MassW"            , "M(W)"                              , STANDARD,    60,    0.,  300.),
+      // Top mass estimate
+      H("massTop_"          , "MassTop"          , "M(Top)"                            , STANDARD,    50,    0.,  500.),
+      // W mass transverse estimate mu
+      H("MTWm_"             , "MTWm"             , "M_{T}^{W}(#mu)"                    , STANDARD,    60,    0.,  300.),
+      // Top mass transverse estimate mu
+      H("mMTT_"             , "mMTT"             , "M_{T}^{t}(#mu)"                    , STANDARD,    50,    0.,  500.),
+      // W mass transverse estimate e
+      H("MTWe_"             , "MTWe"             , "M_{T}^{W}(e)"                      , STANDARD,    60,    0.,  300.),
+      // Top mass transverse estimate e
+      H("eMTT_"             , "eMTT"             , "M_{T}^{t}(e)"                      , STANDARD,    50,    0.,  500.),
+      // --- [VERBOSE] --- //
+      // eta of the leading muon
+      H("muonEta_"          , "MuonEta"          , "#eta(#mu)"                         , VERBOSE ,    30,   -3.,    3.),
+      // std isolation variable of the leading muon
+      H("muonPFRelIso_"     , "MuonPFRelIso"     , "PFIso_{Rel}(#mu)"                  , VERBOSE ,    50,    0.,    1.),
+      H("muonRelIso_"       , "MuonRelIso"       , "Iso_{Rel}(#mu)"                    , VERBOSE ,    50,    0.,    1.),
+      // eta of the leading electron
+      H("elecEta_"          , "ElecEta"          , "#eta(e)"                           , VERBOSE ,    30,   -3.,    3.),
+      // std isolation variable of the leading electron
+      H("elecRelIso_"       , "ElecRelIso"       , "Iso_{Rel}(e)"                      , VERBOSE ,    50,    0.,    1.),
+      H("elecPFRelIso_"     , "ElecPFRelIso"     , "PFIso_{Rel}(e)"                    , VERBOSE ,    50,    0.,    1.),
+      // multiplicity of btagged jets (for track counting high efficiency) with pt(L2L3)>30
+      H("jetMultBEff_"      , "JetMultBEff"      , "N_{30}(b/eff)"                     , VERBOSE ,    10,    0.,   10.),
+      // btag discriminator for track counting high efficiency for jets with pt(L2L3)>30
+      H("jetBDiscEff_"      , "JetBDiscEff"      , "Disc_{b/eff}(jet)"                 , VERBOSE ,   100,    0.,   10.),
+      // eta of the 1. leading jet
+      H("jet1Eta_"          , "Jet1Eta"          , "#eta (jet1)"                       , VERBOSE ,    50,   -5.,    5.),
+      // eta of the 2. leading jet
+      H("jet2Eta_"          , "Jet2Eta"          , "#eta (jet2)"                       , VERBOSE ,    50,   -5.,    5.),
+      // pt of the 1. leading jet (corrected to L2+L3)
+      H("jet1Pt_"           , "Jet1Pt"           , "pt_{L2L3}(jet1)"                   , VERBOSE ,    60,    0.,  300.),
+      // pt of the 2. leading jet (corrected to L2+L3)
+      H("jet2Pt_"           , "Jet2Pt"           , "pt_{L2L3}(jet2)"                   , VERBOSE ,    60,    0.,  300.),
+      // eta and pt of the b-tagged jet (filled only when nJets==2)
+      H("TaggedJetEta_"     , "TaggedJetEta"     , "#eta (Tagged jet)"                 , VERBOSE ,    50,   -5.,    5.),
+      H("TaggedJetPt_"      , "TaggedJetPt"      , "pt_{L2L3}(Tagged jet)"             , VERBOSE ,    60,    0.,  300.),
+      // eta and pt of the jet not passing b-tag (filled only when nJets==2)
+      H("UnTaggedJetEta_"   , "UnTaggedJetEta"   , "#eta (UnTagged jet)"               , VERBOSE ,    50,   -5.,    5.),
+      H("UnTaggedJetPt_"    , "UnTaggedJetPt"    , "pt_{L2L3}(UnTagged jet)"           , VERBOSE ,    60,    0.,  300.),
+      // eta and pt of the most forward jet in the event with nJets==2
+      H("FwdJetEta_"        , "FwdJetEta"        , "#eta (Fwd jet)"                    , VERBOSE ,    50,   -5.,    5.),
+      H("FwdJetPt_"         , "FwdJetPt"         , "pt_{L2L3}(Fwd jet)"                , VERBOSE ,    60,    0.,  300.),
+      // 2D histogram (pt,eta) of the b-tagged jet (filled only when nJets==2)
+      H("TaggedJetPtEta_"   , "TaggedJetPt_Eta"  , "(pt vs #eta)_{L2L3}(Tagged jet)"   , VERBOSE ,    60,    0.,  300.,      50,   -5.,    5.),
+      // 2D histogram (pt,eta) of the not-b tagged jet (filled only when nJets==2)
+      H("UnTaggedJetPtEta_" , "UnTaggedJetPt_Eta", "(pt vs #eta)_{L2L3}(UnTagged jet)" , VERBOSE ,    60,    0.,  300.,      50,   -5.,    5.),
+      // MET (tc)
+      H("metTC_"            , "METTC"            , "MET_{TC}"                          , VERBOSE ,    50,    0.,  200.),
+      // MET (pflow)
+      H("metPflow_"         , "METPflow"         , "MET_{Pflow}"                       , VERBOSE ,    50,    0.,  200.),
+      // dz for muons (to suppress cosmis)
+      H("muonDelZ_"         , "MuonDelZ"         , "d_{z}(#mu)"                        , VERBOSE ,    50,  -25.,   25.),
+      // dxy for muons (to suppress cosmics)
+      H("muonDelXY_"        , "MuonDelXY"        , "d_{xy}(#mu)"                       , VERBOSE ,    50,  -0.1,   0.1,      50,  -0.1,   0.1),
+      // --- [DEBUG] --- //
+      // relative muon isolation from charged hadrons  for the leading muon
+      H("muonChHadIso_"     , "MuonChHadIso"     , "Iso_{ChHad}(#mu)"                  , DEBUG   ,   100,    0.,    1.),
+      // relative muon isolation from neutral hadrons for the leading muon
+      H("muonNeuHadIso_"    , "MuonNeuHadIso"    , "Iso_{NeuHad}(#mu)"                 , DEBUG   ,   100,    0.,    1.),
+      // relative muon isolation from photons for the leading muon
+      H("muonPhIso_"        , "MuonPhIso"        , "Iso_{Ph}(#mu)"                     , DEBUG   ,   100,    0.,    1.),
+      // relative electron isolation from charged hadrons for the leading electron
+      H("elecChHadIso_"     , "ElecChHadIso"     , "Iso_{ChHad}(e)"                    , DEBUG   ,   100,    0.,    1.),
+      // relative electron isolation from neutral hadrons for the leading electron
+      H("elecNeuHadIso_"    , "ElecNeuHadIso"    , "Iso_{NeuHad}(e)"                   , DEBUG   ,   100,    0.,    1.),
+      // relative electron isolation from photons for the leading electron
+      H("elecPhIso_"        , "ElecPhIso"        , "Iso_{Ph}(e)"                       , DEBUG   ,   100,    0.,    1.),
+      // multiplicity of btagged jets (for track counting high purity) with pt(L2L3)>30
+      H("jetMultBPur_"      , "JetMultBPur"      , "N_{30}(b/pur)"                     , DEBUG   ,    10,    0.,   10.),
+      // btag discriminator for track counting high purity
+      H("jetBDiscPur_"      , "JetBDiscPur"      , "Disc_{b/pur}(Jet)"                 , DEBUG   ,   200,  -10.,   10.),
+      // btag discriminator for track counting high purity for 1. leading jet
+      H("jet1BDiscPur_"     , "Jet1BDiscPur"     , "Disc_{b/pur}(Jet1)"                , DEBUG   ,   200,  -10.,   10.),
+      // btag discriminator for track counting high purity for 2. leading jet
+      H("jet2BDiscPur_"     , "Jet2BDiscPur"     , "Disc_{b/pur}(Jet2)"                , DEBUG   ,   200,  -10.,   10.),
+      // multiplicity of btagged jets (for simple secondary vertex) with pt(L2L3)>30
+      H("jetMultBVtx_"      , "JetMultBVtx"      , "N_{30}(b/vtx)"                     , DEBUG   ,    10,    0.,   10.),
+      // btag discriminator for simple secondary vertex
+      H("jetBDiscVtx_"      , "JetBDiscVtx"      , "Disc_{b/vtx}(Jet)"                 , DEBUG   ,    35,   -1.,    6.),
+      // multiplicity of btagged jets (for combined secondary vertex) with pt(L2L3)>30
+      H("jetMultBCombVtx_"  , "JetMultBCombVtx"  , "N_{30}(b/CSV)"                     , DEBUG   ,    10,    0.,   10.),
+      // btag discriminator for combined secondary vertex
+      H("jetBDiscCombVtx_"  , "JetBDiscCombVtx"  , "Disc_{b/CSV}(Jet)"                 , DEBUG   ,    60,   -1.,    2.),
+      // btag discriminator for combined secondary vertex for 1. leading jet
+      H("jet1BDiscCombVtx_" , "Jet1BDiscCombVtx" , "Disc_{b/CSV}(Jet1)"                , DEBUG   ,    60,   -1.,    2.),
+      // btag discriminator for combined secondary vertex for 2. leading jet
+      H("jet2BDiscCombVtx_" , "Jet2BDiscCombVtx" , "Disc_{b/CSV}(Jet2)"                , DEBUG   ,    60,   -1.,    2.),
+      // pt of the 1. leading jet (uncorrected)
+      H("jet1PtRaw_"        , "Jet1PtRaw"        , "pt_{Raw}(jet1)"                    , DEBUG   ,    60,    0.,  300.),
+      // pt of the 2. leading jet (uncorrected)
+      H("jet2PtRaw_"        , "Jet2PtRaw"        , "pt_{Raw}(jet2)"                    , DEBUG   ,    60,    0.,  300.),
+      // selected events
+      H("eventLogger_"      , "EventLogger"      , "Logged Events"                     , DEBUG   ,     9,    0.,    9.,      10,    0.,   10.)
+    };
+    return std::vector<H>(DEFAULTS, DEFAULTS+sizeof(DEFAULTS)/sizeof(DEFAULTS[0]));
+  }
+
   void 
   MonitorEnsemble::fill(const edm::Event& event, const edm::EventSetup& setup)
   {
@@ -367,7 +363,7 @@ namespace SingleTopTChannelLepton {
 	pvMult++;
     }
     
-    fill("pvMult_",    pvMult   );
+    fill(PV_MULT,    pvMult   );
     
     /* 
        ------------------------------------------------------------
@@ -398,12 +394,14 @@ namespace SingleTopTChannelLepton {
     
     // check availability of electron id
     edm::Handle<edm::ValueMap<float> > electronId; 
-    if(!electronId_.label().empty()) 
+    if(!electronId_.label().empty()){
       if( !event.getByLabel(electronId_, electronId) ) return;
+      electronIds_.resolve(*elecs_gsf, *electronId);
+    }
     
     // loop electron collection
     unsigned int eMult=0, eMultIso=0;
-    std::vector<const reco::GsfElectron*> isoElecs;
+    ArenaVector<const reco::GsfElectron*>::type isoElecs(arena_);
     reco::GsfElectron e;
     
     
@@ -418,7 +416,7 @@ namespace SingleTopTChannelLepton {
       // restrict to electrons with good electronId
       int eID = 0;
       if (!electronId_.label().empty()) 
-	eID = (int)(*electronId)[elecs_gsf->refAt(idx_gsf)];
+	eID = (int)electronIds_.at(idx_gsf);
       
       if( electronId_.label().empty()  ? true : ( (eID  & eidPattern_) && (eID >=5)) ){ // NEED TO CHECK 
 	
@@ -432,13 +430,13 @@ namespace SingleTopTChannelLepton {
  	  
 	  if( eMult==0 ){
 	    // restrict to the leading electron
-	    fill("elecPt_" , elec->pt() );
-	    fill("elecEta_", elec->eta());
-	    fill("elecRelIso_" , isolationRel );
-	    fill("elecPFRelIso_",PFisolationRel );
-	    fill("elecChHadIso_" , isolationChHad );
-	    fill("elecNeuHadIso_" , isolationNeuHad );
-	    fill("elecPhIso_" , isolationPhoton );
+	    fill(ELEC_PT, elec->pt() );
+	    fill(ELEC_ETA, elec->eta());
+	    fill(ELEC_REL_ISO, isolationRel );
+	    fill(ELEC_PF_REL_ISO,PFisolationRel );
+	    fill(ELEC_CH_HAD_ISO, isolationChHad );
+	    fill(ELEC_NEU_HAD_ISO, isolationNeuHad );
+	    fill(ELEC_PH_ISO, isolationPhoton );
 	    
 	  }
 	  // in addition to the multiplicity counter buffer the iso 
@@ -449,8 +447,8 @@ namespace SingleTopTChannelLepton {
       idx_gsf++;
     }
     
-    fill("elecMult_",    eMult   );
-    fill("elecMultIso_", eMultIso);
+    fill(ELEC_MULT,    eMult   );
+    fill(ELEC_MULT_ISO, eMultIso);
     
     /* 
        ------------------------------------------------------------
@@ -498,8 +496,8 @@ namespace SingleTopTChannelLepton {
       
       // restrict to globalMuons
       if( muon->isGlobalMuon() ){ 
-	fill("muonDelZ_" , muon->globalTrack()->vz());
-	fill("muonDelXY_", muon->globalTrack()->vx(), muon->globalTrack()->vy());
+	fill(MUON_DEL_Z, muon->globalTrack()->vz());
+	fill(MUON_DEL_XY, muon->globalTrack()->vx(), muon->globalTrack()->vy());
 	
 	// apply selection
 	if( !muonSelect || (*muonSelect)(*muonit)) {
@@ -519,13 +517,13 @@ namespace SingleTopTChannelLepton {
 	    //				      muon->pfIsolationR04().sumNeutralHadronEt + muon->pfIsolationR04().sumPhotonEt)/muon->pt() 
 	    // << "   pt: " << muon->pt() << endl;
 	    // restrict to leading muon
-	    fill("muonPt_"     , muon->pt() );
-	    fill("muonEta_"    , muon->eta());
-	    fill("muonRelIso_" , isolationRel );
-	    fill("muonChHadIso_" , isolationChHad );
-	    fill("muonNeuHadIso_" , isolationNeuHad );
-	    fill("muonPhIso_" , isolationPhoton );
-	    fill("muonPFRelIso_" , PFisolationRel );
+	    fill(MUON_PT, muon->pt() );
+	    fill(MUON_ETA, muon->eta());
+	    fill(MUON_REL_ISO, isolationRel );
+	    fill(MUON_CH_HAD_ISO, isolationChHad );
+	    fill(MUON_NEU_HAD_ISO, isolationNeuHad );
+	    fill(MUON_PH_ISO, isolationPhoton );
+	    fill(MUON_PF_REL_ISO, PFisolationRel );
 	    
 	  }
 	  ++mMult; 
@@ -535,8 +533,8 @@ namespace SingleTopTChannelLepton {
       }
     }
     
-    fill("muonMult_",    mMult   );
-    fill("muonMultIso_", mMultIso);
+    fill(MUON_MULT,    mMult   );
+    fill(MUON_MULT_ISO, mMultIso);
     
     
     /* 
@@ -579,19 +577,26 @@ namespace SingleTopTChannelLepton {
     }
     
     // loop jet collection
-    std::vector<reco::Jet> correctedJets;
+    ArenaVector<reco::Jet>::type correctedJets(arena_);
     unsigned int mult=0, multBEff=0, multBPur=0, multNoBPur=0,  multBVtx=0, multBCombVtx=0;
     
     edm::Handle<edm::View<reco::Jet> > jets; 
     if( !event.getByLabel(jets_, jets) ) return;
+    correctedJets.reserve(jets->size());
+    if( includeBTag_ ){
+      btagEffValues_.resolve(*jets, *btagEff); btagPurValues_.resolve(*jets, *btagPur);
+      btagVtxValues_.resolve(*jets, *btagVtx); btagCombVtxValues_.resolve(*jets, *btagCombVtx);
+    }
     
+    // the jetID is only available for calo jets
     edm::Handle<reco::JetIDValueMap> jetID; 
     if(jetIDSelect_){ 
       if( !event.getByLabel(jetIDLabel_, jetID) ) return;
+      jetIDs_.resolveType<reco::CaloJet>(*jets, *jetID);
     }
     
-    vector<double> bJetDiscVal; 
-    vector<double> NobJetDiscVal;
+    ArenaVector<double>::type bJetDiscVal(arena_); 
+    ArenaVector<double>::type NobJetDiscVal(arena_);
     reco::Jet TaggedJetCand;
     reco::Jet UnTaggedJetCand;
     reco::Jet FwdJetCand;
@@ -599,8 +604,8 @@ namespace SingleTopTChannelLepton {
       // check jetID for calo jets
       unsigned int idx = jet-jets->begin();
       if(dynamic_cast<const reco::CaloJet*>(&*jet)){
-	if( jetIDSelect_ && dynamic_cast<const reco::CaloJet*>(jets->refAt(idx).get())){
-	  if(!(*jetIDSelect_)((*jetID)[jets->refAt(idx)])) continue;
+	if( jetIDSelect_ ){
+	  if(!(*jetIDSelect_)(jetIDs_[idx])) continue;
 	}
       }
       
@@ -638,19 +643,18 @@ namespace SingleTopTChannelLepton {
       
       if( includeBTag_ ){
 	// fill b-discriminators
-	edm::RefToBase<reco::Jet> jetRef = jets->refAt(idx);	
-	if( (*btagVtx)[jetRef]>btagVtxWP_ ) ++multBVtx; 
-	if( (*btagCombVtx)[jetRef]>btagCombVtxWP_ ) ++multBCombVtx; 
+	if( btagVtxValues_[idx]>btagVtxWP_ ) ++multBVtx; 
+	if( btagCombVtxValues_[idx]>btagCombVtxWP_ ) ++multBCombVtx; 
 	//	cout << "btag: "  << (*btagPur)[jetRef] << "   jet eta: " << monitorJet.eta()  <<  endl; 
-	if( (*btagPur)[jetRef]>btagPurWP_ ){
+	if( btagPurValues_[idx]>btagPurWP_ ){
 	  if (multBPur == 0){
 	    TaggedJetCand = monitorJet;
 	    // TaggedJetCand = *jet;
-	    bJetDiscVal.push_back((*btagPur)[jetRef]);
+	    bJetDiscVal.push_back(btagPurValues_[idx]);
 	    
 	  }
  	  else if (multBPur == 1){
-	    bJetDiscVal.push_back((*btagPur)[jetRef]);
+	    bJetDiscVal.push_back(btagPurValues_[idx]);
 	    if (bJetDiscVal[1]>bJetDiscVal[0])
 	      TaggedJetCand = monitorJet;
 	    //TaggedJetCand = *jet;
@@ -661,11 +665,11 @@ namespace SingleTopTChannelLepton {
 	else{
 	  if (multNoBPur == 0){
 	    UnTaggedJetCand = monitorJet;
-	    NobJetDiscVal.push_back((*btagPur)[jetRef]);
+	    NobJetDiscVal.push_back(btagPurValues_[idx]);
 	    
 	  }
 	  else if (multNoBPur == 1){
-            NobJetDiscVal.push_back((*btagPur)[jetRef]);
+            NobJetDiscVal.push_back(btagPurValues_[idx]);
             if (NobJetDiscVal[1]<NobJetDiscVal[0])
               UnTaggedJetCand = monitorJet;
           }
@@ -673,45 +677,45 @@ namespace SingleTopTChannelLepton {
 	  ++multNoBPur;
 	}
 	
-	if( (*btagEff)[jetRef]>btagEffWP_ ) ++multBEff; 
+	if( btagEffValues_[idx]>btagEffWP_ ) ++multBEff; 
 	
 	
 	if(mult==1) {
-	  fill("jet1BDiscPur_", (*btagPur)[jetRef]); 
-	  fill("jet1BDiscCombVtx_", (*btagCombVtx)[jetRef]); 
+	  fill(JET1_BDISC_PUR, btagPurValues_[idx]); 
+	  fill(JET1_BDISC_COMB_VTX, btagCombVtxValues_[idx]); 
 	}
 	
 	else if(mult==2) {
-          fill("jet2BDiscPur_", (*btagPur)[jetRef]);
-	  fill("jet2BDiscCombVtx_", (*btagCombVtx)[jetRef]); 
+          fill(JET2_BDISC_PUR, btagPurValues_[idx]);
+	  fill(JET2_BDISC_COMB_VTX, btagCombVtxValues_[idx]); 
         }
 	
-	fill("jetBDiscEff_", (*btagEff)[jetRef]); 
-	fill("jetBDiscPur_", (*btagPur)[jetRef]); 
-	fill("jetBDiscVtx_", (*btagVtx)[jetRef]); 
-	fill("jetBDiscCombVtx_", (*btagCombVtx)[jetRef]); 
+	fill(JET_BDISC_EFF, btagEffValues_[idx]); 
+	fill(JET_BDISC_PUR, btagPurValues_[idx]); 
+	fill(JET_BDISC_VTX, btagVtxValues_[idx]); 
+	fill(JET_BDISC_COMB_VTX, btagCombVtxValues_[idx]); 
 	
       }
       // fill pt (raw or L2L3) for the leading jets  
       if(mult==1) {
-	fill("jet1Pt_" , monitorJet.pt()); 
-	fill("jet1Eta_", monitorJet.eta()); 
-	fill("jet1PtRaw_", jet->pt() );
+	fill(JET1_PT, monitorJet.pt()); 
+	fill(JET1_ETA, monitorJet.eta()); 
+	fill(JET1_PT_RAW, jet->pt() );
 	FwdJetCand = monitorJet;
 	
       }
       
       if(mult==2) {
-	fill("jet2Pt_" , monitorJet.pt()); 
-	fill("jet2Eta_", monitorJet.eta()); 
-	fill("jet2PtRaw_", jet->pt() );
+	fill(JET2_PT, monitorJet.pt()); 
+	fill(JET2_ETA, monitorJet.eta()); 
+	fill(JET2_PT_RAW, jet->pt() );
 	
 	if ( abs(monitorJet.eta()) > abs(FwdJetCand.eta()) ){
 	  FwdJetCand = monitorJet;
 	}
 	
-	fill("FwdJetPt_" , FwdJetCand.pt());
-	fill("FwdJetEta_", FwdJetCand.eta());
+	fill(FWD_JET_PT, FwdJetCand.pt());
+	fill(FWD_JET_ETA, FwdJetCand.eta());
 	
       }
       
@@ -721,21 +725,21 @@ namespace SingleTopTChannelLepton {
     
     if (multNoBPur == 1 && multBPur == 1){
       
-      fill("TaggedJetPtEta_" , TaggedJetCand.pt(), TaggedJetCand.eta());
-      fill("UnTaggedJetPtEta_" , UnTaggedJetCand.pt(), UnTaggedJetCand.eta());
+      fill(TAGGED_JET_PT_ETA, TaggedJetCand.pt(), TaggedJetCand.eta());
+      fill(UNTAGGED_JET_PT_ETA, UnTaggedJetCand.pt(), UnTaggedJetCand.eta());
       
       
-      fill("TaggedJetPt_" , TaggedJetCand.pt());
-      fill("TaggedJetEta_", TaggedJetCand.eta());
-      fill("UnTaggedJetPt_" , UnTaggedJetCand.pt());
-      fill("UnTaggedJetEta_", UnTaggedJetCand.eta());
+      fill(TAGGED_JET_PT, TaggedJetCand.pt());
+      fill(TAGGED_JET_ETA, TaggedJetCand.eta());
+      fill(UNTAGGED_JET_PT, UnTaggedJetCand.pt());
+      fill(UNTAGGED_JET_ETA, UnTaggedJetCand.eta());
     }
     
-    fill("jetMult_"    , mult    );
-    fill("jetMultBEff_", multBEff);
-    fill("jetMultBPur_", multBPur);
-    fill("jetMultBVtx_", multBVtx);
-    fill("jetMultBCombVtx_", multBCombVtx);
+    fill(JET_MULT, mult    );
+    fill(JET_MULT_BEFF, multBEff);
+    fill(JET_MULT_BPUR, multBPur);
+    fill(JET_MULT_BVTX, multBVtx);
+    fill(JET_MULT_BCOMB_VTX, multBCombVtx);
     
     /* 
     ------------------------------------------------------------
@@ -752,9 +756,9 @@ namespace SingleTopTChannelLepton {
       if( !event.getByLabel(*met_, met) ) continue;
       if(met->begin()!=met->end()){
 	unsigned int idx=met_-mets_.begin();
-	if(idx==0) { fill("metCalo_" , met->begin()->et()); }
-	if(idx==1) { fill("metTC_"   , met->begin()->et()); }
-	if(idx==2) { fill("metPflow_", met->begin()->et());   mET = *(met->begin()); }
+	if(idx==0) { fill(MET_CALO, met->begin()->et()); }
+	if(idx==1) { fill(MET_TC, met->begin()->et()); }
+	if(idx==2) { fill(MET_PFLOW, met->begin()->et());   mET = *(met->begin()); }
       }
     }
     
@@ -772,36 +776,36 @@ namespace SingleTopTChannelLepton {
     Calculate eventKinematics(MAXJETS, WMASS);
     double wMass   = eventKinematics.massWBoson  (correctedJets);
     double topMass = eventKinematics.massTopQuark(correctedJets);
-    if(wMass>=0 && topMass>=0) {fill("massW_" , wMass  ); fill("massTop_" , topMass);}
+    if(wMass>=0 && topMass>=0) {fill(MASS_W, wMass  ); fill(MASS_TOP, topMass);}
     // fill plots for trigger monitoring
     if((lowerEdge_==-1. && upperEdge_==-1.) || (lowerEdge_<wMass && wMass<upperEdge_) ){
-      if(!triggerTable_.label().empty()) fill(event, *triggerTable, "trigger", triggerPaths_);
-      if(logged_<=hists_.find("eventLogger_")->second->getNbinsY()){
+      if(!triggerTable_.label().empty()) fill(event, *triggerTable, triggerPaths_);
+      if(booked(EVENT_LOGGER) && logged_<=hists_[EVENT_LOGGER]->getNbinsY()){
 	// log runnumber, lumi block, event number & some
 	// more pysics infomation for interesting events
-	fill("eventLogger_", 0.5, logged_+0.5, event.eventAuxiliary().run()); 
-	fill("eventLogger_", 1.5, logged_+0.5, event.eventAuxiliary().luminosityBlock()); 
-	fill("eventLogger_", 2.5, logged_+0.5, event.eventAuxiliary().event()); 
-	if(correctedJets.size()>0) fill("eventLogger_", 3.5, logged_+0.5, correctedJets[0].pt()); 
-	if(correctedJets.size()>1) fill("eventLogger_", 4.5, logged_+0.5, correctedJets[1].pt()); 
-	if(correctedJets.size()>2) fill("eventLogger_", 5.5, logged_+0.5, correctedJets[2].pt()); 
-	if(correctedJets.size()>3) fill("eventLogger_", 6.5, logged_+0.5, correctedJets[3].pt()); 
-	fill("eventLogger_", 7.5, logged_+0.5, wMass  ); 
-	fill("eventLogger_", 8.5, logged_+0.5, topMass); 
+	fill(EVENT_LOGGER, 0.5, logged_+0.5, event.eventAuxiliary().run()); 
+	fill(EVENT_LOGGER, 1.5, logged_+0.5, event.eventAuxiliary().luminosityBlock()); 
+	fill(EVENT_LOGGER, 2.5, logged_+0.5, event.eventAuxiliary().event()); 
+	if(correctedJets.size()>0) fill(EVENT_LOGGER, 3.5, logged_+0.5, correctedJets[0].pt()); 
+	if(correctedJets.size()>1) fill(EVENT_LOGGER, 4.5, logged_+0.5, correctedJets[1].pt()); 
+	if(correctedJets.size()>2) fill(EVENT_LOGGER, 5.5, logged_+0.5, correctedJets[2].pt()); 
+	if(correctedJets.size()>3) fill(EVENT_LOGGER, 6.5, logged_+0.5, correctedJets[3].pt()); 
+	fill(EVENT_LOGGER, 7.5, logged_+0.5, wMass  ); 
+	fill(EVENT_LOGGER, 8.5, logged_+0.5, topMass); 
 	++logged_;
       }
     }
     
     if(multBPur != 0 && mMultIso == 1 ){
       
-      double mtW = eventKinematics.tmassWBoson(&mu,mET,TaggedJetCand); fill("MTWm_",mtW);
-      double MTT = eventKinematics.tmassTopQuark(&mu,mET,TaggedJetCand); fill("mMTT_", MTT);
+      double mtW = eventKinematics.tmassWBoson(&mu,mET,TaggedJetCand); fill(MTW_MU,mtW);
+      double MTT = eventKinematics.tmassTopQuark(&mu,mET,TaggedJetCand); fill(MTT_MU, MTT);
       
     }
     
     if(multBPur != 0 && eMultIso == 1 ){
-      double mtW = eventKinematics.tmassWBoson(&e,mET,TaggedJetCand); fill("MTWe_",mtW);
-      double MTT = eventKinematics.tmassTopQuark(&e,mET,TaggedJetCand); fill("eMTT_", MTT);
+      double mtW = eventKinematics.tmassWBoson(&e,mET,TaggedJetCand); fill(MTW_E,mtW);
+      double MTT = eventKinematics.tmassTopQuark(&e,mET,TaggedJetCand); fill(MTT_E, MTT);
     }
 
   }
@@ -809,7 +813,7 @@ namespace SingleTopTChannelLepton {
 }
 
 
-SingleTopTChannelLeptonDQM::SingleTopTChannelLeptonDQM(const edm::ParameterSet& cfg): triggerTable_(""), vertex_(""), vertexSelect_(0), beamspot_(""), beamspotSelect_(0)
+SingleTopTChannelLeptonDQM::SingleTopTChannelLeptonDQM(const edm::ParameterSet& cfg): triggerTable_(""), vertex_(""), vertexSelect_(0), beamspot_(""), beamspotSelect_(0), histograms_(0), timing_(0)
 {
   // configure preselection
   edm::ParameterSet presel=cfg.getParameter<edm::ParameterSet>("preselection");
@@ -828,17 +832,64 @@ SingleTopTChannelLeptonDQM::SingleTopTChannelLeptonDQM(const edm::ParameterSet&
     beamspot_= beamspot.getParameter<edm::InputTag>("src");
     beamspotSelect_= new StringCutObjectSelector<reco::BeamSpot>(beamspot.getParameter<std::string>("select"));
   }
+  // the histogram definitions are parsed once and shared by
+  // all MonitorEnsembles; modifications of the compiled-in 
+  // defaults are optional
+  edm::ParameterSet setup=cfg.getParameter<edm::ParameterSet>("setup");
+  std::vector<edm::ParameterSet> histograms;
+  if( setup.existsAs<edm::ParameterSet>("monitoring") ){
+    edm::ParameterSet monitoring=setup.getParameter<edm::ParameterSet>("monitoring");
+    if( monitoring.existsAs<std::vector<edm::ParameterSet> >("histograms") ){
+      histograms= monitoring.getParameter<std::vector<edm::ParameterSet> >("histograms");
+    }
+  }
+  histograms_= new HistogramTable(SingleTopTChannelLepton::MonitorEnsemble::defaults(), histograms);
+
   // conifgure the selection
   std::vector<edm::ParameterSet> sel=cfg.getParameter<std::vector<edm::ParameterSet> >("selection");
+  // share the selection steps with the other modules if the
+  // SelectionGraph service is available, keep them local else
+  edm::Service<SelectionGraph> graph;
+  selectionGraph_= graph.isAvailable() ? &(*graph) : &localGraph_;
   for(unsigned int i=0; i<sel.size(); ++i){
     selectionOrder_.push_back(sel.at(i).getParameter<std::string>("label"));
-    selection_[selectionStep(selectionOrder_.back())] = std::make_pair(sel.at(i), new SingleTopTChannelLepton::MonitorEnsemble(selectionStep(selectionOrder_.back()).c_str(), cfg.getParameter<edm::ParameterSet>("setup"), cfg.getParameter<std::vector<edm::ParameterSet> >("selection")));
+    selection_[selectionStep(selectionOrder_.back())] = std::make_pair(sel.at(i), new SingleTopTChannelLepton::MonitorEnsemble(selectionStep(selectionOrder_.back()).c_str(), setup, sel, histograms_));
+    selection_[selectionStep(selectionOrder_.back())].second->useArena(&arena_);
+    // register the selection step with the shared selection graph
+    std::string type=objectType(selectionOrder_.back());
+    if(selectionGraph_->supports(type)){
+      selectionIds_[selectionStep(selectionOrder_.back())] = selectionGraph_->subscribe(type, sel.at(i));
+    }
+  }
+  // configure the timing and rejection monitoring of the
+  // selection steps; it is optional and sampled every Nth
+  // event (the accept/reject counters are filled always)
+  if( cfg.existsAs<edm::ParameterSet>("timing") ){
+    std::vector<std::string> steps;
+    for(unsigned int i=0; i<selectionOrder_.size(); ++i){ steps.push_back(selectionStep(selectionOrder_[i])); }
+    timing_= new SelectionTiming(cfg.getParameter<edm::ParameterSet>("setup").getParameter<std::string>("directory"), steps, cfg.getParameter<edm::ParameterSet>("timing").getParameter<unsigned int>("sampling"));
   }
 }
 
+bool
+SingleTopTChannelLeptonDQM::select(const std::string& key, const edm::Event& event, const edm::EventSetup& setup)
+{
+  SelectionTiming::Clock clock(timing_, key, SelectionTiming::SELECT);
+  return clock.passed(selectionGraph_->select(selectionIds_[key], event, setup));
+}
+
+void
+SingleTopTChannelLeptonDQM::fill(const std::string& key, const edm::Event& event, const edm::EventSetup& setup)
+{
+  SelectionTiming::Clock clock(timing_, key, SelectionTiming::FILL);
+  selection_[key].second->fill(event, setup);
+}
+
 void 
 SingleTopTChannelLeptonDQM::analyze(const edm::Event& event, const edm::EventSetup& setup)
 { 
+  // the per-event containers of the previous event are gone
+  arena_.reset();
   if(!triggerTable_.label().empty()){
     edm::Handle<edm::TriggerResults> triggerTable;
     if( !event.getByLabel(triggerTable_, triggerTable) ) return;
@@ -861,75 +912,67 @@ SingleTopTChannelLeptonDQM::analyze(const edm::Event& event, const edm::EventSet
   }
   
   
-  // apply selection steps
+  // apply selection steps; each unique step is evaluated
+  // only once per event and shared with all other modules
+  if( timing_ ) timing_->next();
   unsigned int passed=0;
   for(std::vector<std::string>::const_iterator selIt=selectionOrder_.begin(); selIt!=selectionOrder_.end(); ++selIt){
     std::string key = selectionStep(*selIt), type = objectType(*selIt);
     if(selection_.find(key)!=selection_.end()){
       if(type=="empty"){
-	selection_[key].second->fill(event, setup);
+	fill(key, event, setup);
       }
       if(type=="presel" ){
 	//	cout << "PRESELECTION" << endl;
-      	selection_[key].second->fill(event, setup);
+      	fill(key, event, setup);
       }
       if(type=="elecs"){
-	SelectionStep<reco::GsfElectron> step(selection_[key].first);
-	if(step.select(event)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ ++passed;
+	  fill(key, event, setup);
 	} else break;
       }
       if(type=="elecs/pf"){
-        SelectionStep<reco::PFCandidate> step(selection_[key].first);
-        if(step.select(event, "electron")){ ++passed;
-	  selection_[key].second->fill(event, setup);
+        if(select(key, event, setup)){ ++passed;
+	  fill(key, event, setup);
         } else break;
       }
       if(type=="muons"){
-	SelectionStep<reco::Muon> step(selection_[key].first);
-	if(step.select(event)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ ++passed;
+	  fill(key, event, setup);
 	} else break;
       }
       if(type=="muons/pf"){
 	//	cout << "MUON SELECTION" << endl;
-	SelectionStep<reco::PFCandidate> step(selection_[key].first);
-        if(step.select(event, "muon")){++passed;
-          selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){++passed;
+          fill(key, event, setup);
 	  
         } else break;
       }
       if(type=="jets" ){
-	SelectionStep<reco::Jet> step(selection_[key].first);
-	if(step.select(event, setup)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ ++passed;
+	  fill(key, event, setup);
 	} else break;
       }
       if(type=="jets/pf" ){
 	//	cout << "JET SELECTION" << endl;
-	SelectionStep<reco::PFJet> step(selection_[key].first);
-	
 	std::string key2 = selectionStep(*(++selIt));
-	SelectionStep<reco::PFJet> step2(selection_[key2].first);
 	
- 	if(step.select(event, setup)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+ 	if(select(key, event, setup)){ ++passed;
+	  fill(key, event, setup);
 	} 
-	else if (step2.select(event, setup)){ ++passed;
-	  selection_[key2].second->fill(event, setup);
+	else if (select(key2, event, setup)){ ++passed;
+	  fill(key2, event, setup);
 	}
 	else break;
       }
       if(type=="jets/calo" ){
-	SelectionStep<reco::CaloJet> step(selection_[key].first);
-	if(step.select(event, setup)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ ++passed;
+	  fill(key, event, setup);
 	} else break;
       }
       if(type=="met" ){
-	SelectionStep<reco::MET> step(selection_[key].first);
-	if(step.select(event)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ ++passed;
+	  fill(key, event, setup);
 	} else break;
       }
     }
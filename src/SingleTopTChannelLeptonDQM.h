@@ -10,6 +10,9 @@
 
 #include "DataFormats/JetReco/interface/Jet.h"
 #include "DQM/Physics/interface/TopDQMHelpers.h"
+#include "DQM/Physics/interface/EventArena.h"
+#include "DQM/Physics/interface/AssociationTable.h"
+#include "DQM/Physics/interface/HistogramTable.h"
 #include "DataFormats/MuonReco/interface/Muon.h"
 #include "DataFormats/Common/interface/ValueMap.h"
 #include "DataFormats/METReco/interface/CaloMET.h"
@@ -31,7 +34,13 @@
    not contain much more than 10 histograms though in the STANDARD configuration, as these 
    histograms will be monitored at each SelectionStep. Monitoring of histograms after selec-
    tion steps within the same object collection needs to be implemented within the Monitor-
-   Ensemble. It will not be covered by the SelectionStep class.
+   Ensemble. It will not be covered by the SelectionStep class. The per-event containers of
+   the selected electrons, jets and b-tag values are taken from the EventArena given via
+   _useArena_, if any. The electronId, the jetID and the b-tag discriminators are resolved
+   once per event into AssociationTables aligned with the electron and jet collections.
+   The histograms are defined in a HistogramTable, which is shared by all MonitorEnsembles
+   of the module; its slots follow the enumeration _Histogram_ and are used to fill the
+   histograms without any look up by name.
 */
 
 namespace SingleTopTChannelLepton {
@@ -40,10 +49,20 @@ namespace SingleTopTChannelLepton {
   public:
     /// different verbosity levels
     enum Level{ STANDARD, VERBOSE, DEBUG };
+    /// slots of the histograms in the HistogramTable (in the
+    /// order of the compiled-in defaults)
+    enum Histogram{ PV_MULT, MUON_PT, MUON_MULT, MUON_MULT_ISO, ELEC_PT, ELEC_MULT, ELEC_MULT_ISO, JET_MULT, TRIGGER_EFF, TRIGGER_MON,
+		    MET_CALO, MASS_W, MASS_TOP, MTW_MU, MTT_MU, MTW_E, MTT_E, MUON_ETA, MUON_PF_REL_ISO, MUON_REL_ISO, ELEC_ETA,
+		    ELEC_REL_ISO, ELEC_PF_REL_ISO, JET_MULT_BEFF, JET_BDISC_EFF, JET1_ETA, JET2_ETA, JET1_PT, JET2_PT, TAGGED_JET_ETA,
+		    TAGGED_JET_PT, UNTAGGED_JET_ETA, UNTAGGED_JET_PT, FWD_JET_ETA, FWD_JET_PT, TAGGED_JET_PT_ETA, UNTAGGED_JET_PT_ETA,
+		    MET_TC, MET_PFLOW, MUON_DEL_Z, MUON_DEL_XY, MUON_CH_HAD_ISO, MUON_NEU_HAD_ISO, MUON_PH_ISO, ELEC_CH_HAD_ISO,
+		    ELEC_NEU_HAD_ISO, ELEC_PH_ISO, JET_MULT_BPUR, JET_BDISC_PUR, JET1_BDISC_PUR, JET2_BDISC_PUR, JET_MULT_BVTX,
+		    JET_BDISC_VTX, JET_MULT_BCOMB_VTX, JET_BDISC_COMB_VTX, JET1_BDISC_COMB_VTX, JET2_BDISC_COMB_VTX, JET1_PT_RAW,
+		    JET2_PT_RAW, EVENT_LOGGER, NHISTOGRAMS };
     
   public:
-    /// default contructor
-    MonitorEnsemble(const char* label, const edm::ParameterSet& cfg, const edm::VParameterSet& vcfg);
+    /// default contructor; the HistogramTable is not owned
+    MonitorEnsemble(const char* label, const edm::ParameterSet& cfg, const edm::VParameterSet& vcfg, const HistogramTable* table);
     /// default destructor
     ~MonitorEnsemble(){};
     
@@ -51,6 +70,10 @@ namespace SingleTopTChannelLepton {
     void book(std::string directory);
     /// fill monitor histograms with electronId and jetCorrections
     void fill(const edm::Event& event, const edm::EventSetup& setup);
+    /// take the per-event containers from _arena_ (not owned; 0 for the heap)
+    void useArena(EventArena* arena){ arena_=arena; };
+    /// compiled-in histogram definitions in the order of _Histogram_
+    static std::vector<HistogramTable::Entry> defaults();
 
   private:
     /// deduce monitorPath from label, the label is expected
@@ -61,18 +84,18 @@ namespace SingleTopTChannelLepton {
     std::string selectionPath(const std::string& label) const { return label.substr(0, label.find(':')); };  
 
     /// set configurable labels for trigger monitoring histograms
-    void triggerBinLabels(std::string channel, const std::vector<std::string> labels);
+    void triggerBinLabels(const std::vector<std::string> labels);
     /// fill trigger monitoring histograms
-    void fill(const edm::Event& event, const edm::TriggerResults& triggerTable, std::string channel, const std::vector<std::string> labels) const;
+    void fill(const edm::Event& event, const edm::TriggerResults& triggerTable, const std::vector<std::string> labels) const;
 
     /// check if histogram was booked
-    bool booked(const std::string histName) const { return hists_.find(histName.c_str())!=hists_.end(); };
+    bool booked(Histogram slot) const { return hists_[slot]!=0; };
     /// fill histogram if it had been booked before
-    void fill(const std::string histName, double value) const { if(booked(histName.c_str())) hists_.find(histName.c_str())->second->Fill(value); };
+    void fill(Histogram slot, double value) const { if(booked(slot)) hists_[slot]->Fill(value); };
     /// fill histogram if it had been booked before (2-dim version)
-    void fill(const std::string histName, double xValue, double yValue) const { if(booked(histName.c_str())) hists_.find(histName.c_str())->second->Fill(xValue, yValue); };
+    void fill(Histogram slot, double xValue, double yValue) const { if(booked(slot)) hists_[slot]->Fill(xValue, yValue); };
     /// fill histogram if it had been booked before (2-dim version)
-    void fill(const std::string histName, double xValue, double yValue, double zValue) const { if(booked(histName.c_str())) hists_.find(histName.c_str())->second->Fill(xValue, yValue, zValue); };
+    void fill(Histogram slot, double xValue, double yValue, double zValue) const { if(booked(slot)) hists_[slot]->Fill(xValue, yValue, zValue); };
 
   private:
     /// verbosity level for booking
@@ -143,29 +166,41 @@ namespace SingleTopTChannelLepton {
     int logged_;
     /// storage manager
     DQMStore* store_;
-    /// histogram container  
-    std::map<std::string,MonitorElement*> hists_;
+    /// histogram definitions (not owned)
+    const HistogramTable* table_;
+    /// histogram container indexed by the slots of the
+    /// HistogramTable (0 for histograms, which are not booked)
+    std::vector<MonitorElement*> hists_;
+    /// arena of the per-event containers (not owned; 0 for the heap)
+    EventArena* arena_;
+    /// electronId, jetID and b-tag discriminators of the current 
+    /// event in the order of the electron and jet collections
+    AssociationTable<float> electronIds_;
+    AssociationTable<reco::JetID> jetIDs_;
+    AssociationTable<float> btagEffValues_, btagPurValues_, btagVtxValues_, btagCombVtxValues_;
   };
 
   inline void 
-  MonitorEnsemble::triggerBinLabels(std::string channel, const std::vector<std::string> labels)
+  MonitorEnsemble::triggerBinLabels(const std::vector<std::string> labels)
   {
+    if( !booked(TRIGGER_MON) || !booked(TRIGGER_EFF) ) return;
     for(unsigned int idx=0; idx<labels.size(); ++idx){
-      hists_[(channel+"Mon_").c_str()]->setBinLabel( idx+1, "["+monitorPath(labels[idx])+"]", 1);
-      hists_[(channel+"Eff_").c_str()]->setBinLabel( idx+1, "["+selectionPath(labels[idx])+"]|["+monitorPath(labels[idx])+"]", 1);
+      hists_[TRIGGER_MON]->setBinLabel( idx+1, "["+monitorPath(labels[idx])+"]", 1);
+      hists_[TRIGGER_EFF]->setBinLabel( idx+1, "["+selectionPath(labels[idx])+"]|["+monitorPath(labels[idx])+"]", 1);
     }
   }
 
   inline void 
-  MonitorEnsemble::fill(const edm::Event& event, const edm::TriggerResults& triggerTable, std::string channel, const std::vector<std::string> labels) const
+  MonitorEnsemble::fill(const edm::Event& event, const edm::TriggerResults& triggerTable, const std::vector<std::string> labels) const
   {
+    if( !booked(TRIGGER_MON) || !booked(TRIGGER_EFF) ) return;
     for(unsigned int idx=0; idx<labels.size(); ++idx){
       if( accept(event, triggerTable, monitorPath(labels[idx])) ){
-	fill((channel+"Mon_").c_str(), idx+0.5 );
+	fill(TRIGGER_MON, idx+0.5 );
 	// take care to fill triggerMon_ before evts is being called
-	int evts = hists_.find((channel+"Mon_").c_str())->second->getBinContent(idx+1);
-	double value = hists_.find((channel+"Eff_").c_str())->second->getBinContent(idx+1);
-	fill((channel+"Eff_").c_str(), idx+0.5, 1./evts*(accept(event, triggerTable, selectionPath(labels[idx]))-value));
+	int evts = hists_[TRIGGER_MON]->getBinContent(idx+1);
+	double value = hists_[TRIGGER_EFF]->getBinContent(idx+1);
+	fill(TRIGGER_EFF, idx+0.5, 1./evts*(accept(event, triggerTable, selectionPath(labels[idx]))-value));
       }
     }
   }
@@ -174,6 +209,8 @@ namespace SingleTopTChannelLepton {
 
 #include <utility>
 
+#include "DQM/Physics/interface/SelectionGraph.h"
+#include "DQM/Physics/interface/SelectionTiming.h"
 #include "DQM/Physics/interface/TopDQMHelpers.h"
 #include "FWCore/Framework/interface/EDAnalyzer.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
@@ -221,6 +258,8 @@ class SingleTopTChannelLeptonDQM : public edm::EDAnalyzer  {
   ~SingleTopTChannelLeptonDQM(){
     if( vertexSelect_ ) delete vertexSelect_;
     if( beamspotSelect_ ) delete beamspotSelect_;
+    if( timing_ ) delete timing_;
+    if( histograms_ ) delete histograms_;
     //    if( selection_ ) delete selection_;
   };
   
@@ -234,6 +273,10 @@ class SingleTopTChannelLeptonDQM : public edm::EDAnalyzer  {
   /// deduce selection step from ParameterSet label, the 
   /// label is expected to be of type 'objectType:selectionStep' 
   std::string selectionStep(const std::string& label) { return label.substr(label.find(':')+1); };  
+  /// apply selection step _key_ via the shared SelectionGraph (timed if configured)
+  bool select(const std::string& key, const edm::Event& event, const edm::EventSetup& setup);
+  /// fill the MonitorEnsemble of selection step _key_ (timed if configured)
+  void fill(const std::string& key, const edm::Event& event, const edm::EventSetup& setup);
 
  private:
   /// trigger table
@@ -259,6 +302,20 @@ class SingleTopTChannelLeptonDQM : public edm::EDAnalyzer  {
   /// MonitoringEnsemble keeps an instance of the MonitorEnsemble class to 
   /// be filled _after_ each selection step
   std::map<std::string, std::pair<edm::ParameterSet, SingleTopTChannelLepton::MonitorEnsemble*> > selection_;
+  /// selection graph the selection steps are registered with; this is the
+  /// SelectionGraph service if available and _localGraph_ otherwise
+  SelectionGraph* selectionGraph_;
+  SelectionGraph localGraph_;
+  /// ids of the selection steps in the selection graph (for all
+  /// selection step types supported by the SelectionGraph)
+  std::map<std::string, unsigned int> selectionIds_;
+  /// histogram definitions shared by all MonitorEnsembles
+  HistogramTable* histograms_;
+  /// timing and rejection monitoring of the selection steps (optional)
+  SelectionTiming* timing_;
+  /// memory of the per-event containers of the MonitorEnsembles; 
+  /// reset at the beginning of each event
+  EventArena arena_;
 };
 
 #endif
@@ -0,0 +1,37 @@
+#include "DQM/Physics/interface/SparseHistogram.h"
+
+#include "TH1.h"
+#include "TArrayD.h"
+
+double
+SparseHistogram::bytes() const
+{
+  // one node (key, sums and chaining pointer) per
+  // non-empty bin and one pointer per bucket
+  return bins_.size()*(sizeof(int)+sizeof(Bin)+sizeof(void*)) + bins_.bucket_count()*sizeof(void*);
+}
+
+MonitorElement*
+SparseHistogram::save(DQMStore* store)
+{
+  // the dense histogram is booked at the first save
+  if( !me_ ) me_=def_.book(store);
+  if( bins_.empty() ) return me_;
+  TH1* hist=me_->getTH1();
+  double entries=hist->GetEntries()+entries_;
+  // the squared weights are only kept if needed
+  if( weighted_ && hist->GetSumw2N()==0 ) hist->Sumw2();
+  int nx=def_.nBinsX()+2;
+  for(boost::unordered_map<int, Bin>::const_iterator content=bins_.begin(); content!=bins_.end(); ++content){
+    // one fill per non-empty bin at its center
+    double x=center(content->first%nx, def_.nBinsX(), def_.lowX(), def_.highX());
+    if( def_.nBinsY()>0 ){ me_->Fill(x, center(content->first/nx, def_.nBinsY(), def_.lowY(), def_.highY()), content->second.sumw); }
+    else{ me_->Fill(x, content->second.sumw); }
+    // the fill adds the square of the summed weights
+    if( hist->GetSumw2N()>0 ) (*hist->GetSumw2())[content->first]+=content->second.sumw2-content->second.sumw*content->second.sumw;
+  }
+  hist->SetEntries(entries);
+  me_->update();
+  bins_.clear(); entries_=0.;
+  return me_;
+}
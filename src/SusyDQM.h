@@ -15,6 +15,7 @@
 
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
+#include "DQM/Physics/interface/DileptonPairs.h"
 
 #include "DataFormats/Common/interface/Handle.h"
 #include "DataFormats/TrackReco/interface/Track.h"
@@ -139,6 +140,9 @@ class SusyDQM: public edm::EDAnalyzer {
       MonitorElement * hRAL_SSmumu_monitor_;
       MonitorElement * hRAL_TriMuon_monitor_;
 
+      // invariant masses of the lepton pairs of the event
+      DileptonPairs dileptons_;
+
 };
 
 template<typename Mu, typename Ele, typename Jet, typename Met>
@@ -367,6 +371,22 @@ void SusyDQM<Mu, Ele, Jet, Met>::analyze(const edm::Event& evt, const edm::Event
 
    hRAL_Met_->Fill(MET);
 
+   // Invariant masses and charge flags of all pairs of good leptons; the
+   // good muons are added first, followed by the good electrons, such
+   // that all electron muon pairs have the muon as first lepton
+   std::vector<int> muonIdx(muons->size(), -1);
+   std::vector<int> elecIdx(elecs->size(), -1);
+   dileptons_.clear();
+   for (typename std::vector<Mu>::const_iterator mu_i = muons->begin(); mu_i != muons->end(); ++mu_i) {
+      if (goodSusyMuon(&(*mu_i)) && mu_i->pt() > RAL_muon_pt_cut_)
+         muonIdx[mu_i - muons->begin()] = dileptons_.add(*mu_i);
+   }
+   for (typename std::vector<Ele>::const_iterator ele_i = elecs->begin(); ele_i != elecs->end(); ++ele_i) {
+      if (goodSusyElectron(&(*ele_i)) && ele_i->pt() > RAL_elec_pt_cut_)
+         elecIdx[ele_i - elecs->begin()] = dileptons_.add(*ele_i);
+   }
+   dileptons_.compute();
+
    int nMuons = 0;
    int nSSmumu = 0;
    int nOSmumu = 0;
@@ -376,7 +396,8 @@ void SusyDQM<Mu, Ele, Jet, Met>::analyze(const edm::Event& evt, const edm::Event
    float dR = 0.;
 
    for (typename std::vector<Mu>::const_iterator mu_i = muons->begin(); mu_i != muons->end(); ++mu_i) {
-      if (!(goodSusyMuon(&(*mu_i)) && mu_i->pt() > RAL_muon_pt_cut_))
+      int i = muonIdx[mu_i - muons->begin()];
+      if (i < 0)
          continue;
       ++nMuons;
 
@@ -391,15 +412,16 @@ void SusyDQM<Mu, Ele, Jet, Met>::analyze(const edm::Event& evt, const edm::Event
       for (typename std::vector<Mu>::const_iterator mu_j = muons->begin(); mu_j != muons->end(); ++mu_j) {
          if (mu_i >= mu_j)
             continue;
-         if (!(goodSusyMuon(&(*mu_j)) && mu_j->pt() > RAL_muon_pt_cut_))
+         int j = muonIdx[mu_j - muons->begin()];
+         if (j < 0)
             continue;
 
-         inv = (mu_i->p4() + mu_j->p4()).M();
-         if (mu_i->charge() * mu_j->charge() > 0) {
+         inv = dileptons_.mass(i, j);
+         if (dileptons_.sameSign(i, j)) {
             ++nSSmumu;
             hRAL_mass_SS_mumu_->Fill(inv);
          }
-         if (mu_i->charge() * mu_j->charge() < 0) {
+         if (dileptons_.oppositeSign(i, j)) {
             ++nOSmumu;
             hRAL_mass_OS_mumu_->Fill(inv);
          }
@@ -407,16 +429,17 @@ void SusyDQM<Mu, Ele, Jet, Met>::analyze(const edm::Event& evt, const edm::Event
 
       //Electron muon pairs
       for (typename std::vector<Ele>::const_iterator ele_j = elecs->begin(); ele_j != elecs->end(); ++ele_j) {
-         if (!(goodSusyElectron(&(*ele_j)) && ele_j->pt() > RAL_elec_pt_cut_))
+         int j = elecIdx[ele_j - elecs->begin()];
+         if (j < 0)
             continue;
-         inv = (mu_i->p4() + ele_j->p4()).M();
+         inv = dileptons_.mass(i, j);
          dR = deltaR(*mu_i, *ele_j);
          hRAL_dR_emu_->Fill(dR);
-         if (mu_i->charge() * ele_j->charge() > 0) {
+         if (dileptons_.sameSign(i, j)) {
             ++nSSemu;
             hRAL_mass_SS_emu_->Fill(inv);
          }
-         if (mu_i->charge() * ele_j->charge() < 0) {
+         if (dileptons_.oppositeSign(i, j)) {
             ++nOSemu;
             hRAL_mass_OS_emu_->Fill(inv);
          }
@@ -429,7 +452,8 @@ void SusyDQM<Mu, Ele, Jet, Met>::analyze(const edm::Event& evt, const edm::Event
    int nSSee = 0;
    int nOSee = 0;
    for (typename std::vector<Ele>::const_iterator ele_i = elecs->begin(); ele_i != elecs->end(); ++ele_i) {
-      if (!(goodSusyElectron(&(*ele_i)) && ele_i->pt() > RAL_elec_pt_cut_))
+      int i = elecIdx[ele_i - elecs->begin()];
+      if (i < 0)
          continue;
       nElectrons++;
 
@@ -443,15 +467,16 @@ void SusyDQM<Mu, Ele, Jet, Met>::analyze(const edm::Event& evt, const edm::Event
       for (typename std::vector<Ele>::const_iterator ele_j = elecs->begin(); ele_j != elecs->end(); ++ele_j) {
          if (ele_i >= ele_j)
             continue;
-         if (!(goodSusyElectron(&(*ele_j)) && ele_j->pt() > RAL_elec_pt_cut_))
+         int j = elecIdx[ele_j - elecs->begin()];
+         if (j < 0)
             continue;
 
-         inv = (ele_i->p4() + ele_j->p4()).M();
-         if (ele_i->charge() * ele_j->charge() > 0) {
+         inv = dileptons_.mass(i, j);
+         if (dileptons_.sameSign(i, j)) {
             ++nSSee;
             hRAL_mass_SS_ee_->Fill(inv);
          }
-         if (ele_i->charge() * ele_j->charge() < 0) {
+         if (dileptons_.oppositeSign(i, j)) {
             ++nOSee;
             hRAL_mass_OS_ee_->Fill(inv);
          }
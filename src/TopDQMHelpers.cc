@@ -6,25 +6,6 @@ Calculate::Calculate(int maxNJets, double wMass):
 {
 }
 
-double
-Calculate::massWBoson(const std::vector<reco::Jet>& jets)
-{
-  if(!failed_&& massWBoson_<0) operator()(jets); return massWBoson_;
-}
-
-double 
-Calculate::massTopQuark(const std::vector<reco::Jet>& jets)
-{ 
-  if(!failed_&& massTopQuark_<0) operator()(jets); return massTopQuark_; 
-}
-
-
-double 
-Calculate::massBTopQuark(const std::vector<reco::Jet>& jets, std::vector<double> VbtagWP, double btagWP_)
-{ 
-  if(!failed_&& massBTopQuark_<0) operator2(jets, VbtagWP, btagWP_); return massBTopQuark_; 
-}
-
 double 
 Calculate::tmassWBoson(reco::RecoCandidate* mu, const reco::MET& met, const reco::Jet& b)
 {
@@ -52,19 +33,16 @@ void Calculate::operator()( const reco::Jet& bJet, reco::RecoCandidate* lepton,
 
 
 void
-Calculate::operator()(const std::vector<reco::Jet>& jets)
+Calculate::operator()(const reco::Jet* jets, unsigned int nJets)
 {
-  if(maxNJets_<0) maxNJets_=jets.size();
-  failed_= jets.size()<(unsigned int) maxNJets_;
+  if(maxNJets_<0) maxNJets_=nJets;
+  failed_= nJets<(unsigned int) maxNJets_;
   if( failed_){ return; }
 
   // associate those jets with maximum pt of the vectorial 
   // sum to the hadronic decay chain
   double maxPt=-1.;
-  std::vector<int> maxPtIndices;
-  maxPtIndices.push_back(-1);
-  maxPtIndices.push_back(-1);
-  maxPtIndices.push_back(-1);
+  int maxPtIndices[3]={-1, -1, -1};
   
   for(int idx=0; idx<maxNJets_; ++idx){
     for(int jdx=0; jdx<maxNJets_; ++jdx){ if(jdx<=idx) continue;
@@ -72,10 +50,9 @@ Calculate::operator()(const std::vector<reco::Jet>& jets)
 	reco::Particle::LorentzVector sum = jets[idx].p4()+jets[jdx].p4()+jets[kdx].p4();
 	if( maxPt<0. || maxPt<sum.pt() ){
 	  maxPt=sum.pt();
-	  maxPtIndices.clear();
-	  maxPtIndices.push_back(idx);
-	  maxPtIndices.push_back(jdx);
-	  maxPtIndices.push_back(kdx);
+	  maxPtIndices[0]=idx;
+	  maxPtIndices[1]=jdx;
+	  maxPtIndices[2]=kdx;
 	}
       }
     }
@@ -87,18 +64,15 @@ Calculate::operator()(const std::vector<reco::Jet>& jets)
   // associate those jets that get closest to the W mass
   // with their invariant mass to the W boson
   double wDist =-1.;
-  std::vector<int> wMassIndices;
-  wMassIndices.push_back(-1);
-  wMassIndices.push_back(-1);
-  for(unsigned idx=0; idx<maxPtIndices.size(); ++idx){  
-    for(unsigned jdx=0; jdx<maxPtIndices.size(); ++jdx){  
+  int wMassIndices[2]={-1, -1};
+  for(unsigned idx=0; idx<3; ++idx){  
+    for(unsigned jdx=0; jdx<3; ++jdx){  
       if( jdx==idx || maxPtIndices[idx]>maxPtIndices[jdx] ) continue;
 	reco::Particle::LorentzVector sum = jets[maxPtIndices[idx]].p4()+jets[maxPtIndices[jdx]].p4();
 	if( wDist<0. || wDist>fabs(sum.mass()-wMass_) ){
 	  wDist=fabs(sum.mass()-wMass_);
-	  wMassIndices.clear();
-	  wMassIndices.push_back(maxPtIndices[idx]);
-	  wMassIndices.push_back(maxPtIndices[jdx]);
+	  wMassIndices[0]=maxPtIndices[idx];
+	  wMassIndices[1]=maxPtIndices[jdx];
 	}
     }
   }
@@ -108,20 +82,17 @@ Calculate::operator()(const std::vector<reco::Jet>& jets)
 
 
 void
-Calculate::operator2(const std::vector<reco::Jet>& jets, std::vector<double> bjet, double btagWP)
+Calculate::operator2(const reco::Jet* jets, unsigned int nJets, const double* bjet, unsigned int nBJets, double btagWP)
 {
-  if(maxNJets_<0) maxNJets_=jets.size();
-  failed_= jets.size()<(unsigned int) maxNJets_;
+  if(maxNJets_<0) maxNJets_=nJets;
+  failed_= nJets<(unsigned int) maxNJets_;
   if( failed_){ return; }
-  if (jets.size() != bjet.size()){return;}
+  if (nJets != nBJets){return;}
 
   // associate those jets with maximum pt of the vectorial 
   // sum to the hadronic decay chain. Require ONLY 1 btagged jet
   double maxBPt=-1.;
-  std::vector<int> maxBPtIndices;
-  maxBPtIndices.push_back(-1);
-  maxBPtIndices.push_back(-1);
-  maxBPtIndices.push_back(-1);
+  int maxBPtIndices[3]={-1, -1, -1};
   for(int idx=0; idx<maxNJets_; ++idx){
     for(int jdx=0; jdx<maxNJets_; ++jdx){ if(jdx<=idx) continue;
         for(int kdx=0; kdx<maxNJets_; ++kdx){if(kdx==idx || kdx==jdx) continue;
@@ -132,10 +103,9 @@ Calculate::operator2(const std::vector<reco::Jet>& jets, std::vector<double> bje
                     reco::Particle::LorentzVector sum = jets[idx].p4()+jets[jdx].p4()+jets[kdx].p4();
                     if( maxBPt<0. || maxBPt<sum.pt() ){
                         maxBPt=sum.pt();
-                        maxBPtIndices.clear();
-                        maxBPtIndices.push_back(idx);
-                        maxBPtIndices.push_back(jdx);
-                        maxBPtIndices.push_back(kdx);
+                        maxBPtIndices[0]=idx;
+                        maxBPtIndices[1]=jdx;
+                        maxBPtIndices[2]=kdx;
                     }
             }
         }
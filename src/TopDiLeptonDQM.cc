@@ -12,7 +12,9 @@
 using namespace std;
 using namespace edm;
 
-TopDiLeptonDQM::TopDiLeptonDQM( const edm::ParameterSet& ps ) {
+TopDiLeptonDQM::TopDiLeptonDQM( const edm::ParameterSet& ps ) :
+  dimassLogAxis_(200, 1., 1000.) // 10^(3.)=1000
+{
 
   initialize();
 
@@ -159,24 +161,10 @@ void TopDiLeptonDQM::beginJob() {
   ElecIso_trk_        = dbe_->book1D("ElecIso_trk",           "Electron Iso_trk",    21, -2., 40.);
   ElecIso_CombRelIso_ = dbe_->book1D("08_ElecIso_CombRelIso", "Electron CombRelIso", 20,  0.,  1.);
 
-  const int nbins = 200;
-
-  double logmin = 0.;
-  double logmax = 3.;  // 10^(3.)=1000
-
-  float bins[nbins+1];
-
-  for (int i = 0; i <= nbins; i++) {
-
-    double log = logmin + (logmax-logmin)*i/nbins;
-    bins[i] = std::pow(10.0, log);
-
-  }
-
   dimassRC_       = dbe_->book1D("09_dimassRC",      "Dilepton mass RC",        50, 0., 200.);
   dimassWC_       = dbe_->book1D("11_dimassWC",      "Dilepton mass WC",        50, 0., 200.);
-  dimassRC_LOGX_  = dbe_->book1D("10_dimassRC_LOGX", "Dilepton mass RC LOG", nbins, &bins[0]);
-  dimassWC_LOGX_  = dbe_->book1D("12_dimassWC_LOGX", "Dilepton mass WC LOG", nbins, &bins[0]);
+  dimassRC_LOGX_  = dbe_->book1D("10_dimassRC_LOGX", "Dilepton mass RC LOG", dimassLogAxis_.nBins(), dimassLogAxis_.edges());
+  dimassWC_LOGX_  = dbe_->book1D("12_dimassWC_LOGX", "Dilepton mass WC LOG", dimassLogAxis_.nBins(), dimassLogAxis_.edges());
   dimassRC_LOG10_ = dbe_->book1D("dimassRC_LOG10",   "Dilepton mass RC LOG",    50, 0.,  2.5);
   dimassWC_LOG10_ = dbe_->book1D("dimassWC_LOG10",   "Dilepton mass WC LOG",    50, 0.,  2.5);
 
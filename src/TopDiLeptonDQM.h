@@ -17,6 +17,7 @@
 
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "DQMServices/Core/interface/MonitorElement.h"
+#include "DQM/Physics/interface/LogAxis.h"
 
 #include "DataFormats/Common/interface/Ref.h"
 #include "DataFormats/Common/interface/Handle.h"
@@ -134,6 +135,9 @@ class TopDiLeptonDQM : public edm::EDAnalyzer {
     MonitorElement * dimassRC_LOG10_;
     MonitorElement * dimassWC_LOG10_;
 
+    // logarithmic binning of the dimassRC_LOGX_ and dimassWC_LOGX_ histograms
+    LogAxis dimassLogAxis_;
+
     MonitorElement * D_eta_muons_;
     MonitorElement * D_phi_muons_;
     MonitorElement * D_eta_elecs_;
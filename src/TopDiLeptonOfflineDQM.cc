@@ -5,13 +5,22 @@
 #include "DQM/Physics/src/TopDiLeptonOfflineDQM.h"
 #include "DataFormats/JetReco/interface/PFJet.h"
 #include "DQM/Physics/interface/TopDQMHelpers.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 namespace TopDiLeptonOffline {
 
-  MonitorEnsemble::MonitorEnsemble(const char* label, const edm::ParameterSet& cfg) : 
+  // maximal number of isolated leptons of
+  // each flavour in the event export
+  static const unsigned int MAXEXPORTLEPTONS = 4;
+
+  MonitorEnsemble::MonitorEnsemble(const char* label, const edm::ParameterSet& cfg, const HistogramTable* table) : 
    label_(label), eidPattern_(0), elecIso_(0), elecSelect_(0), muonIso_(0), muonSelect_(0), jetIDSelect_(0), 
-   lowerEdge_(-1.), upperEdge_(-1.), elecMuLogged_(0), diMuonLogged_(0), diElecLogged_(0)
+   lowerEdge_(-1.), upperEdge_(-1.), elecMuLogged_(0), diMuonLogged_(0), diElecLogged_(0), table_(table), export_(0), arena_(0)
   {
+    // the slots of the table have to follow the enumeration
+    if( table_->size()!=NHISTOGRAMS ){
+      throw cms::Exception("Configuration") << "MonitorEnsemble: histogram table has " << table_->size() << " entries, expected " << NHISTOGRAMS << "\n";
+    }
     // sources have to be given; this PSet is not optional
     edm::ParameterSet sources=cfg.getParameter<edm::ParameterSet>("sources");
     muons_= sources.getParameter<edm::InputTag>("muons");
@@ -121,134 +130,180 @@ namespace TopDiLeptonOffline {
     unsigned int nElecMu=elecMuPaths_.size();
     unsigned int nDiMuon=diMuonPaths_.size();
 
-    // --- [STANDARD] --- //
-    //Run Number
-    hists_["RunNumb_"    ] = store_->book1D("RunNumber"  , "Run Nr."          ,   1.e4,  1.5e5,    3.e5);
-    // invariant mass of opposite charge lepton pair (only filled for same flavor)
-    hists_["invMass_"     ] = store_->book1D("InvMass"     , "M(lep1, lep2)"           ,       80,   0.,     320.);
-    // invariant mass of opposite charge lepton pair (only filled for same flavor)
-    hists_["invMassLog_"  ] = store_->book1D("InvMassLog"  , "log_{10}(M(lep1, lep2))" ,       80,   .1,      2.5);
-    // invariant mass of same charge lepton pair (log10 for low mass region, only filled for same flavor)
-    hists_["invMassWC_"   ] = store_->book1D("InvMassWC"   , "M_{WC}(L1, L2)"          ,       80,   0.,     320.);
-    // invariant mass of same charge lepton pair (log10 for low mass region, only filled for same flavor)
-    hists_["invMassWCLog_"] = store_->book1D("InvMassLogWC", "log_{10}(M_{WC})"        ,       80,   .1,      2.5);
-    // decay channel [1]: muon/muon, [2]:elec/elec, [3]:elec/muon 
-    hists_["decayChannel_"] = store_->book1D("DecayChannel", "Decay Channel"           ,        3,    0,        3);
-    // trigger efficiency estimates for the electron muon channel
-    hists_["elecMuEff_"   ] = store_->book1D("ElecMuEff"   , "Eff(e/#mu paths)"        ,  nElecMu,   0.,  nElecMu);
-    // monitored trigger occupancy for the electron muon channel
-    hists_["elecMuMon_"   ] = store_->book1D("ElecMuMon"   , "Mon(e/#mu paths)"        ,  nElecMu,   0.,  nElecMu);
-    // trigger efficiency estimates for the di muon channel
-    hists_["diMuonEff_"   ] = store_->book1D("DiMuonEff"   , "Eff(#mu/#mu paths)"      ,  nDiMuon,   0.,  nDiMuon);
-    // monitored trigger occupancy for the di muon channel
-    hists_["diMuonMon_"   ] = store_->book1D("DiMuonMon"   , "Mon(#mu/#mu paths)"      ,  nDiMuon,   0.,  nDiMuon);
-    // pt of the leading lepton
-    hists_["lep1Pt_"      ] = store_->book1D("Lep1Pt"      , "pt(lep1)"                ,       50,   0.,     200.);
-    // pt of the 2. leading lepton
-    hists_["lep2Pt_"      ] = store_->book1D("Lep2Pt"      , "pt(lep2)"                ,       50,   0.,     200.);
-    // multiplicity of jets with pt>30 (corrected to L2+L3)
-    hists_["jetMult_"     ] = store_->book1D("JetMult"     , "N_{30}(jet)"             ,       21, -0.5,      20.5); 
-    // MET (calo)
-    hists_["metCalo_"     ] = store_->book1D("METCalo"     , "MET_{Calo}"              ,       50,   0.,     200.);
+    // book all histograms of the table up to the verbosity
+    // level; histograms without binning in x are booked with
+    // one bin per trigger path of their channel
+    hists_.assign(table_->size(), 0);
+    for(unsigned int slot=0; slot<table_->size(); ++slot){
+      const HistogramTable::Entry& hist=(*table_)[slot];
+      if( hist.level>verbosity_ ) continue;
+      unsigned int nPaths=(slot==DI_MUON_EFF || slot==DI_MUON_MON) ? nDiMuon : nElecMu;
+      int nBinsX=hist.nBinsX>0 ? hist.nBinsX : nPaths; double highX=hist.nBinsX>0 ? hist.highX : nPaths;
+      if( hist.is2D() ) hists_[slot] = store_->book2D(hist.name, hist.title, nBinsX, hist.lowX, highX, hist.nBinsY, hist.lowY, hist.highY);
+      else hists_[slot] = store_->book1D(hist.name, hist.title, nBinsX, hist.lowX, highX);
+    }
 
     // set bin labels for trigger monitoring
-    triggerBinLabels(std::string("elecMu"), elecMuPaths_);
-    triggerBinLabels(std::string("diMuon"), diMuonPaths_);
+    triggerBinLabels(ELEC_MU_MON, ELEC_MU_EFF, elecMuPaths_);
+    triggerBinLabels(DI_MUON_MON, DI_MUON_EFF, diMuonPaths_);
     // set bin labels for decayChannel_
-    hists_["decayChannel_"]->setBinLabel( 1, "#mu e"  , 1);
-    hists_["decayChannel_"]->setBinLabel( 2, "#mu #mu", 1);
-    hists_["decayChannel_"]->setBinLabel( 3, "e e"    , 1);
-
-    if( verbosity_==STANDARD) return;
-
-    // --- [VERBOSE] --- //
-    // mean eta of the candidate leptons
-    hists_["sumEtaL1L2_"  ] = store_->book1D("SumEtaL1L2"  , "<#eta>(lep1, lep2)"      ,       100,  -5.,       5.); 
-    // deltaEta between the 2 candidate leptons
-    hists_["dEtaL1L2_"    ] = store_->book1D("DEtaL1L2"    , "#Delta#eta(lep1,lep2)"   ,       80,  -4.,       4.);
-    // deltaPhi between the 2 candidate leptons
-    hists_["dPhiL1L2_"    ] = store_->book1D("DPhiL1L2"    , "#Delta#phi(lep1,lep2)"   ,       64, -3.2,      3.2);
-    // pt of the candidate electron (depending on the decay channel)
-    hists_["elecPt_"      ] = store_->book1D("ElecPt"      , "pt(e)"                   ,       50,   0.,     200.);
-    // relative isolation of the candidate electron (depending on the decay channel)
-    hists_["elecRelIso_"  ] = store_->book1D("ElecRelIso"  , "Iso_{Rel}(e)"            ,       50,   0.,       1.);
-    // pt of the canddiate muon (depending on the decay channel)
-    hists_["muonPt_"      ] = store_->book1D("MuonPt"      , "pt(#mu)"                 ,       50,   0.,     200.);
-    // relative isolation of the candidate muon (depending on the decay channel)
-    hists_["muonRelIso_"  ] = store_->book1D("MuonRelIso"  , "Iso_{Rel}(#mu)"          ,       50,   0.,       1.);
-    // pt of the 1. leading jet (corrected to L2+L3)
-    hists_["jet1Pt_"      ] = store_->book1D("Jet1Pt"      , "pt_{L2L3}(jet1)"         ,       60,   0.,     300.);   
-    // pt of the 2. leading jet (corrected to L2+L3)
-    hists_["jet2Pt_"      ] = store_->book1D("Jet2Pt"      , "pt_{L2L3}(jet2)"         ,       60,   0.,     300.);
-    // MET (PF)
-    hists_["metPflow_"    ] = store_->book1D("METPflow"    , "MET_{Pflow}"             ,       50,   0.,     200.);
-    // MET (TC)
-    hists_["metTC_"       ] = store_->book1D("METTC"       , "MET_{TC}"                ,       50,   0.,     200.);
-    // dz for muons (to suppress cosmis)
-    hists_["muonDelZ_"    ] = store_->book1D("MuonDelZ"    , "d_{z}(#mu)"              ,       50, -25.,      25.);
-    // dxy for muons (to suppress cosmics)
-    hists_["muonDelXY_"   ] = store_->book2D("MuonDelXY"   , "d_{xy}(#mu)"             , 50,  -1.,  1., 50, -1., 1.);
-    // lepton multiplicity after std isolation
-    hists_["lepMultIso_"  ] = store_->book2D("LepMultIso"  , "N_{Iso}(e) vs N_{Iso}(#mu)" ,  5,    0.,   5.,  5,   0.,    5.);
-
+    if( booked(DECAY_CHANNEL) ){
+      hists_[DECAY_CHANNEL]->setBinLabel( 1, "#mu e"  , 1);
+      hists_[DECAY_CHANNEL]->setBinLabel( 2, "#mu #mu", 1);
+      hists_[DECAY_CHANNEL]->setBinLabel( 3, "e e"    , 1);
+    }
     // set axes titles for dxy for muons
-    hists_["muonDelXY_"   ]->setAxisTitle( "x [cm]", 1); hists_["muonDelXY_"   ]->setAxisTitle( "y [cm]", 2);
+    if( booked(MUON_DEL_XY) ){
+      hists_[MUON_DEL_XY]->setAxisTitle( "x [cm]", 1); hists_[MUON_DEL_XY]->setAxisTitle( "y [cm]", 2);
+    }
     // set axes titles for lepton multiplicity after std isolation
-    hists_["lepMultIso_"  ]->setAxisTitle( "N_{Iso}(#mu)", 1); hists_["lepMultIso_"   ]->setAxisTitle( "N_{Iso}(elec)", 2);
-
-    if( verbosity_==VERBOSE) return;
-
-    // --- [DEBUG] --- //
-    // electron multiplicity after std isolation
-    hists_["elecMultIso_" ] = store_->book1D("ElecMultIso" , "N_{Iso}(e)"              ,       11, -0.5,     10.5);
-    // muon multiplicity after std isolation
-    hists_["muonMultIso_" ] = store_->book1D("MuonMultIso" , "N_{Iso}(#mu)"            ,       11, -0.5,     10.5);
-    // calo isolation of the candidate muon (depending on the decay channel)
-    hists_["muonCalIso_"  ] = store_->book1D("MuonCalIso"  , "Iso_{Cal}(#mu)"          ,       50,   0.,       1.);
-    // track isolation of the candidate muon (depending on the decay channel)
-    hists_["muonTrkIso_"  ] = store_->book1D("MuonTrkIso"  , "Iso_{Trk}(#mu)"          ,       50,   0.,       1.);
-    // calo isolation of the candidate electron (depending on the decay channel)
-    hists_["elecCalIso_"  ] = store_->book1D("ElecCalIso"  , "Iso_{Cal}(e)"            ,       50,   0.,       1.);
-    // track isolation of the candidate electron (depending on the decay channel)
-    hists_["elecTrkIso_"  ] = store_->book1D("ElecTrkIso"  , "Iso_{Trk}(e)"            ,       50,   0.,       1.);
-    // eta of the leading jet
-    hists_["jet1Eta_"     ] = store_->book1D("Jet1Eta"     , "#eta(jet1)"              ,       30,  -5.,       5.); 
-    // eta of the 2. leading jet
-    hists_["jet2Eta_"     ] = store_->book1D("Jet2Eta"     , "#eta(jet2)"              ,       30,  -5.,       5.);
-    // pt of the 1. leading jet (not corrected)
-    hists_["jet1PtRaw_"   ] = store_->book1D("Jet1PtRaw"   , "pt_{Raw}(jet1)"          ,       60,   0.,     300.);   
-    // pt of the 2. leading jet (not corrected)     
-    hists_["jet2PtRaw_"   ] = store_->book1D("Jet2PtRaw"   , "pt_{Raw}(jet2)"          ,       60,   0.,     300.);
-    // deltaEta between the 2 leading jets
-    hists_["dEtaJet1Jet2_"] = store_->book1D("DEtaJet1Jet2", "#Delta#eta(jet1,jet2)"   ,       80,  -4.,       4.);
-    // deltaEta between the lepton and the leading jet
-    hists_["dEtaJet1Lep1_"] = store_->book1D("DEtaJet1Lep1", "#Delta#eta(jet1,lep1)"   ,       80,  -4.,       4.);
-    // deltaEta between the lepton and MET
-    hists_["dEtaLep1MET_" ] = store_->book1D("DEtaLep1MET" , "#Delta#eta(lep1,MET)"    ,       80,  -4.,       4.);
-    // deltaEta between leading jet and MET
-    hists_["dEtaJet1MET_" ] = store_->book1D("DEtaJet1MET" , "#Delta#eta(jet1,MET)"    ,       80,  -4.,       4.);
-    // deltaPhi of 2 leading jets
-    hists_["dPhiJet1Jet2_"] = store_->book1D("DPhiJet1Jet2", "#Delta#phi(jet1,jet2)"   ,       64, -3.2,      3.2);
-    // deltaPhi of 1. lepton and 1. jet
-    hists_["dPhiJet1Lep1_"] = store_->book1D("DPhiJet1Lep1", "#Delta#phi(jet1,lep1)"   ,       64, -3.2,      3.2);
-    // deltaPhi of 1. lepton and MET
-    hists_["dPhiLep1MET_" ] = store_->book1D("DPhiLep1MET" , "#Delta#phi(lep1,MET)"    ,       64, -3.2,      3.2);
-    // deltaPhi of 1. jet and MET
-    hists_["dPhiJet1MET_" ] = store_->book1D("DPhiJet1MET" , "#Delta#phi(jet1,MET)"    ,       64, -3.2,      3.2);
-    // selected dimuon events
-    hists_["diMuonLogger_"] = store_->book2D("DiMuonLogger", "Logged DiMuon Events"    ,        8,   0.,       8.,   10,   0.,   10.);
-    // selected dielec events
-    hists_["diElecLogger_"] = store_->book2D("DiElecLogger", "Logged DiElec Events"    ,        8,   0.,       8.,   10,   0.,   10.);
-    // selected elemu events
-    hists_["elecMuLogger_"] = store_->book2D("ElecMuLogger", "Logged ElecMu Events"    ,        8,   0.,       8.,   10,   0.,   10.);
-
-    // set bin labels for trigger monitoring
-    loggerBinLabels(std::string("diMuonLogger_")); 
-    loggerBinLabels(std::string("diElecLogger_")); 
-    loggerBinLabels(std::string("elecMuLogger_"));
+    if( booked(LEP_MULT_ISO) ){
+      hists_[LEP_MULT_ISO]->setAxisTitle( "N_{Iso}(#mu)", 1); hists_[LEP_MULT_ISO]->setAxisTitle( "N_{Iso}(elec)", 2);
+    }
+    // set bin labels for event logging
+    loggerBinLabels(DI_MUON_LOGGER); 
+    loggerBinLabels(DI_ELEC_LOGGER); 
+    loggerBinLabels(ELEC_MU_LOGGER);
     return;
   }
 
+  std::vector<HistogramTable::Entry>
+  MonitorEnsemble::defaults()
+  {
+    typedef HistogramTable::Entry H;
+    // key, name, title, level, binning (nBins<=0: one bin per trigger path)
+    static const H DEFAULTS[] = {
+      // --- [STANDARD] --- //
+      //Run Number
+      H("RunNumb_"      , "RunNumber"    , "Run Nr."                    , STANDARD,  1.e4, 1.5e5,  3.e5),
+      // invariant mass of opposite charge lepton pair (only filled for same flavor)
+      H("invMass_"      , "InvMass"      , "M(lep1, lep2)"              , STANDARD,    80,    0.,  320.),
+      // invariant mass of opposite charge lepton pair (only filled for same flavor)
+      H("invMassLog_"   , "InvMassLog"   , "log_{10}(M(lep1, lep2))"    , STANDARD,    80,    .1,   2.5),
+      // invariant mass of same charge lepton pair (log10 for low mass region, only filled for same flavor)
+      H("invMassWC_"    , "InvMassWC"    , "M_{WC}(L1, L2)"             , STANDARD,    80,    0.,  320.),
+      // invariant mass of same charge lepton pair (log10 for low mass region, only filled for same flavor)
+      H("invMassWCLog_" , "InvMassLogWC" , "log_{10}(M_{WC})"           , STANDARD,    80,    .1,   2.5),
+      // decay channel [1]: muon/muon, [2]:elec/elec, [3]:elec/muon
+      H("decayChannel_" , "DecayChannel" , "Decay Channel"              , STANDARD,     3,     0,     3),
+      // trigger efficiency estimates for the electron muon channel
+      H("elecMuEff_"    , "ElecMuEff"    , "Eff(e/#mu paths)"           , STANDARD,     0,    0.,    0.),
+      // monitored trigger occupancy for the electron muon channel
+      H("elecMuMon_"    , "ElecMuMon"    , "Mon(e/#mu paths)"           , STANDARD,     0,    0.,    0.),
+      // trigger efficiency estimates for the di muon channel
+      H("diMuonEff_"    , "DiMuonEff"    , "Eff(#mu/#mu paths)"         , STANDARD,     0,    0.,    0.),
+      // monitored trigger occupancy for the di muon channel
+      H("diMuonMon_"    , "DiMuonMon"    , "Mon(#mu/#mu paths)"         , STANDARD,     0,    0.,    0.),
+      // pt of the leading lepton
+      H("lep1Pt_"       , "Lep1Pt"       , "pt(lep1)"                   , STANDARD,    50,    0.,  200.),
+      // pt of the 2. leading lepton
+      H("lep2Pt_"       , "Lep2Pt"       , "pt(lep2)"                   , STANDARD,    50,    0.,  200.),
+      // multiplicity of jets with pt>30 (corrected to L2+L3)
+      H("jetMult_"      , "JetMult"      , "N_{30}(jet)"                , STANDARD,    21,  -0.5,  20.5),
+      // MET (calo)
+      H("metCalo_"      , "METCalo"      , "MET_{Calo}"                 , STANDARD,    50,    0.,  200.),
+      // --- [VERBOSE] --- //
+      // mean eta of the candidate leptons
+      H("sumEtaL1L2_"   , "SumEtaL1L2"   , "<#eta>(lep1, lep2)"         , VERBOSE ,   100,   -5.,    5.),
+      // deltaEta between the 2 candidate leptons
+      H("dEtaL1L2_"     , "DEtaL1L2"     , "#Delta#eta(lep1,lep2)"      , VERBOSE ,    80,   -4.,    4.),
+      // deltaPhi between the 2 candidate leptons
+      H("dPhiL1L2_"     , "DPhiL1L2"     , "#Delta#phi(lep1,lep2)"      , VERBOSE ,    64,  -3.2,   3.2),
+      // pt of the candidate electron (depending on the decay channel)
+      H("elecPt_"       , "ElecPt"       , "pt(e)"                      , VERBOSE ,    50,    0.,  200.),
+      // relative isolation of the candidate electron (depending on the decay channel)
+      H("elecRelIso_"   , "ElecRelIso"   , "Iso_{Rel}(e)"               , VERBOSE ,    50,    0.,    1.),
+      // pt of the canddiate muon (depending on the decay channel)
+      H("muonPt_"       , "MuonPt"       , "pt(#mu)"                    , VERBOSE ,    50,    0.,  200.),
+      // relative isolation of the candidate muon (depending on the decay channel)
+      H("muonRelIso_"   , "MuonRelIso"   , "Iso_{Rel}(#mu)"             , VERBOSE ,    50,    0.,    1.),
+      // pt of the 1. leading jet (corrected to L2+L3)
+      H("jet1Pt_"       , "Jet1Pt"       , "pt_{L2L3}(jet1)"            , VERBOSE ,    60,    0.,  300.),
+      // pt of the 2. leading jet (corrected to L2+L3)
+      H("jet2Pt_"       , "Jet2Pt"       , "pt_{L2L3}(jet2)"            , VERBOSE ,    60,    0.,  300.),
+      // MET (PF)
+      H("metPflow_"     , "METPflow"     , "MET_{Pflow}"                , VERBOSE ,    50,    0.,  200.),
+      // MET (TC)
+      H("metTC_"        , "METTC"        , "MET_{TC}"                   , VERBOSE ,    50,    0.,  200.),
+      // dz for muons (to suppress cosmis)
+      H("muonDelZ_"     , "MuonDelZ"     , "d_{z}(#mu)"                 , VERBOSE ,    50,  -25.,   25.),
+      // dxy for muons (to suppress cosmics)
+      H("muonDelXY_"    , "MuonDelXY"    , "d_{xy}(#mu)"                , VERBOSE ,    50,   -1.,    1.,      50,   -1.,    1.),
+      // lepton multiplicity after std isolation
+      H("lepMultIso_"   , "LepMultIso"   , "N_{Iso}(e) vs N_{Iso}(#mu)" , VERBOSE ,     5,    0.,    5.,       5,    0.,    5.),
+      // --- [DEBUG] --- //
+      // electron multiplicity after std isolation
+      H("elecMultIso_"  , "ElecMultIso"  , "N_{Iso}(e)"                 , DEBUG   ,    11,  -0.5,  10.5),
+      // muon multiplicity after std isolation
+      H("muonMultIso_"  , "MuonMultIso"  , "N_{Iso}(#mu)"               , DEBUG   ,    11,  -0.5,  10.5),
+      // calo isolation of the candidate muon (depending on the decay channel)
+      H("muonCalIso_"   , "MuonCalIso"   , "Iso_{Cal}(#mu)"             , DEBUG   ,    50,    0.,    1.),
+      // track isolation of the candidate muon (depending on the decay channel)
+      H("muonTrkIso_"   , "MuonTrkIso"   , "Iso_{Trk}(#mu)"             , DEBUG   ,    50,    0.,    1.),
+      // calo isolation of the candidate electron (depending on the decay channel)
+      H("elecCalIso_"   , "ElecCalIso"   , "Iso_{Cal}(e)"               , DEBUG   ,    50,    0.,    1.),
+      // track isolation of the candidate electron (depending on the decay channel)
+      H("elecTrkIso_"   , "ElecTrkIso"   , "Iso_{Trk}(e)"               , DEBUG   ,    50,    0.,    1.),
+      // eta of the leading jet
+      H("jet1Eta_"      , "Jet1Eta"      , "#eta(jet1)"                 , DEBUG   ,    30,   -5.,    5.),
+      // eta of the 2. leading jet
+      H("jet2Eta_"      , "Jet2Eta"      , "#eta(jet2)"                 , DEBUG   ,    30,   -5.,    5.),
+      // pt of the 1. leading jet (not corrected)
+      H("jet1PtRaw_"    , "Jet1PtRaw"    , "pt_{Raw}(jet1)"             , DEBUG   ,    60,    0.,  300.),
+      // pt of the 2. leading jet (not corrected)
+      H("jet2PtRaw_"    , "Jet2PtRaw"    , "pt_{Raw}(jet2)"             , DEBUG   ,    60,    0.,  300.),
+      // deltaEta between the 2 leading jets
+      H("dEtaJet1Jet2_" , "DEtaJet1Jet2" , "#Delta#eta(jet1,jet2)"      , DEBUG   ,    80,   -4.,    4.),
+      // deltaEta between the lepton and the leading jet
+      H("dEtaJet1Lep1_" , "DEtaJet1Lep1" , "#Delta#eta(jet1,lep1)"      , DEBUG   ,    80,   -4.,    4.),
+      // deltaEta between the lepton and MET
+      H("dEtaLep1MET_"  , "DEtaLep1MET"  , "#Delta#eta(lep1,MET)"       , DEBUG   ,    80,   -4.,    4.),
+      // deltaEta between leading jet and MET
+      H("dEtaJet1MET_"  , "DEtaJet1MET"  , "#Delta#eta(jet1,MET)"       , DEBUG   ,    80,   -4.,    4.),
+      // deltaPhi of 2 leading jets
+      H("dPhiJet1Jet2_" , "DPhiJet1Jet2" , "#Delta#phi(jet1,jet2)"      , DEBUG   ,    64,  -3.2,   3.2),
+      // deltaPhi of 1. lepton and 1. jet
+      H("dPhiJet1Lep1_" , "DPhiJet1Lep1" , "#Delta#phi(jet1,lep1)"      , DEBUG   ,    64,  -3.2,   3.2),
+      // deltaPhi of 1. lepton and MET
+      H("dPhiLep1MET_"  , "DPhiLep1MET"  , "#Delta#phi(lep1,MET)"       , DEBUG   ,    64,  -3.2,   3.2),
+      // deltaPhi of 1. jet and MET
+      H("dPhiJet1MET_"  , "DPhiJet1MET"  , "#Delta#phi(jet1,MET)"       , DEBUG   ,    64,  -3.2,   3.2),
+      // selected dimuon events
+      H("diMuonLogger_" , "DiMuonLogger" , "Logged DiMuon Events"       , DEBUG   ,     8,    0.,    8.,      10,    0.,   10.),
+      // selected dielec events
+      H("diElecLogger_" , "DiElecLogger" , "Logged DiElec Events"       , DEBUG   ,     8,    0.,    8.,      10,    0.,   10.),
+      // selected elemu events
+      H("elecMuLogger_" , "ElecMuLogger" , "Logged ElecMu Events"       , DEBUG   ,     8,    0.,    8.,      10,    0.,   10.)
+    };
+    return std::vector<H>(DEFAULTS, DEFAULTS+sizeof(DEFAULTS)/sizeof(DEFAULTS[0]));
+  }
+
+  void
+  MonitorEnsemble::exportTo(EventExport* out)
+  {
+    export_=out; columns_.resize(NCOLUMNS);
+    // isolated muons and electrons
+    columns_[MUON_PT_COL      ]=out->add("muonPt"      , MAXEXPORTLEPTONS);
+    columns_[MUON_ETA_COL     ]=out->add("muonEta"     , MAXEXPORTLEPTONS);
+    columns_[MUON_PHI_COL     ]=out->add("muonPhi"     , MAXEXPORTLEPTONS);
+    columns_[MUON_CHARGE_COL  ]=out->add("muonCharge"  , MAXEXPORTLEPTONS);
+    columns_[ELEC_PT_COL      ]=out->add("elecPt"      , MAXEXPORTLEPTONS);
+    columns_[ELEC_ETA_COL     ]=out->add("elecEta"     , MAXEXPORTLEPTONS);
+    columns_[ELEC_PHI_COL     ]=out->add("elecPhi"     , MAXEXPORTLEPTONS);
+    columns_[ELEC_CHARGE_COL  ]=out->add("elecCharge"  , MAXEXPORTLEPTONS);
+    // jet multiplicity and the two leading jets (corrected to L2+L3)
+    columns_[JET_MULT_COL     ]=out->add("jetMult"     );
+    columns_[JET_PT_COL       ]=out->add("jetPt"       , 2);
+    columns_[JET_ETA_COL      ]=out->add("jetEta"      , 2);
+    columns_[JET_PHI_COL      ]=out->add("jetPhi"      , 2);
+    // one entry per MET source in the order of the configuration (-1 if not found)
+    columns_[MET_ET_COL       ]=out->add("metEt"       , mets_.size());
+    columns_[MET_PHI_COL      ]=out->add("metPhi"      , mets_.size());
+    // decay channel (NONE, DIMUON, DIELEC, ELECMU) and mass of the leading lepton pair (-1 for NONE)
+    columns_[DECAY_CHANNEL_COL]=out->add("decayChannel");
+    columns_[MASS_LL_COL      ]=out->add("massLL"      );
+  }
+
   void 
   MonitorEnsemble::fill(const edm::Event& event, const edm::EventSetup& setup)
   {
@@ -261,15 +316,13 @@ namespace TopDiLeptonOffline {
     /*
     ------------------------------------------------------------
     
-    Run and Inst. Luminosity information (Inst. Lumi. filled now with a dummy value=5.0)
+    Run information
     
     ------------------------------------------------------------
     */
     
     if (!event.eventAuxiliary().run()) return;
-    fill("RunNumb_", event.eventAuxiliary().run());   
-    
-    double dummy=5.; fill("InstLumi_", dummy);
+    fill(RUN_NUMB, event.eventAuxiliary().run());   
      
     
     /* 
@@ -281,7 +334,7 @@ namespace TopDiLeptonOffline {
     */
 
     // buffer isolated muons
-    std::vector<const reco::Muon*> isoMuons;
+    ArenaVector<const reco::Muon*>::type isoMuons(arena_);
 
     edm::Handle<edm::View<reco::Muon> > muons;
     if( !event.getByLabel(muons_, muons) ) return;
@@ -289,19 +342,19 @@ namespace TopDiLeptonOffline {
     for(edm::View<reco::Muon>::const_iterator muon=muons->begin(); muon!=muons->end(); ++muon){
       // restrict to globalMuons
       if( muon->isGlobalMuon() ){ 
-	fill("muonDelZ_" , muon->globalTrack()->vz());
-	fill("muonDelXY_", muon->globalTrack()->vx(), muon->globalTrack()->vy());
+	fill(MUON_DEL_Z, muon->globalTrack()->vz());
+	fill(MUON_DEL_XY, muon->globalTrack()->vx(), muon->globalTrack()->vy());
 	// apply preselection
 	if(!muonSelect_ || (*muonSelect_)(*muon)){
 	  double isolationTrk = muon->pt()/(muon->pt()+muon->isolationR03().sumPt);
 	  double isolationCal = muon->pt()/(muon->pt()+muon->isolationR03().emEt+muon->isolationR03().hadEt);
 	  double isolationRel = (muon->isolationR03().sumPt+muon->isolationR03().emEt+muon->isolationR03().hadEt)/muon->pt();
-	  fill("muonTrkIso_" , isolationTrk); fill("muonCalIso_" , isolationCal); fill("muonRelIso_" , isolationRel);
+	  fill(MUON_TRK_ISO, isolationTrk); fill(MUON_CAL_ISO, isolationCal); fill(MUON_REL_ISO, isolationRel);
 	  if(!muonIso_ || (*muonIso_)(*muon)) isoMuons.push_back(&(*muon));
 	}
       }
     }
-    fill("muonMultIso_", isoMuons.size());
+    fill(MUON_MULT_ISO, isoMuons.size());
 
     /* 
     ------------------------------------------------------------
@@ -312,7 +365,7 @@ namespace TopDiLeptonOffline {
     */
 
     // buffer isolated electronss
-    std::vector<const reco::GsfElectron*> isoElecs;
+    ArenaVector<const reco::GsfElectron*>::type isoElecs(arena_);
     edm::Handle<edm::ValueMap<float> > electronId; 
     if(!electronId_.label().empty()) {
       if( !event.getByLabel(electronId_, electronId) ) return;
@@ -320,22 +373,23 @@ namespace TopDiLeptonOffline {
 
     edm::Handle<edm::View<reco::GsfElectron> > elecs;
     if( !event.getByLabel(elecs_, elecs) ) return;
+    if( !electronId_.label().empty() ) electronIds_.resolve(*elecs, *electronId);
 
     for(edm::View<reco::GsfElectron>::const_iterator elec=elecs->begin(); elec!=elecs->end(); ++elec){
       // restrict to electrons with good electronId
       int idx = elec-elecs->begin();
-      if( electronId_.label().empty() ? true : ((int)(*electronId)[elecs->refAt(idx)] & eidPattern_) ){
+      if( electronId_.label().empty() ? true : ((int)electronIds_[idx] & eidPattern_) ){
 	// apply preselection
 	if(!elecSelect_ || (*elecSelect_)(*elec)){
 	  double isolationTrk = elec->pt()/(elec->pt()+elec->dr03TkSumPt());
 	  double isolationCal = elec->pt()/(elec->pt()+elec->dr03EcalRecHitSumEt()+elec->dr03HcalTowerSumEt());
 	  double isolationRel = (elec->dr03TkSumPt()+elec->dr03EcalRecHitSumEt()+elec->dr03HcalTowerSumEt())/elec->pt();
-	  fill("elecTrkIso_" , isolationTrk); fill("elecCalIso_" , isolationCal); fill("elecRelIso_" , isolationRel);
+	  fill(ELEC_TRK_ISO, isolationTrk); fill(ELEC_CAL_ISO, isolationCal); fill(ELEC_REL_ISO, isolationRel);
 	  if(!elecIso_ || (*elecIso_)(*elec)) isoElecs.push_back(&(*elec));
 	}
       }
     }
-    fill("elecMultIso_", isoElecs.size());
+    fill(ELEC_MULT_ISO, isoElecs.size());
 
     /* 
     ------------------------------------------------------------
@@ -369,19 +423,21 @@ namespace TopDiLeptonOffline {
 
     unsigned int mult=0;
     // buffer leadingJets
-    std::vector<reco::Jet> leadingJets;
+    ArenaVector<reco::Jet>::type leadingJets(arena_); leadingJets.reserve(2);
     edm::Handle<edm::View<reco::Jet> > jets; 
     if( !event.getByLabel(jets_, jets) ) return;
 
+    // the jetID is only available for calo jets
     edm::Handle<reco::JetIDValueMap> jetID;
     if(jetIDSelect_){ 
       if( !event.getByLabel(jetIDLabel_, jetID) ) return;
+      jetIDs_.resolveType<reco::CaloJet>(*jets, *jetID);
     }
 
     for(edm::View<reco::Jet>::const_iterator jet=jets->begin(); jet!=jets->end(); ++jet){
       unsigned int idx=jet-jets->begin();
-      if( jetIDSelect_ && dynamic_cast<const reco::CaloJet*>(jets->refAt(idx).get())){
-	if(!(*jetIDSelect_)((*jetID)[jets->refAt(idx)])) continue;
+      if( jetIDSelect_ && dynamic_cast<const reco::CaloJet*>(&*jet)){
+	if(!(*jetIDSelect_)(jetIDs_[idx])) continue;
       }
       // chekc additional jet selection for calo, pf and bare reco jets
       if(dynamic_cast<const reco::CaloJet*>(&*jet)){
@@ -398,7 +454,7 @@ namespace TopDiLeptonOffline {
       }
       // check for overlaps
       bool overlap=false;
-      for(std::vector<const reco::GsfElectron*>::const_iterator elec=isoElecs.begin(); elec!=isoElecs.end(); ++elec){
+      for(ArenaVector<const reco::GsfElectron*>::type::const_iterator elec=isoElecs.begin(); elec!=isoElecs.end(); ++elec){
 	if(reco::deltaR((*elec)->eta(), (*elec)->phi(), jet->eta(), jet->phi())<0.4){overlap=true; break;}
       } if(overlap){continue;}
       // prepare jet to fill monitor histograms
@@ -406,34 +462,34 @@ namespace TopDiLeptonOffline {
       ++mult; // determine jet multiplicity
       if(idx==0) {
 	leadingJets.push_back(monitorJet);
-	fill("jet1Pt_"    , monitorJet.pt());
-	fill("jet1PtRaw_" , jet->pt() );
-	fill("jet1Eta_"   , jet->eta());
+	fill(JET1_PT, monitorJet.pt());
+	fill(JET1_PT_RAW, jet->pt() );
+	fill(JET1_ETA, jet->eta());
       }
       if(idx==1) {
 	leadingJets.push_back(monitorJet);
-	fill("jet2Pt_"    , monitorJet.pt());
-	fill("jet2PtRaw_" , jet->pt() );
-	fill("jet2Eta_"   , jet->eta());
+	fill(JET2_PT, monitorJet.pt());
+	fill(JET2_PT_RAW, jet->pt() );
+	fill(JET2_ETA, jet->eta());
       }
     }
     if(leadingJets.size()>1){
-      fill("dEtaJet1Jet2_" , leadingJets[0].eta()-leadingJets[1].eta());
-      fill("dPhiJet1Jet2_" , reco::deltaPhi(leadingJets[0].phi(), leadingJets[1].phi()));
+      fill(DETA_JET1_JET2, leadingJets[0].eta()-leadingJets[1].eta());
+      fill(DPHI_JET1_JET2, reco::deltaPhi(leadingJets[0].phi(), leadingJets[1].phi()));
       if( !isoMuons.empty() ){
 	if( isoElecs.empty() || isoMuons[0]->pt()>isoElecs[0]->pt() ){
-	  fill("dEtaJet1Lep1_" , isoMuons[0]->eta()-leadingJets[0].eta());
-	  fill("dPhiJet1Lep1_" , reco::deltaPhi(isoMuons[0]->phi() , leadingJets[0].phi()));
+	  fill(DETA_JET1_LEP1, isoMuons[0]->eta()-leadingJets[0].eta());
+	  fill(DPHI_JET1_LEP1, reco::deltaPhi(isoMuons[0]->phi() , leadingJets[0].phi()));
 	} 
       }
       if( !isoElecs.empty() ){
 	if( isoMuons.empty() || isoElecs[0]->pt()>isoMuons[0]->pt() ){
-	  fill("dEtaJet1Lep1_" , isoElecs[0]->eta()-leadingJets[0].eta());
-	  fill("dPhiJet1Lep1_" , reco::deltaPhi(isoElecs[0]->phi() , leadingJets[0].phi()));
+	  fill(DETA_JET1_LEP1, isoElecs[0]->eta()-leadingJets[0].eta());
+	  fill(DPHI_JET1_LEP1, reco::deltaPhi(isoElecs[0]->phi() , leadingJets[0].phi()));
 	}
       }
     }
-    fill("jetMult_", mult);
+    fill(JET_MULT, mult);
     
     /* 
     ------------------------------------------------------------
@@ -454,27 +510,56 @@ namespace TopDiLeptonOffline {
 	unsigned int idx=met_-mets_.begin();
 	if(idx==0){
 	  caloMET=*met->begin(); 
-	  fill("metCalo_", met->begin()->et());
+	  fill(MET_CALO, met->begin()->et());
 	  if(!leadingJets.empty()){
-	    fill("dEtaJet1MET_" , leadingJets[0].eta()-met->begin()->eta());
-	    fill("dPhiJet1MET_" , reco::deltaPhi(leadingJets[0].phi(), met->begin()->phi()));
+	    fill(DETA_JET1_MET, leadingJets[0].eta()-met->begin()->eta());
+	    fill(DPHI_JET1_MET, reco::deltaPhi(leadingJets[0].phi(), met->begin()->phi()));
 	  }
 	  if( !isoMuons.empty() ){
 	    if( isoElecs.empty() || isoMuons[0]->pt()>isoElecs[0]->pt() ){
-	      fill("dEtaLep1MET_" , isoMuons[0]->eta()-met->begin()->eta());
-	      fill("dPhiLep1MET_" , reco::deltaPhi(isoMuons[0]->phi(), met->begin()->phi()));
+	      fill(DETA_LEP1_MET, isoMuons[0]->eta()-met->begin()->eta());
+	      fill(DPHI_LEP1_MET, reco::deltaPhi(isoMuons[0]->phi(), met->begin()->phi()));
 	    } 
 	  }
 	  if( !isoElecs.empty() ){
 	    if( isoMuons.empty() || isoElecs[0]->pt()>isoMuons[0]->pt() ){
-	      fill("dEtaLep1MET_" , isoElecs[0]->eta()-met->begin()->eta());
-	      fill("dPhiLep1MET_" , reco::deltaPhi(isoElecs[0]->phi(), met->begin()->phi()));
+	      fill(DETA_LEP1_MET, isoElecs[0]->eta()-met->begin()->eta());
+	      fill(DPHI_LEP1_MET, reco::deltaPhi(isoElecs[0]->phi(), met->begin()->phi()));
 	    }
 	  }
 	}
-	if(idx==1){ fill("metTC_"   , met->begin()->et());}
-	if(idx==2){ fill("metPflow_", met->begin()->et());}
+	if(idx==1){ fill(MET_TC, met->begin()->et());}
+	if(idx==2){ fill(MET_PFLOW, met->begin()->et());}
+      }
+    }
+
+    // write the event to the export (if configured)
+    if( export_ ){
+      for(ArenaVector<const reco::Muon*>::type::const_iterator muon=isoMuons.begin(); muon!=isoMuons.end(); ++muon){
+	export_->push(columns_[MUON_PT_COL], (*muon)->pt ()); export_->push(columns_[MUON_ETA_COL   ], (*muon)->eta   ());
+	export_->push(columns_[MUON_PHI_COL], (*muon)->phi()); export_->push(columns_[MUON_CHARGE_COL], (*muon)->charge());
+      }
+      for(ArenaVector<const reco::GsfElectron*>::type::const_iterator elec=isoElecs.begin(); elec!=isoElecs.end(); ++elec){
+	export_->push(columns_[ELEC_PT_COL], (*elec)->pt ()); export_->push(columns_[ELEC_ETA_COL   ], (*elec)->eta   ());
+	export_->push(columns_[ELEC_PHI_COL], (*elec)->phi()); export_->push(columns_[ELEC_CHARGE_COL], (*elec)->charge());
+      }
+      export_->set(columns_[JET_MULT_COL], mult);
+      for(ArenaVector<reco::Jet>::type::const_iterator jet=leadingJets.begin(); jet!=leadingJets.end(); ++jet){
+	export_->push(columns_[JET_PT_COL], jet->pt()); export_->push(columns_[JET_ETA_COL], jet->eta()); export_->push(columns_[JET_PHI_COL], jet->phi());
+      }
+      for(std::vector<edm::InputTag>::const_iterator met_=mets_.begin(); met_!=mets_.end(); ++met_){
+	edm::Handle<edm::View<reco::MET> > met;
+	bool found=event.getByLabel(*met_, met) && met->begin()!=met->end();
+	export_->push(columns_[MET_ET_COL ], found ? met->begin()->et () : -1.);
+	export_->push(columns_[MET_PHI_COL], found ? met->begin()->phi() : -1.);
       }
+      DecayChannel channel=decayChannel(isoMuons, isoElecs); double massLL=-1.;
+      if( channel==DIMUON ) massLL=(isoMuons[0]->p4()+isoMuons[1]->p4()).mass();
+      if( channel==DIELEC ) massLL=(isoElecs[0]->p4()+isoElecs[1]->p4()).mass();
+      if( channel==ELECMU ) massLL=(isoElecs[0]->p4()+isoMuons[0]->p4()).mass();
+      export_->set(columns_[DECAY_CHANNEL_COL], channel);
+      export_->set(columns_[MASS_LL_COL      ], massLL );
+      export_->write(event.id());
     }
 
 
@@ -487,32 +572,32 @@ namespace TopDiLeptonOffline {
     */
 
     // check number of isolated leptons
-    fill("lepMultIso_", isoMuons.size(), isoElecs.size());
+    fill(LEP_MULT_ISO, isoMuons.size(), isoElecs.size());
     // ELECMU channel
     if( decayChannel(isoMuons, isoElecs) == ELECMU ){
-      fill("decayChannel_", 0.5);
+      fill(DECAY_CHANNEL, 0.5);
       double mass = (isoElecs[0]->p4()+isoMuons[0]->p4()).mass();
       if( (lowerEdge_==-1. && upperEdge_==-1.) || (lowerEdge_<mass && mass<upperEdge_) ){
         
-	fill("dEtaL1L2_"  , isoElecs[0]->eta()-isoMuons[0]->eta()); 
-	fill("sumEtaL1L2_", (isoElecs[0]->eta()+isoMuons[0]->eta())/2); 
-	fill("dPhiL1L2_"  , reco::deltaPhi(isoElecs[0]->phi(), isoMuons[0]->eta())); 
-	fill("elecPt_", isoElecs[0]->pt()); fill("muonPt_", isoMuons[0]->pt()); 
-	fill("lep1Pt_", isoElecs[0]->pt()>isoMuons[0]->pt() ? isoElecs[0]->pt() : isoMuons[0]->pt());
-	fill("lep2Pt_", isoElecs[0]->pt()>isoMuons[0]->pt() ? isoMuons[0]->pt() : isoElecs[0]->pt());
+	fill(DETA_L1L2, isoElecs[0]->eta()-isoMuons[0]->eta()); 
+	fill(SUM_ETA_L1L2, (isoElecs[0]->eta()+isoMuons[0]->eta())/2); 
+	fill(DPHI_L1L2, reco::deltaPhi(isoElecs[0]->phi(), isoMuons[0]->eta())); 
+	fill(ELEC_PT, isoElecs[0]->pt()); fill(MUON_PT, isoMuons[0]->pt()); 
+	fill(LEP1_PT, isoElecs[0]->pt()>isoMuons[0]->pt() ? isoElecs[0]->pt() : isoMuons[0]->pt());
+	fill(LEP2_PT, isoElecs[0]->pt()>isoMuons[0]->pt() ? isoMuons[0]->pt() : isoElecs[0]->pt());
 	// fill plots for trigger monitoring
-	if(!triggerTable_.label().empty()) fill(event, *triggerTable, "elecMu", elecMuPaths_);
-	if(elecMuLogged_<=hists_.find("elecMuLogger_")->second->getNbinsY()){
+	if(!triggerTable_.label().empty()) fill(event, *triggerTable, ELEC_MU_MON, ELEC_MU_EFF, elecMuPaths_);
+	if(booked(ELEC_MU_LOGGER) && elecMuLogged_<=hists_[ELEC_MU_LOGGER]->getNbinsY()){
 	  // log runnumber, lumi block, event number & some
 	  // more pysics infomation for interesting events
-	  fill("elecMuLogger_", 0.5, elecMuLogged_+0.5, event.eventAuxiliary().run()); 
-	  fill("elecMuLogger_", 1.5, elecMuLogged_+0.5, event.eventAuxiliary().luminosityBlock()); 
-	  fill("elecMuLogger_", 2.5, elecMuLogged_+0.5, event.eventAuxiliary().event()); 
-	  fill("elecMuLogger_", 3.5, elecMuLogged_+0.5, isoMuons[0]->pt()); 
-	  fill("elecMuLogger_", 4.5, elecMuLogged_+0.5, isoElecs[0]->pt()); 
-	  if(leadingJets.size()>0) fill("elecMuLogger_", 5.5, elecMuLogged_+0.5, leadingJets[0].pt()); 
-	  if(leadingJets.size()>1) fill("elecMuLogger_", 6.5, elecMuLogged_+0.5, leadingJets[1].pt()); 
-	  fill("elecMuLogger_", 7.5, elecMuLogged_+0.5, caloMET.et()); 
+	  fill(ELEC_MU_LOGGER, 0.5, elecMuLogged_+0.5, event.eventAuxiliary().run()); 
+	  fill(ELEC_MU_LOGGER, 1.5, elecMuLogged_+0.5, event.eventAuxiliary().luminosityBlock()); 
+	  fill(ELEC_MU_LOGGER, 2.5, elecMuLogged_+0.5, event.eventAuxiliary().event()); 
+	  fill(ELEC_MU_LOGGER, 3.5, elecMuLogged_+0.5, isoMuons[0]->pt()); 
+	  fill(ELEC_MU_LOGGER, 4.5, elecMuLogged_+0.5, isoElecs[0]->pt()); 
+	  if(leadingJets.size()>0) fill(ELEC_MU_LOGGER, 5.5, elecMuLogged_+0.5, leadingJets[0].pt()); 
+	  if(leadingJets.size()>1) fill(ELEC_MU_LOGGER, 6.5, elecMuLogged_+0.5, leadingJets[1].pt()); 
+	  fill(ELEC_MU_LOGGER, 7.5, elecMuLogged_+0.5, caloMET.et()); 
 	  ++elecMuLogged_; 
 	}
       }
@@ -520,31 +605,31 @@ namespace TopDiLeptonOffline {
 
     // DIMUON channel
     if( decayChannel(isoMuons, isoElecs) == DIMUON ){
-      fill("decayChannel_", 1.5);
+      fill(DECAY_CHANNEL, 1.5);
       int charge = isoMuons[0]->charge()*isoMuons[1]->charge();
       double mass = (isoMuons[0]->p4()+isoMuons[1]->p4()).mass();
       
-      fill(charge<0 ? "invMass_"    : "invMassWC_"    , mass       );
-      fill(charge<0 ? "invMassLog_" : "invMassWCLog_" , log10(mass));
+      fill(charge<0 ? INV_MASS    : INV_MASS_WC    , mass       );
+      fill(charge<0 ? INV_MASS_LOG : INV_MASS_WC_LOG , log10(mass));
       if((lowerEdge_==-1. && upperEdge_==-1.) || (lowerEdge_<mass && mass<upperEdge_) ){
-        fill("dEtaL1L2_"  , isoMuons[0]->eta()-isoMuons[1]->eta() );
-	fill("sumEtaL1L2_", (isoMuons[0]->eta()+isoMuons[1]->eta())/2);
-	fill("dPhiL1L2_", reco::deltaPhi(isoMuons[0]->phi(),isoMuons[1]->phi()) );
-	fill("muonPt_", isoMuons[0]->pt()); fill("muonPt_", isoMuons[1]->pt()); 
-	fill("lep1Pt_", isoMuons[0]->pt()); fill("lep2Pt_", isoMuons[1]->pt()); 
+        fill(DETA_L1L2, isoMuons[0]->eta()-isoMuons[1]->eta() );
+	fill(SUM_ETA_L1L2, (isoMuons[0]->eta()+isoMuons[1]->eta())/2);
+	fill(DPHI_L1L2, reco::deltaPhi(isoMuons[0]->phi(),isoMuons[1]->phi()) );
+	fill(MUON_PT, isoMuons[0]->pt()); fill(MUON_PT, isoMuons[1]->pt()); 
+	fill(LEP1_PT, isoMuons[0]->pt()); fill(LEP2_PT, isoMuons[1]->pt()); 
 	// fill plots for trigger monitoring
-	if(!triggerTable_.label().empty()) fill(event, *triggerTable, "diMuon", diMuonPaths_);
-	if(diMuonLogged_<=hists_.find("diMuonLogger_")->second->getNbinsY()){
+	if(!triggerTable_.label().empty()) fill(event, *triggerTable, DI_MUON_MON, DI_MUON_EFF, diMuonPaths_);
+	if(booked(DI_MUON_LOGGER) && diMuonLogged_<=hists_[DI_MUON_LOGGER]->getNbinsY()){
 	  // log runnumber, lumi block, event number & some
 	  // more pysics infomation for interesting events
-	  fill("diMuonLogger_", 0.5, diMuonLogged_+0.5, event.eventAuxiliary().run()); 
-	  fill("diMuonLogger_", 1.5, diMuonLogged_+0.5, event.eventAuxiliary().luminosityBlock()); 
-	  fill("diMuonLogger_", 2.5, diMuonLogged_+0.5, event.eventAuxiliary().event()); 
-	  fill("diMuonLogger_", 3.5, diMuonLogged_+0.5, isoMuons[0]->pt()); 
-	  fill("diMuonLogger_", 4.5, diMuonLogged_+0.5, isoMuons[1]->pt()); 
-	  if(leadingJets.size()>0) fill("diMuonLogger_", 5.5, diMuonLogged_+0.5, leadingJets[0].pt()); 
-	  if(leadingJets.size()>1) fill("diMuonLogger_", 6.5, diMuonLogged_+0.5, leadingJets[1].pt()); 
-	  fill("diMuonLogger_", 7.5, diMuonLogged_+0.5, caloMET.et()); 
+	  fill(DI_MUON_LOGGER, 0.5, diMuonLogged_+0.5, event.eventAuxiliary().run()); 
+	  fill(DI_MUON_LOGGER, 1.5, diMuonLogged_+0.5, event.eventAuxiliary().luminosityBlock()); 
+	  fill(DI_MUON_LOGGER, 2.5, diMuonLogged_+0.5, event.eventAuxiliary().event()); 
+	  fill(DI_MUON_LOGGER, 3.5, diMuonLogged_+0.5, isoMuons[0]->pt()); 
+	  fill(DI_MUON_LOGGER, 4.5, diMuonLogged_+0.5, isoMuons[1]->pt()); 
+	  if(leadingJets.size()>0) fill(DI_MUON_LOGGER, 5.5, diMuonLogged_+0.5, leadingJets[0].pt()); 
+	  if(leadingJets.size()>1) fill(DI_MUON_LOGGER, 6.5, diMuonLogged_+0.5, leadingJets[1].pt()); 
+	  fill(DI_MUON_LOGGER, 7.5, diMuonLogged_+0.5, caloMET.et()); 
 	  ++diMuonLogged_; 
 	}
       }
@@ -552,28 +637,28 @@ namespace TopDiLeptonOffline {
 
     // DIELEC channel
     if( decayChannel(isoMuons, isoElecs) == DIELEC ){
-      fill("decayChannel_", 2.5);
+      fill(DECAY_CHANNEL, 2.5);
       int charge = isoElecs[0]->charge()*isoElecs[1]->charge();
       double mass = (isoElecs[0]->p4()+isoElecs[1]->p4()).mass();
-      fill(charge<0 ? "invMass_"    : "invMassWC_"    , mass       );
-      fill(charge<0 ? "invMassLog_" : "invMassWCLog_" , log10(mass));
+      fill(charge<0 ? INV_MASS    : INV_MASS_WC    , mass       );
+      fill(charge<0 ? INV_MASS_LOG : INV_MASS_WC_LOG , log10(mass));
       if((lowerEdge_==-1. && upperEdge_==-1.) || (lowerEdge_<mass && mass<upperEdge_) ){
-	fill("dEtaL1L2_"  , isoElecs[0]->eta()-isoElecs[1]->eta() );
-	fill("sumEtaL1L2_", (isoElecs[0]->eta()+isoElecs[1]->eta())/2);
-	fill("dPhiL1L2_"  , reco::deltaPhi(isoElecs[0]->phi(),isoElecs[1]->phi()) );
-	fill("elecPt_", isoElecs[0]->pt()); fill("elecPt_", isoElecs[1]->pt()); 
-	fill("lep1Pt_", isoElecs[0]->pt()); fill("lep2Pt_", isoElecs[1]->pt()); 
-	if(diElecLogged_<=hists_.find("diElecLogger_")->second->getNbinsY()){
+	fill(DETA_L1L2, isoElecs[0]->eta()-isoElecs[1]->eta() );
+	fill(SUM_ETA_L1L2, (isoElecs[0]->eta()+isoElecs[1]->eta())/2);
+	fill(DPHI_L1L2, reco::deltaPhi(isoElecs[0]->phi(),isoElecs[1]->phi()) );
+	fill(ELEC_PT, isoElecs[0]->pt()); fill(ELEC_PT, isoElecs[1]->pt()); 
+	fill(LEP1_PT, isoElecs[0]->pt()); fill(LEP2_PT, isoElecs[1]->pt()); 
+	if(booked(DI_ELEC_LOGGER) && diElecLogged_<=hists_[DI_ELEC_LOGGER]->getNbinsY()){
 	  // log runnumber, lumi block, event number & some
 	  // more pysics infomation for interesting events
-	  fill("diElecLogger_", 0.5, diElecLogged_+0.5, event.eventAuxiliary().run()); 
-	  fill("diElecLogger_", 1.5, diElecLogged_+0.5, event.eventAuxiliary().luminosityBlock()); 
-	  fill("diElecLogger_", 2.5, diElecLogged_+0.5, event.eventAuxiliary().event()); 
-	  fill("diElecLogger_", 3.5, diElecLogged_+0.5, isoElecs[0]->pt()); 
-	  fill("diElecLogger_", 4.5, diElecLogged_+0.5, isoElecs[1]->pt()); 
-	  if(leadingJets.size()>0) fill("diElecLogger_", 5.5, diElecLogged_+0.5, leadingJets[0].pt()); 
-	  if(leadingJets.size()>1) fill("diElecLogger_", 6.5, diElecLogged_+0.5, leadingJets[1].pt()); 
-	  fill("diElecLogger_", 7.5, diElecLogged_+0.5, caloMET.et()); 
+	  fill(DI_ELEC_LOGGER, 0.5, diElecLogged_+0.5, event.eventAuxiliary().run()); 
+	  fill(DI_ELEC_LOGGER, 1.5, diElecLogged_+0.5, event.eventAuxiliary().luminosityBlock()); 
+	  fill(DI_ELEC_LOGGER, 2.5, diElecLogged_+0.5, event.eventAuxiliary().event()); 
+	  fill(DI_ELEC_LOGGER, 3.5, diElecLogged_+0.5, isoElecs[0]->pt()); 
+	  fill(DI_ELEC_LOGGER, 4.5, diElecLogged_+0.5, isoElecs[1]->pt()); 
+	  if(leadingJets.size()>0) fill(DI_ELEC_LOGGER, 5.5, diElecLogged_+0.5, leadingJets[0].pt()); 
+	  if(leadingJets.size()>1) fill(DI_ELEC_LOGGER, 6.5, diElecLogged_+0.5, leadingJets[1].pt()); 
+	  fill(DI_ELEC_LOGGER, 7.5, diElecLogged_+0.5, caloMET.et()); 
 	  ++diElecLogged_; 
 	}
       }
@@ -582,7 +667,7 @@ namespace TopDiLeptonOffline {
   
 }
 
-TopDiLeptonOfflineDQM::TopDiLeptonOfflineDQM(const edm::ParameterSet& cfg): triggerTable_(""), vertex_(""), vertexSelect_(0), beamspotSelect_(0)
+TopDiLeptonOfflineDQM::TopDiLeptonOfflineDQM(const edm::ParameterSet& cfg): triggerTable_(""), vertex_(""), vertexSelect_(0), beamspotSelect_(0), histograms_(0), timing_(0), export_(0)
 {
   // configure the preselection
   edm::ParameterSet presel=cfg.getParameter<edm::ParameterSet>("preselection");
@@ -602,17 +687,73 @@ TopDiLeptonOfflineDQM::TopDiLeptonOfflineDQM(const edm::ParameterSet& cfg): trig
     beamspotSelect_= new StringCutObjectSelector<reco::BeamSpot>(beamspot.getParameter<std::string>("select"));
   }
 
+  // the histogram definitions are parsed once and shared by
+  // all MonitorEnsembles; modifications of the compiled-in 
+  // defaults are optional
+  edm::ParameterSet setup=cfg.getParameter<edm::ParameterSet>("setup");
+  std::vector<edm::ParameterSet> histograms;
+  if( setup.existsAs<edm::ParameterSet>("monitoring") ){
+    edm::ParameterSet monitoring=setup.getParameter<edm::ParameterSet>("monitoring");
+    if( monitoring.existsAs<std::vector<edm::ParameterSet> >("histograms") ){
+      histograms= monitoring.getParameter<std::vector<edm::ParameterSet> >("histograms");
+    }
+  }
+  histograms_= new HistogramTable(TopDiLeptonOffline::MonitorEnsemble::defaults(), histograms);
+
   // conifgure the selection
   std::vector<edm::ParameterSet> sel=cfg.getParameter<std::vector<edm::ParameterSet> >("selection");
+  // share the selection steps with the other modules if the
+  // SelectionGraph service is available, keep them local else
+  edm::Service<SelectionGraph> graph;
+  selectionGraph_= graph.isAvailable() ? &(*graph) : &localGraph_;
   for(unsigned int i=0; i<sel.size(); ++i){
     selectionOrder_.push_back(sel.at(i).getParameter<std::string>("label"));
-    selection_[selectionStep(selectionOrder_.back())] = std::make_pair(sel.at(i), new TopDiLeptonOffline::MonitorEnsemble(selectionStep(selectionOrder_.back()).c_str(), cfg.getParameter<edm::ParameterSet>("setup")));
+    selection_[selectionStep(selectionOrder_.back())] = std::make_pair(sel.at(i), new TopDiLeptonOffline::MonitorEnsemble(selectionStep(selectionOrder_.back()).c_str(), setup, histograms_));
+    selection_[selectionStep(selectionOrder_.back())].second->useArena(&arena_);
+    // register the selection step with the shared selection graph
+    std::string type=objectType(selectionOrder_.back());
+    if(selectionGraph_->supports(type)){
+      selectionIds_[selectionStep(selectionOrder_.back())] = selectionGraph_->subscribe(type, sel.at(i));
+    }
   }
+  // configure the timing and rejection monitoring of the
+  // selection steps; it is optional and sampled every Nth
+  // event (the accept/reject counters are filled always)
+  if( cfg.existsAs<edm::ParameterSet>("timing") ){
+    std::vector<std::string> steps;
+    for(unsigned int i=0; i<selectionOrder_.size(); ++i){ steps.push_back(selectionStep(selectionOrder_[i])); }
+    timing_= new SelectionTiming(cfg.getParameter<edm::ParameterSet>("setup").getParameter<std::string>("directory"), steps, cfg.getParameter<edm::ParameterSet>("timing").getParameter<unsigned int>("sampling"));
+  }
+  // configure the export of the events passing the last
+  // selection step into a columnar file; it is optional, 
+  // compression is optional (zlib at level 1 per default)
+  if( cfg.existsAs<edm::ParameterSet>("eventExport") && !selectionOrder_.empty() ){
+    edm::ParameterSet eventExport=cfg.getParameter<edm::ParameterSet>("eventExport");
+    int compression= eventExport.existsAs<int>("compression") ? eventExport.getParameter<int>("compression") : 1;
+    export_= new EventExport(eventExport.getParameter<std::string>("fileName"), "TopDiLeptonOfflineDQM", compression);
+    selection_[selectionStep(selectionOrder_.back())].second->exportTo(export_);
+  }
+}
+
+bool
+TopDiLeptonOfflineDQM::select(const std::string& key, const edm::Event& event, const edm::EventSetup& setup)
+{
+  SelectionTiming::Clock clock(timing_, key, SelectionTiming::SELECT);
+  return clock.passed(selectionGraph_->select(selectionIds_[key], event, setup));
+}
+
+void
+TopDiLeptonOfflineDQM::fill(const std::string& key, const edm::Event& event, const edm::EventSetup& setup)
+{
+  SelectionTiming::Clock clock(timing_, key, SelectionTiming::FILL);
+  selection_[key].second->fill(event, setup);
 }
 
 void 
 TopDiLeptonOfflineDQM::analyze(const edm::Event& event, const edm::EventSetup& setup)
 { 
+  // the per-event containers of the previous event are gone
+  arena_.reset();
   if(!triggerTable_.label().empty()){
     edm::Handle<edm::TriggerResults> triggerTable;
     if( !event.getByLabel(triggerTable_, triggerTable) ) return;
@@ -628,47 +769,43 @@ TopDiLeptonOfflineDQM::analyze(const edm::Event& event, const edm::EventSetup& s
     if( !event.getByLabel(beamspot_, beamspot) ) return;
     if(!(*beamspotSelect_)(*beamspot)) return;
   }
-  // apply selection steps
+  // apply selection steps; each unique step is evaluated
+  // only once per event and shared with all other modules
+  if( timing_ ) timing_->next();
   for(std::vector<std::string>::const_iterator selIt=selectionOrder_.begin(); selIt!=selectionOrder_.end(); ++selIt){
     std::string key = selectionStep(*selIt), type = objectType(*selIt);
     if(selection_.find(key)!=selection_.end()){
       if(type=="empty"){
-	selection_[key].second->fill(event, setup);
+	fill(key, event, setup);
       }
       if(type=="muons"){
-	SelectionStep<reco::Muon> step(selection_[key].first);
-	if(step.select(event)){
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){
+	  fill(key, event, setup);
 	} else break;
       }
       if(type=="elecs"){
-	SelectionStep<reco::GsfElectron> step(selection_[key].first);
-	if(step.select(event)){ 
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ 
+	  fill(key, event, setup);
 	} else break;
       }
       if(type=="jets" ){
-	SelectionStep<reco::Jet> step(selection_[key].first);
-	if(step.select(event, setup)){
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){
+	  fill(key, event, setup);
 	} else break;
       }
       if(type=="jets/pf" ){
-	SelectionStep<reco::PFJet> step(selection_[key].first);
-	if(step.select(event, setup)){
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){
+	  fill(key, event, setup);
 	} else break;
       }
       if(type=="jets/calo" ){
-	SelectionStep<reco::CaloJet> step(selection_[key].first);
-	if(step.select(event, setup)){
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){
+	  fill(key, event, setup);
 	} else break;
       }
       if(type=="met" ){
-	SelectionStep<reco::MET> step(selection_[key].first);
-	if(step.select(event)){
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){
+	  fill(key, event, setup);
 	} else break;
       }
     }
@@ -11,6 +11,10 @@
 #include "DataFormats/Math/interface/deltaR.h"
 #include "DataFormats/JetReco/interface/Jet.h"
 #include "DQM/Physics/interface/TopDQMHelpers.h"
+#include "DQM/Physics/interface/EventExport.h"
+#include "DQM/Physics/interface/EventArena.h"
+#include "DQM/Physics/interface/AssociationTable.h"
+#include "DQM/Physics/interface/HistogramTable.h"
 #include "DataFormats/MuonReco/interface/Muon.h"
 #include "DataFormats/Common/interface/ValueMap.h"
 #include "DataFormats/METReco/interface/CaloMET.h"
@@ -31,7 +35,15 @@
    not contain much more than 10 histograms though in the STANDARD configuration, as these 
    histograms will be monitored at each SelectionStep. Monitoring of histograms after selec-
    tion steps within the same object collection needs to be implemented within the Monitor-
-   Ensemble. It will not be covered by the SelectionStep class.
+   Ensemble. It will not be covered by the SelectionStep class. If an EventExport is attached
+   via _exportTo_ the isolated leptons, the leading jets, the MET, the decay channel and the
+   dilepton mass of each filled event are written to it. The per-event containers of the
+   isolated leptons and of the leading jets are taken from the EventArena given via
+   _useArena_, if any. The electronId and the jetID are resolved once per event into
+   AssociationTables aligned with the electron and jet collections. The histograms are
+   defined in a HistogramTable, which is shared by all MonitorEnsembles of the module; its
+   slots follow the enumeration _Histogram_ and are used to fill the histograms without
+   any look up by name.
 */
 
 namespace TopDiLeptonOffline {
@@ -45,10 +57,18 @@ namespace TopDiLeptonOffline {
     typedef reco::LeafCandidate::LorentzVector LorentzVector;
     /// different decay channels
     enum DecayChannel{ NONE, DIMUON, DIELEC, ELECMU };
+    /// slots of the histograms in the HistogramTable (in the
+    /// order of the compiled-in defaults)
+    enum Histogram{ RUN_NUMB, INV_MASS, INV_MASS_LOG, INV_MASS_WC, INV_MASS_WC_LOG, DECAY_CHANNEL, ELEC_MU_EFF, ELEC_MU_MON,
+		    DI_MUON_EFF, DI_MUON_MON, LEP1_PT, LEP2_PT, JET_MULT, MET_CALO, SUM_ETA_L1L2, DETA_L1L2, DPHI_L1L2, ELEC_PT,
+		    ELEC_REL_ISO, MUON_PT, MUON_REL_ISO, JET1_PT, JET2_PT, MET_PFLOW, MET_TC, MUON_DEL_Z, MUON_DEL_XY, LEP_MULT_ISO,
+		    ELEC_MULT_ISO, MUON_MULT_ISO, MUON_CAL_ISO, MUON_TRK_ISO, ELEC_CAL_ISO, ELEC_TRK_ISO, JET1_ETA, JET2_ETA,
+		    JET1_PT_RAW, JET2_PT_RAW, DETA_JET1_JET2, DETA_JET1_LEP1, DETA_LEP1_MET, DETA_JET1_MET, DPHI_JET1_JET2,
+		    DPHI_JET1_LEP1, DPHI_LEP1_MET, DPHI_JET1_MET, DI_MUON_LOGGER, DI_ELEC_LOGGER, ELEC_MU_LOGGER, NHISTOGRAMS };
     
   public:
-    /// default contructor
-    MonitorEnsemble(const char* label, const edm::ParameterSet& cfg);
+    /// default contructor; the HistogramTable is not owned
+    MonitorEnsemble(const char* label, const edm::ParameterSet& cfg, const HistogramTable* table);
     /// default destructor
     ~MonitorEnsemble(){};
     
@@ -56,8 +76,18 @@ namespace TopDiLeptonOffline {
     void book(std::string directory);
     /// fill monitor histograms with electronId and jetCorrections
     void fill(const edm::Event& event, const edm::EventSetup& setup);
+    /// register the columns with _out_ and write each filled event to it (not owned)
+    void exportTo(EventExport* out);
+    /// take the per-event containers from _arena_ (not owned; 0 for the heap)
+    void useArena(EventArena* arena){ arena_=arena; };
+    /// compiled-in histogram definitions in the order of _Histogram_
+    static std::vector<HistogramTable::Entry> defaults();
 
   private:
+    /// columns of the event export
+    enum Column{ MUON_PT_COL, MUON_ETA_COL, MUON_PHI_COL, MUON_CHARGE_COL, ELEC_PT_COL, ELEC_ETA_COL, ELEC_PHI_COL, ELEC_CHARGE_COL, 
+		 JET_MULT_COL, JET_PT_COL, JET_ETA_COL, JET_PHI_COL, MET_ET_COL, MET_PHI_COL, DECAY_CHANNEL_COL, MASS_LL_COL, NCOLUMNS };
+
     /// deduce monitorPath from label, the label is expected
     /// to be of type 'selectionPath:monitorPath'
     std::string monitorPath(const std::string& label) const { return label.substr(label.find(':')+1); };  
@@ -65,23 +95,24 @@ namespace TopDiLeptonOffline {
     /// expected to be of type 'selectionPath:monitorPath' 
     std::string selectionPath(const std::string& label) const { return label.substr(0, label.find(':')); };  
     /// determine dileptonic decay channel 
-    DecayChannel decayChannel(const std::vector<const reco::Muon*>& muons, const std::vector<const reco::GsfElectron*>& elecs) const;
+    DecayChannel decayChannel(const ArenaVector<const reco::Muon*>::type& muons, const ArenaVector<const reco::GsfElectron*>::type& elecs) const;
 
     /// set labels for event logging histograms
-    void loggerBinLabels(std::string hist);
+    void loggerBinLabels(Histogram hist);
     /// set configurable labels for trigger monitoring histograms
-    void triggerBinLabels(std::string channel, const std::vector<std::string> labels);
+    /// (occupancy _mon_ and efficiency _eff_ of a channel)
+    void triggerBinLabels(Histogram mon, Histogram eff, const std::vector<std::string> labels);
     /// fill trigger monitoring histograms
-    void fill(const edm::Event& event, const edm::TriggerResults& triggerTable, std::string channel, const std::vector<std::string> labels) const;
+    void fill(const edm::Event& event, const edm::TriggerResults& triggerTable, Histogram mon, Histogram eff, const std::vector<std::string> labels) const;
 
     /// check if histogram was booked
-    bool booked(const std::string histName) const { return hists_.find(histName.c_str())!=hists_.end(); };
+    bool booked(Histogram slot) const { return hists_[slot]!=0; };
     /// fill histogram if it had been booked before
-    void fill(const std::string histName, double value) const { if(booked(histName.c_str())) hists_.find(histName.c_str())->second->Fill(value); };
+    void fill(Histogram slot, double value) const { if(booked(slot)) hists_[slot]->Fill(value); };
     /// fill histogram if it had been booked before (2-dim version)
-    void fill(const std::string histName, double xValue, double yValue) const { if(booked(histName.c_str())) hists_.find(histName.c_str())->second->Fill(xValue, yValue); };
+    void fill(Histogram slot, double xValue, double yValue) const { if(booked(slot)) hists_[slot]->Fill(xValue, yValue); };
     /// fill histogram if it had been booked before (2-dim version)
-    void fill(const std::string histName, double xValue, double yValue, double zValue) const { if(booked(histName.c_str())) hists_.find(histName.c_str())->second->Fill(xValue, yValue, zValue); };
+    void fill(Histogram slot, double xValue, double yValue, double zValue) const { if(booked(slot)) hists_[slot]->Fill(xValue, yValue, zValue); };
 
   private:
     /// verbosity level for booking
@@ -140,62 +171,77 @@ namespace TopDiLeptonOffline {
     int elecMuLogged_, diMuonLogged_, diElecLogged_;
     /// storage manager
     DQMStore* store_;
-    /// histogram container  
-    std::map<std::string,MonitorElement*> hists_;
+    /// histogram definitions (not owned)
+    const HistogramTable* table_;
+    /// histogram container indexed by the slots of the
+    /// HistogramTable (0 for histograms, which are not booked)
+    std::vector<MonitorElement*> hists_;
+    /// event export (not owned; 0 if not exported) and its column indices
+    EventExport* export_;
+    std::vector<unsigned int> columns_;
+    /// arena of the per-event containers (not owned; 0 for the heap)
+    EventArena* arena_;
+    /// electronId and jetID of the current event in the 
+    /// order of the electron and jet collections
+    AssociationTable<float> electronIds_;
+    AssociationTable<reco::JetID> jetIDs_;
   };
 
   inline void 
-  MonitorEnsemble::loggerBinLabels(std::string hist)
+  MonitorEnsemble::loggerBinLabels(Histogram hist)
   {
+    if( !booked(hist) ) return;
     // set axes titles for selected events
-    hists_[hist.c_str()]->getTH1()->SetOption("TEXT");
-    hists_[hist.c_str()]->setBinLabel( 1 , "Run"             , 1);
-    hists_[hist.c_str()]->setBinLabel( 2 , "Block"           , 1);
-    hists_[hist.c_str()]->setBinLabel( 3 , "Event"           , 1);
-    hists_[hist.c_str()]->setBinLabel( 6 , "pt_{L2L3}(jet1)" , 1);
-    hists_[hist.c_str()]->setBinLabel( 7 , "pt_{L2L3}(jet2)" , 1);
-    hists_[hist.c_str()]->setBinLabel( 8 , "MET_{Calo}"      , 1);
-    hists_[hist.c_str()]->setAxisTitle("logged evts"         , 2);
-
-    if(hist=="diMuonLogger_"){
-      hists_[hist.c_str()]->setBinLabel( 4 , "pt(muon)" , 1);
-      hists_[hist.c_str()]->setBinLabel( 5 , "pt(muon)" , 1);
+    hists_[hist]->getTH1()->SetOption("TEXT");
+    hists_[hist]->setBinLabel( 1 , "Run"             , 1);
+    hists_[hist]->setBinLabel( 2 , "Block"           , 1);
+    hists_[hist]->setBinLabel( 3 , "Event"           , 1);
+    hists_[hist]->setBinLabel( 6 , "pt_{L2L3}(jet1)" , 1);
+    hists_[hist]->setBinLabel( 7 , "pt_{L2L3}(jet2)" , 1);
+    hists_[hist]->setBinLabel( 8 , "MET_{Calo}"      , 1);
+    hists_[hist]->setAxisTitle("logged evts"         , 2);
+
+    if(hist==DI_MUON_LOGGER){
+      hists_[hist]->setBinLabel( 4 , "pt(muon)" , 1);
+      hists_[hist]->setBinLabel( 5 , "pt(muon)" , 1);
     }
-    if(hist=="diElecLogger_"){
-      hists_[hist.c_str()]->setBinLabel( 4 , "pt(elec)" , 1);
-      hists_[hist.c_str()]->setBinLabel( 5 , "pt(elec)" , 1);
+    if(hist==DI_ELEC_LOGGER){
+      hists_[hist]->setBinLabel( 4 , "pt(elec)" , 1);
+      hists_[hist]->setBinLabel( 5 , "pt(elec)" , 1);
     }
-    if(hist=="elecMuLogger_"){
-      hists_[hist.c_str()]->setBinLabel( 4 , "pt(elec)" , 1);
-      hists_[hist.c_str()]->setBinLabel( 5 , "pt(muon)" , 1);
+    if(hist==ELEC_MU_LOGGER){
+      hists_[hist]->setBinLabel( 4 , "pt(elec)" , 1);
+      hists_[hist]->setBinLabel( 5 , "pt(muon)" , 1);
     }
   }
 
   inline void 
-  MonitorEnsemble::triggerBinLabels(std::string channel, const std::vector<std::string> labels)
+  MonitorEnsemble::triggerBinLabels(Histogram mon, Histogram eff, const std::vector<std::string> labels)
   {
+    if( !booked(mon) || !booked(eff) ) return;
     for(unsigned int idx=0; idx<labels.size(); ++idx){
-      hists_[(channel+"Mon_").c_str()]->setBinLabel( idx+1, "["+monitorPath(labels[idx])+"]", 1);
-      hists_[(channel+"Eff_").c_str()]->setBinLabel( idx+1, "["+selectionPath(labels[idx])+"]|["+monitorPath(labels[idx])+"]", 1);
+      hists_[mon]->setBinLabel( idx+1, "["+monitorPath(labels[idx])+"]", 1);
+      hists_[eff]->setBinLabel( idx+1, "["+selectionPath(labels[idx])+"]|["+monitorPath(labels[idx])+"]", 1);
     }
   }
 
   inline void 
-  MonitorEnsemble::fill(const edm::Event& event, const edm::TriggerResults& triggerTable, std::string channel, const std::vector<std::string> labels) const
+  MonitorEnsemble::fill(const edm::Event& event, const edm::TriggerResults& triggerTable, Histogram mon, Histogram eff, const std::vector<std::string> labels) const
   {
+    if( !booked(mon) || !booked(eff) ) return;
     for(unsigned int idx=0; idx<labels.size(); ++idx){
       if( accept(event, triggerTable, monitorPath(labels[idx])) ){
-	fill((channel+"Mon_").c_str(), idx+0.5 );
+	fill(mon, idx+0.5 );
 	// take care to fill triggerMon_ before evts is being called
-	int evts = hists_.find((channel+"Mon_").c_str())->second->getBinContent(idx+1);
-	double value = hists_.find((channel+"Eff_").c_str())->second->getBinContent(idx+1);
-	fill((channel+"Eff_").c_str(), idx+0.5, 1./evts*(accept(event, triggerTable, selectionPath(labels[idx]))-value));
+	int evts = hists_[mon]->getBinContent(idx+1);
+	double value = hists_[eff]->getBinContent(idx+1);
+	fill(eff, idx+0.5, 1./evts*(accept(event, triggerTable, selectionPath(labels[idx]))-value));
       }
     }
   }
   
   inline MonitorEnsemble::DecayChannel
-  MonitorEnsemble::decayChannel(const std::vector<const reco::Muon*>& muons, const std::vector<const reco::GsfElectron*>& elecs) const 
+  MonitorEnsemble::decayChannel(const ArenaVector<const reco::Muon*>::type& muons, const ArenaVector<const reco::GsfElectron*>::type& elecs) const 
   {
     DecayChannel type=NONE;
     if( muons.size()>1 ){ type=DIMUON; } else if( elecs.size()>1 ){ type=DIELEC; } else if( !elecs.empty() && !muons.empty() ){ type=ELECMU; }
@@ -206,6 +252,8 @@ namespace TopDiLeptonOffline {
 
 #include <utility>
 
+#include "DQM/Physics/interface/SelectionGraph.h"
+#include "DQM/Physics/interface/SelectionTiming.h"
 #include "FWCore/Framework/interface/EDAnalyzer.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
@@ -252,6 +300,9 @@ class TopDiLeptonOfflineDQM : public edm::EDAnalyzer  {
   ~TopDiLeptonOfflineDQM(){ 
     if( beamspotSelect_ ) delete beamspotSelect_; 
     if( vertexSelect_ ) delete vertexSelect_;
+    if( timing_ ) delete timing_;
+    if( export_ ) delete export_;
+    if( histograms_ ) delete histograms_;
   }
   
   /// do this during the event loop
@@ -264,6 +315,10 @@ class TopDiLeptonOfflineDQM : public edm::EDAnalyzer  {
   /// deduce selection step from ParameterSet label, the 
   /// label is expected to be of type 'objectType:selectionStep' 
   std::string selectionStep(const std::string& label) { return label.substr(label.find(':')+1); };  
+  /// apply selection step _key_ via the shared SelectionGraph (timed if configured)
+  bool select(const std::string& key, const edm::Event& event, const edm::EventSetup& setup);
+  /// fill the MonitorEnsemble of selection step _key_ (timed if configured)
+  void fill(const std::string& key, const edm::Event& event, const edm::EventSetup& setup);
 
  private:
   /// trigger table
@@ -288,6 +343,22 @@ class TopDiLeptonOfflineDQM : public edm::EDAnalyzer  {
   /// MonitoringEnsemble keeps an instance of the MonitorEnsemble class to 
   /// be filled _after_ each selection step
     std::map<std::string, std::pair<edm::ParameterSet, TopDiLeptonOffline::MonitorEnsemble*> > selection_;
+    /// selection graph the selection steps are registered with; this is the
+    /// SelectionGraph service if available and _localGraph_ otherwise
+    SelectionGraph* selectionGraph_;
+    SelectionGraph localGraph_;
+    /// ids of the selection steps in the selection graph (for all
+    /// selection step types supported by the SelectionGraph)
+    std::map<std::string, unsigned int> selectionIds_;
+    /// histogram definitions shared by all MonitorEnsembles
+    HistogramTable* histograms_;
+    /// timing and rejection monitoring of the selection steps (optional)
+    SelectionTiming* timing_;
+    /// export of the events passing the last selection step (optional)
+    EventExport* export_;
+    /// memory of the per-event containers of the MonitorEnsembles; 
+    /// reset at the beginning of each event
+    EventArena arena_;
 };
 
 #endif
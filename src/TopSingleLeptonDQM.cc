@@ -3,7 +3,11 @@
 #include "DataFormats/BTauReco/interface/JetTag.h"
 #include "DataFormats/JetReco/interface/PFJet.h"
 #include "DQM/Physics/src/TopSingleLeptonDQM.h"
+#include "FWCore/Framework/interface/Run.h"
+#include "FWCore/Framework/interface/LuminosityBlock.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "DataFormats/Math/interface/deltaR.h"
+#include "FWCore/Utilities/interface/Exception.h"
 #include <iostream>
 using namespace std;
 namespace TopSingleLepton {
@@ -14,10 +18,17 @@ namespace TopSingleLepton {
   // nominal mass of the W boson to 
   // be used for the top mass estimate
   static const double WMASS = 80.4;
+  // maximal number of jets per event
+  // in the event export
+  static const unsigned int MAXEXPORTJETS = 10;
 
-  MonitorEnsemble::MonitorEnsemble(const char* label, const edm::ParameterSet& cfg) : 
-    label_(label), elecIso_(0), elecSelect_(0), pvSelect_(0), muonIso_(0), muonSelect_(0), jetIDSelect_(0), includeBTag_(false), lowerEdge_(-1.), upperEdge_(-1.), logged_(0)
+  MonitorEnsemble::MonitorEnsemble(const char* label, const edm::ParameterSet& cfg, const HistogramTable* table, BookingBudget* budget) : 
+    label_(label), elecIso_(0), elecSelect_(0), pvSelect_(0), muonIso_(0), muonSelect_(0), jetIDSelect_(0), includeBTag_(false), lowerEdge_(-1.), upperEdge_(-1.), logged_(0), lazy_(false), budget_(budget), fillBatchSize_(128), table_(table), sampled_(true), export_(0), arena_(0)
   {
+    // the slots of the table have to follow the enumeration
+    if( table_->size()!=NHISTOGRAMS ){
+      throw cms::Exception("Configuration") << "MonitorEnsemble: histogram table has " << table_->size() << " entries, expected " << NHISTOGRAMS << "\n";
+    }
     // sources have to be given; this PSet is not optional
     edm::ParameterSet sources=cfg.getParameter<edm::ParameterSet>("sources");
     muons_= sources.getParameter<edm::InputTag>("muons");
@@ -139,6 +150,24 @@ namespace TopSingleLepton {
       if(monitoring.getParameter<std::string>("verbosity") == "STANDARD")
 	verbosity_= STANDARD;
     }
+    // lazyBooking is optional; if switched on histograms are
+    // only booked when they are filled for the first time
+    // (and as long as the booking budget of the module allows)
+    if( cfg.existsAs<edm::ParameterSet>("monitoring") ){
+      edm::ParameterSet monitoring=cfg.getParameter<edm::ParameterSet>("monitoring");
+      if( monitoring.existsAs<bool>("lazyBooking") ){
+	lazy_= monitoring.getParameter<bool>("lazyBooking");
+      }
+      // fillBatchSize is optional; it defines the batch size 
+      // for buffered fills (<=1 means no batching)
+      fillBatchSize_= monitoring.getUntrackedParameter<unsigned int>("fillBatchSize", fillBatchSize_);
+      // sparseHistograms is optional; the histograms given 
+      // by their names (e.g. RunNumb_) are kept in sparse 
+      // form until the end of the run
+      if( monitoring.existsAs<std::vector<std::string> >("sparseHistograms") ){
+	sparseNames_= monitoring.getParameter<std::vector<std::string> >("sparseHistograms");
+      }
+    }
     // and don't forget to do the histogram booking
     book(cfg.getParameter<std::string>("directory"));
   }
@@ -150,142 +179,313 @@ namespace TopSingleLepton {
     std::string current(directory); current+=label_;
     store_=edm::Service<DQMStore>().operator->();
     store_->setCurrentFolder(current);
+    folder_=current;
 
     // determine number of bins for trigger monitoring
     unsigned int nPaths=triggerPaths_.size();
 
-    // --- [STANDARD] --- //
-    //Run Number
-    hists_["RunNumb_"    ] = store_->book1D("RunNumber"  , "Run Nr."          ,   1.e4,  1.5e5,    3.e5);
-    //instantaneous luminosity
-    hists_["InstLumi_"   ] = store_->book1D("InstLumi"   , "Inst. Lumi."      ,    100,     0.,    1.e3);
-    // number of selected primary vertices
-    hists_["pvMult_"     ] = store_->book1D("PvMult"     , "N_{pvs}"          ,     100,     0.,    100.);  
-    // pt of the leading muon
-    hists_["muonPt_"     ] = store_->book1D("MuonPt"     , "pt(#mu)"          ,     50,     0.,    250.);   
-    // muon multiplicity before std isolation
-    hists_["muonMult_"   ] = store_->book1D("MuonMult"   , "N_{All}(#mu)"     ,     10,     0.,     10.);   
-    // muon multiplicity after  std isolation
-    hists_["muonMultIso_"] = store_->book1D("MuonMultIso", "N_{Iso}(#mu)"     ,     10,     0.,     10.);   
-    // pt of the leading electron
-    hists_["elecPt_"     ] = store_->book1D("ElecPt"     , "pt(e)"            ,     50,     0.,    250.);   
-    // electron multiplicity before std isolation
-    hists_["elecMult_"   ] = store_->book1D("ElecMult"   , "N_{All}(e)"       ,     10,     0.,     10.);   
-    // electron multiplicity after  std isolation
-    hists_["elecMultIso_"] = store_->book1D("ElecMultIso", "N_{Iso}(e)"       ,     10,     0.,     10.);   
-    // multiplicity of jets with pt>20 (corrected to L2+L3)
-    hists_["jetMult_"    ] = store_->book1D("JetMult"    , "N_{30}(jet)"      ,     10,     0.,     10.);   
-    // trigger efficiency estimates for single lepton triggers
-    hists_["triggerEff_" ] = store_->book1D("TriggerEff" , "Eff(trigger)"     , nPaths,     0.,  nPaths);
-    // monitored trigger occupancy for single lepton triggers
-    hists_["triggerMon_" ] = store_->book1D("TriggerMon" , "Mon(trigger)"     , nPaths,     0.,  nPaths);
-    // MET (calo)
-    hists_["metCalo_"    ] = store_->book1D("METCalo"    , "MET_{Calo}"       ,     50,     0.,    200.);   
-    // W mass estimate
-    hists_["massW_"      ] = store_->book1D("MassW"      , "M(W)"             ,     60,     0.,    300.);   
-    // Top mass estimate
-    hists_["massTop_"    ] = store_->book1D("MassTop"    , "M(Top)"           ,     50,     0.,    500.);   
-    // b-tagged Top mass
-    hists_["massBTop_"   ] = store_->book1D("MassBTop"   , "M(Top, 1 b-tag)"  ,     50,     0.,    500.);
-    
+    // book all histograms of the table up to the verbosity
+    // level; histograms without binning in x are booked with
+    // one bin per trigger path
+    for(unsigned int slot=0; slot<table_->size(); ++slot){
+      const HistogramTable::Entry& hist=(*table_)[slot];
+      if( hist.level>verbosity_ ) continue;
+      int nBinsX=hist.nBinsX>0 ? hist.nBinsX : nPaths; double highX=hist.nBinsX>0 ? hist.highX : nPaths;
+      if( hist.is2D() ) book2D(hist.key, hist.name, hist.title, nBinsX, hist.lowX, highX, hist.nBinsY, hist.lowY, hist.highY);
+      else book1D(hist.key, hist.name, hist.title, nBinsX, hist.lowX, highX);
+    }
+    // prepare the fill targets of all histograms; they
+    // are resolved on first fill
+    targets_.assign(table_->size(), Target());
+
     // set bin labels for trigger monitoring
     triggerBinLabels(std::string("trigger"), triggerPaths_);
-
-    if( verbosity_==STANDARD) return;
-
-    // --- [VERBOSE] --- //
-    // eta of the leading muon
-    hists_["muonEta_"    ] = store_->book1D("MuonEta"    , "#eta(#mu)"        ,     30,    -3.,      3.);   
-    // std isolation variable of the leading muon
-    hists_["muonRelIso_" ] = store_->book1D("MuonRelIso" , "Iso_{Rel}(#mu)"   ,     50,     0.,      1.);   
-    // eta of the leading electron
-    hists_["elecEta_"    ] = store_->book1D("ElecEta"    , "#eta(e)"          ,     30,    -3.,      3.);   
-    // std isolation variable of the leading electron
-    hists_["elecRelIso_" ] = store_->book1D("ElecRelIso" , "Iso_{Rel}(e)"     ,     50,     0.,      1.);   
-    // multiplicity of btagged jets (for track counting high efficiency) with pt(L2L3)>30
-    hists_["jetMultBEff_"] = store_->book1D("JetMultBEff", "N_{30}(TCHE)"    ,     10,     0.,     10.);   
-    // btag discriminator for track counting high efficiency for jets with pt(L2L3)>30
-    hists_["jetBDiscEff_"] = store_->book1D("JetBDiscEff", "Disc_{TCHE}(jet)",     100,     0.,    10.);   
-    // eta of the 1. leading jet (corrected to L2+L3)
-    hists_["jet1Eta_"    ] = store_->book1D("Jet1Eta"    , "#eta_{L2L3}(jet1)",     60,     -3.,     3.);   
-    // pt of the 1. leading jet (corrected to L2+L3)
-    hists_["jet1Pt_"     ] = store_->book1D("Jet1Pt"     , "pt_{L2L3}(jet1)"  ,     60,     0.,    300.);   
-   // eta of the 2. leading jet (corrected to L2+L3)
-    hists_["jet2Eta_"    ] = store_->book1D("Jet2Eta"    , "#eta_{L2L3}(jet2)",     60,     -3.,     3.);   
-    // pt of the 2. leading jet (corrected to L2+L3)
-    hists_["jet2Pt_"     ] = store_->book1D("Jet2Pt"     , "pt_{L2L3}(jet2)"  ,     60,     0.,    300.);   
-   // eta of the 3. leading jet (corrected to L2+L3)
-    hists_["jet3Eta_"    ] = store_->book1D("Jet3Eta"    , "#eta_{L2L3}(jet3)",     60,     -3.,     3.);   
-    // pt of the 3. leading jet (corrected to L2+L3)
-    hists_["jet3Pt_"     ] = store_->book1D("Jet3Pt"     , "pt_{L2L3}(jet3)"  ,     60,     0.,    300.);   
-   // eta of the 4. leading jet (corrected to L2+L3)
-    hists_["jet4Eta_"    ] = store_->book1D("Jet4Eta"    , "#eta_{L2L3}(jet4)",     60,     -3.,     3.);   
-    // pt of the 4. leading jet (corrected to L2+L3)
-    hists_["jet4Pt_"     ] = store_->book1D("Jet4Pt"     , "pt_{L2L3}(jet4)"  ,     60,     0.,    300.);   
-    // MET (tc)
-    hists_["metTC_"      ] = store_->book1D("METTC"      , "MET_{TC}"         ,     50,     0.,    200.);   
-    // MET (pflow)
-    hists_["metPflow_"   ] = store_->book1D("METPflow"   , "MET_{Pflow}"      ,     50,     0.,    200.);   
-    // dz for muons (to suppress cosmis)
-    hists_["muonDelZ_"    ] = store_->book1D("MuonDelZ"  , "d_{z}(#mu)"       ,     50,   -25.,     25.);
-    // dxy for muons (to suppress cosmics)
-    hists_["muonDelXY_"   ] = store_->book2D("MuonDelXY" , "d_{xy}(#mu)"      ,     50,   -0.1,     0.1,   50,   -0.1,   0.1);
-
     // set axes titles for dxy for muons
-    hists_["muonDelXY_"   ]->setAxisTitle( "x [cm]", 1); hists_["muonDelXY_"   ]->setAxisTitle( "y [cm]", 2);
-
-    if( verbosity_==VERBOSE) return;
-
-    // --- [DEBUG] --- //
-    // relative muon isolation in tracker for the leading muon
-    hists_["muonTrkIso_" ] = store_->book1D("MuonTrkIso" , "Iso_{Trk}(#mu)"   ,     50,     0.,      1.);   
-    // relative muon isolation in ecal+hcal for the leading muon
-    hists_["muonCalIso_" ] = store_->book1D("MuonCalIso" , "Iso_{Ecal}(#mu)"  ,     50,     0.,      1.);   
-    // relative electron isolation in tracker for the leading electron
-    hists_["elecTrkIso_" ] = store_->book1D("ElecTrkIso" , "Iso_{Trk}(e)"     ,     50,     0.,      1.);   
-    // relative electron isolation in ecal+hcal for the leading electron
-    hists_["elecCalIso_" ] = store_->book1D("ElecCalIso" , "Iso_{Ecal}(e)"    ,     50,     0.,      1.);   
-    // multiplicity of btagged jets (for track counting high purity) with pt(L2L3)>30
-    hists_["jetMultBPur_"] = store_->book1D("JetMultBPur", "N_{30}(TCHP)"    ,     10,     0.,     10.);   
-    // btag discriminator for track counting high purity
-    hists_["jetBDiscPur_"] = store_->book1D("JetBDiscPur", "Disc_{TCHP}(Jet)",    100,     0.,    10.);   
-    // multiplicity of btagged jets (for simple secondary vertex) with pt(L2L3)>30
-    hists_["jetMultBVtx_"] = store_->book1D("JetMultBVtx", "N_{30}(SSVHE)"    ,    10,     0.,     10.);   
-    // btag discriminator for simple secondary vertex
-    hists_["jetBDiscVtx_"] = store_->book1D("JetBDiscVtx", "Disc_{SSVHE}(Jet)",    35,    -1.,      6.);   
-    // multiplicity for combined secondary vertex
-    hists_["jetMultCSVtx_"]= store_->book1D("JetMultCSV" , "N_{30}(CSV)"     ,      10,     0.,     10.);
-    // btag discriminator for combined secondary vertex
-    hists_["jetBCVtx_"]   = store_->book1D("JetDiscCSV"  , "Disc_{CSV}(JET)" ,     100,   -1.,      2.);
-    // pt of the 1. leading jet (uncorrected)
-    hists_["jet1PtRaw_"  ] = store_->book1D("Jet1PtRaw"  , "pt_{Raw}(jet1)"   ,     60,     0.,    300.);   
-    // pt of the 2. leading jet (uncorrected)
-    hists_["jet2PtRaw_"  ] = store_->book1D("Jet2PtRaw"  , "pt_{Raw}(jet2)"   ,     60,     0.,    300.);   
-    // pt of the 3. leading jet (uncorrected)
-    hists_["jet3PtRaw_"  ] = store_->book1D("Jet3PtRaw"  , "pt_{Raw}(jet3)"   ,     60,     0.,    300.);   
-    // pt of the 4. leading jet (uncorrected)
-    hists_["jet4PtRaw_"  ] = store_->book1D("Jet4PtRaw"  , "pt_{Raw}(jet4)"   ,     60,     0.,    300.);   
-    // selected events
-    hists_["eventLogger_"] = store_->book2D("EventLogger", "Logged Events"    ,      9,     0.,      9.,   10,   0.,   10.);
+    setAxisTitle("muonDelXY_", "x [cm]", 1); setAxisTitle("muonDelXY_", "y [cm]", 2);
 
     // set axes titles for selected events
-    hists_["eventLogger_"]->getTH1()->SetOption("TEXT");
-    hists_["eventLogger_"]->setBinLabel( 1 , "Run"             , 1);
-    hists_["eventLogger_"]->setBinLabel( 2 , "Block"           , 1);
-    hists_["eventLogger_"]->setBinLabel( 3 , "Event"           , 1);
-    hists_["eventLogger_"]->setBinLabel( 4 , "pt_{L2L3}(jet1)" , 1);
-    hists_["eventLogger_"]->setBinLabel( 5 , "pt_{L2L3}(jet2)" , 1);
-    hists_["eventLogger_"]->setBinLabel( 6 , "pt_{L2L3}(jet3)" , 1);
-    hists_["eventLogger_"]->setBinLabel( 7 , "pt_{L2L3}(jet4)" , 1);
-    hists_["eventLogger_"]->setBinLabel( 8 , "M_{W}"           , 1);
-    hists_["eventLogger_"]->setBinLabel( 9 , "M_{Top}"         , 1);
-    hists_["eventLogger_"]->setAxisTitle("logged evts"         , 2);
-    return;
+    setOption("eventLogger_", "TEXT");
+    setBinLabel("eventLogger_", 1, "Run"             , 1);
+    setBinLabel("eventLogger_", 2, "Block"           , 1);
+    setBinLabel("eventLogger_", 3, "Event"           , 1);
+    setBinLabel("eventLogger_", 4, "pt_{L2L3}(jet1)" , 1);
+    setBinLabel("eventLogger_", 5, "pt_{L2L3}(jet2)" , 1);
+    setBinLabel("eventLogger_", 6, "pt_{L2L3}(jet3)" , 1);
+    setBinLabel("eventLogger_", 7, "pt_{L2L3}(jet4)" , 1);
+    setBinLabel("eventLogger_", 8, "M_{W}"           , 1);
+    setBinLabel("eventLogger_", 9, "M_{Top}"         , 1);
+    setAxisTitle("eventLogger_", "logged evts", 2);
+  }
+
+  void
+  MonitorEnsemble::exportTo(EventExport* out)
+  {
+    export_=out; columns_.resize(NCOLUMNS);
+    columns_[PV_MULT_COL     ]=out->add("pvMult"    ); 
+    columns_[MUON_MULT_COL   ]=out->add("muonMult"  ); 
+    columns_[ELEC_MULT_COL   ]=out->add("elecMult"  ); 
+    columns_[JET_MULT_COL    ]=out->add("jetMult"   );
+    // leading muon and electron (0 if there is none)
+    columns_[MUON_PT_COL     ]=out->add("muonPt"    ); 
+    columns_[MUON_ETA_COL    ]=out->add("muonEta"   ); 
+    columns_[MUON_PHI_COL    ]=out->add("muonPhi"   ); 
+    columns_[MUON_REL_ISO_COL]=out->add("muonRelIso");
+    columns_[ELEC_PT_COL     ]=out->add("elecPt"    ); 
+    columns_[ELEC_ETA_COL    ]=out->add("elecEta"   ); 
+    columns_[ELEC_PHI_COL    ]=out->add("elecPhi"   ); 
+    columns_[ELEC_REL_ISO_COL]=out->add("elecRelIso");
+    // selected jets (corrected to L2+L3) and their CSV discriminator
+    columns_[JET_PT_COL      ]=out->add("jetPt"     , MAXEXPORTJETS);
+    columns_[JET_ETA_COL     ]=out->add("jetEta"    , MAXEXPORTJETS);
+    columns_[JET_PHI_COL     ]=out->add("jetPhi"    , MAXEXPORTJETS);
+    columns_[JET_CSV_COL     ]=out->add("jetCSV"    , MAXEXPORTJETS);
+    // one entry per MET source in the order of the configuration (-1 if not found)
+    columns_[MET_ET_COL      ]=out->add("metEt"     , mets_.size());
+    columns_[MET_PHI_COL     ]=out->add("metPhi"    , mets_.size());
+    // mass estimates (-1 if not available)
+    columns_[MASS_W_COL      ]=out->add("massW"     ); 
+    columns_[MASS_TOP_COL    ]=out->add("massTop"   ); 
+    columns_[MASS_BTOP_COL   ]=out->add("massBTop"  );
+  }
+
+  std::vector<HistogramTable::Entry>
+  MonitorEnsemble::defaults()
+  {
+    typedef HistogramTable::Entry H;
+    // key, name, title, level, binning (nBins<=0: one bin per trigger path)
+    static const H DEFAULTS[] = {
+      // --- [STANDARD] --- //
+      //Run Number
+      H("RunNumb_"      , "RunNumber"  , "Run Nr."          , STANDARD,  1.e4,  1.5e5,    3.e5),
+      //instantaneous luminosity
+      H("InstLumi_"     , "InstLumi"   , "Inst. Lumi."      , STANDARD,   100,     0.,    1.e3),
+      // number of selected primary vertices
+      H("pvMult_"       , "PvMult"     , "N_{pvs}"          , STANDARD,   100,     0.,    100.),
+      // pt of the leading muon
+      H("muonPt_"       , "MuonPt"     , "pt(#mu)"          , STANDARD,    50,     0.,    250.),
+      // muon multiplicity before std isolation
+      H("muonMult_"     , "MuonMult"   , "N_{All}(#mu)"     , STANDARD,    10,     0.,     10.),
+      // muon multiplicity after  std isolation
+      H("muonMultIso_"  , "MuonMultIso", "N_{Iso}(#mu)"     , STANDARD,    10,     0.,     10.),
+      // pt of the leading electron
+      H("elecPt_"       , "ElecPt"     , "pt(e)"            , STANDARD,    50,     0.,    250.),
+      // electron multiplicity before std isolation
+      H("elecMult_"     , "ElecMult"   , "N_{All}(e)"       , STANDARD,    10,     0.,     10.),
+      // electron multiplicity after  std isolation
+      H("elecMultIso_"  , "ElecMultIso", "N_{Iso}(e)"       , STANDARD,    10,     0.,     10.),
+      // multiplicity of jets with pt>20 (corrected to L2+L3)
+      H("jetMult_"      , "JetMult"    , "N_{30}(jet)"      , STANDARD,    10,     0.,     10.),
+      // trigger efficiency estimates for single lepton triggers
+      H("triggerEff_"   , "TriggerEff" , "Eff(trigger)"     , STANDARD,     0,     0.,      0.),
+      // monitored trigger occupancy for single lepton triggers
+      H("triggerMon_"   , "TriggerMon" , "Mon(trigger)"     , STANDARD,     0,     0.,      0.),
+      // MET (calo)
+      H("metCalo_"      , "METCalo"    , "MET_{Calo}"       , STANDARD,    50,     0.,    200.),
+      // W mass estimate
+      H("massW_"        , "MassW"      , "M(W)"             , STANDARD,    60,     0.,    300.),
+      // Top mass estimate
+      H("massTop_"      , "MassTop"    , "M(Top)"           , STANDARD,    50,     0.,    500.),
+      // b-tagged Top mass
+      H("massBTop_"     , "MassBTop"   , "M(Top, 1 b-tag)"  , STANDARD,    50,     0.,    500.),
+      // --- [VERBOSE] --- //
+      // eta of the leading muon
+      H("muonEta_"      , "MuonEta"    , "#eta(#mu)"        , VERBOSE ,    30,    -3.,      3.),
+      // std isolation variable of the leading muon
+      H("muonRelIso_"   , "MuonRelIso" , "Iso_{Rel}(#mu)"   , VERBOSE ,    50,     0.,      1.),
+      // eta of the leading electron
+      H("elecEta_"      , "ElecEta"    , "#eta(e)"          , VERBOSE ,    30,    -3.,      3.),
+      // std isolation variable of the leading electron
+      H("elecRelIso_"   , "ElecRelIso" , "Iso_{Rel}(e)"     , VERBOSE ,    50,     0.,      1.),
+      // multiplicity of btagged jets (for track counting high efficiency) with pt(L2L3)>30
+      H("jetMultBEff_"  , "JetMultBEff", "N_{30}(TCHE)"     , VERBOSE ,    10,     0.,     10.),
+      // btag discriminator for track counting high efficiency for jets with pt(L2L3)>30
+      H("jetBDiscEff_"  , "JetBDiscEff", "Disc_{TCHE}(jet)" , VERBOSE ,   100,     0.,     10.),
+      // eta of the 1. leading jet (corrected to L2+L3)
+      H("jet1Eta_"      , "Jet1Eta"    , "#eta_{L2L3}(jet1)", VERBOSE ,    60,    -3.,      3.),
+      // pt of the 1. leading jet (corrected to L2+L3)
+      H("jet1Pt_"       , "Jet1Pt"     , "pt_{L2L3}(jet1)"  , VERBOSE ,    60,     0.,    300.),
+      // eta of the 2. leading jet (corrected to L2+L3)
+      H("jet2Eta_"      , "Jet2Eta"    , "#eta_{L2L3}(jet2)", VERBOSE ,    60,    -3.,      3.),
+      // pt of the 2. leading jet (corrected to L2+L3)
+      H("jet2Pt_"       , "Jet2Pt"     , "pt_{L2L3}(jet2)"  , VERBOSE ,    60,     0.,    300.),
+      // eta of the 3. leading jet (corrected to L2+L3)
+      H("jet3Eta_"      , "Jet3Eta"    , "#eta_{L2L3}(jet3)", VERBOSE ,    60,    -3.,      3.),
+      // pt of the 3. leading jet (corrected to L2+L3)
+      H("jet3Pt_"       , "Jet3Pt"     , "pt_{L2L3}(jet3)"  , VERBOSE ,    60,     0.,    300.),
+      // eta of the 4. leading jet (corrected to L2+L3)
+      H("jet4Eta_"      , "Jet4Eta"    , "#eta_{L2L3}(jet4)", VERBOSE ,    60,    -3.,      3.),
+      // pt of the 4. leading jet (corrected to L2+L3)
+      H("jet4Pt_"       , "Jet4Pt"     , "pt_{L2L3}(jet4)"  , VERBOSE ,    60,     0.,    300.),
+      // MET (tc)
+      H("metTC_"        , "METTC"      , "MET_{TC}"         , VERBOSE ,    50,     0.,    200.),
+      // MET (pflow)
+      H("metPflow_"     , "METPflow"   , "MET_{Pflow}"      , VERBOSE ,    50,     0.,    200.),
+      // dz for muons (to suppress cosmis)
+      H("muonDelZ_"     , "MuonDelZ"   , "d_{z}(#mu)"       , VERBOSE ,    50,   -25.,     25.),
+      // dxy for muons (to suppress cosmics)
+      H("muonDelXY_"    , "MuonDelXY"  , "d_{xy}(#mu)"      , VERBOSE ,    50,   -0.1,     0.1,   50,   -0.1,   0.1),
+      // --- [DEBUG] --- //
+      // relative muon isolation in tracker for the leading muon
+      H("muonTrkIso_"   , "MuonTrkIso" , "Iso_{Trk}(#mu)"   , DEBUG   ,    50,     0.,      1.),
+      // relative muon isolation in ecal+hcal for the leading muon
+      H("muonCalIso_"   , "MuonCalIso" , "Iso_{Ecal}(#mu)"  , DEBUG   ,    50,     0.,      1.),
+      // relative electron isolation in tracker for the leading electron
+      H("elecTrkIso_"   , "ElecTrkIso" , "Iso_{Trk}(e)"     , DEBUG   ,    50,     0.,      1.),
+      // relative electron isolation in ecal+hcal for the leading electron
+      H("elecCalIso_"   , "ElecCalIso" , "Iso_{Ecal}(e)"    , DEBUG   ,    50,     0.,      1.),
+      // multiplicity of btagged jets (for track counting high purity) with pt(L2L3)>30
+      H("jetMultBPur_"  , "JetMultBPur", "N_{30}(TCHP)"     , DEBUG   ,    10,     0.,     10.),
+      // btag discriminator for track counting high purity
+      H("jetBDiscPur_"  , "JetBDiscPur", "Disc_{TCHP}(Jet)" , DEBUG   ,   100,     0.,     10.),
+      // multiplicity of btagged jets (for simple secondary vertex) with pt(L2L3)>30
+      H("jetMultBVtx_"  , "JetMultBVtx", "N_{30}(SSVHE)"    , DEBUG   ,    10,     0.,     10.),
+      // btag discriminator for simple secondary vertex
+      H("jetBDiscVtx_"  , "JetBDiscVtx", "Disc_{SSVHE}(Jet)", DEBUG   ,    35,    -1.,      6.),
+      // multiplicity for combined secondary vertex
+      H("jetMultCSVtx_" , "JetMultCSV" , "N_{30}(CSV)"      , DEBUG   ,    10,     0.,     10.),
+      // btag discriminator for combined secondary vertex
+      H("jetBCVtx_"     , "JetDiscCSV" , "Disc_{CSV}(JET)"  , DEBUG   ,   100,    -1.,      2.),
+      // pt of the 1. leading jet (uncorrected)
+      H("jet1PtRaw_"    , "Jet1PtRaw"  , "pt_{Raw}(jet1)"   , DEBUG   ,    60,     0.,    300.),
+      // pt of the 2. leading jet (uncorrected)
+      H("jet2PtRaw_"    , "Jet2PtRaw"  , "pt_{Raw}(jet2)"   , DEBUG   ,    60,     0.,    300.),
+      // pt of the 3. leading jet (uncorrected)
+      H("jet3PtRaw_"    , "Jet3PtRaw"  , "pt_{Raw}(jet3)"   , DEBUG   ,    60,     0.,    300.),
+      // pt of the 4. leading jet (uncorrected)
+      H("jet4PtRaw_"    , "Jet4PtRaw"  , "pt_{Raw}(jet4)"   , DEBUG   ,    60,     0.,    300.),
+      // selected events
+      H("eventLogger_"  , "EventLogger", "Logged Events"    , DEBUG   ,     9,     0.,      9.,   10,   0.,   10.)
+    };
+    return std::vector<H>(DEFAULTS, DEFAULTS+sizeof(DEFAULTS)/sizeof(DEFAULTS[0]));
+  }
+
+  void
+  MonitorEnsemble::book1D(const std::string& histName, const std::string& name, const std::string& title, int nBins, double low, double high)
+  {
+    define(histName, HistogramDef(folder_, name, title, nBins, low, high));
+  }
+
+  void
+  MonitorEnsemble::book2D(const std::string& histName, const std::string& name, const std::string& title, int nBinsX, double lowX, double highX, int nBinsY, double lowY, double highY)
+  {
+    define(histName, HistogramDef(folder_, name, title, nBinsX, lowX, highX, nBinsY, lowY, highY));
+  }
+
+  void
+  MonitorEnsemble::define(const std::string& key, const HistogramDef& def)
+  {
+    if( std::find(sparseNames_.begin(), sparseNames_.end(), key)!=sparseNames_.end() ){ sparse_[key]=SparseHistogram(def); return; }
+    if( lazy_ ){ pending_[key]=def; return; }
+    hists_[key]=def.book(store_);
+  }
+
+  void
+  MonitorEnsemble::setAxisTitle(const std::string& histName, const std::string& title, int axis)
+  {
+    if( sparse_.find(histName)!=sparse_.end() ){ sparse_[histName].definition().setAxisTitle(title, axis); return; }
+    if( pending_.find(histName)!=pending_.end() ){ pending_[histName].setAxisTitle(title, axis); return; }
+    if( hists_.find(histName)!=hists_.end() ) hists_[histName]->setAxisTitle(title, axis);
+  }
+
+  void
+  MonitorEnsemble::setBinLabel(const std::string& histName, int bin, const std::string& label, int axis)
+  {
+    if( sparse_.find(histName)!=sparse_.end() ){ sparse_[histName].definition().setBinLabel(bin, label, axis); return; }
+    if( pending_.find(histName)!=pending_.end() ){ pending_[histName].setBinLabel(bin, label, axis); return; }
+    if( hists_.find(histName)!=hists_.end() ) hists_[histName]->setBinLabel(bin, label, axis);
+  }
+
+  void
+  MonitorEnsemble::setOption(const std::string& histName, const std::string& option)
+  {
+    if( sparse_.find(histName)!=sparse_.end() ){ sparse_[histName].definition().setOption(option); return; }
+    if( pending_.find(histName)!=pending_.end() ){ pending_[histName].setOption(option); return; }
+    if( hists_.find(histName)!=hists_.end() ) hists_[histName]->getTH1()->SetOption(option.c_str());
+  }
+
+  MonitorElement*
+  MonitorEnsemble::book(const std::string& histName)
+  {
+    std::map<std::string,MonitorElement*>::const_iterator hist=hists_.find(histName);
+    if( hist!=hists_.end() ) return hist->second;
+    // book deferred histogram on first access; if the budget
+    // of the module is exceeded the histogram is marked as 
+    // refused (null pointer) and all its fills are dropped
+    std::map<std::string,HistogramDef>::iterator def=pending_.find(histName);
+    if( def==pending_.end() ) return 0;
+    MonitorElement* me=0;
+    if( !budget_ || budget_->request(def->second.bytes()) ){
+      me=def->second.book(store_);
+    }
+    hists_[histName]=me; pending_.erase(def);
+    return me;
+  }
+
+  void
+  MonitorEnsemble::fillBuffered(Histogram slot, double value)
+  {
+    // sparse histograms are not buffered
+    Target& hist=target(slot);
+    if( hist.hist ){ hist.hist->fill(value); return; }
+    if( !hist.buffer ){
+      hist.buffer=&buffers_[(*table_)[slot].key];
+      hist.buffer->attach(hist.me, fillBatchSize_);
+    }
+    hist.buffer->fill(value);
+  }
+
+  void
+  MonitorEnsemble::flush()
+  {
+    for(std::map<std::string,FillBuffer>::iterator buffer=buffers_.begin(); buffer!=buffers_.end(); ++buffer){
+      buffer->second.flush();
+    }
+  }
+
+  void
+  MonitorEnsemble::save()
+  {
+    // the dense MonitorElements of the sparse histograms are
+    // booked at the first save and kept with the others from
+    // then on; the sparse contents are added to them
+    for(std::map<std::string,SparseHistogram>::iterator hist=sparse_.begin(); hist!=sparse_.end(); ++hist){
+      hists_[hist->first]=hist->second.save(store_);
+    }
+  }
+
+  void
+  MonitorEnsemble::beginRun()
+  {
+    // the histograms are not reset between runs; deferred 
+    // histograms booked later on start with zero entries
+    entries_.clear();
+    for(std::map<std::string,MonitorElement*>::const_iterator hist=hists_.begin(); hist!=hists_.end(); ++hist){
+      if( hist->second ) entries_[hist->first]=hist->second->getEntries();
+    }
+  }
+
+  std::vector<std::string>
+  MonitorEnsemble::unfilled() const
+  {
+    std::vector<std::string> names;
+    for(std::map<std::string,HistogramDef>::const_iterator def=pending_.begin(); def!=pending_.end(); ++def){
+      names.push_back(def->second.name());
+    }
+    for(std::map<std::string,MonitorElement*>::const_iterator hist=hists_.begin(); hist!=hists_.end(); ++hist){
+      if( !hist->second ){ names.push_back(hist->first+" (refused)"); continue; }
+      std::map<std::string,double>::const_iterator entries=entries_.find(hist->first);
+      if( hist->second->getEntries()==(entries!=entries_.end() ? entries->second : 0.) ) names.push_back(hist->second->getName());
+    }
+    return names;
   }
 
   void 
-  MonitorEnsemble::fill(const edm::Event& event, const edm::EventSetup& setup)
+  MonitorEnsemble::fill(const edm::Event& event, const edm::EventSetup& setup, bool sampled)
   {
+    // the kinematic distributions are only filled for sampled
+    // events; multiplicities and trigger monitoring always
+    sampled_=sampled;
+
     // fetch trigger event if configured such 
     edm::Handle<edm::TriggerResults> triggerTable;
     if(!triggerTable_.label().empty()) {
@@ -307,7 +507,7 @@ namespace TopSingleLepton {
       if(!pvSelect_ || (*pvSelect_)(*pv))
 	pvMult++;
     }
-    fill("pvMult_",    pvMult   );
+    fill(PV_MULT,    pvMult   );
 
 
     /*
@@ -318,9 +518,9 @@ namespace TopSingleLepton {
     ------------------------------------------------------------
     */
     if (!event.eventAuxiliary().run()) return;
-    fill("RunNumb_", event.eventAuxiliary().run());   
+    fill(RUN_NUMB, event.eventAuxiliary().run());   
     
-    double dummy=5.; fill("InstLumi_", dummy);
+    double dummy=5.; fill(INST_LUMI, dummy);
      
 
     /* 
@@ -339,26 +539,29 @@ namespace TopSingleLepton {
     edm::Handle<edm::ValueMap<float> > electronId; 
     if(!electronId_.label().empty()) {
       if( !event.getByLabel(electronId_, electronId) ) return;
+      electronIds_.resolve(*elecs, *electronId);
     }
 
     // loop electron collection
     unsigned int eMult=0, eMultIso=0;
-    std::vector<const reco::GsfElectron*> isoElecs;
+    ArenaVector<const reco::GsfElectron*>::type isoElecs(arena_);
+    const reco::GsfElectron* leadingElec=0; double leadingElecIso=0.;
     for(edm::View<reco::GsfElectron>::const_iterator elec=elecs->begin(); elec!=elecs->end(); ++elec){
       unsigned int idx = elec-elecs->begin();
       // restrict to electrons with good electronId
-      if( electronId_.label().empty() ? true : ((int)(*electronId)[elecs->refAt(idx)] & eidPattern_) ){
+      if( electronId_.label().empty() ? true : ((int)electronIds_[idx] & eidPattern_) ){
 	if(!elecSelect_ || (*elecSelect_)(*elec)){
 	  double isolationTrk = elec->pt()/(elec->pt()+elec->dr03TkSumPt());
 	  double isolationCal = elec->pt()/(elec->pt()+elec->dr03EcalRecHitSumEt()+elec->dr03HcalTowerSumEt());
 	  double isolationRel = (elec->dr03TkSumPt()+elec->dr03EcalRecHitSumEt()+elec->dr03HcalTowerSumEt())/elec->pt();
-	  if( eMult==0 ){
+	  if( eMult==0 ){ leadingElec=&(*elec); leadingElecIso=isolationRel; }
+	  if( eMult==0 && sampled_ ){
 	    // restrict to the leading electron
-	    fill("elecPt_" , elec->pt() );
-	    fill("elecEta_", elec->eta());
-	    fill("elecRelIso_" , isolationRel );
-	    fill("elecTrkIso_" , isolationTrk );
-	    fill("elecCalIso_" , isolationCal );
+	    fill(ELEC_PT , elec->pt() );
+	    fill(ELEC_ETA, elec->eta());
+	    fill(ELEC_REL_ISO , isolationRel );
+	    fill(ELEC_TRK_ISO , isolationTrk );
+	    fill(ELEC_CAL_ISO , isolationCal );
 	  }
 	  // in addition to the multiplicity counter buffer the iso 
 	  // electron candidates for later overlap check with jets
@@ -366,8 +569,8 @@ namespace TopSingleLepton {
 	}
       }
     }
-    fill("elecMult_",    eMult   );
-    fill("elecMultIso_", eMultIso);
+    fill(ELEC_MULT,    eMult   );
+    fill(ELEC_MULT_ISO, eMultIso);
     
     /* 
     ------------------------------------------------------------
@@ -379,6 +582,7 @@ namespace TopSingleLepton {
 
     // fill monitoring plots for muons
     unsigned int mMult=0, mMultIso=0;
+    const reco::Muon* leadingMuon=0; double leadingMuonIso=0.;
 
     edm::Handle<edm::View<reco::Muon> > muons;
     if( !event.getByLabel(muons_, muons) ) return;
@@ -386,27 +590,30 @@ namespace TopSingleLepton {
     for(edm::View<reco::Muon>::const_iterator muon=muons->begin(); muon!=muons->end(); ++muon){
       // restrict to globalMuons
       if( muon->isGlobalMuon() ){ 
-	fill("muonDelZ_" , muon->globalTrack()->vz());
-	fill("muonDelXY_", muon->globalTrack()->vx(), muon->globalTrack()->vy());
+	if( sampled_ ){
+	  fill(MUON_DEL_Z , muon->globalTrack()->vz());
+	  fill(MUON_DEL_XY, muon->globalTrack()->vx(), muon->globalTrack()->vy());
+	}
 	// apply preselection
 	if(!muonSelect_ || (*muonSelect_)(*muon)){
 	  double isolationTrk = muon->pt()/(muon->pt()+muon->isolationR03().sumPt);
 	  double isolationCal = muon->pt()/(muon->pt()+muon->isolationR03().emEt+muon->isolationR03().hadEt);
 	  double isolationRel = (muon->isolationR03().sumPt+muon->isolationR03().emEt+muon->isolationR03().hadEt)/muon->pt();
-	  if( mMult==0 ){
+	  if( mMult==0 ){ leadingMuon=&(*muon); leadingMuonIso=isolationRel; }
+	  if( mMult==0 && sampled_ ){
 	    // restrict to leading muon
-	    fill("muonPt_"     , muon->pt() );
-	    fill("muonEta_"    , muon->eta());
-	    fill("muonRelIso_" , isolationRel );
-	    fill("muonTrkIso_" , isolationTrk );
-	    fill("muonCalIso_" , isolationCal );
+	    fill(MUON_PT     , muon->pt() );
+	    fill(MUON_ETA    , muon->eta());
+	    fill(MUON_REL_ISO , isolationRel );
+	    fill(MUON_TRK_ISO , isolationTrk );
+	    fill(MUON_CAL_ISO , isolationCal );
 	  }
 	   ++mMult; if(!muonIso_ || (*muonIso_)(*muon)) ++mMultIso;
 	}
       }
     }
-    fill("muonMult_",    mMult   );
-    fill("muonMultIso_", mMultIso);
+    fill(MUON_MULT,    mMult   );
+    fill(MUON_MULT_ISO, mMultIso);
 
     /* 
     ------------------------------------------------------------
@@ -448,23 +655,31 @@ namespace TopSingleLepton {
     }
 
     // loop jet collection
-    std::vector<reco::Jet> correctedJets;
-    std::vector<double> JetTagValues;
+    ArenaVector<reco::Jet>::type correctedJets(arena_);
+    ArenaVector<double>::type JetTagValues(arena_);
     unsigned int mult=0, multBEff=0, multBPur=0, multBVtx=0, multCSV=0;
     
     edm::Handle<edm::View<reco::Jet> > jets; 
     if( !event.getByLabel(jets_, jets) ) return;
+    correctedJets.reserve(jets->size());
+    if( includeBTag_ ){
+      JetTagValues.reserve(jets->size());
+      btagEffValues_.resolve(*jets, *btagEff); btagPurValues_.resolve(*jets, *btagPur);
+      btagVtxValues_.resolve(*jets, *btagVtx); btagCSVValues_.resolve(*jets, *btagCSV);
+    }
 
+    // the jetID is only available for calo jets
     edm::Handle<reco::JetIDValueMap> jetID; 
     if(jetIDSelect_){ 
       if( !event.getByLabel(jetIDLabel_, jetID) ) return;
+      jetIDs_.resolveType<reco::CaloJet>(*jets, *jetID);
     }
 
     for(edm::View<reco::Jet>::const_iterator jet=jets->begin(); jet!=jets->end(); ++jet){
       // check jetID for calo jets
       unsigned int idx = jet-jets->begin();
-      if( jetIDSelect_ && dynamic_cast<const reco::CaloJet*>(jets->refAt(idx).get())){
-	if(!(*jetIDSelect_)((*jetID)[jets->refAt(idx)])) continue;
+      if( jetIDSelect_ && dynamic_cast<const reco::CaloJet*>(&*jet)){
+	if(!(*jetIDSelect_)(jetIDs_[idx])) continue;
       }
       // chekc additional jet selection for calo, pf and bare reco jets
       if(dynamic_cast<const reco::CaloJet*>(&*jet)){
@@ -490,35 +705,41 @@ namespace TopSingleLepton {
       correctedJets.push_back(monitorJet);
       ++mult; // determine jet multiplicity
       if( includeBTag_ ){
-	// fill b-discriminators
-	edm::RefToBase<reco::Jet> jetRef = jets->refAt(idx);
-	fill("jetBDiscEff_", (*btagEff)[jetRef]); if( (*btagEff)[jetRef]>btagEffWP_ ) ++multBEff; 
-	fill("jetBDiscPur_", (*btagPur)[jetRef]); if( (*btagPur)[jetRef]>btagPurWP_ ) ++multBPur; 
-	fill("jetBDiscVtx_", (*btagVtx)[jetRef]); if( (*btagVtx)[jetRef]>btagVtxWP_ ) ++multBVtx; 
-        fill("jetBCVtx_"   , (*btagCSV)[jetRef]); if( (*btagCSV)[jetRef]>btagCSVWP_ ) ++multCSV;
+	// fill b-discriminators (the tagged multiplicities always)
+	if( sampled_ ){
+	  fillBuffered(JET_BDISC_EFF, btagEffValues_[idx]);
+	  fillBuffered(JET_BDISC_PUR, btagPurValues_[idx]);
+	  fillBuffered(JET_BDISC_VTX, btagVtxValues_[idx]);
+	  fillBuffered(JET_BCVTX   , btagCSVValues_[idx]);
+	}
+	if( btagEffValues_[idx]>btagEffWP_ ) ++multBEff; 
+	if( btagPurValues_[idx]>btagPurWP_ ) ++multBPur; 
+	if( btagVtxValues_[idx]>btagVtxWP_ ) ++multBVtx; 
+	if( btagCSVValues_[idx]>btagCSVWP_ ) ++multCSV;
         
         //Fill a vector with Jet b-tag WP for later M3+1tag calculation: CSV tagger
-        JetTagValues.push_back( (*btagCSV)[jetRef]);
+        JetTagValues.push_back( btagCSVValues_[idx]);
       }
       // fill pt (raw or L2L3) for the leading four jets  
-      if(idx==0) {fill("jet1Pt_" , monitorJet.pt()); fill("jet1PtRaw_", jet->pt() );
-                  fill("jet1Eta_", monitorJet.eta());
+      if(!sampled_) continue;
+      if(idx==0) {fill(JET1_PT , monitorJet.pt()); fill(JET1_PT_RAW, jet->pt() );
+                  fill(JET1_ETA, monitorJet.eta());
 		 };
-      if(idx==1) {fill("jet2Pt_" , monitorJet.pt()); fill("jet2PtRaw_", jet->pt() );
-                  fill("jet2Eta_", monitorJet.eta());
+      if(idx==1) {fill(JET2_PT , monitorJet.pt()); fill(JET2_PT_RAW, jet->pt() );
+                  fill(JET2_ETA, monitorJet.eta());
 		 }
-      if(idx==2) {fill("jet3Pt_" , monitorJet.pt()); fill("jet3PtRaw_", jet->pt() );
-                  fill("jet3Eta_", monitorJet.eta());
+      if(idx==2) {fill(JET3_PT , monitorJet.pt()); fill(JET3_PT_RAW, jet->pt() );
+                  fill(JET3_ETA, monitorJet.eta());
 		 }
-      if(idx==3) {fill("jet4Pt_" , monitorJet.pt()); fill("jet4PtRaw_", jet->pt() );
-                  fill("jet4Eta_", monitorJet.eta());
+      if(idx==3) {fill(JET4_PT , monitorJet.pt()); fill(JET4_PT_RAW, jet->pt() );
+                  fill(JET4_ETA, monitorJet.eta());
 		 }
     }
-    fill("jetMult_"     , mult    );
-    fill("jetMultBEff_" , multBEff);
-    fill("jetMultBPur_" , multBPur);
-    fill("jetMultBVtx_" , multBVtx);
-    fill("jetMultCSVtx_", multCSV );
+    fill(JET_MULT     , mult    );
+    fill(JET_MULT_BEFF , multBEff);
+    fill(JET_MULT_BPUR , multBPur);
+    fill(JET_MULT_BVTX , multBVtx);
+    fill(JET_MULT_CSVTX, multCSV );
     
     /* 
     ------------------------------------------------------------
@@ -529,14 +750,14 @@ namespace TopSingleLepton {
     */
 
     // fill monitoring histograms for met
-    for(std::vector<edm::InputTag>::const_iterator met_=mets_.begin(); met_!=mets_.end(); ++met_){
+    for(std::vector<edm::InputTag>::const_iterator met_=mets_.begin(); sampled_ && met_!=mets_.end(); ++met_){
       edm::Handle<edm::View<reco::MET> > met;
       if( !event.getByLabel(*met_, met) ) continue;
       if(met->begin()!=met->end()){
 	unsigned int idx=met_-mets_.begin();
-	if(idx==0) fill("metCalo_" , met->begin()->et());
-	if(idx==1) fill("metTC_"   , met->begin()->et());
-	if(idx==2) fill("metPflow_", met->begin()->et());
+	if(idx==0) fill(MET_CALO , met->begin()->et());
+	if(idx==1) fill(MET_TC   , met->begin()->et());
+	if(idx==2) fill(MET_PFLOW, met->begin()->et());
       }
     }
 
@@ -553,30 +774,68 @@ namespace TopSingleLepton {
     Calculate eventKinematics(MAXJETS, WMASS);
     double wMass   = eventKinematics.massWBoson   (correctedJets);
     double topMass = eventKinematics.massTopQuark (correctedJets);
-    if(wMass>=0 && topMass>=0 ) {fill("massW_" ,   wMass  );fill("massTop_" , topMass);}
+    if(wMass>=0 && topMass>=0 && sampled_) {fill(MASS_W ,   wMass  );fill(MASS_TOP , topMass);}
+    
+    // M3 with Btag (CSV Tight) requirement
+    double btopMass=-1.;
+    if (includeBTag_ && correctedJets.size()==JetTagValues.size() && (sampled_ || export_)){
+      btopMass= eventKinematics.massBTopQuark(correctedJets, JetTagValues, btagCSVWP_);
+    }
+
+    // write the event to the export (if configured)
+    if (export_){
+      export_->set(columns_[PV_MULT_COL  ], pvMult);
+      export_->set(columns_[MUON_MULT_COL], mMult );
+      export_->set(columns_[ELEC_MULT_COL], eMult );
+      export_->set(columns_[JET_MULT_COL ], mult  );
+      if (leadingMuon){
+	export_->set(columns_[MUON_PT_COL ], leadingMuon->pt ()); export_->set(columns_[MUON_ETA_COL    ], leadingMuon->eta());
+	export_->set(columns_[MUON_PHI_COL], leadingMuon->phi()); export_->set(columns_[MUON_REL_ISO_COL], leadingMuonIso   );
+      }
+      if (leadingElec){
+	export_->set(columns_[ELEC_PT_COL ], leadingElec->pt ()); export_->set(columns_[ELEC_ETA_COL    ], leadingElec->eta());
+	export_->set(columns_[ELEC_PHI_COL], leadingElec->phi()); export_->set(columns_[ELEC_REL_ISO_COL], leadingElecIso   );
+      }
+      for(unsigned int idx=0; idx<correctedJets.size(); ++idx){
+	export_->push(columns_[JET_PT_COL ], correctedJets[idx].pt ());
+	export_->push(columns_[JET_ETA_COL], correctedJets[idx].eta());
+	export_->push(columns_[JET_PHI_COL], correctedJets[idx].phi());
+	if (includeBTag_) export_->push(columns_[JET_CSV_COL], JetTagValues[idx]);
+      }
+      for(std::vector<edm::InputTag>::const_iterator met_=mets_.begin(); met_!=mets_.end(); ++met_){
+	edm::Handle<edm::View<reco::MET> > met;
+	bool found=event.getByLabel(*met_, met) && met->begin()!=met->end();
+	export_->push(columns_[MET_ET_COL ], found ? met->begin()->et () : -1.);
+	export_->push(columns_[MET_PHI_COL], found ? met->begin()->phi() : -1.);
+      }
+      export_->set(columns_[MASS_W_COL   ], wMass   );
+      export_->set(columns_[MASS_TOP_COL ], topMass );
+      export_->set(columns_[MASS_BTOP_COL], btopMass);
+      export_->write(event.id());
+    }
     
     // Fill M3 with Btag (CSV Tight) requirement
     
     if (!includeBTag_) return;
     if (correctedJets.size() != JetTagValues.size()) return;
-    double btopMass= eventKinematics.massBTopQuark(correctedJets, JetTagValues, btagCSVWP_);
-    if (btopMass>=0) fill("massBTop_", btopMass);
+    if (sampled_ && btopMass>=0) fill(MASS_BTOP, btopMass);
     
     // fill plots for trigger monitoring
     if((lowerEdge_==-1. && upperEdge_==-1.) || (lowerEdge_<wMass && wMass<upperEdge_) ){
-      if(!triggerTable_.label().empty()) fill(event, *triggerTable, "trigger", triggerPaths_);
-      if(logged_<=hists_.find("eventLogger_")->second->getNbinsY()){
+      if(!triggerTable_.label().empty()) fill(event, *triggerTable, triggerPaths_);
+      MonitorElement* logger=target(EVENT_LOGGER).me;
+      if(logger && logged_<=logger->getNbinsY()){
 	// log runnumber, lumi block, event number & some
 	// more pysics infomation for interesting events
-	fill("eventLogger_", 0.5, logged_+0.5, event.eventAuxiliary().run()); 
-	fill("eventLogger_", 1.5, logged_+0.5, event.eventAuxiliary().luminosityBlock()); 
-	fill("eventLogger_", 2.5, logged_+0.5, event.eventAuxiliary().event()); 
-	if(correctedJets.size()>0) fill("eventLogger_", 3.5, logged_+0.5, correctedJets[0].pt()); 
-	if(correctedJets.size()>1) fill("eventLogger_", 4.5, logged_+0.5, correctedJets[1].pt()); 
-	if(correctedJets.size()>2) fill("eventLogger_", 5.5, logged_+0.5, correctedJets[2].pt()); 
-	if(correctedJets.size()>3) fill("eventLogger_", 6.5, logged_+0.5, correctedJets[3].pt()); 
-	fill("eventLogger_", 7.5, logged_+0.5, wMass  ); 
-	fill("eventLogger_", 8.5, logged_+0.5, topMass); 
+	fill(EVENT_LOGGER, 0.5, logged_+0.5, event.eventAuxiliary().run()); 
+	fill(EVENT_LOGGER, 1.5, logged_+0.5, event.eventAuxiliary().luminosityBlock()); 
+	fill(EVENT_LOGGER, 2.5, logged_+0.5, event.eventAuxiliary().event()); 
+	if(correctedJets.size()>0) fill(EVENT_LOGGER, 3.5, logged_+0.5, correctedJets[0].pt()); 
+	if(correctedJets.size()>1) fill(EVENT_LOGGER, 4.5, logged_+0.5, correctedJets[1].pt()); 
+	if(correctedJets.size()>2) fill(EVENT_LOGGER, 5.5, logged_+0.5, correctedJets[2].pt()); 
+	if(correctedJets.size()>3) fill(EVENT_LOGGER, 6.5, logged_+0.5, correctedJets[3].pt()); 
+	fill(EVENT_LOGGER, 7.5, logged_+0.5, wMass  ); 
+	fill(EVENT_LOGGER, 8.5, logged_+0.5, topMass); 
 	++logged_;
       }
     }
@@ -585,7 +844,7 @@ namespace TopSingleLepton {
 }
 
 
-TopSingleLeptonDQM::TopSingleLeptonDQM(const edm::ParameterSet& cfg): triggerTable_(""), vertexSelect_(0), beamspot_(""), beamspotSelect_(0)
+TopSingleLeptonDQM::TopSingleLeptonDQM(const edm::ParameterSet& cfg): triggerTable_(""), vertexSelect_(0), beamspot_(""), beamspotSelect_(0), budget_(0), histograms_(0), timing_(0), sampling_(0), trends_(0), export_(0), index_(0)
 {
   // configure preselection
   edm::ParameterSet presel=cfg.getParameter<edm::ParameterSet>("preselection");
@@ -605,17 +864,107 @@ TopSingleLeptonDQM::TopSingleLeptonDQM(const edm::ParameterSet& cfg): triggerTab
     beamspotSelect_= new StringCutObjectSelector<reco::BeamSpot>(beamspot.getParameter<std::string>("select"));
   }
 
+  // configure the memory budget for lazily booked histograms; 
+  // it is optional and given in kB (<=0 means no limit)
+  edm::ParameterSet setup=cfg.getParameter<edm::ParameterSet>("setup");
+  // the histogram definitions are parsed once and shared by
+  // all MonitorEnsembles; modifications of the compiled-in 
+  // defaults are optional
+  std::vector<edm::ParameterSet> histograms;
+  if( setup.existsAs<edm::ParameterSet>("monitoring") ){
+    edm::ParameterSet monitoring=setup.getParameter<edm::ParameterSet>("monitoring");
+    if( monitoring.existsAs<double>("memoryBudget") ){
+      budget_= new BookingBudget(monitoring.getParameter<double>("memoryBudget"));
+    }
+    if( monitoring.existsAs<std::vector<edm::ParameterSet> >("histograms") ){
+      histograms= monitoring.getParameter<std::vector<edm::ParameterSet> >("histograms");
+    }
+  }
+  histograms_= new HistogramTable(TopSingleLepton::MonitorEnsemble::defaults(), histograms);
+
   // conifgure the selection
   std::vector<edm::ParameterSet> sel=cfg.getParameter<std::vector<edm::ParameterSet> >("selection");
+  // share the selection steps with the other modules if the
+  // SelectionGraph service is available, keep them local else
+  edm::Service<SelectionGraph> graph;
+  selectionGraph_= graph.isAvailable() ? &(*graph) : &localGraph_;
   for(unsigned int i=0; i<sel.size(); ++i){
     selectionOrder_.push_back(sel.at(i).getParameter<std::string>("label"));
-    selection_[selectionStep(selectionOrder_.back())] = std::make_pair(sel.at(i), new TopSingleLepton::MonitorEnsemble(selectionStep(selectionOrder_.back()).c_str(), cfg.getParameter<edm::ParameterSet>("setup")));
+    selection_[selectionStep(selectionOrder_.back())] = std::make_pair(sel.at(i), new TopSingleLepton::MonitorEnsemble(selectionStep(selectionOrder_.back()).c_str(), setup, histograms_, budget_));
+    selection_[selectionStep(selectionOrder_.back())].second->useArena(&arena_);
+    // register the selection step with the shared selection graph
+    std::string type=objectType(selectionOrder_.back());
+    if(selectionGraph_->supports(type)){
+      selectionIds_[selectionStep(selectionOrder_.back())] = selectionGraph_->subscribe(type, sel.at(i));
+    }
   }
+  // configure the timing and rejection monitoring of the
+  // selection steps; it is optional and sampled every Nth
+  // event (the accept/reject counters are filled always)
+  if( cfg.existsAs<edm::ParameterSet>("timing") ){
+    std::vector<std::string> steps;
+    for(unsigned int i=0; i<selectionOrder_.size(); ++i){ steps.push_back(selectionStep(selectionOrder_[i])); }
+    timing_= new SelectionTiming(cfg.getParameter<edm::ParameterSet>("setup").getParameter<std::string>("directory"), steps, cfg.getParameter<edm::ParameterSet>("timing").getParameter<unsigned int>("sampling"));
+  }
+  // configure the subsample of events for which the kinematic
+  // distributions are filled; it is optional (all events are 
+  // filled otherwise), the event counters are filled always
+  if( cfg.existsAs<edm::ParameterSet>("sampling") ){
+    edm::ParameterSet sampling=cfg.getParameter<edm::ParameterSet>("sampling");
+    sampling_= new MonitorSampling(setup.getParameter<std::string>("directory"), sampling.getParameter<unsigned int>("prescale"), sampling.getParameter<double>("timeBudget"));
+  }
+  // configure the trends of the number of events passing each
+  // selection step per luminosity section; it is optional
+  if( cfg.existsAs<edm::ParameterSet>("trends") ){
+    trends_= new LumiTrends(setup.getParameter<std::string>("directory"), cfg.getParameter<edm::ParameterSet>("trends").getParameter<unsigned int>("lumis"));
+    for(unsigned int i=0; i<selectionOrder_.size(); ++i){
+      std::string step=selectionStep(selectionOrder_[i]);
+      trendIds_.push_back(trends_->add(step, "Events passing "+step+" per lumi section"));
+    }
+  }
+  // configure the export of the events passing the last
+  // selection step into a columnar file; it is optional, 
+  // compression is optional (zlib at level 1 per default)
+  if( cfg.existsAs<edm::ParameterSet>("eventExport") && !selectionOrder_.empty() ){
+    edm::ParameterSet eventExport=cfg.getParameter<edm::ParameterSet>("eventExport");
+    int compression= eventExport.existsAs<int>("compression") ? eventExport.getParameter<int>("compression") : 1;
+    export_= new EventExport(eventExport.getParameter<std::string>("fileName"), "TopSingleLeptonDQM", compression);
+    selection_[selectionStep(selectionOrder_.back())].second->exportTo(export_);
+  }
+  // configure the index of the events passing each selection
+  // step per luminosity section; it is optional
+  if( cfg.existsAs<edm::ParameterSet>("eventIndex") ){
+    index_= new SelectionIndex(cfg.getParameter<edm::ParameterSet>("eventIndex").getParameter<std::string>("fileName"), cfg.getParameter<std::string>("@module_label"));
+    for(unsigned int i=0; i<selectionOrder_.size(); ++i){
+      std::string step=selectionStep(selectionOrder_[i]);
+      indexIds_[step]=index_->add(step);
+    }
+  }
+}
+
+bool
+TopSingleLeptonDQM::select(const std::string& key, const edm::Event& event, const edm::EventSetup& setup)
+{
+  SelectionTiming::Clock clock(timing_, key, SelectionTiming::SELECT);
+  return clock.passed(selectionGraph_->select(selectionIds_[key], event, setup));
+}
+
+void
+TopSingleLeptonDQM::fill(const std::string& key, unsigned int step, const edm::Event& event, const edm::EventSetup& setup)
+{
+  bool sampled = !sampling_ || sampling_->sampled();
+  if( trends_ ) trends_->count(trendIds_[step]);
+  if( index_ ) index_->passed(indexIds_[key], event.id().event());
+  SelectionTiming::Clock clock(timing_, key, SelectionTiming::FILL);
+  selection_[key].second->fill(event, setup, sampled);
 }
 
 void 
 TopSingleLeptonDQM::analyze(const edm::Event& event, const edm::EventSetup& setup)
 { 
+  // the per-event containers of the previous event are gone
+  arena_.reset();
+  if( trends_ ) trends_->event();
   if(!triggerTable_.label().empty()){
     edm::Handle<edm::TriggerResults> triggerTable;
     if( !event.getByLabel(triggerTable_, triggerTable) ) return;
@@ -627,58 +976,100 @@ TopSingleLeptonDQM::analyze(const edm::Event& event, const edm::EventSetup& setu
     if( !event.getByLabel(beamspot_, beamspot) ) return;
     if(!(*beamspotSelect_)(*beamspot)) return;
   }
-  // apply selection steps
+  // apply selection steps; each unique step is evaluated
+  // only once per event and shared with all other modules
+  if( timing_ ) timing_->next();
+  if( sampling_ ) sampling_->next();
+  MonitorSampling::Clock clock(sampling_);
   unsigned int passed=0;
   for(std::vector<std::string>::const_iterator selIt=selectionOrder_.begin(); selIt!=selectionOrder_.end(); ++selIt){
     std::string key = selectionStep(*selIt), type = objectType(*selIt);
+    unsigned int step = selIt-selectionOrder_.begin();
     if(selection_.find(key)!=selection_.end()){
       if(type=="empty"){
-	selection_[key].second->fill(event, setup);
+	fill(key, step, event, setup);
       }
       if(type=="muons"){
-	SelectionStep<reco::Muon> step(selection_[key].first);
-	if(step.select(event)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ ++passed;
+	  fill(key, step, event, setup);
 	} else break;
       }
       if(type=="elecs"){
-	SelectionStep<reco::GsfElectron> step(selection_[key].first);
-	if(step.select(event)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ ++passed;
+	  fill(key, step, event, setup);
 	} else break;
       }
       if(type=="pvs" ){
-	SelectionStep<reco::Vertex> step(selection_[key].first);
-	if(step.selectVertex(event)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ ++passed;
+	  fill(key, step, event, setup);
 	} else break;
       }
       if(type=="jets" ){
-	SelectionStep<reco::Jet> step(selection_[key].first);
-	if(step.select(event, setup)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ ++passed;
+	  fill(key, step, event, setup);
 	} else break;
       }
       if(type=="jets/pf" ){
-	SelectionStep<reco::PFJet> step(selection_[key].first);
-	if(step.select(event, setup)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ ++passed;
+	  fill(key, step, event, setup);
 	} else break;
       }
       if(type=="jets/calo" ){
-	SelectionStep<reco::CaloJet> step(selection_[key].first);
-	if(step.select(event, setup)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ ++passed;
+	  fill(key, step, event, setup);
 	} else break;
       }
       if(type=="met" ){
-	SelectionStep<reco::MET> step(selection_[key].first);
-	if(step.select(event)){ ++passed;
-	  selection_[key].second->fill(event, setup);
+	if(select(key, event, setup)){ ++passed;
+	  fill(key, step, event, setup);
 	} else break;
       }
     }
   }
 }
 
+void 
+TopSingleLeptonDQM::beginRun(const edm::Run& run, const edm::EventSetup& setup)
+{
+  for(std::map<std::string, std::pair<edm::ParameterSet, TopSingleLepton::MonitorEnsemble*> >::iterator sel=selection_.begin(); sel!=selection_.end(); ++sel){
+    sel->second.second->beginRun();
+  }
+  if( trends_ ) trends_->beginRun();
+}
+
+void 
+TopSingleLeptonDQM::endRun(const edm::Run& run, const edm::EventSetup& setup)
+{
+  // flush buffered fills and fill the sparse histograms
+  // into their MonitorElements before they are written
+  for(std::map<std::string, std::pair<edm::ParameterSet, TopSingleLepton::MonitorEnsemble*> >::iterator sel=selection_.begin(); sel!=selection_.end(); ++sel){
+    sel->second.second->flush(); sel->second.second->save();
+  }
+  // report histograms, which have not been filled during 
+  // the run; they are candidates to be removed from the
+  // configuration
+  edm::LogInfo log("TopSingleLeptonDQM");
+  log << "Histograms not filled in run " << run.run() << ":\n";
+  for(std::vector<std::string>::const_iterator selIt=selectionOrder_.begin(); selIt!=selectionOrder_.end(); ++selIt){
+    std::string key = selectionStep(*selIt);
+    if(selection_.find(key)==selection_.end()) continue;
+    std::vector<std::string> unfilled=selection_[key].second->unfilled();
+    log << " - " << key << " (" << unfilled.size() << "):";
+    for(unsigned int idx=0; idx<unfilled.size(); ++idx){ log << " " << unfilled[idx]; }
+    log << "\n";
+  }
+  if( budget_ ){
+    log << "Booking budget: " << budget_->booked() << " histograms booked (" << budget_->used() << " kB), " 
+	<< budget_->refused() << " refused\n";
+  }
+}
 
+void 
+TopSingleLeptonDQM::endLuminosityBlock(const edm::LuminosityBlock& lumi, const edm::EventSetup& setup)
+{
+  for(std::map<std::string, std::pair<edm::ParameterSet, TopSingleLepton::MonitorEnsemble*> >::iterator sel=selection_.begin(); sel!=selection_.end(); ++sel){
+    sel->second.second->flush();
+  }
+  if( trends_ ) trends_->append(lumi.id().luminosityBlock());
+  if( index_ ) index_->write(lumi.id().run(), lumi.id().luminosityBlock());
+}
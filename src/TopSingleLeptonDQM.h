@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <algorithm>
 
 #include "FWCore/Framework/interface/Event.h"
 #include "DQMServices/Core/interface/DQMStore.h"
@@ -10,6 +11,14 @@
 
 #include "DataFormats/JetReco/interface/Jet.h"
 #include "DQM/Physics/interface/TopDQMHelpers.h"
+#include "DQM/Physics/interface/LazyBooking.h"
+#include "DQM/Physics/interface/FillBuffer.h"
+#include "DQM/Physics/interface/SparseHistogram.h"
+#include "DQM/Physics/interface/HistogramTable.h"
+#include "DQM/Physics/interface/EventExport.h"
+#include "DQM/Physics/interface/EventBitmap.h"
+#include "DQM/Physics/interface/EventArena.h"
+#include "DQM/Physics/interface/AssociationTable.h"
 #include "DataFormats/MuonReco/interface/Muon.h"
 #include "DataFormats/Common/interface/ValueMap.h"
 #include "DataFormats/METReco/interface/CaloMET.h"
@@ -31,7 +40,24 @@
    not contain much more than 10 histograms though in the STANDARD configuration, as these 
    histograms will be monitored at each SelectionStep. Monitoring of histograms after selec-
    tion steps within the same object collection needs to be implemented within the Monitor-
-   Ensemble. It will not be covered by the SelectionStep class.
+   Ensemble. It will not be covered by the SelectionStep class. If the parameter _lazyBooking_
+   is set to true in the monitoring PSet the histograms are only booked when they are filled 
+   for the first time. They are accounted against the BookingBudget of the module (if any).
+   Histograms listed in the parameter _sparseHistograms_ of the monitoring PSet are kept
+   as SparseHistograms during the run; their dense MonitorElements are booked and filled
+   by _save_ at the end of the run only. For events which are not _sampled_ (see
+   MonitorSampling) only the multiplicities, the run and lumi information and the trigger
+   monitoring are filled; the kinematic distributions, the b-tag discriminators and the
+   mass estimates are skipped.
+   The histograms are defined in a HistogramTable, which is shared by all MonitorEnsembles
+   of the module; its slots follow the enumeration _Histogram_ and are used to fill the
+   histograms without any look up by name. If an EventExport is attached via _exportTo_
+   the multiplicities, the kinematics of the leading leptons and of the jets, the MET and
+   the mass estimates of each filled event are written to it (independent of the
+   sampling). The per-event containers of the selected electrons, jets and b-tag values
+   are taken from the EventArena given via _useArena_, if any. The electronId, the jetID
+   and the b-tag discriminators are resolved once per event into AssociationTables aligned
+   with the electron and jet collections.
 */
 
 namespace TopSingleLepton {
@@ -40,19 +66,49 @@ namespace TopSingleLepton {
   public:
     /// different verbosity levels
     enum Level{ STANDARD, VERBOSE, DEBUG };
+    /// slots of the histograms in the HistogramTable (in the
+    /// order of the compiled-in defaults)
+    enum Histogram{ RUN_NUMB, INST_LUMI, PV_MULT, MUON_PT, MUON_MULT, MUON_MULT_ISO, ELEC_PT, ELEC_MULT, ELEC_MULT_ISO, JET_MULT, 
+		    TRIGGER_EFF, TRIGGER_MON, MET_CALO, MASS_W, MASS_TOP, MASS_BTOP, 
+		    MUON_ETA, MUON_REL_ISO, ELEC_ETA, ELEC_REL_ISO, JET_MULT_BEFF, JET_BDISC_EFF, JET1_ETA, JET1_PT, JET2_ETA, JET2_PT, 
+		    JET3_ETA, JET3_PT, JET4_ETA, JET4_PT, MET_TC, MET_PFLOW, MUON_DEL_Z, MUON_DEL_XY, 
+		    MUON_TRK_ISO, MUON_CAL_ISO, ELEC_TRK_ISO, ELEC_CAL_ISO, JET_MULT_BPUR, JET_BDISC_PUR, JET_MULT_BVTX, JET_BDISC_VTX, 
+		    JET_MULT_CSVTX, JET_BCVTX, JET1_PT_RAW, JET2_PT_RAW, JET3_PT_RAW, JET4_PT_RAW, EVENT_LOGGER, NHISTOGRAMS };
     
   public:
-    /// default contructor
-    MonitorEnsemble(const char* label, const edm::ParameterSet& cfg);
+    /// default contructor; the HistogramTable is not owned
+    MonitorEnsemble(const char* label, const edm::ParameterSet& cfg, const HistogramTable* table, BookingBudget* budget=0);
     /// default destructor
     ~MonitorEnsemble(){};
     
     /// book histograms in subdirectory _directory_
     void book(std::string directory);
-    /// fill monitor histograms with electronId and jetCorrections
-    void fill(const edm::Event& event, const edm::EventSetup& setup);
+    /// fill monitor histograms with electronId and jetCorrections; the
+    /// kinematic distributions are filled for _sampled_ events only
+    void fill(const edm::Event& event, const edm::EventSetup& setup, bool sampled=true);
+    /// keep the number of entries of the booked histograms
+    /// at the beginning of the run
+    void beginRun();
+    /// names of histograms that have not been filled since the beginning of the run
+    std::vector<std::string> unfilled() const;
+    /// fill all buffered values into the MonitorElements
+    void flush();
+    /// book the dense MonitorElements of the sparse histograms (if not done
+    /// yet) and fill the sparse contents into them
+    void save();
+    /// compiled-in histogram definitions in the order of _Histogram_
+    static std::vector<HistogramTable::Entry> defaults();
+    /// register the columns with _out_ and write each filled event to it (not owned)
+    void exportTo(EventExport* out);
+    /// take the per-event containers from _arena_ (not owned; 0 for the heap)
+    void useArena(EventArena* arena){ arena_=arena; };
 
   private:
+    /// columns of the event export
+    enum Column{ PV_MULT_COL, MUON_MULT_COL, ELEC_MULT_COL, JET_MULT_COL, MUON_PT_COL, MUON_ETA_COL, MUON_PHI_COL, MUON_REL_ISO_COL, 
+		 ELEC_PT_COL, ELEC_ETA_COL, ELEC_PHI_COL, ELEC_REL_ISO_COL, JET_PT_COL, JET_ETA_COL, JET_PHI_COL, JET_CSV_COL, 
+		 MET_ET_COL, MET_PHI_COL, MASS_W_COL, MASS_TOP_COL, MASS_BTOP_COL, NCOLUMNS };
+
     /// deduce monitorPath from label, the label is expected
     /// to be of type 'selectionPath:monitorPath'
     std::string monitorPath(const std::string& label) const { return label.substr(label.find(':')+1); };  
@@ -63,16 +119,73 @@ namespace TopSingleLepton {
     /// set configurable labels for trigger monitoring histograms
     void triggerBinLabels(std::string channel, const std::vector<std::string> labels);
     /// fill trigger monitoring histograms
-    void fill(const edm::Event& event, const edm::TriggerResults& triggerTable, std::string channel, const std::vector<std::string> labels) const;
+    void fill(const edm::Event& event, const edm::TriggerResults& triggerTable, const std::vector<std::string> labels);
+
+    /// book histogram or keep its definition in case of lazy booking
+    void book1D(const std::string& histName, const std::string& name, const std::string& title, int nBins, double low, double high);
+    /// book histogram or keep its definition in case of lazy booking (2-dim version)
+    void book2D(const std::string& histName, const std::string& name, const std::string& title, int nBinsX, double lowX, double highX, int nBinsY, double lowY, double highY);
+    /// book histogram _def_ as _key_ or keep its definition in case of lazy booking
+    void define(const std::string& key, const HistogramDef& def);
+    /// set axis title of booked or deferred histogram
+    void setAxisTitle(const std::string& histName, const std::string& title, int axis);
+    /// set bin label of booked or deferred histogram
+    void setBinLabel(const std::string& histName, int bin, const std::string& label, int axis);
+    /// set draw option of booked or deferred histogram
+    void setOption(const std::string& histName, const std::string& option);
+    /// return histogram; a deferred histogram is booked here, which happens on
+    /// its first fill only; returns 0 if the histogram is unknown or refused
+    MonitorElement* book(const std::string& histName);
+
+    /// fill histogram via a FillBuffer (for frequently filled histograms)
+    void fillBuffered(Histogram slot, double value);
 
-    /// check if histogram was booked
-    bool booked(const std::string histName) const { return hists_.find(histName.c_str())!=hists_.end(); };
     /// fill histogram if it had been booked before
-    void fill(const std::string histName, double value) const { if(booked(histName.c_str())) hists_.find(histName.c_str())->second->Fill(value); };
-    /// fill histogram if it had been booked before (2-dim version)
-    void fill(const std::string histName, double xValue, double yValue) const { if(booked(histName.c_str())) hists_.find(histName.c_str())->second->Fill(xValue, yValue); };
+    void fill(Histogram slot, double value){ fill(target(slot), value); };
+    /// fill histogram if it had been booked before (1-dim version with weight)
+    void fillWeighted(Histogram slot, double value, double weight){ fillWeighted(target(slot), value, weight); };
     /// fill histogram if it had been booked before (2-dim version)
-    void fill(const std::string histName, double xValue, double yValue, double zValue) const { if(booked(histName.c_str())) hists_.find(histName.c_str())->second->Fill(xValue, yValue, zValue); };
+    void fill(Histogram slot, double xValue, double yValue){ fill(target(slot), xValue, yValue, 1.); };
+    /// fill histogram if it had been booked before (2-dim version with weight)
+    void fill(Histogram slot, double xValue, double yValue, double zValue){ fill(target(slot), xValue, yValue, zValue); };
+
+    /// resolved fill target of a histogram
+    struct Target {
+      Target() : resolved(false), me(0), hist(0), buffer(0) {};
+      /// true once the look up by key has been done
+      bool resolved;
+      /// MonitorElement (0 if not booked, refused or sparse)
+      MonitorElement* me;
+      /// sparse histogram (0 if not sparse)
+      SparseHistogram* hist;
+      /// fill buffer (0 if not filled buffered so far)
+      FillBuffer* buffer;
+    };
+    /// fill target of histogram _slot_; the target is looked up by key on
+    /// first access only, deferred histograms are booked then
+    Target& target(unsigned int slot){
+      Target& target=targets_[slot];
+      if( !target.resolved ) resolve(target, (*table_)[slot].key);
+      return target;
+    };
+    /// look up the fill target of histogram _key_
+    void resolve(Target& target, const std::string& key){ target.hist=sparse(key); if(!target.hist) target.me=book(key); target.resolved=true; };
+    /// fill target (sparse histogram or MonitorElement)
+    void fill(const Target& target, double value) const { if(target.hist){ target.hist->fill(value); return; } if(target.me) target.me->Fill(value); };
+    /// fill target (1-dim version with weight)
+    void fillWeighted(const Target& target, double value, double weight) const {
+      if(target.hist){ target.hist->fill(value, weight); return; } if(target.me) target.me->Fill(value, weight);
+    };
+    /// fill target (2-dim version with weight)
+    void fill(const Target& target, double xValue, double yValue, double zValue) const { 
+      if(target.hist){ target.hist->fill(xValue, yValue, zValue); return; } if(target.me) target.me->Fill(xValue, yValue, zValue);
+    };
+    /// return sparse histogram _key_; returns 0 if the histogram is not sparse
+    SparseHistogram* sparse(const std::string& key){
+      if( sparse_.empty() ) return 0;
+      std::map<std::string,SparseHistogram>::iterator hist=sparse_.find(key); 
+      return hist!=sparse_.end() ? &hist->second : 0;
+    };
 
   private:
     /// verbosity level for booking
@@ -137,31 +250,68 @@ namespace TopSingleLepton {
 
     /// number of logged interesting events
     int logged_;
+    /// book histograms on first fill only
+    bool lazy_;
+    /// booking budget of the module (not owned)
+    BookingBudget* budget_;
+    /// folder for histogram booking
+    std::string folder_;
     /// storage manager
     DQMStore* store_;
-    /// histogram container  
+    /// histogram container
     std::map<std::string,MonitorElement*> hists_;
+    /// definitions of histograms not yet booked
+    std::map<std::string,HistogramDef> pending_;
+    /// number of entries of the booked histograms at the beginning of the run
+    std::map<std::string,double> entries_;
+    /// batch size for buffered fills
+    unsigned int fillBatchSize_;
+    /// fill buffers for frequently filled histograms
+    std::map<std::string,FillBuffer> buffers_;
+    /// histogram definitions (not owned)
+    const HistogramTable* table_;
+    /// fill targets per slot
+    std::vector<Target> targets_;
+    /// true if the kinematic distributions are filled for the current event
+    bool sampled_;
+    /// event export (not owned; 0 if not exported) and its column indices
+    EventExport* export_;
+    std::vector<unsigned int> columns_;
+    /// arena of the per-event containers (not owned; 0 for the heap)
+    EventArena* arena_;
+    /// electronId, jetID and b-tag discriminators of the current 
+    /// event in the order of the electron and jet collections
+    AssociationTable<float> electronIds_;
+    AssociationTable<reco::JetID> jetIDs_;
+    AssociationTable<float> btagEffValues_, btagPurValues_, btagVtxValues_, btagCSVValues_;
+
+    /// names of the histograms to be kept in sparse form
+    std::vector<std::string> sparseNames_;
+    /// sparse histograms
+    std::map<std::string,SparseHistogram> sparse_;
   };
 
   inline void 
   MonitorEnsemble::triggerBinLabels(std::string channel, const std::vector<std::string> labels)
   {
     for(unsigned int idx=0; idx<labels.size(); ++idx){
-      hists_[(channel+"Mon_").c_str()]->setBinLabel( idx+1, "["+monitorPath(labels[idx])+"]", 1);
-      hists_[(channel+"Eff_").c_str()]->setBinLabel( idx+1, "["+selectionPath(labels[idx])+"]|["+monitorPath(labels[idx])+"]", 1);
+      setBinLabel(channel+"Mon_", idx+1, "["+monitorPath(labels[idx])+"]", 1);
+      setBinLabel(channel+"Eff_", idx+1, "["+selectionPath(labels[idx])+"]|["+monitorPath(labels[idx])+"]", 1);
     }
   }
 
   inline void 
-  MonitorEnsemble::fill(const edm::Event& event, const edm::TriggerResults& triggerTable, std::string channel, const std::vector<std::string> labels) const
+  MonitorEnsemble::fill(const edm::Event& event, const edm::TriggerResults& triggerTable, const std::vector<std::string> labels)
   {
     for(unsigned int idx=0; idx<labels.size(); ++idx){
       if( accept(event, triggerTable, monitorPath(labels[idx])) ){
-	fill((channel+"Mon_").c_str(), idx+0.5 );
+	MonitorElement* mon=target(TRIGGER_MON).me; MonitorElement* eff=target(TRIGGER_EFF).me;
+	if( !mon || !eff ) continue;
+	fill(TRIGGER_MON, idx+0.5 );
 	// take care to fill triggerMon_ before evts is being called
-	int evts = hists_.find((channel+"Mon_").c_str())->second->getBinContent(idx+1);
-	double value = hists_.find((channel+"Eff_").c_str())->second->getBinContent(idx+1);
-	fill((channel+"Eff_").c_str(), idx+0.5, 1./evts*(accept(event, triggerTable, selectionPath(labels[idx]))-value));
+	int evts = mon->getBinContent(idx+1);
+	double value = eff->getBinContent(idx+1);
+	fillWeighted(TRIGGER_EFF, idx+0.5, 1./evts*(accept(event, triggerTable, selectionPath(labels[idx]))-value));
       }
     }
   }
@@ -170,6 +320,10 @@ namespace TopSingleLepton {
 
 #include <utility>
 
+#include "DQM/Physics/interface/SelectionGraph.h"
+#include "DQM/Physics/interface/SelectionTiming.h"
+#include "DQM/Physics/interface/MonitorSampling.h"
+#include "DQM/Physics/interface/LumiTrends.h"
 #include "DQM/Physics/interface/TopDQMHelpers.h"
 #include "FWCore/Framework/interface/EDAnalyzer.h"
 #include "FWCore/Framework/interface/Frameworkfwd.h"
@@ -217,10 +371,24 @@ class TopSingleLeptonDQM : public edm::EDAnalyzer  {
   ~TopSingleLeptonDQM(){
     if( vertexSelect_ ) delete vertexSelect_;
     if( beamspotSelect_ ) delete beamspotSelect_;
+    if( budget_ ) delete budget_;
+    if( timing_ ) delete timing_;
+    if( sampling_ ) delete sampling_;
+    if( trends_ ) delete trends_;
+    if( histograms_ ) delete histograms_;
+    if( export_ ) delete export_;
+    if( index_ ) delete index_;
   };
   
   /// do this during the event loop
   virtual void analyze(const edm::Event& event, const edm::EventSetup& setup);
+  /// keep the number of entries of the histograms and reset the trends at the beginning of the run
+  virtual void beginRun(const edm::Run& run, const edm::EventSetup& setup);
+  /// report histograms that have not been filled during the run
+  virtual void endRun(const edm::Run& run, const edm::EventSetup& setup);
+  /// flush buffered fills, append the trends and write the event index at the end
+  /// of each luminosity block
+  virtual void endLuminosityBlock(const edm::LuminosityBlock& lumi, const edm::EventSetup& setup);
     
  private:
   /// deduce object type from ParameterSet label, the label
@@ -229,6 +397,11 @@ class TopSingleLeptonDQM : public edm::EDAnalyzer  {
   /// deduce selection step from ParameterSet label, the 
   /// label is expected to be of type 'objectType:selectionStep' 
   std::string selectionStep(const std::string& label) { return label.substr(label.find(':')+1); };  
+  /// apply selection step _key_ via the shared SelectionGraph (timed if configured)
+  bool select(const std::string& key, const edm::Event& event, const edm::EventSetup& setup);
+  /// fill the MonitorEnsemble of selection step _key_ at position _step_ of
+  /// the selection order (timed and sampled if configured)
+  void fill(const std::string& key, unsigned int step, const edm::Event& event, const edm::EventSetup& setup);
 
  private:
   /// trigger table
@@ -254,6 +427,39 @@ class TopSingleLeptonDQM : public edm::EDAnalyzer  {
   /// MonitoringEnsemble keeps an instance of the MonitorEnsemble class to 
   /// be filled _after_ each selection step
   std::map<std::string, std::pair<edm::ParameterSet, TopSingleLepton::MonitorEnsemble*> > selection_;
+  /// memory budget for lazily booked histograms shared 
+  /// by all MonitorEnsembles of the module (optional)
+  BookingBudget* budget_;
+  /// histogram definitions shared by all MonitorEnsembles of the module
+  HistogramTable* histograms_;
+  /// selection graph the selection steps are registered with; this is the
+  /// SelectionGraph service if available and _localGraph_ otherwise
+  SelectionGraph* selectionGraph_;
+  SelectionGraph localGraph_;
+  /// ids of the selection steps in the selection graph (for all
+  /// selection step types supported by the SelectionGraph)
+  std::map<std::string, unsigned int> selectionIds_;
+  /// timing and rejection monitoring of the selection steps (optional)
+  SelectionTiming* timing_;
+  /// subsample of events for which the kinematic distributions
+  /// of the MonitorEnsembles are filled (optional)
+  MonitorSampling* sampling_;
+  /// number of events passing each selection step per
+  /// luminosity section (optional)
+  LumiTrends* trends_;
+  /// counters of the selection steps in the trends (in
+  /// the order of the selection steps)
+  std::vector<unsigned int> trendIds_;
+  /// export of the events passing the last selection step (optional)
+  EventExport* export_;
+  /// index of the events passing each selection step per
+  /// luminosity section (optional)
+  SelectionIndex* index_;
+  /// steps of the event index
+  std::map<std::string, unsigned int> indexIds_;
+  /// memory of the per-event containers of the MonitorEnsembles; 
+  /// reset at the beginning of each event
+  EventArena arena_;
 };
 
 #endif
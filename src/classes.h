@@ -0,0 +1,11 @@
+#include "DataFormats/Common/interface/Wrapper.h"
+#include "DQM/Physics/interface/HistogramDeltas.h"
+
+namespace {
+  struct dictionary {
+    HistogramDelta delta;
+    std::vector<HistogramDelta> deltas;
+    LumiHistogramDeltas lumiDeltas;
+    edm::Wrapper<LumiHistogramDeltas> wrappedLumiDeltas;
+  };
+}
@@ -1,4 +1,5 @@
 #include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
 
 #include "DQM/Physics/src/BPhysicsOniaDQM.h"
 //#include "DQM/Physics/src/EwkDQM.h"
@@ -16,6 +17,10 @@
 //#include "DQM/Physics/src/QcdUeDQM.h"
 #include "DQM/Physics/src/HiggsDQM.h"
 #include "DQM/Physics/src/ExoticaDQM.h"
+#include "DQM/Physics/interface/SelectionGraph.h"
+#include "DQM/Physics/src/AllocationCounter.h"
+#include "DQM/Physics/src/MEtoLumiDeltaConverter.h"
+#include "DQM/Physics/src/LumiDeltaToMEConverter.h"
 
 
 DEFINE_FWK_MODULE(BPhysicsOniaDQM);
@@ -34,3 +39,8 @@ DEFINE_FWK_MODULE(RecoSusyDQM);
 //DEFINE_FWK_MODULE(QcdUeDQM);
 DEFINE_FWK_MODULE(HiggsDQM);
 DEFINE_FWK_MODULE(ExoticaDQM);
+DEFINE_FWK_MODULE(MEtoLumiDeltaConverter);
+DEFINE_FWK_MODULE(LumiDeltaToMEConverter);
+
+DEFINE_FWK_SERVICE(SelectionGraph);
+DEFINE_FWK_SERVICE(AllocationCounter);
@@ -0,0 +1,93 @@
+#ifndef BENCHMARKTOOLS
+#define BENCHMARKTOOLS
+
+#include <new>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include <sys/time.h>
+
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/Math/interface/LorentzVector.h"
+#include "FWCore/FWLite/interface/AutoLibraryLoader.h"
+
+/**
+   Common fixture of the standalone benchmarks and tests in DQM/Physics/test
+
+   Counts all heap allocations and allocated bytes of the process (via the global
+   operator new) and provides the wall clock time, the random numbers and the four
+   vectors the synthetic inputs are generated from. As it replaces the global operator
+   new and delete, the header is to be included by exactly one source file per binary.
+   Usage:
+
+   benchmark::initialize();
+   unsigned long long allocs=benchmark::nAllocs; double start=benchmark::now();
+   ...
+   printf("%f ns, %llu allocations\n", benchmark::now()-start, benchmark::nAllocs-allocs);
+*/
+
+namespace benchmark {
+  // number of heap allocations and allocated bytes of the process
+  unsigned long long nAllocs=0, nBytes=0;
+  // results are accumulated here to keep the compiler
+  // from optimizing the benchmarked calls away
+  double sink=0.;
+}
+
+void* operator new(std::size_t size) throw(std::bad_alloc)
+{
+  ++benchmark::nAllocs; benchmark::nBytes+=size;
+  void* ptr=std::malloc(size ? size : 1);
+  if(!ptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) throw()
+{
+  std::free(ptr);
+}
+
+namespace benchmark {
+
+  // load the dictionaries and seed the random numbers, such
+  // that all runs are done on the same synthetic inputs
+  inline void initialize()
+  {
+    AutoLibraryLoader::enable();
+    std::srand(4711);
+  }
+
+  // wall clock time in ns
+  inline double now()
+  {
+    timeval tv; gettimeofday(&tv, 0);
+    return tv.tv_sec*1.e9+tv.tv_usec*1.e3;
+  }
+
+  // uniform random number in [low, high)
+  inline double uniform(double low, double high)
+  {
+    return low+(high-low)*(std::rand()/(RAND_MAX+1.));
+  }
+
+  // four vector from pt, eta, phi and mass; massless approximation for mass<0
+  inline math::XYZTLorentzVector p4(double pt, double eta, double phi, double mass)
+  {
+    double px=pt*cos(phi), py=pt*sin(phi), pz=pt*sinh(eta);
+    double p2=px*px+py*py+pz*pz;
+    return math::XYZTLorentzVector(px, py, pz, mass<0. ? sqrt(p2) : sqrt(p2+mass*mass));
+  }
+
+  // edm::View of the objects of _objects_ as handed to the modules by the
+  // event (without references to a product, i.e. refAt cannot be used)
+  template <typename Object>
+  edm::View<Object> view(const std::vector<Object>& objects)
+  {
+    std::vector<void const*> pointers;
+    for(unsigned int idx=0; idx<objects.size(); ++idx){ pointers.push_back(&objects[idx]); }
+    return edm::View<Object>(pointers, edm::helper_vector_ptr());
+  }
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+/**
+   Standalone correctness test for DQM/Physics/interface/DileptonPairs.h
+
+   Compares the invariant masses and the charge flags of all lepton pairs as computed
+   by DileptonPairs with the results of ROOT's LorentzVector (math::XYZTLorentzVector)
+   for synthetic events with 0-20 leptons. The leptons are generated with physical
+   masses, in the massless approximation (E=|p|, as used in the EWK and Higgs modules)
+   and with vanishing charge. Pairs are checked in both index orders. The test returns
+   a non-zero exit code if any mass deviates by more than the relative tolerance or if
+   any charge flag differs.
+
+   Usage: DileptonPairsTest [nEvents]
+*/
+
+#include <cstdio>
+#include <vector>
+
+#include "DQM/Physics/interface/DileptonPairs.h"
+#include "DQM/Physics/test/BenchmarkTools.h"
+
+using namespace benchmark;
+
+int main(int argc, char* argv[])
+{
+  initialize();
+  unsigned int nEvents = argc>1 ? std::atoi(argv[1]) : 10000;
+
+  // relative tolerance of the masses
+  const double tolerance=1.e-9;
+  unsigned long nPairs=0, nMassFailures=0, nFlagFailures=0; double maxDeviation=0.;
+
+  DileptonPairs pairs;
+  for(unsigned int evt=0; evt<nEvents; ++evt){
+    std::vector<math::XYZTLorentzVector> leptons; std::vector<int> charges;
+    unsigned int nLeptons=std::rand()%21;
+    for(unsigned int idx=0; idx<nLeptons; ++idx){
+      double masses[]={ 0.000511, 0.10566, 1.777, -1. };
+      leptons.push_back(p4(uniform(0.5, 200.), uniform(-2.5, 2.5), uniform(-M_PI, M_PI), masses[std::rand()%4]));
+      charges.push_back(std::rand()%5 ? (std::rand()%2 ? 1 : -1) : 0);
+    }
+
+    pairs.clear();
+    for(unsigned int idx=0; idx<nLeptons; ++idx){
+      pairs.add(leptons[idx].px(), leptons[idx].py(), leptons[idx].pz(), leptons[idx].energy(), charges[idx]);
+    }
+    pairs.compute();
+
+    for(unsigned int i=0; i<nLeptons; ++i){
+      for(unsigned int j=0; j<nLeptons; ++j){
+	if( i==j ) continue;
+	++nPairs;
+	double mass=(leptons[i]+leptons[j]).M();
+	double deviation=fabs(pairs.mass(i, j)-mass)/(fabs(mass)>1. ? fabs(mass) : 1.);
+	if( deviation>maxDeviation ) maxDeviation=deviation;
+	if( deviation>tolerance ){
+	  ++nMassFailures;
+	  if( nMassFailures<=10 ) printf("mass mismatch in event %u, pair (%u, %u): %.12g vs %.12g\n", evt, i, j, pairs.mass(i, j), mass);
+	}
+	int sign=charges[i]*charges[j];
+	if( pairs.sameSign(i, j)!=(sign>0) || pairs.oppositeSign(i, j)!=(sign<0) ){
+	  ++nFlagFailures;
+	  if( nFlagFailures<=10 ) printf("flag mismatch in event %u, pair (%u, %u): %u for charges %d, %d\n", evt, i, j, pairs.flags(i, j), charges[i], charges[j]);
+	}
+      }
+    }
+  }
+  printf("checked %lu pairs: %lu mass and %lu flag mismatches (max. relative deviation %g)\n", nPairs, nMassFailures, nFlagFailures, maxDeviation);
+  return (nMassFailures || nFlagFailures) ? 1 : 0;
+}
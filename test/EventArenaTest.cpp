@@ -0,0 +1,97 @@
+/**
+   Standalone correctness test for DQM/Physics/interface/EventArena.h
+
+   Simulates events, which fill a few ArenaVectors of plain values and pointers of random
+   size (growing beyond the first block of the arena) and reset the arena afterwards. It
+   checks that the allocations are aligned and do not overlap, that the memory is reused
+   after the reset (the first allocation of each event starts at the same address once
+   the blocks have been merged) and that, in the steady state, events which do not need
+   more memory than any event before do not allocate from the heap. Allocations larger
+   than a block and the heap fallback of the ArenaAllocator without arena are checked as
+   well. The test returns a non-zero exit code if any check fails.
+
+   Usage: EventArenaTest [nEvents]
+*/
+
+#include <vector>
+#include <cstdio>
+#include <cstring>
+
+#include "DQM/Physics/interface/EventArena.h"
+#include "DQM/Physics/test/TestTools.h"
+
+using namespace unittest;
+
+namespace {
+
+  // true if _ptr_ is aligned for any fundamental type
+  bool aligned(const void* ptr)
+  {
+    return (reinterpret_cast<size_t>(ptr)%(2*sizeof(double)))==0;
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  initialize();
+  unsigned int nEvents = argc>1 ? std::atoi(argv[1]) : 1000;
+
+  // small first block, such that the first events need to grow
+  EventArena arena(256);
+
+  // raw allocations: aligned, not overlapping, larger than a block
+  std::vector<unsigned char*> chunks; std::vector<size_t> sizes;
+  for(unsigned int idx=0; idx<64; ++idx){
+    size_t size=1+std::rand()%(idx%8 ? 100 : 1000);
+    chunks.push_back(static_cast<unsigned char*>(arena.allocate(size))); sizes.push_back(size);
+    std::memset(chunks.back(), idx, size);
+    check(aligned(chunks.back()), "alignment", 0);
+  }
+  bool intact=true;
+  for(unsigned int idx=0; idx<chunks.size(); ++idx){
+    for(size_t pos=0; pos<sizes[idx]; ++pos){ if( chunks[idx][pos]!=idx ) intact=false; }
+  }
+  check(intact, "non-overlapping allocations", 0);
+  arena.reset();
+
+  // events with scratch containers of random size; the steady state is
+  // reached as soon as the largest event so far fits into the merged block
+  void* first=0; size_t largest=0; unsigned long nSteadyEvents=0;
+  for(unsigned int evt=0; evt<nEvents; ++evt){
+    unsigned int nValues=std::rand()%(evt<nEvents/2 ? 2000 : 1000);
+    unsigned long long allocs=nAllocs;
+    {
+      ArenaVector<double>::type values(&arena);
+      ArenaVector<const double*>::type pointers(&arena);
+      // no reserve: the containers grow by reallocation within the arena
+      for(unsigned int idx=0; idx<nValues; ++idx){ values.push_back(idx); }
+      pointers.reserve(values.size());
+      for(unsigned int idx=0; idx<values.size(); ++idx){ pointers.push_back(&values[idx]); }
+      bool valid=values.size()==nValues && pointers.size()==nValues;
+      for(unsigned int idx=0; valid && idx<nValues; ++idx){ valid=(values[idx]==idx && *pointers[idx]==idx); }
+      check(valid, "container contents", evt);
+      check(values.empty() || aligned(&values[0]), "container alignment", evt);
+    }
+    arena.reset();
+    // the memory is reused from the beginning of the merged block
+    void* next=arena.allocate(1);
+    if( evt>0 ) check(next==first || nValues>largest, "reuse after reset", evt);
+    first=next;
+    arena.reset();
+    if( evt>0 && nValues<=largest ){ check(nAllocs==allocs, "no heap allocation in the steady state", evt); ++nSteadyEvents; }
+    if( nValues>largest ) largest=nValues;
+  }
+  check(nSteadyEvents>0, "steady state reached", nEvents);
+
+  // without arena the memory is taken from the heap
+  unsigned long long allocs=nAllocs;
+  {
+    ArenaVector<double>::type values;
+    values.push_back(1.);
+    check(values.get_allocator().arena()==0 && nAllocs>allocs, "heap fallback", nEvents);
+  }
+
+  printf("%lu events in the steady state\n", nSteadyEvents);
+  return summary();
+}
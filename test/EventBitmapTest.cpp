@@ -0,0 +1,138 @@
+/**
+   Standalone correctness test for DQM/Physics/interface/EventBitmap.h
+
+   Compares the EventBitmap with a std::set of the same event numbers for synthetic sets
+   with array and bitmap containers (sparse and dense event numbers within the same upper
+   48 bits): the contained events after _add_, the intersection (&=) and the union (|=)
+   of all combinations of container types, and the round trip through _serialize_ and
+   _deserialize_. Truncated data, data with a corrupt container size, unsorted array
+   containers, bitmap containers with a wrong size, invalid container types and containers
+   out of order have to be rejected by _deserialize_, records with a corrupt string length
+   by SelectionIndex::read. The test returns a non-zero exit code if any check fails.
+
+   Usage: EventBitmapTest [nSets]
+*/
+
+#include <set>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+#include <iterator>
+
+#include "DQM/Physics/interface/EventBitmap.h"
+#include "DQM/Physics/test/TestTools.h"
+
+using namespace unittest;
+
+namespace {
+
+  // true if _bitmap_ contains exactly the events of _reference_
+  bool equal(const EventBitmap& bitmap, const std::set<uint64_t>& reference)
+  {
+    std::vector<uint64_t> events=bitmap.events();
+    if( bitmap.size()!=reference.size() || events.size()!=reference.size() ) return false;
+    if( !std::equal(events.begin(), events.end(), reference.begin()) ) return false;
+    for(std::set<uint64_t>::const_iterator event=reference.begin(); event!=reference.end(); ++event){
+      if( !bitmap.contains(*event) ) return false;
+    }
+    return true;
+  }
+
+  // random set of events in a few containers; _density_ is the fraction
+  // of the 65536 events of a container which are added at most
+  void generate(EventBitmap& bitmap, std::set<uint64_t>& reference, double density)
+  {
+    unsigned int nContainers=1+std::rand()%3;
+    for(unsigned int container=0; container<nContainers; ++container){
+      uint64_t high=uint64_t(std::rand()%4)<<16 | uint64_t(std::rand()%2)<<40;
+      unsigned int nEvents=int(uniform(0., density)*65536);
+      for(unsigned int idx=0; idx<nEvents; ++idx){
+	uint64_t event=high|(std::rand()&0xffff);
+	bitmap.add(event); reference.insert(event);
+      }
+    }
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  initialize();
+  unsigned int nSets = argc>1 ? std::atoi(argv[1]) : 200;
+
+  // sparse sets have array containers only, dense sets have
+  // bitmap containers (more than 4096 events per container)
+  const double densities[]={ 0.02, 0.5 };
+  for(unsigned int set=0; set<nSets; ++set){
+    EventBitmap lhs, rhs; std::set<uint64_t> lhsRef, rhsRef;
+    generate(lhs, lhsRef, densities[set%2]);
+    generate(rhs, rhsRef, densities[(set/2)%2]);
+    check(equal(lhs, lhsRef) && equal(rhs, rhsRef), "add", set);
+
+    EventBitmap intersection=lhs; intersection&=rhs;
+    std::set<uint64_t> intersectionRef;
+    std::set_intersection(lhsRef.begin(), lhsRef.end(), rhsRef.begin(), rhsRef.end(), std::inserter(intersectionRef, intersectionRef.end()));
+    check(equal(intersection, intersectionRef), "operator&=", set);
+
+    EventBitmap unification=lhs; unification|=rhs;
+    std::set<uint64_t> unificationRef;
+    std::set_union(lhsRef.begin(), lhsRef.end(), rhsRef.begin(), rhsRef.end(), std::inserter(unificationRef, unificationRef.end()));
+    check(equal(unification, unificationRef), "operator|=", set);
+
+    std::string buffer; unification.serialize(buffer);
+    EventBitmap copy;
+    check(copy.deserialize(buffer.data(), buffer.size()) && equal(copy, unificationRef), "serialize/deserialize", set);
+    if( buffer.size()>4 ){
+      check(!copy.deserialize(buffer.data(), buffer.size()-1), "deserialize of truncated data", set);
+    }
+  }
+
+  // a container size beyond the data has to be rejected (the size
+  // field follows the number of containers, the upper bits and the type)
+  EventBitmap single; single.add(1);
+  std::string buffer; single.serialize(buffer);
+  buffer[4+6+1+3]=char(0x7f);
+  EventBitmap copy;
+  check(!copy.deserialize(buffer.data(), buffer.size()), "deserialize of corrupt size", nSets);
+
+  // the type has to be array or bitmap, the containers have to be in
+  // increasing order of their upper bits
+  EventBitmap two; two.add(1); two.add((uint64_t(1)<<16)|1);
+  buffer.clear(); two.serialize(buffer);
+  check(copy.deserialize(buffer.data(), buffer.size()) && copy.size()==2, "deserialize of two containers", nSets);
+  std::string invalid=buffer; invalid[4+6]=char(2);
+  check(!copy.deserialize(invalid.data(), invalid.size()), "deserialize of invalid type", nSets);
+  invalid=buffer; invalid[4+6+1+4+2]=char(0);
+  check(!copy.deserialize(invalid.data(), invalid.size()), "deserialize of duplicate container", nSets);
+
+  // the events of an array container have to be sorted, the number of
+  // bits of a bitmap container has to match its size
+  EventBitmap pair; pair.add(1); pair.add(2);
+  buffer.clear(); pair.serialize(buffer);
+  std::swap(buffer[4+6+1+4], buffer[4+6+1+4+2]);
+  check(!copy.deserialize(buffer.data(), buffer.size()), "deserialize of unsorted array", nSets);
+  EventBitmap dense;
+  for(uint64_t event=0; event<5000; ++event){ dense.add(2*event); }
+  buffer.clear(); dense.serialize(buffer);
+  check(copy.deserialize(buffer.data(), buffer.size()) && copy.size()==5000, "deserialize of bitmap", nSets);
+  buffer[4+6+1+4]^=char(0x02);
+  check(!copy.deserialize(buffer.data(), buffer.size()), "deserialize of bitmap with wrong size", nSets);
+
+  // a record of the SelectionIndex with a string length beyond the end of the
+  // data has to be rejected before the memory for the string is allocated
+  std::string record;
+  record.push_back(char(0xff)); record.push_back(char(0xff)); record+="top";
+  std::istringstream in(record, std::ios::in|std::ios::binary);
+  SelectionIndex::Record read;
+  check(!SelectionIndex::read(in, read) && !in.eof(), "read of corrupt string length", nSets);
+  record.clear(); record.push_back(char(3)); record.push_back(char(0)); record+="top";
+  record.push_back(char(4)); record.push_back(char(0)); record+="step";
+  record.append(8, char(1)); record.append(4, char(0xff));
+  in.str(record); in.clear();
+  unsigned long long bytes=nBytes;
+  check(!SelectionIndex::read(in, read) && !in.eof() && nBytes-bytes<1024, "read of corrupt event length", nSets);
+
+  return summary();
+}
@@ -0,0 +1,132 @@
+/**
+   Standalone memory/allocation benchmark for the per-event collection access in
+   DQM/Physics/src/ExoticaDQM.cc
+
+   Compares the former deep copies of the event collections into data members
+   (calojets, pfjets, pfjetsEI, pfelectronsEI, pfmuonsEI and the MET objects taken
+   by value) with the read-only access via the product of the edm::Handle as done
+   now. In both modes the two leading calo and PF jets are determined by
+   ExoticaDQM::leadingJets as in ExoticaDQM::analyze, with a fixed jet energy
+   correction in place of the JetCorrector. The collections are generated in memory
+   with typical multiplicities of low and high pileup events; for each access mode
+   the time, the number of heap allocations and the number of allocated bytes per
+   event are reported:
+
+    - copy                 : member = *handle; const MET met = metcol->front()
+    - view                 : leadingJets(*handle, ...); const MET& met = metcol->front()
+
+   Usage: ExoticaDQMCopyBenchmark [nEvents]
+*/
+
+#include <cstdio>
+#include <vector>
+
+#include "DQM/Physics/src/ExoticaDQM.h"
+#include "DQM/Physics/test/BenchmarkTools.h"
+#include "DataFormats/JetReco/interface/CaloJetCollection.h"
+#include "DataFormats/JetReco/interface/PFJetCollection.h"
+#include "DataFormats/METReco/interface/CaloMETCollection.h"
+#include "DataFormats/METReco/interface/PFMETCollection.h"
+#include "DataFormats/ParticleFlowCandidate/interface/PFCandidate.h"
+
+using namespace benchmark;
+
+namespace {
+
+  // fixed jet energy correction in place of the JetCorrector
+  struct Correction {
+    template <typename Jet> double operator()(const Jet& jet) const { return jet.pt()<30. ? 1.2 : 1.05; }
+  };
+
+  // leading calo and PF jets as determined in ExoticaDQM::analyze
+  double leadingJets(const reco::CaloJetCollection& caloJets, const reco::PFJetCollection& pfJets)
+  {
+    LeadingObjects<ExoticaDQM::LeadingJet, 2> leadingCaloJets, leadingPFJets;
+    ExoticaDQM::leadingJets(caloJets, Correction(), 0., leadingCaloJets);
+    double sum=ExoticaDQM::leadingJets(pfJets, Correction(), 30., leadingPFJets);
+    for(unsigned int idx=0; idx<leadingCaloJets.size(); ++idx){ sum+=leadingCaloJets.key(idx); }
+    for(unsigned int idx=0; idx<leadingPFJets.size(); ++idx){ sum+=leadingPFJets.key(idx); }
+    return sum;
+  }
+
+  // one synthetic event
+  struct Event {
+    reco::CaloJetCollection caloJets;
+    reco::PFJetCollection pfJets, pfJetsEI;
+    reco::PFCandidateCollection pfElectronsEI, pfMuonsEI;
+    reco::CaloMETCollection caloMETs;
+    reco::PFMETCollection pfMETs;
+  };
+
+  Event event(unsigned int nJets, unsigned int nLeptons)
+  {
+    Event evt;
+    for(unsigned int idx=0; idx<nJets; ++idx){
+      reco::Particle::LorentzVector jet=p4(uniform(10., 200.), uniform(-3., 3.), uniform(-M_PI, M_PI), uniform(5., 20.));
+      evt.caloJets.push_back(reco::CaloJet(jet, reco::CaloJet::Point(0., 0., 0.), reco::CaloJet::Specific()));
+      evt.pfJets  .push_back(reco::PFJet  (jet, reco::PFJet  ::Point(0., 0., 0.), reco::PFJet  ::Specific()));
+      evt.pfJetsEI.push_back(reco::PFJet  (jet, reco::PFJet  ::Point(0., 0., 0.), reco::PFJet  ::Specific()));
+    }
+    for(unsigned int idx=0; idx<nLeptons; ++idx){
+      evt.pfElectronsEI.push_back(reco::PFCandidate(idx%2 ? 1 : -1, p4(uniform(5., 100.), uniform(-2.5, 2.5), uniform(-M_PI, M_PI), 0.0005), reco::PFCandidate::e ));
+      evt.pfMuonsEI    .push_back(reco::PFCandidate(idx%2 ? 1 : -1, p4(uniform(5., 100.), uniform(-2.4, 2.4), uniform(-M_PI, M_PI), 0.106 ), reco::PFCandidate::mu));
+    }
+    evt.caloMETs.push_back(reco::CaloMET(SpecificCaloMETData(), 0., p4(uniform(10., 80.), 0., uniform(-M_PI, M_PI), 0.), reco::CaloMET::Point(0., 0., 0.)));
+    evt.pfMETs  .push_back(reco::PFMET  (SpecificPFMETData  (), 0., p4(uniform(10., 80.), 0., uniform(-M_PI, M_PI), 0.), reco::PFMET  ::Point(0., 0., 0.)));
+    return evt;
+  }
+
+  // previous access: deep copies into the data members
+  struct Copy {
+    reco::CaloJetCollection calojets;
+    reco::PFJetCollection pfjets, pfjetsEI;
+    reco::PFCandidateCollection pfelectronsEI, pfmuonsEI;
+
+    double operator()(const Event& evt){
+      calojets=evt.caloJets; pfjets=evt.pfJets; pfjetsEI=evt.pfJetsEI;
+      pfelectronsEI=evt.pfElectronsEI; pfmuonsEI=evt.pfMuonsEI;
+      const reco::CaloMET met=evt.caloMETs.front(); const reco::PFMET pfmet=evt.pfMETs.front();
+      double sum=met.et()+pfmet.et()+leadingJets(calojets, pfjets);
+      for(reco::PFJetCollection::const_iterator jet=pfjetsEI.begin(); jet!=pfjetsEI.end(); ++jet){ sum+=jet->pt(); }
+      return sum;
+    }
+  };
+
+  // current access: read-only access to the products
+  struct View {
+    double operator()(const Event& evt){
+      const reco::CaloMET& met=evt.caloMETs.front(); const reco::PFMET& pfmet=evt.pfMETs.front();
+      double sum=met.et()+pfmet.et()+leadingJets(evt.caloJets, evt.pfJets);
+      for(reco::PFJetCollection::const_iterator jet=evt.pfJetsEI.begin(); jet!=evt.pfJetsEI.end(); ++jet){ sum+=jet->pt(); }
+      return sum;
+    }
+  };
+
+  // run one access mode on all events and print one line of the report
+  template <typename Access>
+  void run(const char* name, unsigned int nJets, const std::vector<Event>& events, unsigned int nEvents)
+  {
+    Access access; double sum=0.;
+    unsigned long long allocs=nAllocs, bytes=nBytes; double start=now();
+    for(unsigned int evt=0; evt<nEvents; ++evt){ sum+=access(events[evt%events.size()]); }
+    double time=now()-start; sink+=sum;
+    printf("%-8s %6u %12.1f %14.2f %14.1f\n", name, nJets, time/nEvents, (double)(nAllocs-allocs)/nEvents, (double)(nBytes-bytes)/nEvents/1024.);
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  initialize();
+  unsigned int nEvents = argc>1 ? std::atoi(argv[1]) : 10000;
+
+  printf("%-8s %6s %12s %14s %14s\n", "access", "jets", "ns/event", "allocs/event", "kB/event");
+  for(unsigned int nJets=10; nJets<=160; nJets*=4){
+    std::vector<Event> events;
+    for(unsigned int evt=0; evt<20; ++evt){ events.push_back(event(nJets, nJets/5)); }
+    run<Copy>("copy", nJets, events, nEvents);
+    run<View>("view", nJets, events, nEvents);
+  }
+  printf("(checksum %g)\n", sink);
+  return 0;
+}
@@ -0,0 +1,89 @@
+/**
+   Standalone correctness test for DQM/Physics/interface/LeadingObjects.h
+
+   Offers synthetic collections of 0-20 objects to LeadingObjects lists of different
+   length K and compares the kept sort keys and payloads with the first K objects of a
+   stable sort of the collection in descending order of the sort key. The sort keys are
+   drawn from a small set of values, such that ties are frequent: of several objects with
+   equal sort key the ones offered first have to be kept, in the order in which they were
+   offered. Collections with more objects than K check the overflow of the list, lists
+   without payload (NoPayload) check the sort keys only. The test returns a non-zero exit
+   code if any check fails.
+
+   Usage: LeadingObjectsTest [nEvents]
+*/
+
+#include <vector>
+#include <algorithm>
+
+#include "DQM/Physics/interface/LeadingObjects.h"
+#include "DQM/Physics/test/TestTools.h"
+
+using namespace unittest;
+
+namespace {
+
+  // sort key and position in the collection of an object
+  struct Object { double key; unsigned int idx; };
+  // descending order of the sort key
+  bool harder(const Object& lhs, const Object& rhs){ return lhs.key>rhs.key; }
+
+  // offer _objects_ to a list of length K and compare it with the
+  // expectation; _leading_ has to be cleared by the caller
+  template <unsigned int K>
+  void test(LeadingObjects<unsigned int, K>& leading, LeadingObjects<NoPayload, K>& keys, const std::vector<Object>& objects, unsigned int evt)
+  {
+    std::vector<Object> sorted(objects);
+    std::stable_sort(sorted.begin(), sorted.end(), harder);
+    unsigned int n=std::min<unsigned int>(K, sorted.size());
+    // an object is kept if it is among the leading ones of the
+    // objects offered so far (the list never drops it later on)
+    for(unsigned int idx=0; idx<objects.size(); ++idx){
+      unsigned int rank=0;
+      for(unsigned int prev=0; prev<idx; ++prev){ if( !(objects[idx].key>objects[prev].key) ) ++rank; }
+      check(leading.push(objects[idx].key, objects[idx].idx)==(rank<K), "push", evt);
+      check(keys.push(objects[idx].key)==(rank<K), "push without payload", evt);
+    }
+    check(leading.size()==n, "size", evt);
+    check(keys.size()==n, "size without payload", evt);
+    for(unsigned int idx=0; idx<n && idx<leading.size(); ++idx){
+      check(leading.key(idx)==sorted[idx].key, "key", evt);
+      check(leading[idx]==sorted[idx].idx, "payload", evt);
+      check(keys.key(idx)==sorted[idx].key, "key without payload", evt);
+    }
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  initialize();
+  unsigned int nEvents = argc>1 ? std::atoi(argv[1]) : 10000;
+
+  LeadingObjects<unsigned int, 1> leading1; LeadingObjects<NoPayload, 1> keys1;
+  LeadingObjects<unsigned int, 2> leading2; LeadingObjects<NoPayload, 2> keys2;
+  LeadingObjects<unsigned int, 4> leading4; LeadingObjects<NoPayload, 4> keys4;
+  for(unsigned int evt=0; evt<nEvents; ++evt){
+    std::vector<Object> objects;
+    unsigned int nObjects=std::rand()%21;
+    for(unsigned int idx=0; idx<nObjects; ++idx){
+      // few distinct keys to have frequent ties
+      Object object={ 10.*(std::rand()%8), idx }; objects.push_back(object);
+    }
+    leading1.clear(); keys1.clear(); test(leading1, keys1, objects, evt);
+    leading2.clear(); keys2.clear(); test(leading2, keys2, objects, evt);
+    leading4.clear(); keys4.clear(); test(leading4, keys4, objects, evt);
+  }
+
+  // ties: equal keys are kept in the order in which they were
+  // offered; once the list is full an equal key is not kept
+  LeadingObjects<unsigned int, 2> ties;
+  check(ties.push(5., 0), "tie", 0); check(ties.push(5., 1), "tie", 1); check(!ties.push(5., 2), "tie", 2);
+  check(ties[0]==0 && ties[1]==1, "tie order", 0);
+  check(ties.push(6., 3) && ties[0]==3 && ties[1]==0 && ties.key(1)==5., "tie overflow", 0);
+  // the list is empty after clear
+  ties.clear(); check(ties.size()==0, "clear", 0);
+  check(ties.push(-1., 4) && ties.size()==1 && ties[0]==4, "clear", 1);
+
+  return summary();
+}
@@ -0,0 +1,82 @@
+/**
+   Standalone correctness test for DQM/Physics/interface/LogAxis.h
+
+   Compares the bin found by LogAxis::bin with the bin found by TAxis::FindBin for an axis
+   with the same (float) bin edges. Logarithmically spaced axes, an axis with a first edge
+   of 0 followed by logarithmically spaced edges (as used for counts) and an axis with
+   irregular edges are checked for values exactly at the edges and just below and above
+   them, for values within the bins, for under- and overflow and for negative values.
+   The center of each bin has to be found in the bin itself. The test returns a non-zero
+   exit code if any check fails.
+
+   Usage: LogAxisTest [nValues]
+*/
+
+#include <cmath>
+#include <vector>
+#include <cstdio>
+
+#include "TAxis.h"
+#include "DQM/Physics/interface/LogAxis.h"
+#include "DQM/Physics/test/TestTools.h"
+
+using namespace unittest;
+
+namespace {
+
+  // compare the bin of _x_ of _logAxis_ and of the ROOT axis _axis_
+  void compare(const LogAxis& logAxis, TAxis& axis, double x, unsigned int idx)
+  {
+    int bin=axis.FindBin(x);
+    check(logAxis.bin(x)==bin, "bin", idx);
+  }
+
+  // check the bins of _edges_ against TAxis::FindBin
+  void test(LogAxis logAxis, unsigned int nValues, unsigned int idx)
+  {
+    int n=logAxis.nBins();
+    std::vector<double> edges(logAxis.edges(), logAxis.edges()+n+1);
+    TAxis axis(n, &edges[0]);
+    // at and next to the edges
+    for(int edge=0; edge<=n; ++edge){
+      compare(logAxis, axis, edges[edge], idx);
+      compare(logAxis, axis, nextafter(edges[edge], -1.e30), idx);
+      compare(logAxis, axis, nextafter(edges[edge],  1.e30), idx);
+      compare(logAxis, axis, nextafter((double)nextafterf(edges[edge], -1.e30f), 1.e30), idx);
+    }
+    // within the bins, under- and overflow
+    double low=edges[0]>0. ? log10(edges[0])-1. : -1., high=log10(edges[n])+1.;
+    for(unsigned int value=0; value<nValues; ++value){
+      compare(logAxis, axis, std::pow(10., uniform(low, high)), idx);
+      compare(logAxis, axis, uniform(edges[0]-1., edges[n]+1.), idx);
+    }
+    compare(logAxis, axis, -1., idx); compare(logAxis, axis, 0., idx); compare(logAxis, axis, -0., idx);
+    // the centers are within the bins
+    for(int bin=1; bin<=n; ++bin){
+      check(axis.FindBin(logAxis.center(bin))==bin, "center", idx);
+    }
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  initialize();
+  unsigned int nValues = argc>1 ? std::atoi(argv[1]) : 100000;
+
+  // logarithmically spaced axes
+  test(LogAxis(200, 1., 1000.), nValues, 0);
+  test(LogAxis(7, 0.01, 1.e5), nValues, 1);
+  test(LogAxis(1, 2., 3.), nValues, 2);
+  // first edge 0, followed by logarithmically spaced edges
+  std::vector<double> counts(1, 0.);
+  for(unsigned int idx=0; idx<=60; ++idx){ counts.push_back(std::pow(1.e6, idx/60.)); }
+  test(LogAxis(counts), nValues, 3);
+  // irregular edges
+  double irregular[]={ -5., 0., 1., 2., 5., 10., 50., 51., 1000. };
+  test(LogAxis(std::vector<double>(irregular, irregular+9)), nValues, 4);
+  double positive[]={ 0.5, 1., 2., 4., 8., 16., 33., 64. };
+  test(LogAxis(std::vector<double>(positive, positive+8)), nValues, 5);
+
+  return summary();
+}
@@ -0,0 +1,119 @@
+/**
+   Standalone correctness test for DQM/Physics/interface/NMinusOne.h
+
+   Fills a table of N-1 histograms (one per flag, one for all flags, one filled once
+   per event and one which requires a context bit) for all bitmasks of the flags and
+   compares the number of entries and the mean of each histogram with the expectation:
+   for all flags passed each histogram is filled, for a single failed flag only the
+   histogram of this flag is filled (with its own value) and for more than one failed
+   flag nothing is filled. The once-per-event histogram has to be filled at most once
+   between two calls of reset. The test returns a non-zero exit code if any check fails.
+
+   Usage: NMinusOneTest
+*/
+
+#include <cstdio>
+#include <vector>
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "DQMServices/Core/interface/MonitorElement.h"
+#include "DQM/Physics/interface/NMinusOne.h"
+#include "DQM/Physics/test/TestTools.h"
+
+using namespace unittest;
+
+namespace {
+
+  // number of flags of the test
+  const unsigned int NFLAGS = 4;
+  // value slot of the event quantity and of the quantity
+  // with a required context bit (after those of the flags)
+  const unsigned int EVENT = NFLAGS, BARREL = NFLAGS+1;
+  // context bit required by the barrel histogram
+  const unsigned int INBARREL = 1;
+
+  // number of failed flags in _mask_
+  unsigned int nFailed(unsigned int mask)
+  {
+    unsigned int n=0;
+    for(unsigned int flag=0; flag<NFLAGS; ++flag){ if( !(mask&NMinusOne::bit(flag)) ) ++n; }
+    return n;
+  }
+
+  // check that _me_ got _entries_ new entries since _before_ and
+  // that its mean equals _value_ (if it has been filled at all)
+  void compare(MonitorElement* me, double before, double entries, double value, unsigned int idx)
+  {
+    check(me->getEntries()-before==entries, "entries", idx);
+    if( me->getEntries()>0 ) check(me->getMean()==value, "mean", idx);
+  }
+
+}
+
+int main()
+{
+  initialize();
+
+  DQMStore store((edm::ParameterSet()));
+  store.setCurrentFolder("NMinusOneTest");
+
+  // one histogram per flag, filled with a value
+  // that is specific for the flag
+  NMinusOne nMinusOne(NFLAGS, NFLAGS+2);
+  std::vector<MonitorElement*> flags;
+  for(unsigned int flag=0; flag<NFLAGS; ++flag){
+    char name[16]; sprintf(name, "flag%u", flag);
+    flags.push_back(store.book1D(name, name, 10, 0., 10.));
+    nMinusOne.add(flag, flags.back(), flag);
+    nMinusOne.set(flag, flag+0.5);
+  }
+  // histograms for all flags passed, filled once per event
+  // and filled only in the barrel context
+  MonitorElement* all=store.book1D("all", "all", 10, 0., 10.);
+  nMinusOne.add(NMinusOne::ALL, all, EVENT);
+  MonitorElement* once=store.book1D("once", "once", 10, 0., 10.);
+  nMinusOne.add(NMinusOne::ALL, once, EVENT, true);
+  MonitorElement* barrel=store.book1D("barrel", "barrel", 10, 0., 10.);
+  nMinusOne.add(0, barrel, BARREL, false, INBARREL);
+  nMinusOne.set(EVENT, 7.5); nMinusOne.set(BARREL, 8.5);
+
+  // all bitmasks of the flags (with bits beyond the flags
+  // set or not), each in a new event and in the barrel
+  for(unsigned int mask=0; mask<(1u<<(NFLAGS+1)); ++mask){
+    std::vector<double> before;
+    for(unsigned int flag=0; flag<NFLAGS; ++flag){ before.push_back(flags[flag]->getEntries()); }
+    double beforeAll=all->getEntries(), beforeOnce=once->getEntries(), beforeBarrel=barrel->getEntries();
+
+    nMinusOne.reset();
+    unsigned int failed=nFailed(mask);
+    check(nMinusOne.passed(mask)==(failed==0), "passed", mask);
+    check(nMinusOne.passedNMinusOne(mask)==(failed<=1), "passedNMinusOne", mask);
+    check(nMinusOne.fill(mask, INBARREL)==(failed<=1), "fill", mask);
+    for(unsigned int flag=0; flag<NFLAGS; ++flag){
+      bool filled=(failed==0) || (failed==1 && !(mask&NMinusOne::bit(flag)));
+      compare(flags[flag], before[flag], filled ? 1 : 0, flag+0.5, mask);
+    }
+    compare(all, beforeAll, failed==0 ? 1 : 0, 7.5, mask);
+    compare(barrel, beforeBarrel, (failed==0 || (failed==1 && !(mask&NMinusOne::bit(0)))) ? 1 : 0, 8.5, mask);
+
+    // a second fill in the same event leaves the once-per-event
+    // histogram untouched; the others are filled again
+    nMinusOne.fill(mask, INBARREL);
+    compare(once, beforeOnce, failed==0 ? 1 : 0, 7.5, mask);
+    compare(all, beforeAll, failed==0 ? 2 : 0, 7.5, mask);
+  }
+
+  // without the barrel context the barrel histogram is not filled
+  double beforeBarrel=barrel->getEntries(), beforeOnce=once->getEntries();
+  nMinusOne.reset();
+  check(nMinusOne.fill(NMinusOne::bit(1)|NMinusOne::bit(2)|NMinusOne::bit(3)), "fill", 0);
+  compare(barrel, beforeBarrel, 0, 8.5, 0);
+  // the once-per-event state is cleared by reset only
+  nMinusOne.fill(~0u); compare(once, beforeOnce, 1, 7.5, 1);
+  nMinusOne.fill(~0u); compare(once, beforeOnce, 1, 7.5, 2);
+  nMinusOne.reset();
+  nMinusOne.fill(~0u); compare(once, beforeOnce, 2, 7.5, 3);
+
+  return summary();
+}
@@ -0,0 +1,640 @@
+#include "DQM/Physics/test/SyntheticEventProducers.h"
+
+#include <cmath>
+#include <memory>
+#include <algorithm>
+
+#include "CLHEP/Random/RandFlat.h"
+#include "CLHEP/Random/RandGauss.h"
+#include "CLHEP/Random/RandPoissonQ.h"
+#include "CLHEP/Random/RandExponential.h"
+#include "CLHEP/Random/RandBreitWigner.h"
+#include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/RandomNumberGenerator.h"
+#include "Math/GenVector/Boost.h"
+
+#include "DataFormats/Common/interface/Handle.h"
+#include "DataFormats/Common/interface/View.h"
+#include "DataFormats/Common/interface/ValueMap.h"
+#include "DataFormats/DetId/interface/DetId.h"
+#include "DataFormats/MuonDetId/interface/DTLayerId.h"
+#include "DataFormats/MuonDetId/interface/DTChamberId.h"
+#include "DataFormats/SiPixelDetId/interface/PixelSubdetector.h"
+#include "DataFormats/SiStripDetId/interface/StripSubdetector.h"
+#include "DataFormats/TrackingRecHit/interface/InvalidTrackingRecHit.h"
+#include "DataFormats/TrackReco/interface/Track.h"
+#include "DataFormats/TrackReco/interface/TrackFwd.h"
+#include "DataFormats/GsfTrackReco/interface/GsfTrack.h"
+#include "DataFormats/GsfTrackReco/interface/GsfTrackFwd.h"
+#include "DataFormats/EgammaReco/interface/SuperCluster.h"
+#include "DataFormats/EgammaReco/interface/SuperClusterFwd.h"
+#include "DataFormats/EgammaCandidates/interface/GsfElectron.h"
+#include "DataFormats/EgammaCandidates/interface/GsfElectronCore.h"
+#include "DataFormats/EgammaCandidates/interface/GsfElectronFwd.h"
+#include "DataFormats/EgammaCandidates/interface/GsfElectronCoreFwd.h"
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/MuonReco/interface/MuonFwd.h"
+#include "DataFormats/MuonReco/interface/MuonChamberMatch.h"
+#include "DataFormats/MuonReco/interface/MuonSegmentMatch.h"
+#include "DataFormats/MuonReco/interface/MuonIsolation.h"
+#include "DataFormats/VertexReco/interface/Vertex.h"
+#include "DataFormats/VertexReco/interface/VertexFwd.h"
+#include "DataFormats/JetReco/interface/PFJet.h"
+#include "DataFormats/JetReco/interface/PFJetCollection.h"
+#include "DataFormats/JetReco/interface/CaloJet.h"
+#include "DataFormats/JetReco/interface/CaloJetCollection.h"
+#include "DataFormats/METReco/interface/MET.h"
+#include "DataFormats/METReco/interface/METFwd.h"
+#include "DataFormats/METReco/interface/PFMET.h"
+#include "DataFormats/METReco/interface/PFMETFwd.h"
+#include "DataFormats/METReco/interface/CaloMET.h"
+#include "DataFormats/METReco/interface/CaloMETFwd.h"
+#include "DataFormats/BTauReco/interface/JetTag.h"
+
+namespace {
+
+  /// radius of the ECAL barrel, for the position of the super clusters
+  const double ECAL_RADIUS=129.;
+
+  /// sort four momenta in descending pt
+  bool ptGreater(const reco::Candidate::LorentzVector& first, const reco::Candidate::LorentzVector& second)
+  {
+    return first.pt()>second.pt();
+  }
+
+  /// add valid pixel, strip and muon hits to the hit pattern of a track
+  void addHits(reco::TrackBase& track, unsigned int nPixel, unsigned int nStrip, unsigned int nMuon)
+  {
+    unsigned int idx=0;
+    for(unsigned int hit=0; hit<nPixel; ++hit, ++idx){
+      track.setHitPattern(InvalidTrackingRecHit(DetId(DetId::Tracker, PixelSubdetector::PixelBarrel), TrackingRecHit::valid), idx);
+    }
+    for(unsigned int hit=0; hit<nStrip; ++hit, ++idx){
+      track.setHitPattern(InvalidTrackingRecHit(DetId(DetId::Tracker, StripSubdetector::TIB), TrackingRecHit::valid), idx);
+    }
+    for(unsigned int hit=0; hit<nMuon; ++hit, ++idx){
+      // distribute the muon hits over the 4 DT stations
+      track.setHitPattern(InvalidTrackingRecHit(DTLayerId(0, 1+hit%4, 1, 1, 1), TrackingRecHit::valid), idx);
+    }
+  }
+
+  /// reference point of a track with transverse impact parameter dxy w.r.t. the
+  /// beam spot and longitudinal position z (see reco::TrackBase::dxy)
+  math::XYZPoint referencePoint(const reco::BeamSpot& beamSpot, const reco::Candidate::LorentzVector& p4, double dxy, double z)
+  {
+    return math::XYZPoint(beamSpot.x0()-dxy*sin(p4.phi()), beamSpot.y0()+dxy*cos(p4.phi()), z);
+  }
+
+  /// number of vertices of the event and z position of the first one
+  unsigned int vertices(const edm::Event& event, const edm::InputTag& src, double& z)
+  {
+    edm::Handle<reco::VertexCollection> vertices;
+    if( !event.getByLabel(src, vertices) || vertices->empty() ){ z=0.; return 1; }
+    z=vertices->front().z();
+    return vertices->size();
+  }
+
+  /// candidate of a synthetic lepton
+  struct Lepton {
+    reco::Candidate::LorentzVector p4; int charge; bool fake;
+  };
+
+  /// leptons of the event: non-resonant ones plus possibly a resonant pair
+  std::vector<Lepton> leptons(SyntheticGenerator& random, double mean, double ptMin, double ptSlope, double etaMax,
+			      double resonanceFraction, double resonanceMass, double resonanceWidth, double fakeFraction, double mass)
+  {
+    std::vector<Lepton> leptons;
+    if( random.flat()<resonanceFraction ){
+      std::pair<reco::Candidate::LorentzVector, reco::Candidate::LorentzVector> pair=random.resonance(resonanceMass, resonanceWidth, etaMax, mass);
+      int charge=random.charge();
+      Lepton first={ pair.first, charge, false }; Lepton second={ pair.second, -charge, false };
+      leptons.push_back(first); leptons.push_back(second);
+    }
+    unsigned int n=random.multiplicity(mean);
+    for(unsigned int idx=0; idx<n; ++idx){
+      Lepton lepton={ random.p4(random.pt(ptMin, ptSlope), etaMax, mass), random.charge(), random.flat()<fakeFraction };
+      leptons.push_back(lepton);
+    }
+    return leptons;
+  }
+
+}
+
+void
+SyntheticGenerator::init()
+{
+  edm::Service<edm::RandomNumberGenerator> rng;
+  if( !rng.isAvailable() ){
+    throw cms::Exception("Configuration")
+      << "The synthetic event producers require the RandomNumberGeneratorService\n";
+  }
+  engine_=&rng->getEngine();
+}
+
+double
+SyntheticGenerator::flat(double low, double high)
+{
+  return CLHEP::RandFlat::shoot(engine_, low, high);
+}
+
+double
+SyntheticGenerator::gauss(double mean, double sigma)
+{
+  return CLHEP::RandGauss::shoot(engine_, mean, sigma);
+}
+
+unsigned int
+SyntheticGenerator::multiplicity(double mean)
+{
+  return mean>0. ? CLHEP::RandPoissonQ::shoot(engine_, mean) : 0;
+}
+
+double
+SyntheticGenerator::pt(double ptMin, double slope)
+{
+  return ptMin+CLHEP::RandExponential::shoot(engine_, slope);
+}
+
+int
+SyntheticGenerator::charge()
+{
+  return flat()<0.5 ? -1 : 1;
+}
+
+reco::Candidate::LorentzVector
+SyntheticGenerator::p4(double pt, double etaMax, double mass)
+{
+  reco::Candidate::PolarLorentzVector p4(pt, flat(-etaMax, etaMax), flat(-M_PI, M_PI), mass);
+  return reco::Candidate::LorentzVector(p4);
+}
+
+std::pair<reco::Candidate::LorentzVector, reco::Candidate::LorentzVector>
+SyntheticGenerator::resonance(double mass, double width, double etaMax, double daughterMass)
+{
+  // mass of the resonance, kept well above the threshold
+  double m=CLHEP::RandBreitWigner::shoot(engine_, mass, width);
+  m=std::max(m, 2.*daughterMass+1.);
+  // isotropic decay in the rest frame
+  double p=sqrt(0.25*m*m-daughterMass*daughterMass), cosTheta=flat(-1., 1.), phi=flat(-M_PI, M_PI);
+  double sinTheta=sqrt(1.-cosTheta*cosTheta), energy=0.5*m;
+  reco::Candidate::LorentzVector first ( p*sinTheta*cos(phi),  p*sinTheta*sin(phi),  p*cosTheta, energy);
+  reco::Candidate::LorentzVector second(-p*sinTheta*cos(phi), -p*sinTheta*sin(phi), -p*cosTheta, energy);
+  // boost into the lab frame; the resonance has a soft pt spectrum
+  // and is flat in rapidity within the acceptance
+  double pt=CLHEP::RandExponential::shoot(engine_, 10.), rapidity=flat(-0.8*etaMax, 0.8*etaMax), mt=sqrt(m*m+pt*pt), angle=flat(-M_PI, M_PI);
+  reco::Candidate::LorentzVector mother(pt*cos(angle), pt*sin(angle), mt*sinh(rapidity), mt*cosh(rapidity));
+  ROOT::Math::Boost boost(mother.BoostToCM());
+  boost.Invert();
+  return std::make_pair(boost(first), boost(second));
+}
+
+SyntheticBeamSpotProducer::SyntheticBeamSpotProducer(const edm::ParameterSet& cfg):
+  position_(cfg.getParameter<double>("x"), cfg.getParameter<double>("y"), cfg.getParameter<double>("z")),
+  sigmaZ_(cfg.getParameter<double>("sigmaZ"))
+{
+  produces<reco::BeamSpot>();
+}
+
+void
+SyntheticBeamSpotProducer::produce(edm::Event& event, const edm::EventSetup& setup)
+{
+  reco::BeamSpot::CovarianceMatrix error;
+  for(unsigned int idx=0; idx<7; ++idx){ error(idx, idx)=1.e-8; }
+  std::auto_ptr<reco::BeamSpot> beamSpot(new reco::BeamSpot(position_, sigmaZ_, 0., 0., 0.0015, error, reco::BeamSpot::Tracker));
+  event.put(beamSpot);
+}
+
+SyntheticVertexProducer::SyntheticVertexProducer(const edm::ParameterSet& cfg):
+  beamSpot_(cfg.getParameter<edm::InputTag>("beamSpot")),
+  pileup_(cfg.getParameter<double>("pileup"))
+{
+  produces<reco::TrackCollection>();
+  produces<reco::VertexCollection>();
+}
+
+void
+SyntheticVertexProducer::produce(edm::Event& event, const edm::EventSetup& setup)
+{
+  random_.init();
+  edm::Handle<reco::BeamSpot> beamSpot;
+  event.getByLabel(beamSpot_, beamSpot);
+
+  std::auto_ptr<reco::TrackCollection> tracks(new reco::TrackCollection);
+  std::auto_ptr<reco::VertexCollection> vertices(new reco::VertexCollection);
+  reco::TrackRefProd trackRefs=event.getRefBeforePut<reco::TrackCollection>();
+  unsigned int n=1+random_.multiplicity(pileup_);
+  for(unsigned int idx=0; idx<n; ++idx){
+    // the hard interaction has more tracks than the pileup interactions
+    unsigned int nTracks=(idx==0) ? 20+random_.multiplicity(40.) : 3+random_.multiplicity(15.);
+    reco::Vertex::Point position(random_.gauss(beamSpot->x0(), 0.0015), random_.gauss(beamSpot->y0(), 0.0015), random_.gauss(beamSpot->z0(), beamSpot->sigmaZ()));
+    reco::Vertex::Error error;
+    error(0, 0)=error(1, 1)=1.e-6; error(2, 2)=1.e-5;
+    double ndof=2.*nTracks-3.;
+    reco::Vertex vertex(position, error, fabs(random_.gauss(ndof, sqrt(2.*ndof))), ndof, nTracks);
+    // soft tracks attached to the vertex
+    for(unsigned int trk=0; trk<nTracks; ++trk){
+      reco::Candidate::LorentzVector p4=random_.p4(random_.pt(0.3, 1.), 2.5, 0.13957);
+      math::XYZVector momentum(p4.px(), p4.py(), p4.pz());
+      tracks->push_back(reco::Track(random_.flat(0.5, 1.5)*10., 10., position, momentum, random_.charge(), reco::TrackBase::CovarianceMatrix()));
+      vertex.add(reco::TrackBaseRef(reco::TrackRef(trackRefs, tracks->size()-1)), 1.);
+    }
+    vertices->push_back(vertex);
+  }
+  event.put(tracks);
+  event.put(vertices);
+}
+
+SyntheticMuonProducer::SyntheticMuonProducer(const edm::ParameterSet& cfg):
+  beamSpot_(cfg.getParameter<edm::InputTag>("beamSpot")),
+  vertices_(cfg.getParameter<edm::InputTag>("vertices")),
+  mean_(cfg.getParameter<double>("mean")),
+  ptMin_(cfg.getParameter<double>("ptMin")),
+  ptSlope_(cfg.getParameter<double>("ptSlope")),
+  etaMax_(cfg.getParameter<double>("etaMax")),
+  resonanceFraction_(cfg.getParameter<double>("resonanceFraction")),
+  resonanceMass_(cfg.getParameter<double>("resonanceMass")),
+  resonanceWidth_(cfg.getParameter<double>("resonanceWidth")),
+  fakeFraction_(cfg.getParameter<double>("fakeFraction")),
+  isoPerVertex_(cfg.getParameter<double>("isoPerVertex"))
+{
+  produces<reco::TrackCollection>("inner");
+  produces<reco::TrackCollection>("outer");
+  produces<reco::TrackCollection>("global");
+  produces<reco::MuonCollection>();
+}
+
+void
+SyntheticMuonProducer::produce(edm::Event& event, const edm::EventSetup& setup)
+{
+  random_.init();
+  edm::Handle<reco::BeamSpot> beamSpot;
+  event.getByLabel(beamSpot_, beamSpot);
+  double z=0.; unsigned int nVertices=vertices(event, vertices_, z);
+
+  std::auto_ptr<reco::TrackCollection> inner (new reco::TrackCollection);
+  std::auto_ptr<reco::TrackCollection> outer (new reco::TrackCollection);
+  std::auto_ptr<reco::TrackCollection> global(new reco::TrackCollection);
+  std::auto_ptr<reco::MuonCollection> muons(new reco::MuonCollection);
+  reco::TrackRefProd innerRefs =event.getRefBeforePut<reco::TrackCollection>("inner" );
+  reco::TrackRefProd outerRefs =event.getRefBeforePut<reco::TrackCollection>("outer" );
+  reco::TrackRefProd globalRefs=event.getRefBeforePut<reco::TrackCollection>("global");
+
+  std::vector<Lepton> candidates=leptons(random_, mean_, ptMin_, ptSlope_, etaMax_, resonanceFraction_, resonanceMass_, resonanceWidth_, fakeFraction_, 0.10566);
+  for(unsigned int idx=0; idx<candidates.size(); ++idx){
+    const Lepton& lepton=candidates[idx];
+    // prompt muons are well measured and come from the primary vertex,
+    // fake muons (e.g. from decays in flight) have few hits and large dxy
+    double dxy=lepton.fake ? random_.gauss(0., 0.1) : random_.gauss(0., 0.002);
+    math::XYZPoint point=referencePoint(*beamSpot, lepton.p4, dxy, random_.gauss(z, 0.005));
+    math::XYZVector momentum(lepton.p4.px(), lepton.p4.py(), lepton.p4.pz());
+    double chi2=lepton.fake ? 20.*random_.flat(0.5, 2.) : random_.flat(0.5, 1.5);
+
+    reco::Track innerTrack(chi2*15., 15., point, momentum, lepton.charge, reco::TrackBase::CovarianceMatrix());
+    addHits(innerTrack, lepton.fake ? random_.multiplicity(1.) : 2+random_.multiplicity(1.5), lepton.fake ? 3+random_.multiplicity(3.) : 8+random_.multiplicity(4.), 0);
+    reco::Track outerTrack(chi2*20., 20., point, momentum, lepton.charge, reco::TrackBase::CovarianceMatrix());
+    unsigned int muonHits=lepton.fake ? random_.multiplicity(2.) : 15+random_.multiplicity(10.);
+    addHits(outerTrack, 0, 0, muonHits);
+    reco::Track globalTrack(chi2*35., 35., point, momentum, lepton.charge, reco::TrackBase::CovarianceMatrix());
+    addHits(globalTrack, innerTrack.hitPattern().numberOfValidPixelHits(), innerTrack.hitPattern().numberOfValidStripHits(), muonHits);
+    inner ->push_back(innerTrack );
+    outer ->push_back(outerTrack );
+    global->push_back(globalTrack);
+
+    reco::Muon muon(lepton.charge, lepton.p4, point);
+    muon.setInnerTrack (reco::TrackRef(innerRefs , idx));
+    muon.setOuterTrack (reco::TrackRef(outerRefs , idx));
+    muon.setGlobalTrack(reco::TrackRef(globalRefs, idx));
+    unsigned int type=reco::Muon::GlobalMuon | reco::Muon::StandAloneMuon;
+    if( !lepton.fake || random_.flat()<0.5 ) type|=reco::Muon::TrackerMuon;
+    muon.setType(type);
+
+    // segments matched in the DT stations
+    std::vector<reco::MuonChamberMatch> matches;
+    unsigned int stations=lepton.fake ? random_.multiplicity(0.5) : 2+random_.multiplicity(1.);
+    for(unsigned int station=1; station<=std::min(stations, 4u); ++station){
+      reco::MuonSegmentMatch segment;
+      segment.setMask(reco::MuonSegmentMatch::BestInChamberByDR);
+      segment.setMask(reco::MuonSegmentMatch::BestInStationByDR);
+      segment.setMask(reco::MuonSegmentMatch::BelongsToTrackByDR);
+      reco::MuonChamberMatch match;
+      match.id=DTChamberId(0, station, 1);
+      match.segmentMatches.push_back(segment);
+      matches.push_back(match);
+    }
+    muon.setMatches(matches);
+
+    // isolation: non-prompt muons are within jets, the
+    // contribution of pileup grows with the number of vertices
+    double pileup=isoPerVertex_*(nVertices-1);
+    reco::MuonIsolation iso03, iso05;
+    double scale=lepton.fake ? 10. : 1.;
+    iso03.sumPt=scale*random_.pt(0., 1.0)+random_.flat(0., pileup);
+    iso03.emEt =scale*random_.pt(0., 0.8)+random_.flat(0., pileup);
+    iso03.hadEt=scale*random_.pt(0., 0.6)+random_.flat(0., pileup);
+    iso05.sumPt=2.5*iso03.sumPt; iso05.emEt=2.5*iso03.emEt; iso05.hadEt=2.5*iso03.hadEt;
+    muon.setIsolation(iso03, iso05);
+    muons->push_back(muon);
+  }
+  event.put(inner , "inner" );
+  event.put(outer , "outer" );
+  event.put(global, "global");
+  event.put(muons);
+}
+
+SyntheticElectronProducer::SyntheticElectronProducer(const edm::ParameterSet& cfg):
+  beamSpot_(cfg.getParameter<edm::InputTag>("beamSpot")),
+  vertices_(cfg.getParameter<edm::InputTag>("vertices")),
+  mean_(cfg.getParameter<double>("mean")),
+  ptMin_(cfg.getParameter<double>("ptMin")),
+  ptSlope_(cfg.getParameter<double>("ptSlope")),
+  etaMax_(cfg.getParameter<double>("etaMax")),
+  resonanceFraction_(cfg.getParameter<double>("resonanceFraction")),
+  resonanceMass_(cfg.getParameter<double>("resonanceMass")),
+  resonanceWidth_(cfg.getParameter<double>("resonanceWidth")),
+  fakeFraction_(cfg.getParameter<double>("fakeFraction")),
+  isoPerVertex_(cfg.getParameter<double>("isoPerVertex"))
+{
+  produces<reco::GsfTrackCollection>();
+  produces<reco::SuperClusterCollection>();
+  produces<reco::GsfElectronCoreCollection>();
+  produces<reco::GsfElectronCollection>();
+}
+
+void
+SyntheticElectronProducer::produce(edm::Event& event, const edm::EventSetup& setup)
+{
+  random_.init();
+  edm::Handle<reco::BeamSpot> beamSpot;
+  event.getByLabel(beamSpot_, beamSpot);
+  double z=0.; unsigned int nVertices=vertices(event, vertices_, z);
+
+  std::auto_ptr<reco::GsfTrackCollection> tracks(new reco::GsfTrackCollection);
+  std::auto_ptr<reco::SuperClusterCollection> clusters(new reco::SuperClusterCollection);
+  std::auto_ptr<reco::GsfElectronCoreCollection> cores(new reco::GsfElectronCoreCollection);
+  std::auto_ptr<reco::GsfElectronCollection> electrons(new reco::GsfElectronCollection);
+  reco::GsfTrackRefProd trackRefs=event.getRefBeforePut<reco::GsfTrackCollection>();
+  reco::SuperClusterRefProd clusterRefs=event.getRefBeforePut<reco::SuperClusterCollection>();
+  edm::RefProd<reco::GsfElectronCoreCollection> coreRefs=event.getRefBeforePut<reco::GsfElectronCoreCollection>();
+
+  std::vector<Lepton> candidates=leptons(random_, mean_, ptMin_, ptSlope_, etaMax_, resonanceFraction_, resonanceMass_, resonanceWidth_, fakeFraction_, 0.000511);
+  for(unsigned int idx=0; idx<candidates.size(); ++idx){
+    const Lepton& lepton=candidates[idx];
+    double dxy=lepton.fake ? random_.gauss(0., 0.05) : random_.gauss(0., 0.003);
+    math::XYZPoint point=referencePoint(*beamSpot, lepton.p4, dxy, random_.gauss(z, 0.005));
+    math::XYZVector momentum(lepton.p4.px(), lepton.p4.py(), lepton.p4.pz());
+
+    reco::GsfTrack track(random_.flat(0.5, 2.)*15., 15., point, momentum, lepton.charge, reco::TrackBase::CovarianceMatrix());
+    addHits(track, 2+random_.multiplicity(1.), 6+random_.multiplicity(4.), 0);
+    tracks->push_back(track);
+
+    double eta=lepton.p4.eta(), phi=lepton.p4.phi();
+    math::XYZPoint position(ECAL_RADIUS*cos(phi), ECAL_RADIUS*sin(phi), ECAL_RADIUS*sinh(eta));
+    clusters->push_back(reco::SuperCluster(lepton.p4.energy()*random_.gauss(1., 0.03), position));
+
+    reco::GsfElectronCore core(reco::GsfTrackRef(trackRefs, idx));
+    core.setSuperCluster(reco::SuperClusterRef(clusterRefs, idx));
+    cores->push_back(core);
+
+    // identification variables: narrow for prompt, broad for fake electrons
+    bool barrel=fabs(eta)<1.479;
+    reco::GsfElectron::TrackClusterMatching matching;
+    matching.eSuperClusterOverP=random_.gauss(1., lepton.fake ? 0.5 : 0.05);
+    matching.deltaEtaSuperClusterAtVtx=random_.gauss(0., lepton.fake ? 0.02 : 0.002);
+    matching.deltaPhiSuperClusterAtVtx=random_.gauss(0., lepton.fake ? 0.1  : 0.01 );
+    reco::GsfElectron::FiducialFlags fiducial;
+    fiducial.isEB=barrel; fiducial.isEE=!barrel;
+    reco::GsfElectron::ShowerShape shape;
+    shape.sigmaIetaIeta=fabs(random_.gauss(barrel ? 0.009 : 0.025, lepton.fake ? 0.01 : 0.001));
+    shape.sigmaEtaEta=shape.sigmaIetaIeta;
+    shape.hcalDepth1OverEcal=lepton.fake ? random_.pt(0., 0.1) : random_.pt(0., 0.01);
+    shape.hcalDepth2OverEcal=0.;
+    reco::GsfElectron electron(lepton.charge, reco::GsfElectron::ChargeInfo(), edm::Ref<reco::GsfElectronCoreCollection>(coreRefs, idx), matching,
+			       reco::GsfElectron::TrackExtrapolations(), reco::GsfElectron::ClosestCtfTrack(), fiducial, shape, reco::GsfElectron::ConversionRejection());
+    electron.setP4(reco::GsfElectron::P4_COMBINATION, lepton.p4, 0.01*lepton.p4.energy(), true);
+
+    // detector and particle flow based isolation
+    double pileup=isoPerVertex_*(nVertices-1), scale=lepton.fake ? 10. : 1.;
+    reco::GsfElectron::IsolationVariables iso03;
+    iso03.tkSumPt=scale*random_.pt(0., 1.0)+random_.flat(0., pileup);
+    iso03.ecalRecHitSumEt=scale*random_.pt(0., 1.0)+random_.flat(0., pileup);
+    iso03.hcalDepth1TowerSumEt=scale*random_.pt(0., 0.5)+random_.flat(0., pileup);
+    iso03.hcalDepth2TowerSumEt=0.;
+    electron.setIsolation03(iso03);
+    reco::GsfElectron::IsolationVariables iso04=iso03;
+    iso04.tkSumPt*=1.8; iso04.ecalRecHitSumEt*=1.8; iso04.hcalDepth1TowerSumEt*=1.8;
+    electron.setIsolation04(iso04);
+    reco::GsfElectron::PflowIsolationVariables pfIso;
+    pfIso.chargedHadronIso=iso03.tkSumPt;
+    pfIso.neutralHadronIso=iso03.hcalDepth1TowerSumEt;
+    pfIso.photonIso=iso03.ecalRecHitSumEt;
+    electron.setPfIsolationVariables(pfIso);
+    electrons->push_back(electron);
+  }
+  event.put(tracks);
+  event.put(clusters);
+  event.put(cores);
+  event.put(electrons);
+}
+
+SyntheticElectronIDProducer::SyntheticElectronIDProducer(const edm::ParameterSet& cfg):
+  electrons_(cfg.getParameter<edm::InputTag>("electrons")),
+  maxSigmaIetaIeta_(cfg.getParameter<double>("maxSigmaIetaIeta")),
+  maxDeltaEtaIn_(cfg.getParameter<double>("maxDeltaEtaIn")),
+  maxHadronicOverEm_(cfg.getParameter<double>("maxHadronicOverEm")),
+  maxRelIso_(cfg.getParameter<double>("maxRelIso")),
+  passValue_(cfg.getParameter<double>("passValue"))
+{
+  produces<edm::ValueMap<float> >();
+}
+
+void
+SyntheticElectronIDProducer::produce(edm::Event& event, const edm::EventSetup& setup)
+{
+  edm::Handle<reco::GsfElectronCollection> electrons;
+  event.getByLabel(electrons_, electrons);
+
+  std::vector<float> values;
+  for(reco::GsfElectronCollection::const_iterator elec=electrons->begin(); elec!=electrons->end(); ++elec){
+    double relIso=(elec->dr03TkSumPt()+elec->dr03EcalRecHitSumEt()+elec->dr03HcalTowerSumEt())/elec->pt();
+    bool pass=(elec->sigmaIetaIeta()<maxSigmaIetaIeta_ && fabs(elec->deltaEtaSuperClusterTrackAtVtx())<maxDeltaEtaIn_ && elec->hadronicOverEm()<maxHadronicOverEm_ && relIso<maxRelIso_);
+    values.push_back(pass ? passValue_ : 0.);
+  }
+  std::auto_ptr<edm::ValueMap<float> > eid(new edm::ValueMap<float>);
+  edm::ValueMap<float>::Filler filler(*eid);
+  filler.insert(electrons, values.begin(), values.end());
+  filler.fill();
+  event.put(eid);
+}
+
+SyntheticJetProducer::SyntheticJetProducer(const edm::ParameterSet& cfg):
+  vertices_(cfg.getParameter<edm::InputTag>("vertices")),
+  pf_(cfg.getParameter<std::string>("type")=="PF"),
+  mean_(cfg.getParameter<double>("mean")),
+  ptMin_(cfg.getParameter<double>("ptMin")),
+  ptSlope_(cfg.getParameter<double>("ptSlope")),
+  etaMax_(cfg.getParameter<double>("etaMax")),
+  pileupJets_(cfg.getParameter<double>("pileupJets")),
+  pileupPtMin_(cfg.getParameter<double>("pileupPtMin")),
+  pileupPtSlope_(cfg.getParameter<double>("pileupPtSlope"))
+{
+  if( pf_ ) produces<reco::PFJetCollection>();
+  else produces<reco::CaloJetCollection>();
+}
+
+void
+SyntheticJetProducer::produce(edm::Event& event, const edm::EventSetup& setup)
+{
+  random_.init();
+  double z=0.; unsigned int nVertices=vertices(event, vertices_, z);
+
+  std::vector<reco::Candidate::LorentzVector> p4s;
+  unsigned int nHard=random_.multiplicity(mean_), nSoft=random_.multiplicity(pileupJets_*(nVertices-1));
+  for(unsigned int idx=0; idx<nHard+nSoft; ++idx){
+    double pt=(idx<nHard) ? random_.pt(ptMin_, ptSlope_) : random_.pt(pileupPtMin_, pileupPtSlope_);
+    p4s.push_back(random_.p4(pt, etaMax_, 0.1*pt));
+  }
+  // jets are sorted in pt as in the reconstruction
+  std::sort(p4s.begin(), p4s.end(), ptGreater);
+  reco::Jet::Point vertex(0., 0., z);
+
+  if( pf_ ){
+    std::auto_ptr<reco::PFJetCollection> jets(new reco::PFJetCollection);
+    for(unsigned int idx=0; idx<p4s.size(); ++idx){
+      double energy=p4s[idx].energy();
+      double chf=random_.flat(0.4, 0.8), nhf=random_.flat(0.0, 1.0-chf), cemf=random_.flat(0.0, 0.05), nemf=1.-chf-nhf-cemf;
+      reco::PFJet::Specific specific;
+      specific.mChargedHadronEnergy=chf*energy;
+      specific.mNeutralHadronEnergy=nhf*energy;
+      specific.mChargedEmEnergy=cemf*energy;
+      specific.mElectronEnergy=cemf*energy;
+      specific.mNeutralEmEnergy=nemf*energy;
+      specific.mPhotonEnergy=nemf*energy;
+      specific.mChargedMultiplicity=1+random_.multiplicity(10.);
+      specific.mNeutralMultiplicity=1+random_.multiplicity(8.);
+      specific.mChargedHadronMultiplicity=specific.mChargedMultiplicity;
+      specific.mNeutralHadronMultiplicity=specific.mNeutralMultiplicity/2;
+      specific.mPhotonMultiplicity=specific.mNeutralMultiplicity-specific.mNeutralHadronMultiplicity;
+      jets->push_back(reco::PFJet(p4s[idx], vertex, specific));
+    }
+    event.put(jets);
+  }
+  else{
+    std::auto_ptr<reco::CaloJetCollection> jets(new reco::CaloJetCollection);
+    for(unsigned int idx=0; idx<p4s.size(); ++idx){
+      double energy=p4s[idx].energy(), emf=random_.flat(0.1, 0.9);
+      reco::CaloJet::Specific specific;
+      specific.mEnergyFractionEm=emf;
+      specific.mEnergyFractionHadronic=1.-emf;
+      specific.mEmEnergyInEB=emf*energy;
+      specific.mHadEnergyInHB=(1.-emf)*energy;
+      specific.mMaxEInEmTowers=0.5*emf*energy;
+      specific.mMaxEInHadTowers=0.5*(1.-emf)*energy;
+      specific.mTowersArea=0.5;
+      jets->push_back(reco::CaloJet(p4s[idx], vertex, specific));
+    }
+    event.put(jets);
+  }
+}
+
+SyntheticMETProducer::SyntheticMETProducer(const edm::ParameterSet& cfg):
+  vertices_(cfg.getParameter<edm::InputTag>("vertices")),
+  type_(cfg.getParameter<std::string>("type")),
+  sumEt_(cfg.getParameter<double>("sumEt")),
+  sumEtPerVertex_(cfg.getParameter<double>("sumEtPerVertex")),
+  genuineFraction_(cfg.getParameter<double>("genuineFraction")),
+  genuineMean_(cfg.getParameter<double>("genuineMean"))
+{
+  if( type_=="PF" ) produces<reco::PFMETCollection>();
+  else if( type_=="Calo" ) produces<reco::CaloMETCollection>();
+  else if( type_=="plain" ) produces<reco::METCollection>();
+  else{
+    throw cms::Exception("Configuration") << "Unknown MET type " << type_ << " (PF, Calo or plain)\n";
+  }
+}
+
+void
+SyntheticMETProducer::produce(edm::Event& event, const edm::EventSetup& setup)
+{
+  random_.init();
+  double z=0.; unsigned int nVertices=vertices(event, vertices_, z);
+
+  // resolution of each component grows with the square root of the sum of et
+  double sumEt=random_.pt(0., sumEt_)+random_.flat(0.5, 1.5)*sumEtPerVertex_*(nVertices-1);
+  double sigma=0.5*sqrt(sumEt);
+  double px=random_.gauss(0., sigma), py=random_.gauss(0., sigma);
+  if( random_.flat()<genuineFraction_ ){
+    double met=random_.pt(0., genuineMean_), phi=random_.flat(-M_PI, M_PI);
+    px+=met*cos(phi); py+=met*sin(phi);
+  }
+  reco::Candidate::LorentzVector p4(px, py, 0., sqrt(px*px+py*py));
+  reco::Candidate::Point vertex(0., 0., z);
+
+  if( type_=="PF" ){
+    std::auto_ptr<reco::PFMETCollection> met(new reco::PFMETCollection);
+    SpecificPFMETData specific;
+    specific.NeutralEMFraction=0.3; specific.NeutralHadFraction=0.2; specific.ChargedEMFraction=0.05; specific.ChargedHadFraction=0.45;
+    met->push_back(reco::PFMET(specific, sumEt, p4, vertex));
+    event.put(met);
+  }
+  else if( type_=="Calo" ){
+    std::auto_ptr<reco::CaloMETCollection> met(new reco::CaloMETCollection);
+    SpecificCaloMETData specific;
+    specific.EtFractionEm=0.4; specific.EtFractionHadronic=0.6;
+    met->push_back(reco::CaloMET(specific, sumEt, p4, vertex));
+    event.put(met);
+  }
+  else{
+    std::auto_ptr<reco::METCollection> met(new reco::METCollection);
+    met->push_back(reco::MET(sumEt, p4, vertex));
+    event.put(met);
+  }
+}
+
+SyntheticJetTagProducer::SyntheticJetTagProducer(const edm::ParameterSet& cfg):
+  jets_(cfg.getParameter<edm::InputTag>("jets")),
+  bFraction_(cfg.getParameter<double>("bFraction")),
+  signalMean_(cfg.getParameter<double>("signalMean")),
+  signalWidth_(cfg.getParameter<double>("signalWidth")),
+  backgroundMean_(cfg.getParameter<double>("backgroundMean")),
+  backgroundWidth_(cfg.getParameter<double>("backgroundWidth"))
+{
+  produces<reco::JetTagCollection>();
+}
+
+void
+SyntheticJetTagProducer::produce(edm::Event& event, const edm::EventSetup& setup)
+{
+  random_.init();
+  edm::Handle<edm::View<reco::Jet> > jets;
+  event.getByLabel(jets_, jets);
+
+  std::auto_ptr<reco::JetTagCollection> tags(new reco::JetTagCollection(edm::RefToBaseProd<reco::Jet>(jets)));
+  for(unsigned int idx=0; idx<jets->size(); ++idx){
+    double discriminator=(random_.flat()<bFraction_) ? random_.gauss(signalMean_, signalWidth_) : random_.gauss(backgroundMean_, backgroundWidth_);
+    tags->setValue(idx, discriminator);
+  }
+  event.put(tags);
+}
+
+SyntheticTriggerFilter::SyntheticTriggerFilter(const edm::ParameterSet& cfg):
+  src_(cfg.getParameter<edm::InputTag>("src")),
+  ptMin_(cfg.getParameter<double>("ptMin")),
+  minN_(cfg.getParameter<unsigned int>("minN")),
+  efficiency_(cfg.getParameter<double>("efficiency"))
+{
+}
+
+bool
+SyntheticTriggerFilter::filter(edm::Event& event, const edm::EventSetup& setup)
+{
+  random_.init();
+  edm::Handle<edm::View<reco::Candidate> > candidates;
+  if( !event.getByLabel(src_, candidates) ) return false;
+
+  unsigned int n=0;
+  for(edm::View<reco::Candidate>::const_iterator cand=candidates->begin(); cand!=candidates->end(); ++cand){
+    if( cand->pt()>ptMin_ ) ++n;
+  }
+  return n>=minN_ && random_.flat()<efficiency_;
+}
@@ -0,0 +1,354 @@
+#ifndef SYNTHETICEVENTPRODUCERS
+#define SYNTHETICEVENTPRODUCERS
+
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EDFilter.h"
+#include "FWCore/Framework/interface/EDProducer.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+#include "DataFormats/Candidate/interface/Candidate.h"
+#include "DataFormats/BeamSpot/interface/BeamSpot.h"
+
+namespace CLHEP { class HepRandomEngine; }
+
+/**
+   \class   SyntheticGenerator SyntheticEventProducers.h "DQM/Physics/test/SyntheticEventProducers.h"
+
+   \brief   Random kinematics and multiplicities for the synthetic event producers.
+
+   Thin wrapper around the random engine of the RandomNumberGeneratorService, which
+   provides the distributions used by the synthetic event producers: poisson
+   distributed multiplicities, exponentially falling pt spectra, flat distributions
+   in eta and phi and the two decay products of a resonance (e.g. a Z boson) with
+   a Breit-Wigner distributed mass, decayed isotropically in its rest frame. The
+   engine has to be picked up at the beginning of each event via init().
+*/
+
+class SyntheticGenerator {
+ public:
+  /// default constructor
+  SyntheticGenerator() : engine_(0) {};
+  /// default destructor
+  ~SyntheticGenerator(){};
+
+  /// pick up the random engine of the module from the RandomNumberGeneratorService
+  void init();
+  /// flat random number in [low, high)
+  double flat(double low=0., double high=1.);
+  /// gaussian random number
+  double gauss(double mean, double sigma);
+  /// poisson distributed multiplicity
+  unsigned int multiplicity(double mean);
+  /// exponentially falling pt spectrum above ptMin with mean ptMin+slope
+  double pt(double ptMin, double slope);
+  /// random charge +1 or -1
+  int charge();
+  /// four momentum of a particle with random eta and phi
+  reco::Candidate::LorentzVector p4(double pt, double etaMax, double mass);
+  /// decay products of a resonance with given mass and width
+  std::pair<reco::Candidate::LorentzVector, reco::Candidate::LorentzVector> resonance(double mass, double width, double etaMax, double daughterMass);
+
+ private:
+  /// random engine of the module
+  CLHEP::HepRandomEngine* engine_;
+};
+
+/**
+   \class   SyntheticBeamSpotProducer SyntheticEventProducers.h "DQM/Physics/test/SyntheticEventProducers.h"
+
+   \brief   Produces a fixed reco::BeamSpot (to be run with label offlineBeamSpot).
+*/
+
+class SyntheticBeamSpotProducer : public edm::EDProducer {
+ public:
+  /// default constructor
+  explicit SyntheticBeamSpotProducer(const edm::ParameterSet& cfg);
+  /// default destructor
+  ~SyntheticBeamSpotProducer(){};
+
+ private:
+  /// produce the beam spot
+  virtual void produce(edm::Event& event, const edm::EventSetup& setup);
+
+ private:
+  /// position and gaussian width in z of the beam spot
+  reco::BeamSpot::Point position_;
+  double sigmaZ_;
+};
+
+/**
+   \class   SyntheticVertexProducer SyntheticEventProducers.h "DQM/Physics/test/SyntheticEventProducers.h"
+
+   \brief   Produces primary vertices and their tracks (to be run with label offlinePrimaryVertices).
+
+   The number of vertices is 1 (the hard interaction) plus a poisson distributed
+   number of pileup vertices with the configured mean (parameter pileup). The other
+   synthetic producers read the number of vertices back from the event to scale the
+   pileup dependent quantities (isolation sums, soft jets and sum of et). The soft
+   tracks of each vertex are stored in the same module.
+*/
+
+class SyntheticVertexProducer : public edm::EDProducer {
+ public:
+  /// default constructor
+  explicit SyntheticVertexProducer(const edm::ParameterSet& cfg);
+  /// default destructor
+  ~SyntheticVertexProducer(){};
+
+ private:
+  /// produce the vertices
+  virtual void produce(edm::Event& event, const edm::EventSetup& setup);
+
+ private:
+  /// beam spot
+  edm::InputTag beamSpot_;
+  /// mean number of pileup interactions
+  double pileup_;
+  /// random generator
+  SyntheticGenerator random_;
+};
+
+/**
+   \class   SyntheticMuonProducer SyntheticEventProducers.h "DQM/Physics/test/SyntheticEventProducers.h"
+
+   \brief   Produces reco::Muons with inner, outer and global tracks (label muons).
+
+   Produces a poisson distributed number of (global and tracker) muons with an
+   exponentially falling pt spectrum plus, with probability resonanceFraction, an
+   opposite charge pair from a resonance. The tracks carry valid pixel, strip and
+   muon hits in their hit pattern; a fraction fakeFraction of the muons is made of
+   low quality (few hits, large chi2 and impact parameter) muons. The tracks are
+   stored in the same module with instance labels inner, outer and global.
+*/
+
+class SyntheticMuonProducer : public edm::EDProducer {
+ public:
+  /// default constructor
+  explicit SyntheticMuonProducer(const edm::ParameterSet& cfg);
+  /// default destructor
+  ~SyntheticMuonProducer(){};
+
+ private:
+  /// produce the muons and their tracks
+  virtual void produce(edm::Event& event, const edm::EventSetup& setup);
+
+ private:
+  /// beam spot and vertices
+  edm::InputTag beamSpot_, vertices_;
+  /// mean multiplicity and pt spectrum of the non-resonant muons
+  double mean_, ptMin_, ptSlope_, etaMax_;
+  /// fraction of events with a resonance and its mass and width
+  double resonanceFraction_, resonanceMass_, resonanceWidth_;
+  /// fraction of low quality muons
+  double fakeFraction_;
+  /// isolation sum added per vertex
+  double isoPerVertex_;
+  /// random generator
+  SyntheticGenerator random_;
+};
+
+/**
+   \class   SyntheticElectronProducer SyntheticEventProducers.h "DQM/Physics/test/SyntheticEventProducers.h"
+
+   \brief   Produces reco::GsfElectrons with gsf tracks and super clusters (label gsfElectrons).
+
+   Same as SyntheticMuonProducer for electrons. The electron cores, gsf tracks and
+   super clusters are stored in the same module. The identification variables are
+   drawn from narrow distributions for prompt electrons and from broad ones for the
+   fraction fakeFraction of fake electrons.
+*/
+
+class SyntheticElectronProducer : public edm::EDProducer {
+ public:
+  /// default constructor
+  explicit SyntheticElectronProducer(const edm::ParameterSet& cfg);
+  /// default destructor
+  ~SyntheticElectronProducer(){};
+
+ private:
+  /// produce the electrons and the objects they refer to
+  virtual void produce(edm::Event& event, const edm::EventSetup& setup);
+
+ private:
+  /// beam spot and vertices
+  edm::InputTag beamSpot_, vertices_;
+  /// mean multiplicity and pt spectrum of the non-resonant electrons
+  double mean_, ptMin_, ptSlope_, etaMax_;
+  /// fraction of events with a resonance and its mass and width
+  double resonanceFraction_, resonanceMass_, resonanceWidth_;
+  /// fraction of fake electrons
+  double fakeFraction_;
+  /// isolation sum added per vertex
+  double isoPerVertex_;
+  /// random generator
+  SyntheticGenerator random_;
+};
+
+/**
+   \class   SyntheticElectronIDProducer SyntheticEventProducers.h "DQM/Physics/test/SyntheticEventProducers.h"
+
+   \brief   Produces an electron ID value map for the electrons (e.g. label eidRobustLoose).
+
+   The electron ID is computed from the identification and isolation variables of
+   the electron with the configured cut values; the value map holds 1 for passing
+   and 0 for failing electrons, or the bit pattern given by passValue if the value
+   map encodes several working points (as for the simpleEleId value maps).
+*/
+
+class SyntheticElectronIDProducer : public edm::EDProducer {
+ public:
+  /// default constructor
+  explicit SyntheticElectronIDProducer(const edm::ParameterSet& cfg);
+  /// default destructor
+  ~SyntheticElectronIDProducer(){};
+
+ private:
+  /// produce the value map
+  virtual void produce(edm::Event& event, const edm::EventSetup& setup);
+
+ private:
+  /// electrons
+  edm::InputTag electrons_;
+  /// cut values for the identification and the relative isolation
+  double maxSigmaIetaIeta_, maxDeltaEtaIn_, maxHadronicOverEm_, maxRelIso_;
+  /// value for passing electrons
+  double passValue_;
+};
+
+/**
+   \class   SyntheticJetProducer SyntheticEventProducers.h "DQM/Physics/test/SyntheticEventProducers.h"
+
+   \brief   Produces reco::PFJets or reco::CaloJets (e.g. labels ak5PFJets, ak5CaloJets).
+
+   Produces a poisson distributed number of hard jets plus pileupJets soft jets per
+   pileup vertex. The jet type is chosen by the parameter type (PF or Calo); the
+   energy fractions of the jet constituents are drawn around typical values.
+*/
+
+class SyntheticJetProducer : public edm::EDProducer {
+ public:
+  /// default constructor
+  explicit SyntheticJetProducer(const edm::ParameterSet& cfg);
+  /// default destructor
+  ~SyntheticJetProducer(){};
+
+ private:
+  /// produce the jets
+  virtual void produce(edm::Event& event, const edm::EventSetup& setup);
+
+ private:
+  /// vertices
+  edm::InputTag vertices_;
+  /// produce PFJets (true) or CaloJets (false)
+  bool pf_;
+  /// mean multiplicity and pt spectrum of the hard jets
+  double mean_, ptMin_, ptSlope_, etaMax_;
+  /// mean number of soft jets per pileup vertex and their pt spectrum
+  double pileupJets_, pileupPtMin_, pileupPtSlope_;
+  /// random generator
+  SyntheticGenerator random_;
+};
+
+/**
+   \class   SyntheticMETProducer SyntheticEventProducers.h "DQM/Physics/test/SyntheticEventProducers.h"
+
+   \brief   Produces reco::PFMET, reco::CaloMET or reco::MET (e.g. labels pfMet, met, tcMet).
+
+   The missing et is drawn from a gaussian resolution, which grows with the sum of
+   et (itself growing with the number of vertices), plus an exponential component
+   for genuine missing et (e.g. from W decays) with probability genuineFraction.
+*/
+
+class SyntheticMETProducer : public edm::EDProducer {
+ public:
+  /// default constructor
+  explicit SyntheticMETProducer(const edm::ParameterSet& cfg);
+  /// default destructor
+  ~SyntheticMETProducer(){};
+
+ private:
+  /// produce the MET
+  virtual void produce(edm::Event& event, const edm::EventSetup& setup);
+
+ private:
+  /// vertices
+  edm::InputTag vertices_;
+  /// MET type: PF, Calo or plain
+  std::string type_;
+  /// sum of et of the hard interaction and per pileup vertex
+  double sumEt_, sumEtPerVertex_;
+  /// fraction of events with genuine missing et and its mean
+  double genuineFraction_, genuineMean_;
+  /// random generator
+  SyntheticGenerator random_;
+};
+
+/**
+   \class   SyntheticJetTagProducer SyntheticEventProducers.h "DQM/Physics/test/SyntheticEventProducers.h"
+
+   \brief   Produces a reco::JetTagCollection for a jet collection (e.g. label trackCountingHighEffBJetTags).
+
+   A fraction bFraction of the jets gets a discriminator from the (broad) signal
+   distribution, the others from the (narrow) background distribution.
+*/
+
+class SyntheticJetTagProducer : public edm::EDProducer {
+ public:
+  /// default constructor
+  explicit SyntheticJetTagProducer(const edm::ParameterSet& cfg);
+  /// default destructor
+  ~SyntheticJetTagProducer(){};
+
+ private:
+  /// produce the b-tags
+  virtual void produce(edm::Event& event, const edm::EventSetup& setup);
+
+ private:
+  /// jets
+  edm::InputTag jets_;
+  /// fraction of b-jets and mean and width of the signal and background discriminators
+  double bFraction_, signalMean_, signalWidth_, backgroundMean_, backgroundWidth_;
+  /// random generator
+  SyntheticGenerator random_;
+};
+
+/**
+   \class   SyntheticTriggerFilter SyntheticEventProducers.h "DQM/Physics/test/SyntheticEventProducers.h"
+
+   \brief   Emulates an HLT path on synthetic events.
+
+   Accepts the event with probability efficiency if at least minN candidates of the
+   collection src have pt above ptMin. Each filter is run in a path named after the
+   HLT path it emulates in a process called HLT; the TriggerResults of this process
+   and its configuration (as read by the HLTConfigProvider) then take the role of
+   the HLT menu for the DQM modules run on the output.
+*/
+
+class SyntheticTriggerFilter : public edm::EDFilter {
+ public:
+  /// default constructor
+  explicit SyntheticTriggerFilter(const edm::ParameterSet& cfg);
+  /// default destructor
+  ~SyntheticTriggerFilter(){};
+
+ private:
+  /// trigger decision
+  virtual bool filter(edm::Event& event, const edm::EventSetup& setup);
+
+ private:
+  /// candidates to trigger on
+  edm::InputTag src_;
+  /// pt threshold and minimal number of candidates
+  double ptMin_;
+  unsigned int minN_;
+  /// efficiency of the path
+  double efficiency_;
+  /// random generator
+  SyntheticGenerator random_;
+};
+
+#endif
@@ -0,0 +1,27 @@
+#include "DQM/Physics/test/SyntheticJetCorrector.h"
+
+SyntheticJetCorrector::SyntheticJetCorrector(const edm::ParameterSet& cfg):
+  scale_(cfg.getParameter<double>("scale")),
+  offset_(cfg.getParameter<double>("offset"))
+{
+}
+
+double
+SyntheticJetCorrector::correction(const LorentzVector& jet) const
+{
+  double pt=jet.pt();
+  if( pt<=offset_ ) return 0.;
+  return scale_*(pt-offset_)/pt;
+}
+
+SyntheticJetCorrectionESProducer::SyntheticJetCorrectionESProducer(const edm::ParameterSet& cfg):
+  corrector_(new SyntheticJetCorrector(cfg))
+{
+  setWhatProduced(this, cfg.getParameter<std::string>("@module_label"));
+}
+
+boost::shared_ptr<JetCorrector>
+SyntheticJetCorrectionESProducer::produce(const JetCorrectionsRecord& record)
+{
+  return corrector_;
+}
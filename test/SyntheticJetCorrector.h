@@ -0,0 +1,68 @@
+#ifndef SYNTHETICJETCORRECTOR
+#define SYNTHETICJETCORRECTOR
+
+#include <string>
+
+#include "boost/shared_ptr.hpp"
+#include "FWCore/Framework/interface/ESProducer.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "JetMETCorrections/Objects/interface/JetCorrector.h"
+#include "JetMETCorrections/Objects/interface/JetCorrectionsRecord.h"
+
+/**
+   \class   SyntheticJetCorrector SyntheticJetCorrector.h "DQM/Physics/test/SyntheticJetCorrector.h"
+
+   \brief   Stand-in JetCorrector for the test of the DQM modules on synthetic events.
+
+   Simple jet energy correction, which does not need any conditions: an offset (in
+   GeV, e.g. for the pileup energy) is subtracted from the jet pt and the result is
+   scaled by a constant factor. The correction does not depend on the event.
+*/
+
+class SyntheticJetCorrector : public JetCorrector {
+ public:
+  /// default constructor
+  explicit SyntheticJetCorrector(const edm::ParameterSet& cfg);
+  /// default destructor
+  virtual ~SyntheticJetCorrector(){};
+
+  /// correction for a jet four momentum
+  virtual double correction(const LorentzVector& jet) const;
+  /// correction for a jet
+  virtual double correction(const reco::Jet& jet) const { return correction(jet.p4()); };
+  /// the correction does not need the event
+  virtual bool eventRequired() const { return false; };
+  /// the correction does not need a reference to the jet
+  virtual bool refRequired() const { return false; };
+
+ private:
+  /// scale factor and offset
+  double scale_, offset_;
+};
+
+/**
+   \class   SyntheticJetCorrectionESProducer SyntheticJetCorrector.h "DQM/Physics/test/SyntheticJetCorrector.h"
+
+   \brief   Provides the SyntheticJetCorrector under the label of the module.
+
+   To be configured with the label of the correction service expected by the DQM
+   modules (e.g. ak5PFL2L3), together with an EmptyESSource for the record
+   JetCorrectionsRecord.
+*/
+
+class SyntheticJetCorrectionESProducer : public edm::ESProducer {
+ public:
+  /// default constructor
+  explicit SyntheticJetCorrectionESProducer(const edm::ParameterSet& cfg);
+  /// default destructor
+  ~SyntheticJetCorrectionESProducer(){};
+
+  /// provide the corrector
+  boost::shared_ptr<JetCorrector> produce(const JetCorrectionsRecord& record);
+
+ private:
+  /// the corrector (independent of the IOV)
+  boost::shared_ptr<JetCorrector> corrector_;
+};
+
+#endif
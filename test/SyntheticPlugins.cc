@@ -0,0 +1,17 @@
+#include "FWCore/Framework/interface/MakerMacros.h"
+#include "FWCore/Framework/interface/ModuleFactory.h"
+
+#include "DQM/Physics/test/SyntheticEventProducers.h"
+#include "DQM/Physics/test/SyntheticJetCorrector.h"
+
+
+DEFINE_FWK_MODULE(SyntheticBeamSpotProducer);
+DEFINE_FWK_MODULE(SyntheticVertexProducer);
+DEFINE_FWK_MODULE(SyntheticMuonProducer);
+DEFINE_FWK_MODULE(SyntheticElectronProducer);
+DEFINE_FWK_MODULE(SyntheticElectronIDProducer);
+DEFINE_FWK_MODULE(SyntheticJetProducer);
+DEFINE_FWK_MODULE(SyntheticMETProducer);
+DEFINE_FWK_MODULE(SyntheticJetTagProducer);
+DEFINE_FWK_MODULE(SyntheticTriggerFilter);
+DEFINE_FWK_EVENTSETUP_MODULE(SyntheticJetCorrectionESProducer);
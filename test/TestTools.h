@@ -0,0 +1,78 @@
+#ifndef TESTTOOLS
+#define TESTTOOLS
+
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+   Common fixture of the standalone unit tests in DQM/Physics/test
+
+   Counts the checks and the failed checks of a test, reports the first failures and
+   provides the random numbers the synthetic inputs are generated from. The heap
+   allocations of the process are counted via the global operator new (e.g. to check
+   that a code path does not allocate). As it replaces the global operator new and
+   delete, the header is to be included by exactly one source file per binary and not
+   together with BenchmarkTools.h. It does not depend on FWLite. Usage:
+
+   unittest::initialize();
+   unittest::check(result==expected, "result", evt);
+   return unittest::summary();
+*/
+
+namespace unittest {
+  // number of heap allocations and allocated bytes of the process
+  unsigned long long nAllocs=0, nBytes=0;
+  // number of checks and of failed checks
+  unsigned long nChecks=0, nFailures=0;
+}
+
+void* operator new(std::size_t size) throw(std::bad_alloc)
+{
+  ++unittest::nAllocs; unittest::nBytes+=size;
+  void* ptr=std::malloc(size ? size : 1);
+  if(!ptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) throw()
+{
+  std::free(ptr);
+}
+
+namespace unittest {
+
+  // seed the random numbers, such that all runs
+  // are done on the same synthetic inputs
+  inline void initialize()
+  {
+    std::srand(4711);
+  }
+
+  // uniform random number in [low, high)
+  inline double uniform(double low, double high)
+  {
+    return low+(high-low)*(std::rand()/(RAND_MAX+1.));
+  }
+
+  // count a check and report the first failures; _idx_
+  // identifies the input (e.g. the event) of the check
+  inline void check(bool passed, const char* what, unsigned int idx)
+  {
+    ++nChecks;
+    if( passed ) return;
+    ++nFailures;
+    if( nFailures<=10 ) printf("%s failed for input %u\n", what, idx);
+  }
+
+  // print the number of checks and failures; returns
+  // the exit code of the test (non-zero on failures)
+  inline int summary()
+  {
+    printf("%lu checks: %lu failures\n", nChecks, nFailures);
+    return nFailures ? 1 : 0;
+  }
+
+}
+
+#endif
@@ -0,0 +1,177 @@
+/**
+   Standalone micro-benchmark for the helpers in DQM/Physics/interface/TopDQMHelpers.h
+
+   Runs the hot helper functions on synthetic inputs, which are generated in memory
+   (no input files, no EventSetup needed), and reports the time and the number of
+   heap allocations per event for each helper and multiplicity range:
+
+    - accept               : trigger accept for 5 monitored paths in tables of 300-800 paths
+    - SelectionStep        : SelectionStep::select on 2-20 jets (w/o jet corrections) and
+                             SelectionStep::selectVertex on 5-45 primary vertices, both
+                             on the edm::View the event based functions fetch
+    - Calculate            : massWBoson/massTopQuark and massBTopQuark on 4-20 jets
+    - Calculate (tmass)    : tmassWBoson/tmassTopQuark for 1-6 leptons
+
+   Usage: TopDQMHelpersBenchmark [nEvents]
+*/
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "DQM/Physics/interface/TopDQMHelpers.h"
+#include "DQM/Physics/test/BenchmarkTools.h"
+#include "DataFormats/METReco/interface/MET.h"
+#include "DataFormats/MuonReco/interface/Muon.h"
+#include "DataFormats/Common/interface/HLTGlobalStatus.h"
+
+using namespace benchmark;
+
+namespace {
+
+  // synthetic jets, ordered in pt
+  std::vector<reco::Jet> jets(unsigned int n)
+  {
+    std::vector<reco::Jet> jets;
+    double pt=uniform(60., 200.);
+    for(unsigned int idx=0; idx<n; ++idx){
+      jets.push_back(reco::Jet(p4(pt, uniform(-3., 3.), uniform(-M_PI, M_PI), uniform(5., 20.)), reco::Jet::Point(0., 0., 0.)));
+      pt*=uniform(0.6, 1.);
+    }
+    return jets;
+  }
+
+  // synthetic primary vertices, a fraction of which fails the selection
+  std::vector<reco::Vertex> vertices(unsigned int n)
+  {
+    std::vector<reco::Vertex> vertices;
+    for(unsigned int idx=0; idx<n; ++idx){
+      reco::Vertex::Point position(uniform(-0.1, 0.1), uniform(-0.1, 0.1), uniform(-30., 30.));
+      vertices.push_back(reco::Vertex(position, reco::Vertex::Error(), uniform(1., 40.), uniform(0., 60.), 10));
+    }
+    return vertices;
+  }
+
+  // print one line of the report
+  void report(const char* name, unsigned int mult, unsigned int nEvents, double time, unsigned long long allocs)
+  {
+    printf("%-24s %6u %12.1f %14.2f\n", name, mult, time/nEvents, (double)allocs/nEvents);
+  }
+
+}
+
+int main(int argc, char* argv[])
+{
+  initialize();
+  unsigned int nEvents = argc>1 ? std::atoi(argv[1]) : 10000;
+
+  printf("%-24s %6s %12s %14s\n", "helper", "mult", "ns/event", "allocs/event");
+
+  // --- accept --- //
+  for(unsigned int nPaths=300; nPaths<=800; nPaths+=250){
+    std::vector<std::string> names;
+    for(unsigned int idx=0; idx<nPaths; ++idx){
+      char name[64]; snprintf(name, 64, "HLT_Path%u_v%u", idx, idx%7); names.push_back(name);
+    }
+    edm::ParameterSet pset;
+    pset.addParameter<std::vector<std::string> >("@trigger_paths", names);
+    pset.registerIt();
+    edm::TriggerNames triggerNames(pset);
+    edm::HLTGlobalStatus status(nPaths);
+    for(unsigned int idx=0; idx<nPaths; ++idx){
+      status.at(idx)=edm::HLTPathStatus(uniform(0., 1.)<0.1 ? edm::hlt::Pass : edm::hlt::Fail);
+    }
+    edm::TriggerResults triggerTable(status, pset.id());
+    // monitored paths are spread over the table
+    std::vector<std::string> paths;
+    for(unsigned int idx=0; idx<5; ++idx){ paths.push_back(names[(idx*nPaths)/5+nPaths/7]); }
+
+    unsigned int passed=0; unsigned long long allocs=nAllocs; double start=now();
+    for(unsigned int evt=0; evt<nEvents; ++evt){
+      if(accept(triggerNames, triggerTable, paths)) ++passed;
+    }
+    sink+=passed; report("accept", nPaths, nEvents, now()-start, nAllocs-allocs);
+  }
+
+  // --- SelectionStep --- //
+  edm::ParameterSet jetCfg;
+  jetCfg.addParameter<edm::InputTag>("src", edm::InputTag("ak5PFJets"));
+  jetCfg.addParameter<std::string>("select", "pt>30 & abs(eta)<2.5");
+  jetCfg.addParameter<int>("min", 4);
+  SelectionStep<reco::Jet> jetSelection(jetCfg);
+  for(unsigned int nJets=2; nJets<=20; nJets+=6){
+    std::vector<std::vector<reco::Jet> > events;
+    for(unsigned int evt=0; evt<100; ++evt){ events.push_back(jets(nJets)); }
+    std::vector<edm::View<reco::Jet> > views;
+    for(unsigned int evt=0; evt<events.size(); ++evt){ views.push_back(view(events[evt])); }
+
+    unsigned int passed=0; unsigned long long allocs=nAllocs; double start=now();
+    for(unsigned int evt=0; evt<nEvents; ++evt){
+      if(jetSelection.select(views[evt%views.size()], 0)) ++passed;
+    }
+    sink+=passed; report("SelectionStep (jets)", nJets, nEvents, now()-start, nAllocs-allocs);
+  }
+  edm::ParameterSet pvCfg;
+  pvCfg.addParameter<edm::InputTag>("src", edm::InputTag("offlinePrimaryVertices"));
+  pvCfg.addParameter<std::string>("select", "abs(x)<1. & abs(y)<1. & abs(z)<20. & ndof>4 & !isFake");
+  pvCfg.addParameter<int>("min", 1);
+  SelectionStep<reco::Vertex> pvSelection(pvCfg);
+  for(unsigned int nPVs=5; nPVs<=45; nPVs+=20){
+    std::vector<std::vector<reco::Vertex> > events;
+    for(unsigned int evt=0; evt<100; ++evt){ events.push_back(vertices(nPVs)); }
+    std::vector<edm::View<reco::Vertex> > views;
+    for(unsigned int evt=0; evt<events.size(); ++evt){ views.push_back(view(events[evt])); }
+
+    unsigned int passed=0; unsigned long long allocs=nAllocs; double start=now();
+    for(unsigned int evt=0; evt<nEvents; ++evt){
+      if(pvSelection.selectVertex(views[evt%views.size()])) ++passed;
+    }
+    sink+=passed; report("SelectionStep (pvs)", nPVs, nEvents, now()-start, nAllocs-allocs);
+  }
+
+  // --- Calculate --- //
+  for(unsigned int nJets=4; nJets<=20; nJets+=4){
+    std::vector<std::vector<reco::Jet> > events; std::vector<std::vector<double> > btags;
+    for(unsigned int evt=0; evt<100; ++evt){
+      events.push_back(jets(nJets)); btags.push_back(std::vector<double>());
+      for(unsigned int idx=0; idx<nJets; ++idx){ btags.back().push_back(uniform(-1., 1.)); }
+    }
+
+    double sum=0.; unsigned long long allocs=nAllocs; double start=now();
+    for(unsigned int evt=0; evt<nEvents; ++evt){
+      Calculate eventKinematics(4, 80.4);
+      sum+=eventKinematics.massWBoson  (events[evt%events.size()]);
+      sum+=eventKinematics.massTopQuark(events[evt%events.size()]);
+    }
+    sink+=sum; report("Calculate (W, top)", nJets, nEvents, now()-start, nAllocs-allocs);
+
+    allocs=nAllocs; start=now();
+    for(unsigned int evt=0; evt<nEvents; ++evt){
+      Calculate eventKinematics(-1, 80.4);
+      sum+=eventKinematics.massBTopQuark(events[evt%events.size()], btags[evt%btags.size()], 0.679);
+    }
+    sink+=sum; report("Calculate (b-top)", nJets, nEvents, now()-start, nAllocs-allocs);
+  }
+
+  // --- Calculate (tmass) --- //
+  reco::Jet bJet=jets(1).front();
+  reco::MET met(p4(uniform(20., 80.), 0., uniform(-M_PI, M_PI), 0.), reco::MET::Point(0., 0., 0.));
+  for(unsigned int nLeps=1; nLeps<=6; ++nLeps){
+    std::vector<reco::Muon> leptons;
+    for(unsigned int idx=0; idx<nLeps; ++idx){
+      leptons.push_back(reco::Muon(idx%2 ? 1 : -1, p4(uniform(20., 100.), uniform(-2.1, 2.1), uniform(-M_PI, M_PI), 0.106)));
+    }
+
+    double sum=0.; unsigned long long allocs=nAllocs; double start=now();
+    for(unsigned int evt=0; evt<nEvents; ++evt){
+      for(unsigned int idx=0; idx<leptons.size(); ++idx){
+	Calculate eventKinematics(4, 80.4);
+	sum+=eventKinematics.tmassWBoson  (&leptons[idx], met, bJet);
+	sum+=eventKinematics.tmassTopQuark(&leptons[idx], met, bJet);
+      }
+    }
+    sink+=sum; report("Calculate (tmass)", nLeps, nEvents, now()-start, nAllocs-allocs);
+  }
+  printf("(checksum %g)\n", sink);
+  return 0;
+}
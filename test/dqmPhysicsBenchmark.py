@@ -0,0 +1,174 @@
+#!/usr/bin/env python
+"""
+Throughput regression benchmark for the dqmPhysics sequence.
+
+Runs dqmPhysicsBenchmark_cfg.py (generating the synthetic sample with
+syntheticEvents_cfg.py first, if no input is given and it does not exist
+yet), parses the per module CPU time (TimeReport), the per module heap
+allocations (AllocationCounter) and the peak RSS of the job and writes
+them to a JSON report. If a baseline report is given, each module is
+compared against it; the script fails (exit code 1) if the events/s of
+a module drop or its allocations/event or the peak RSS of the job grow
+by more than the tolerance. Modules which are only in one of the two
+reports are listed, but do not fail the comparison. The synthetic sample does not contain the
+heavy ion vertex collection; with --hi a local input file has to be
+given.
+
+Usage:
+  dqmPhysicsBenchmark.py [--input file:sample.root] [--events N] [--hi]
+                         [--report report.json] [--baseline baseline.json]
+                         [--tolerance 0.10] [--update-baseline]
+"""
+
+import os
+import re
+import sys
+import json
+import resource
+import optparse
+import subprocess
+
+TEST_DIR = os.path.dirname(os.path.abspath(__file__))
+SAMPLE = 'syntheticEvents.root'
+
+def run(args, log):
+    """run a cmsRun job and return its log and its peak RSS [MB]"""
+    before = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss
+    out = open(log, 'w')
+    status = subprocess.call(['cmsRun'] + args, stdout=out, stderr=subprocess.STDOUT)
+    out.close()
+    if status != 0:
+        sys.exit('cmsRun %s failed with exit code %d, see %s' % (' '.join(args), status, log))
+    # ru_maxrss is the maximum over all children so far (in kB)
+    after = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss
+    return open(log).read(), max(after, before) / 1024.
+
+def parseTimeReport(log):
+    """per module CPU time per event [s] from the module summary of the TimeReport"""
+    times = {}
+    inSummary = False
+    for line in log.splitlines():
+        if not line.startswith('TimeReport'):
+            inSummary = False
+            continue
+        if 'Module Summary' in line:
+            inSummary = True
+            continue
+        if not inSummary:
+            continue
+        fields = line.split()[1:]
+        try:
+            # columns: CPU/event, CPU/exec, real/event, real/exec, module label
+            times[fields[-1]] = float(fields[0])
+        except (ValueError, IndexError):
+            continue
+    return times
+
+def parseAllocationReport(log):
+    """per module allocations and bytes per event from the AllocationCounter"""
+    allocations = {}
+    for match in re.finditer(r'AllocationReport (\S+) (\S+) (\S+)', log):
+        allocations[match.group(1)] = (float(match.group(2)), float(match.group(3)))
+    return allocations
+
+def parsePeakRSS(log):
+    """peak RSS of the job [MB] as reported by the AllocationCounter, or None"""
+    match = re.search(r'PeakRSSReport (\S+)', log)
+    return float(match.group(1)) if match else None
+
+def report(log, rss, events, sequence):
+    """machine readable report of the job; the peak RSS reported by the
+    job itself is preferred, since rss may include earlier child jobs"""
+    rss = parsePeakRSS(log) or rss
+    times = parseTimeReport(log)
+    allocations = parseAllocationReport(log)
+    modules = {}
+    for label in set(times.keys()) | set(allocations.keys()):
+        module = {}
+        if label in times:
+            module['seconds/event'] = times[label]
+            module['events/s'] = 1. / times[label] if times[label] > 0. else None
+        if label in allocations:
+            module['allocations/event'] = allocations[label][0]
+            module['bytes/event'] = allocations[label][1]
+        modules[label] = module
+    return {'sequence': sequence, 'events': events, 'peakRSS[MB]': rss, 'modules': modules}
+
+def missing(current, baseline):
+    """modules which are only in the baseline and modules which are only in current"""
+    return (sorted(set(baseline['modules']) - set(current['modules'])),
+            sorted(set(current['modules']) - set(baseline['modules'])))
+
+def compare(current, baseline, tolerance):
+    """list of regressions of current w.r.t. baseline; modules which
+    are not in both reports are not compared (see missing)"""
+    regressions = []
+    if current['peakRSS[MB]'] > (1. + tolerance) * baseline['peakRSS[MB]']:
+        regressions.append('peak RSS: %.1f MB (baseline %.1f MB)' % (current['peakRSS[MB]'], baseline['peakRSS[MB]']))
+    for label, reference in sorted(baseline['modules'].items()):
+        module = current['modules'].get(label)
+        if module is None:
+            continue
+        rate, referenceRate = module.get('events/s'), reference.get('events/s')
+        if rate and referenceRate and rate < (1. - tolerance) * referenceRate:
+            regressions.append('%s: %.1f events/s (baseline %.1f events/s)' % (label, rate, referenceRate))
+        allocs, referenceAllocs = module.get('allocations/event'), reference.get('allocations/event')
+        if allocs is not None and referenceAllocs is not None and allocs > (1. + tolerance) * referenceAllocs + 1.:
+            regressions.append('%s: %.1f allocations/event (baseline %.1f)' % (label, allocs, referenceAllocs))
+    return regressions
+
+def main():
+    parser = optparse.OptionParser(usage=__doc__)
+    parser.add_option('--input', default='', help='input file (default: synthetic sample)')
+    parser.add_option('--events', type='int', default=-1, help='number of events')
+    parser.add_option('--hi', action='store_true', default=False, help='benchmark dqmPhysicsHI instead of dqmPhysics')
+    parser.add_option('--skip', default=None, help='comma separated modules to be removed from the sequence')
+    parser.add_option('--report', default='dqmPhysicsBenchmark.json', help='output report')
+    parser.add_option('--baseline', default='', help='baseline report to compare with')
+    parser.add_option('--tolerance', type='float', default=0.10, help='relative tolerance')
+    parser.add_option('--update-baseline', action='store_true', default=False, help='write the report to the baseline')
+    (opts, args) = parser.parse_args()
+
+    input = opts.input
+    if not input:
+        if not os.path.exists(SAMPLE):
+            run([os.path.join(TEST_DIR, 'syntheticEvents_cfg.py')], 'syntheticEvents.log')
+        input = 'file:' + SAMPLE
+    sequence = 'dqmPhysicsHI' if opts.hi else 'dqmPhysics'
+    args = [os.path.join(TEST_DIR, 'dqmPhysicsBenchmark_cfg.py'), 'inputFiles=' + input,
+            'maxEvents=%d' % opts.events, 'sequence=' + sequence]
+    if opts.skip is not None:
+        args.append('skip=' + opts.skip)
+    log, rss = run(args, 'dqmPhysicsBenchmark.log')
+
+    current = report(log, rss, opts.events, sequence)
+    out = open(opts.report, 'w')
+    json.dump(current, out, indent=2, sort_keys=True)
+    out.close()
+    print('report written to %s' % opts.report)
+
+    if opts.baseline and opts.update_baseline:
+        out = open(opts.baseline, 'w')
+        json.dump(current, out, indent=2, sort_keys=True)
+        out.close()
+        print('baseline %s updated' % opts.baseline)
+        return 0
+    if opts.baseline:
+        if not os.path.exists(opts.baseline):
+            sys.exit('baseline %s does not exist (use --update-baseline)' % opts.baseline)
+        baseline = json.load(open(opts.baseline))
+        removed, added = missing(current, baseline)
+        for label in removed:
+            print('MISSING %s: in the baseline, but not in the report' % label)
+        for label in added:
+            print('NEW %s: in the report, but not in the baseline' % label)
+        regressions = compare(current, baseline, opts.tolerance)
+        for regression in regressions:
+            print('REGRESSION %s' % regression)
+        if regressions:
+            return 1
+        print('no regression w.r.t. %s (tolerance %.0f%%)' % (opts.baseline, 100. * opts.tolerance))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,66 @@
+import FWCore.ParameterSet.Config as cms
+
+## --------------------------------------------------------------------
+## Throughput benchmark of the dqmPhysics sequence; to be run via the
+## driver dqmPhysicsBenchmark.py, which parses the time, memory and
+## allocation reports of this job. By default the synthetic sample of
+## syntheticEvents_cfg.py is used. Options (cmsRun ... option=value):
+##
+##   inputFiles : input file(s)     (default: file:syntheticEvents.root)
+##   maxEvents  : number of events  (default: -1)
+##   sequence   : dqmPhysics or dqmPhysicsHI (default: dqmPhysics)
+##   skip       : modules to be removed from the sequence (default:
+##                ExoticaDQM, whose input is not in the synthetic sample)
+## --------------------------------------------------------------------
+import FWCore.ParameterSet.VarParsing as VarParsing
+options = VarParsing.VarParsing('analysis')
+options.register('sequence', 'dqmPhysics', VarParsing.VarParsing.multiplicity.singleton, VarParsing.VarParsing.varType.string,
+                 "sequence to be benchmarked (dqmPhysics or dqmPhysicsHI)")
+options.register('skip', 'ExoticaDQM', VarParsing.VarParsing.multiplicity.list, VarParsing.VarParsing.varType.string,
+                 "modules to be removed from the sequence")
+options.setDefault('inputFiles', ['file:syntheticEvents.root'])
+options.parseArguments()
+
+process = cms.Process("PhysicsDQMBenchmark")
+
+process.load("DQM.Physics.DQMPhysics_cff")
+process.load("DQM.Physics.syntheticJetCorrections_cff")
+
+process.load("DQMServices.Core.DQM_cfg")
+process.load("DQMServices.Components.DQMEnvironment_cfi")
+process.DQM.collectorHost = ''
+process.dqmSaver.workflow = cms.untracked.string('/Physics/Benchmark/DataSet')
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(options.maxEvents)
+)
+
+process.source = cms.Source(
+    "PoolSource"
+    ,fileNames = cms.untracked.vstring(options.inputFiles)
+)
+
+## configure message logger
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 1000
+process.MessageLogger.categories.append('AllocationReport')
+process.MessageLogger.cerr.AllocationReport = cms.untracked.PSet(limit = cms.untracked.int32(-1))
+
+## per module time (TimeReport), heap allocations and peak RSS of the job
+process.AllocationCounter = cms.Service("AllocationCounter",
+    ## distributions per module and event, saved with the DQM output
+    monitorElements = cms.untracked.bool(True)
+)
+
+sequence = getattr(process, options.sequence)
+for module in options.skip:
+    if module: sequence.remove(getattr(process, module))
+
+process.p = cms.Path(
+    sequence +
+    ## save histograms
+    process.dqmSaver
+)
+
+## Options and Output Report
+process.options   = cms.untracked.PSet( wantSummary = cms.untracked.bool(True) )
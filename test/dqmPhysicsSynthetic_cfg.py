@@ -0,0 +1,57 @@
+import FWCore.ParameterSet.Config as cms
+
+## --------------------------------------------------------------------
+## DQM/Physics modules on synthetic events (see syntheticEvents_cfg.py);
+## needs neither remote input files nor a GlobalTag. The jet corrections
+## are taken from the stand-in correctors, the HLT menu from the process
+## which generated the events.
+## --------------------------------------------------------------------
+process = cms.Process("PhysicsDQM")
+
+process.load("DQM.Physics.DQMPhysics_cff")
+process.load("DQM.Physics.syntheticJetCorrections_cff")
+
+process.load("DQMServices.Core.DQM_cfg")
+process.load("DQMServices.Components.DQMEnvironment_cfi")
+process.DQM.collectorHost = ''
+process.dqmSaver.workflow = cms.untracked.string('/Physics/Synthetic/DataSet')
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+
+process.source = cms.Source(
+    "PoolSource"
+    ,fileNames = cms.untracked.vstring(
+      'file:syntheticEvents.root'
+    )
+)
+
+## configure message logger
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 1000
+
+## per module timing
+process.Timing = cms.Service("Timing",
+    summaryOnly = cms.untracked.bool(True)
+)
+
+## all modules for which the synthetic events provide the input
+## collections; ExoticaDQM needs photons, ECAL rechits and the EI
+## collections, which are not generated
+process.p = cms.Path(
+    process.bphysicsOniaDQM            +
+    process.ewkMuDQM                   +
+    process.ewkElecDQM                 +
+    process.topSingleMuonMediumDQM     +
+    process.topSingleElectronMediumDQM +
+    process.DiMuonDQM                  +
+    process.DiElectronDQM              +
+    process.susyDQM                    +
+    process.HiggsDQM                   +
+    ## save histograms
+    process.dqmSaver
+)
+
+## Options and Output Report
+process.options   = cms.untracked.PSet( wantSummary = cms.untracked.bool(True) )
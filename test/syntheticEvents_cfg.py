@@ -0,0 +1,38 @@
+import FWCore.ParameterSet.Config as cms
+
+## --------------------------------------------------------------------
+## Generation of synthetic events for the offline (performance) test of
+## the DQM/Physics modules; needs neither input files nor a GlobalTag.
+## The process has to be called HLT, such that its trigger paths take
+## the role of the HLT menu for the DQM modules. Run the DQM modules on
+## the output with dqmPhysicsSynthetic_cfg.py.
+## --------------------------------------------------------------------
+process = cms.Process("HLT")
+
+## synthetic event content and emulated trigger paths
+process.load("DQM.Physics.syntheticEvents_cff")
+
+## pileup scenario: 'noPU', '2010', '2011', '2012' or
+## the mean number of pileup interactions
+from DQM.Physics.syntheticEvents_cff import setPileup
+setPileup(process, '2012')
+
+## number of events
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(
+  input = cms.untracked.int32(10000)
+)
+
+## output
+process.output = cms.OutputModule("PoolOutputModule",
+  fileName       = cms.untracked.string('syntheticEvents.root'),
+  outputCommands = cms.untracked.vstring('keep *')
+)
+process.outpath = cms.EndPath(process.output)
+
+## options and messaging
+process.options = cms.untracked.PSet(
+   wantSummary = cms.untracked.bool(True)
+)
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.cerr.FwkReport.reportEvery = 1000
@@ -0,0 +1,53 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process('HARVESTING')
+
+## incremental harvesting: the per lumi histogram deltas written
+## by the MEtoLumiDeltaConverter in topDQM_production_cfg.py are
+## merged lumi by lumi; no full histogram snapshots are collated
+
+# import of standard configurations
+process.load('DQMServices.Core.DQM_cfg')
+process.load('DQMServices.Components.DQMEnvironment_cfi')
+process.load('DQM.Physics.lumiDeltaToMEConverter_cfi')
+
+## input file (adapt input file name correspondingly)
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring("file:topDQM_production.root"),
+    processingMode = cms.untracked.string('RunsAndLumis')
+)
+
+## number of events
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+
+## output options
+process.options = cms.untracked.PSet(
+    Rethrow  = cms.untracked.vstring('ProductNotFound'),
+    fileMode = cms.untracked.string('FULLMERGE')
+)
+
+## DQMStore and output configuration
+process.DQMStore.collateHistograms = False
+process.dqmSaver.convention     = 'Offline'
+process.dqmSaver.saveByRun      = cms.untracked.int32( -1)
+process.dqmSaver.saveAtJobEnd   = cms.untracked.bool(True)
+process.dqmSaver.forceRunNumber = cms.untracked.int32(  1)
+process.dqmSaver.workflow       = cms.untracked.string('/TopVal/CMSSW_3_8_4/RECO') ## adapt apropriately
+
+## message logger
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.categories.append('LumiDeltaToMEConverter')
+process.MessageLogger.cerr.LumiDeltaToMEConverter = cms.untracked.PSet(limit = cms.untracked.int32(-1))
+
+## path definitions
+process.lumidelta = cms.Path(
+    process.lumiDeltaToMEConverter
+)
+process.dqmsave = cms.EndPath(
+    process.dqmSaver
+)
+
+## schedule definition
+process.schedule = cms.Schedule(process.lumidelta,process.dqmsave)
@@ -98,6 +98,10 @@ process.MessageLogger.cerr.SingleTopTChannelLeptonDQM    = cms.untracked.PSet(li
 process.MessageLogger.cerr.FwkReport.reportEvery = 1000
 process.MEtoEDMConverter.deleteAfterCopy = cms.untracked.bool(False)  ## line added to avoid crash when changing run number
 
+## per lumi histogram deltas for the incremental harvesting
+## (see topDQM_harvesting_lumiDeltas_cfg.py)
+process.load("DQM.Physics.meToLumiDeltaConverter_cfi")
+
 
 ## path definitions
 process.p      = cms.Path(
@@ -112,7 +116,8 @@ process.p      = cms.Path(
     process.topSingleElectronLooseDQM  +
     process.topSingleElectronMediumDQM +
     process.singleTopMuonMediumDQM     +
-    process.singleTopElectronMediumDQM
+    process.singleTopElectronMediumDQM +
+    process.meToLumiDeltaConverter
 )
 process.endjob = cms.Path(
     process.endOfProcess